@@ -0,0 +1,121 @@
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "timestamp.h"
+#include "clock_table.h"
+#include "vector_kernels.h"
+
+/* ---------- Benchmark Configuration ---------- */
+
+#define TARGET_ELEMENTS (1 << 25)   // ~32M counter visits per measurement
+#define REPEATS 3                   // best of
+
+static volatile int g_sink;
+
+/* ---------- Timing Helpers ---------- */
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/* ---------- Workload ---------- */
+
+// Snapshots of n gossiping processes, one per event: stored clocks as analytics code
+// would keep them
+static Timestamp *make_rows(ClockType type, int n, int count) {
+    Timestamp *procs = malloc(n * sizeof(Timestamp));
+    Timestamp *rows = malloc(count * sizeof(Timestamp));
+    for (int i = 0; i < n; i++) procs[i] = ts_create(n, i, type);
+
+    size_t max_size = (2 * (size_t)n + 1) * sizeof(int);
+    char *scratch = malloc(max_size);
+    unsigned int seed = 7;
+    for (int r = 0; r < count; r++) {
+        int p = rand_r(&seed) % n;
+        int q = rand_r(&seed) % n;
+        ts_increment(&procs[p]);
+        if (q != p && rand_r(&seed) % 2) {
+            size_t size = ts_serialize_for_dest(&procs[p], q, scratch, max_size);
+            ts_merge_and_tick(&procs[q], scratch, size);
+            p = q;
+        }
+        rows[r] = ts_clone(&procs[p]);
+    }
+
+    free(scratch);
+    for (int i = 0; i < n; i++) ts_destroy(&procs[i]);
+    free(procs);
+    return rows;
+}
+
+/* ---------- Measurements ---------- */
+
+// Nanoseconds per row: ts_compare in a loop, then ts_compare_many over a table of the same rows
+static void run_bench(ClockType type, int n, int count, double *loop_ns, double *many_ns) {
+    Timestamp *rows = make_rows(type, n, count);
+    ClockTable table;
+    clock_table_init(&table, n, type, count);
+    clock_table_add_all(&table, rows, count);
+    TSOrder *orders = malloc(count * sizeof(TSOrder));
+    const Timestamp *query = &rows[count / 2];
+
+    int iters = TARGET_ELEMENTS / ((long)n * count);
+    if (iters < 4) iters = 4;
+    *loop_ns = *many_ns = 1e30;
+    int acc = 0;
+
+    for (int rep = 0; rep < REPEATS; rep++) {
+        double t0 = now_ns();
+        for (int it = 0; it < iters; it++) {
+            for (int r = 0; r < count; r++) {
+                orders[r] = ts_compare(query, &rows[r]);
+            }
+            acc += orders[it % count];
+        }
+        double ns = (now_ns() - t0) / ((double)iters * count);
+        if (ns < *loop_ns) *loop_ns = ns;
+
+        t0 = now_ns();
+        for (int it = 0; it < iters; it++) {
+            ts_compare_many(query, &table, orders);
+            acc += orders[it % count];
+        }
+        ns = (now_ns() - t0) / ((double)iters * count);
+        if (ns < *many_ns) *many_ns = ns;
+    }
+    g_sink = acc;
+
+    free(orders);
+    clock_table_destroy(&table);
+    for (int r = 0; r < count; r++) ts_destroy(&rows[r]);
+    free(rows);
+}
+
+/* ---------- Main ---------- */
+
+int main(void) {
+    const ClockType types[] = {CLOCK_STANDARD, CLOCK_SPARSE, CLOCK_DIFFERENTIAL, CLOCK_COMPRESSED};
+    const int sizes[] = {8, 64, 256};
+    const int row_counts[] = {1000, 10000};
+
+    printf("=== One-vs-Many Compare Benchmark ===\n");
+    printf("Dispatched ISA: %s\n\n", vk_isa_name(vk_active_isa()));
+    printf("%-13s %6s %8s %14s %14s %10s\n", "type", "n", "rows", "loop(ns/row)", "many(ns/row)", "speedup");
+
+    for (int t = 0; t < (int)(sizeof(types) / sizeof(types[0])); t++) {
+        for (int s = 0; s < (int)(sizeof(sizes) / sizeof(sizes[0])); s++) {
+            for (int c = 0; c < (int)(sizeof(row_counts) / sizeof(row_counts[0])); c++) {
+                double loop_ns, many_ns;
+                run_bench(types[t], sizes[s], row_counts[c], &loop_ns, &many_ns);
+                printf("%-13s %6d %8d %14.2f %14.2f %9.2fx\n", clock_type_names[types[t]], sizes[s],
+                       row_counts[c], loop_ns, many_ns, loop_ns / many_ns);
+            }
+        }
+        printf("\n");
+    }
+    return 0;
+}
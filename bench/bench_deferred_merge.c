@@ -0,0 +1,150 @@
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "timestamp.h"
+
+/* ---------- Benchmark Configuration ---------- */
+
+#define TARGET_ELEMENTS (1 << 22)   // ~4M message entries per measurement
+#define TICKS_PER_SEND 2            // local events of the aggregator per send
+#define REPEATS 3                   // best of
+
+static volatile int g_sink;
+
+/* ---------- Timing Helpers ---------- */
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/* ---------- Workload ---------- */
+
+// Messages from n - 1 gossiping producers to process 0, serialized once up front
+typedef struct {
+    char *bytes;
+    size_t *offset;     // message i is bytes[offset[i] .. offset[i + 1])
+    int count;
+} Inbox;
+
+static Inbox make_inbox(ClockType type, int n, int count) {
+    Timestamp *producers = malloc(n * sizeof(Timestamp));
+    for (int i = 1; i < n; i++) producers[i] = ts_create(n, i, type);
+
+    size_t max_size = (2 * (size_t)n + 1) * sizeof(int);
+    Inbox inbox;
+    inbox.bytes = malloc(count * max_size);
+    inbox.offset = malloc((count + 1) * sizeof(size_t));
+    inbox.count = count;
+    inbox.offset[0] = 0;
+
+    char *scratch = malloc(max_size);
+    unsigned int seed = 7;
+    for (int i = 0; i < count; i++) {
+        int p = 1 + rand_r(&seed) % (n - 1);
+        int q = 1 + rand_r(&seed) % (n - 1);
+        if (q != p && rand_r(&seed) % 2) {
+            ts_increment(&producers[q]);
+            size_t size = ts_serialize_for_dest(&producers[q], p, scratch, max_size);
+            ts_merge_and_tick(&producers[p], scratch, size);
+        }
+        ts_increment(&producers[p]);
+        size_t size = ts_serialize_for_dest(&producers[p], 0, inbox.bytes + inbox.offset[i], max_size);
+        inbox.offset[i + 1] = inbox.offset[i] + size;
+    }
+
+    free(scratch);
+    for (int i = 1; i < n; i++) ts_destroy(&producers[i]);
+    free(producers);
+    return inbox;
+}
+
+static void free_inbox(Inbox *inbox) {
+    free(inbox->bytes);
+    free(inbox->offset);
+}
+
+/* ---------- Measurements ---------- */
+
+// Process 0 takes the whole inbox and reports to process 1 after every recv_per_send
+// receives; returns ns per event and leaves the final clock in *out
+static double replay(ClockType type, int n, const Inbox *inbox, int recv_per_send, int deferred,
+                     Timestamp *out) {
+    Timestamp agg = ts_create(n, 0, type);
+    ts_set_deferred(&agg, deferred);
+    size_t bufsize = (2 * (size_t)n + 1) * sizeof(int);
+    char *buffer = malloc(bufsize);
+    long events = 0;
+    size_t sent = 0;
+
+    double t0 = now_ns();
+    for (int i = 0; i < inbox->count; i++) {
+        ts_merge_and_tick(&agg, inbox->bytes + inbox->offset[i], inbox->offset[i + 1] - inbox->offset[i]);
+        events++;
+        if ((i + 1) % recv_per_send == 0) {
+            for (int t = 0; t < TICKS_PER_SEND; t++) ts_increment(&agg);
+            sent += ts_serialize_for_dest(&agg, 1, buffer, bufsize);
+            events += TICKS_PER_SEND + 1;
+        }
+    }
+    double ns = (now_ns() - t0) / events;
+
+    g_sink = (int)sent;
+    free(buffer);
+    *out = agg;
+    return ns;
+}
+
+static double best_replay(ClockType type, int n, const Inbox *inbox, int recv_per_send, int deferred,
+                          Timestamp *out) {
+    double best = 0.0;
+    for (int r = 0; r < REPEATS; r++) {
+        Timestamp ts;
+        double ns = replay(type, n, inbox, recv_per_send, deferred, &ts);
+        if (r == 0 || ns < best) best = ns;
+        if (r + 1 < REPEATS) ts_destroy(&ts);
+        else *out = ts;
+    }
+    return best;
+}
+
+/* ---------- Main ---------- */
+
+int main(void) {
+    const ClockType types[] = {CLOCK_STANDARD, CLOCK_DIFFERENTIAL, CLOCK_COMPRESSED};
+    const int ns[] = {16, 64, 256, 1024};
+    const int recv_per_send[] = {4, 16};
+
+    printf("=== Deferred Receive Benchmark ===\n");
+    printf("Process 0 receives from n - 1 gossiping producers; after every R receives it makes\n");
+    printf("%d local events and one send to process 1\n\n", TICKS_PER_SEND);
+    printf("%-13s %-5s %-4s %12s %12s %8s\n", "type", "n", "R", "eager(ns)", "deferred(ns)", "speedup");
+
+    for (int t = 0; t < (int)(sizeof(types) / sizeof(types[0])); t++) {
+        for (int i = 0; i < (int)(sizeof(ns) / sizeof(ns[0])); i++) {
+            int n = ns[i];
+            int count = TARGET_ELEMENTS / n;
+            Inbox inbox = make_inbox(types[t], n, count < 1024 ? 1024 : count);
+
+            for (int r = 0; r < (int)(sizeof(recv_per_send) / sizeof(recv_per_send[0])); r++) {
+                Timestamp eager, deferred;
+                double eager_ns = best_replay(types[t], n, &inbox, recv_per_send[r], 0, &eager);
+                double deferred_ns = best_replay(types[t], n, &inbox, recv_per_send[r], 1, &deferred);
+                if (ts_compare(&eager, &deferred) != TS_EQUAL) {
+                    fprintf(stderr, "Deferred %s clock differs from the eager one\n", clock_type_names[types[t]]);
+                    exit(1);
+                }
+                printf("%-13s %-5d %-4d %12.1f %12.1f %8.2f\n", clock_type_names[types[t]], n,
+                       recv_per_send[r], eager_ns, deferred_ns, eager_ns / deferred_ns);
+                ts_destroy(&eager);
+                ts_destroy(&deferred);
+            }
+            free_inbox(&inbox);
+        }
+        printf("\n");
+    }
+    return 0;
+}
@@ -0,0 +1,164 @@
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "encoded_clock.h"
+
+/* ---------- Benchmark Configuration ---------- */
+
+#define MIN_N 4
+#define MAX_N 64
+#define TICKS_PER_PROCESS 4         // average counter value per entry
+#define TARGET_TICKS (1 << 21)      // ~2M counter units factored per measurement
+
+static volatile int g_sink;
+
+/* ---------- Timing Helpers ---------- */
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static int iterations_for(int n) {
+    int iters = TARGET_TICKS / (n * TICKS_PER_PROCESS);
+    return iters < 16 ? 16 : iters;
+}
+
+/* ---------- Inputs ---------- */
+
+// a and b each see random ticks from every process; c = a with one extra tick, so a -> c
+static void make_clocks(int n, Timestamp *a, Timestamp *b, Timestamp *c) {
+    *a = encoded_create(n, 0, CLOCK_ENCODED);
+    *b = encoded_create(n, 0, CLOCK_ENCODED);
+    srand(42);
+    for (int k = 0; k < n * TICKS_PER_PROCESS; k++) {
+        a->pid = rand() % n;
+        encoded_increment(a);
+        b->pid = rand() % n;
+        encoded_increment(b);
+    }
+    *c = encoded_clone(a);
+    c->pid = n - 1;
+    encoded_increment(c);
+}
+
+/* ---------- Measurements ---------- */
+
+typedef struct {
+    double compare_before_ns;      // a -> c
+    double compare_concurrent_ns;  // a || b
+    double merge_ns;               // a merged with b's serialized form
+    size_t encoded_bytes;
+} BenchResult;
+
+static BenchResult run_bench(int n, int decode_path) {
+    Timestamp a, b, c;
+    make_clocks(n, &a, &b, &c);
+    encoded_force_decode(decode_path);
+
+    int iters = iterations_for(n);
+    unsigned char *buffer = malloc(encoded_serialize(&b, NULL, 0));
+    size_t size = encoded_serialize(&b, buffer, encoded_serialize(&b, NULL, 0));
+    BenchResult r;
+    r.encoded_bytes = size;
+
+    int acc = 0;
+    double t0 = now_ns();
+    for (int it = 0; it < iters; it++) {
+        acc += encoded_compare(&a, &c);
+    }
+    r.compare_before_ns = (now_ns() - t0) / iters;
+
+    t0 = now_ns();
+    for (int it = 0; it < iters; it++) {
+        acc += encoded_compare(&a, &b);
+    }
+    r.compare_concurrent_ns = (now_ns() - t0) / iters;
+
+    // Merge into a fresh copy of a each time so every call does the same work
+    t0 = now_ns();
+    for (int it = 0; it < iters; it++) {
+        Timestamp dst = encoded_clone(&a);
+        encoded_merge(&dst, buffer, size);
+        encoded_destroy(&dst);
+    }
+    r.merge_ns = (now_ns() - t0) / iters;
+    g_sink = acc;
+
+    encoded_force_decode(0);
+    free(buffer);
+    encoded_destroy(&a);
+    encoded_destroy(&b);
+    encoded_destroy(&c);
+    return r;
+}
+
+/* ---------- Capacity ---------- */
+
+typedef struct {
+    long long word_events;       // increments until the product leaves the 8-byte word
+    long long predicted_events;  // encoded_events_left(fresh clock, 8): worst-case bound
+    long long switch_events;     // increments until the switch to vector form
+    double log_word_events;      // increments the Q32.32 log absorbs before it wraps
+} CapacityResult;
+
+// Every process ticks in turn on one clock, as if each event were merged into it
+static CapacityResult run_capacity(int n) {
+    Timestamp ts = encoded_create(n, 0, CLOCK_ENCODED);
+    const EncodedClockData *data = (const EncodedClockData*)ts.data;
+    CapacityResult r;
+    r.predicted_events = encoded_events_left(&ts, sizeof(unsigned long long));
+    r.log_word_events = 18446744073709551616.0 / (double)data->prime_logs[n - 1];
+    r.word_events = -1;
+    
+    long long events = 0;
+    while (!data->overflow) {
+        ts.pid = events % n;
+        encoded_increment(&ts);
+        events++;
+        if (r.word_events < 0 && data->value.len > 2) r.word_events = events - 1;
+    }
+    r.switch_events = events;
+    if (r.word_events < 0) r.word_events = events;
+    
+    encoded_destroy(&ts);
+    return r;
+}
+
+/* ---------- Main ---------- */
+
+int main(void) {
+    // Keep the prime encoding at every size so both paths see the same operands
+    encoded_set_vector_threshold((size_t)1 << 30);
+
+    printf("=== Encoded Clock Compare/Merge Benchmark ===\n");
+    printf("Counters: ~%d ticks per process\n\n", TICKS_PER_PROCESS);
+    printf("%-6s %-8s %8s %12s %12s %12s %10s %10s\n",
+           "n", "path", "bytes", "cmp->(ns)", "cmp||(ns)", "merge(ns)", "cmp-> x", "merge x");
+
+    for (int n = MIN_N; n <= MAX_N; n *= 2) {
+        BenchResult decode = run_bench(n, 1);
+        BenchResult encoded = run_bench(n, 0);
+        printf("%-6d %-8s %8zu %12.1f %12.1f %12.1f %10s %10s\n", n, "decode",
+               decode.encoded_bytes, decode.compare_before_ns, decode.compare_concurrent_ns,
+               decode.merge_ns, "1.00", "1.00");
+        printf("%-6d %-8s %8zu %12.1f %12.1f %12.1f %10.2f %10.2f\n\n", n, "encoded",
+               encoded.encoded_bytes, encoded.compare_before_ns, encoded.compare_concurrent_ns,
+               encoded.merge_ns, decode.compare_before_ns / encoded.compare_before_ns,
+               decode.merge_ns / encoded.merge_ns);
+    }
+    
+    // Capacity at the default threshold
+    encoded_set_vector_threshold(0);
+    printf("=== Encoded Clock Capacity (round-robin ticks) ===\n\n");
+    printf("%-6s %12s %12s %12s %16s\n", "n", "8B events", "predicted", "switch", "log word");
+    for (int n = MIN_N; n <= MAX_N; n *= 2) {
+        CapacityResult r = run_capacity(n);
+        printf("%-6d %12lld %12lld %12lld %16.3g\n", n, r.word_events, r.predicted_events,
+               r.switch_events, r.log_word_events);
+    }
+    return 0;
+}
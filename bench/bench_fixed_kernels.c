@@ -0,0 +1,192 @@
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include "timestamp.h"
+
+/* ---------- Benchmark Configuration ---------- */
+
+#define TARGET_ELEMENTS (1 << 25)   // ~32M element visits per measurement
+#define MAX_FIXED_N 64
+
+static volatile int g_sink;
+
+/* ---------- Timing Helpers ---------- */
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static int iterations_for(int n) {
+    int iters = TARGET_ELEMENTS / n;
+    return iters < 16 ? 16 : iters;
+}
+
+/* ---------- Measurements ---------- */
+
+typedef struct {
+    double merge_ns;
+    double compare_ns;      // a <= b: full scan required
+    double increment_ns;
+    double serialize_ns;
+} BenchResult;
+
+// Clocks bind their kernels at creation, so each run creates its own
+static BenchResult run_bench(ClockType type, int n, int fixed) {
+    ts_set_fixed_kernels(fixed);
+    Timestamp a = ts_create(n, 0, type);
+    Timestamp b = ts_create(n, 1, type);
+    ts_set_fixed_kernels(1);
+
+    // Counters in the hundreds (16-bit standard clocks); b dominates a
+    int v[MAX_FIXED_N];
+    srand(42);
+    for (int i = 0; i < n; i++) v[i] = 100 + rand() % 400;
+    ts_merge(&a, v, n * sizeof(int));
+    for (int i = 0; i < n; i++) v[i] += 1 + rand() % 3;
+    ts_merge(&b, v, n * sizeof(int));
+    ts_increment(&b);
+
+    int iters = iterations_for(n);
+    uint64_t buffer[MAX_FIXED_N];
+    size_t size = ts_serialize(&a, buffer, sizeof(buffer));
+    BenchResult r;
+    int acc = 0;
+
+    // The receiver already knows everything: the common steady-state merge
+    double t0 = now_ns();
+    for (int it = 0; it < iters; it++) {
+        ts_merge(&b, buffer, size);
+    }
+    r.merge_ns = (now_ns() - t0) / iters;
+
+    t0 = now_ns();
+    for (int it = 0; it < iters; it++) {
+        acc += ts_compare(&a, &b);
+    }
+    r.compare_ns = (now_ns() - t0) / iters;
+
+    t0 = now_ns();
+    for (int it = 0; it < iters; it++) {
+        ts_increment(&a);
+    }
+    r.increment_ns = (now_ns() - t0) / iters;
+
+    t0 = now_ns();
+    for (int it = 0; it < iters; it++) {
+        acc += (int)ts_serialize(&b, buffer, sizeof(buffer));
+    }
+    r.serialize_ns = (now_ns() - t0) / iters;
+    g_sink = acc;
+
+    ts_destroy(&a);
+    ts_destroy(&b);
+    return r;
+}
+
+/* ---------- Digest Compare ---------- */
+
+typedef struct {
+    double equal_ns;
+    double concurrent_ns;   // equal sums
+    double before_ns;       // a <= b: the digests cannot decide
+} CompareResult;
+
+static double time_compare(const Timestamp *a, const Timestamp *b, int iters) {
+    int acc = 0;
+    double t0 = now_ns();
+    for (int it = 0; it < iters; it++) {
+        acc += ts_compare(a, b);
+    }
+    g_sink = acc;
+    return (now_ns() - t0) / iters;
+}
+
+static CompareResult run_compare_bench(ClockType type, int n, int digests) {
+    Timestamp a = ts_create(n, 0, type);
+    Timestamp b = ts_create(n, 1, type);
+    
+    // Every entry set, so sparse clocks are as long as the others
+    int *v = malloc(n * sizeof(int));
+    for (int i = 0; i < n; i++) v[i] = 100 + i % 400;
+    ts_merge(&a, v, n * sizeof(int));
+    ts_merge(&b, v, n * sizeof(int));
+    free(v);
+    ts_increment(&a);
+    ts_increment(&b);      // a and b: equal sums, neither dominates
+    Timestamp same = ts_clone(&a);
+    Timestamp later = ts_clone(&a);
+    ts_increment(&later);
+    ts_increment(&later);  // a <= later
+    
+    int iters = TARGET_ELEMENTS / n;
+    CompareResult r;
+    ts_set_digest_compare(digests);
+    r.equal_ns = time_compare(&a, &same, iters);
+    r.concurrent_ns = time_compare(&a, &b, iters);
+    r.before_ns = time_compare(&a, &later, iters);
+    ts_set_digest_compare(1);
+    
+    ts_destroy(&a);
+    ts_destroy(&b);
+    ts_destroy(&same);
+    ts_destroy(&later);
+    return r;
+}
+
+static void print_compare_bench(void) {
+    const ClockType types[] = {CLOCK_STANDARD, CLOCK_SPARSE, CLOCK_DIFFERENTIAL, CLOCK_COMPRESSED};
+    const int ns[] = {16, 256, 4096};
+    
+    printf("=== Digest Compare Benchmark ===\n");
+    printf("%-13s %-5s %-8s %10s %10s %10s %8s %8s\n", "type", "n", "compare", "equal(ns)",
+           "conc(ns)", "before(ns)", "equal x", "conc x");
+    for (int t = 0; t < (int)(sizeof(types) / sizeof(types[0])); t++) {
+        for (int i = 0; i < (int)(sizeof(ns) / sizeof(ns[0])); i++) {
+            CompareResult scan = run_compare_bench(types[t], ns[i], 0);
+            CompareResult digest = run_compare_bench(types[t], ns[i], 1);
+            printf("%-13s %-5d %-8s %10.1f %10.1f %10.1f %8s %8s\n", clock_type_names[types[t]], ns[i],
+                   "scan", scan.equal_ns, scan.concurrent_ns, scan.before_ns, "1.00", "1.00");
+            printf("%-13s %-5d %-8s %10.1f %10.1f %10.1f %8.2f %8.2f\n", clock_type_names[types[t]], ns[i],
+                   "digest", digest.equal_ns, digest.concurrent_ns, digest.before_ns,
+                   scan.equal_ns / digest.equal_ns, scan.concurrent_ns / digest.concurrent_ns);
+        }
+        printf("\n");
+    }
+}
+
+/* ---------- Main ---------- */
+
+#define FIXED_N_ENTRY(N) N,
+static const int fixed_ns[] = { FOR_EACH_FIXED_N(FIXED_N_ENTRY) };
+
+int main(void) {
+    const ClockType types[] = {CLOCK_STANDARD, CLOCK_DIFFERENTIAL};
+
+    printf("=== Fixed-n Kernel Benchmark ===\n");
+    printf("%-13s %-4s %-8s %10s %10s %10s %10s %8s %8s %8s\n", "type", "n", "kernels",
+           "merge(ns)", "cmp(ns)", "incr(ns)", "ser(ns)", "merge x", "cmp x", "ser x");
+
+    for (int t = 0; t < (int)(sizeof(types) / sizeof(types[0])); t++) {
+        for (int i = 0; i < (int)(sizeof(fixed_ns) / sizeof(fixed_ns[0])); i++) {
+            int n = fixed_ns[i];
+            BenchResult generic = run_bench(types[t], n, 0);
+            BenchResult fixed = run_bench(types[t], n, 1);
+            printf("%-13s %-4d %-8s %10.1f %10.1f %10.1f %10.1f %8s %8s %8s\n", clock_type_names[types[t]], n,
+                   "generic", generic.merge_ns, generic.compare_ns, generic.increment_ns,
+                   generic.serialize_ns, "1.00", "1.00", "1.00");
+            printf("%-13s %-4d %-8s %10.1f %10.1f %10.1f %10.1f %8.2f %8.2f %8.2f\n", clock_type_names[types[t]], n,
+                   "fixed", fixed.merge_ns, fixed.compare_ns, fixed.increment_ns, fixed.serialize_ns,
+                   generic.merge_ns / fixed.merge_ns, generic.compare_ns / fixed.compare_ns,
+                   generic.serialize_ns / fixed.serialize_ns);
+        }
+        printf("\n");
+    }
+    
+    print_compare_bench();
+    return 0;
+}
@@ -0,0 +1,190 @@
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "vector_kernels.h"
+#include "counter_store.h"
+
+/* ---------- Benchmark Configuration ---------- */
+
+#define MIN_N 16
+#define MAX_N 65536
+#define TARGET_ELEMENTS (1 << 26)   // ~64M element visits per measurement
+
+static volatile int g_sink;
+
+/* ---------- Timing Helpers ---------- */
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static int iterations_for(int n) {
+    int iters = TARGET_ELEMENTS / n;
+    return iters < 16 ? 16 : iters;
+}
+
+/* ---------- Legacy Loops (pre-kernel implementation) ---------- */
+
+static void legacy_merge(int *dst, const int *src, int n) {
+    for (int i = 0; i < n; i++) {
+        if (src[i] > dst[i]) {
+            dst[i] = src[i];
+        }
+    }
+}
+
+static TSOrder legacy_compare(const int *a, const int *b, int n) {
+    int a_le_b = 1, b_le_a = 1;
+    int a_lt_b = 0, b_lt_a = 0;
+
+    for (int i = 0; i < n; i++) {
+        if (a[i] > b[i]) {
+            a_le_b = 0;
+            b_lt_a = 1;
+        }
+        if (b[i] > a[i]) {
+            b_le_a = 0;
+            a_lt_b = 1;
+        }
+    }
+
+    if (a_le_b && b_le_a) return TS_EQUAL;
+    if (a_le_b && a_lt_b) return TS_BEFORE;
+    if (b_le_a && b_lt_a) return TS_AFTER;
+    return TS_CONCURRENT;
+}
+
+/* ---------- Measurements ---------- */
+
+typedef struct {
+    double merge_ns;
+    double compare_before_ns;      // a <= b: full scan required
+    double compare_concurrent_ns;  // diverges early: eligible for early exit
+} BenchResult;
+
+static void fill_inputs(int *a, int *b, int *c, int n, unsigned int seed) {
+    srand(seed);
+    for (int i = 0; i < n; i++) {
+        a[i] = 1 + rand() % 1000;
+        b[i] = a[i] + (rand() % 3);   // b dominates a
+        c[i] = a[i];
+    }
+    // c is concurrent with a within the first few entries
+    c[0] = a[0] + 1;
+    c[1] = a[1] - 1;
+}
+
+static BenchResult run_bench(int n, int use_legacy) {
+    int *a = malloc(n * sizeof(int));
+    int *b = malloc(n * sizeof(int));
+    int *c = malloc(n * sizeof(int));
+    int *dst = malloc(n * sizeof(int));
+    fill_inputs(a, b, c, n, 42);
+    int iters = iterations_for(n);
+    BenchResult r;
+
+    memcpy(dst, a, n * sizeof(int));
+    double t0 = now_ns();
+    for (int it = 0; it < iters; it++) {
+        if (use_legacy) legacy_merge(dst, (it & 1) ? b : c, n);
+        else vk_merge_max(dst, (it & 1) ? b : c, n);
+    }
+    r.merge_ns = (now_ns() - t0) / iters;
+    g_sink = dst[n - 1];
+
+    int acc = 0;
+    t0 = now_ns();
+    for (int it = 0; it < iters; it++) {
+        acc += use_legacy ? legacy_compare(a, b, n) : vk_compare(a, b, n);
+    }
+    r.compare_before_ns = (now_ns() - t0) / iters;
+
+    t0 = now_ns();
+    for (int it = 0; it < iters; it++) {
+        acc += use_legacy ? legacy_compare(a, c, n) : vk_compare(a, c, n);
+    }
+    r.compare_concurrent_ns = (now_ns() - t0) / iters;
+    g_sink = acc;
+
+    free(a);
+    free(b);
+    free(c);
+    free(dst);
+    return r;
+}
+
+// Adaptive-width counters: full-scan compare and int32 merge at each storage width
+static void run_width_bench(int n, int width, double *compare_ns, double *merge_ns) {
+    void *a = calloc(n, width);
+    void *b = calloc(n, width);
+    int32_t *src = malloc(n * sizeof(int32_t));
+    for (int i = 0; i < n; i++) {
+        counter_set(a, width, i, 1 + i % 100);
+        counter_set(b, width, i, 1 + i % 100 + (i == n - 1));
+        src[i] = i % 101;
+    }
+    int iters = iterations_for(n);
+    ClockDigest digest;  // raised by the merges; not read
+    clock_digest_reset(&digest);
+
+    int acc = 0;
+    double t0 = now_ns();
+    for (int it = 0; it < iters; it++) {
+        acc += counter_compare(a, width, b, width, n);
+    }
+    *compare_ns = (now_ns() - t0) / iters;
+
+    t0 = now_ns();
+    for (int it = 0; it < iters; it++) {
+        counter_merge_i32(a, width, src, n, &digest);
+    }
+    *merge_ns = (now_ns() - t0) / iters;
+    g_sink = acc + (int)counter_get(a, width, n - 1);
+
+    free(a);
+    free(b);
+    free(src);
+}
+
+/* ---------- Main ---------- */
+
+int main(void) {
+    VkIsa best = vk_active_isa();
+
+    printf("=== Dense Vector Kernel Benchmark ===\n");
+    printf("Dispatched ISA: %s\n\n", vk_isa_name(best));
+    printf("%-8s %-8s %12s %12s %12s %10s %10s\n",
+           "n", "kernel", "merge(ns)", "cmp<=(ns)", "cmp||(ns)", "merge x", "cmp<= x");
+
+    for (int n = MIN_N; n <= MAX_N; n *= 4) {
+        BenchResult legacy = run_bench(n, 1);
+        printf("%-8d %-8s %12.1f %12.1f %12.1f %10s %10s\n", n, "legacy",
+               legacy.merge_ns, legacy.compare_before_ns, legacy.compare_concurrent_ns, "1.00", "1.00");
+
+        for (int isa = VK_ISA_SCALAR; isa < VK_ISA_COUNT; isa++) {
+            if (!vk_force_isa((VkIsa)isa)) continue;
+            BenchResult r = run_bench(n, 0);
+            printf("%-8d %-8s %12.1f %12.1f %12.1f %10.2f %10.2f\n", n, vk_isa_name((VkIsa)isa),
+                   r.merge_ns, r.compare_before_ns, r.compare_concurrent_ns,
+                   legacy.merge_ns / r.merge_ns, legacy.compare_before_ns / r.compare_before_ns);
+        }
+        vk_force_isa(best);
+        printf("\n");
+    }
+
+    printf("=== Counter Width Benchmark ===\n");
+    printf("%-8s %-8s %12s %12s\n", "n", "width", "merge(ns)", "cmp<=(ns)");
+    for (int n = 256; n <= MAX_N; n *= 16) {
+        for (int width = COUNTER_WIDTH_MIN; width <= COUNTER_WIDTH_MAX; width *= 2) {
+            double compare_ns, merge_ns;
+            run_width_bench(n, width, &compare_ns, &merge_ns);
+            printf("%-8d %-8d %12.1f %12.1f\n", n, 8 * width, merge_ns, compare_ns);
+        }
+        printf("\n");
+    }
+    return 0;
+}
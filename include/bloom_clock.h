@@ -0,0 +1,56 @@
+#ifndef BLOOM_CLOCK_H
+#define BLOOM_CLOCK_H
+
+#include <stdint.h>
+#include "timestamp.h"
+
+/* ---------- Bloom Clock Configuration ---------- */
+
+// Bloom clocks (Ramabaja 2019): a counting Bloom filter of every event in the causal
+// history. Event c of process pid increments k cells chosen by hashing (pid, c), so the
+// timestamp is m counters no matter how many processes exist.
+#define BLOOM_DEFAULT_CELLS 64
+#define BLOOM_DEFAULT_HASHES 3
+
+// Filter shape for clocks created from now on; 0 restores the default for either value
+void bloom_set_params(int cells, int hashes);
+int bloom_cells(void);
+int bloom_hashes(void);
+
+/* ---------- Bloom Clock Data Structure ---------- */
+
+// One block: header and filter together (see clock_arena.h)
+typedef struct {
+    int m;              // filter width
+    int k;              // hash functions per event
+    uint32_t events;    // this process's event counter (local, not serialized)
+    int cells[];        // m counters
+} BloomClockData;
+
+/* ---------- Bloom Clock Operations ---------- */
+
+Timestamp bloom_create(int n, int pid, ClockType type);
+Timestamp bloom_create_in(ClockArena *arena, int n, int pid, ClockType type);
+void bloom_destroy(Timestamp *ts);
+void bloom_increment(Timestamp *ts);
+void bloom_merge(Timestamp *dst, const void *other_data, size_t other_size);
+// Dominance over the cells. BEFORE/AFTER may be false positives; see bloom_false_positive.
+TSOrder bloom_compare(const Timestamp *a, const Timestamp *b);
+size_t bloom_serialize(const Timestamp *ts, void *buffer, size_t bufsize);
+void bloom_deserialize(Timestamp *ts, const void *buffer, size_t size);
+void bloom_to_string(const Timestamp *ts, char *buf, size_t bufsize);
+Timestamp bloom_clone(const Timestamp *ts);
+Timestamp bloom_clone_in(ClockArena *arena, const Timestamp *ts);
+
+/* ---------- False Positive Estimate ---------- */
+
+// Probability that a's cells are dominated by b's although a did not happen before b:
+// the chance that the k cells of one event missing from b's history are all covered by
+// b's extra increments, (1 - (1 - 1/m)^(sum(b) - sum(a)))^k. 0 if a is not dominated.
+double bloom_false_positive(const Timestamp *a, const Timestamp *b);
+
+/* ---------- Operations Table ---------- */
+
+extern const TimestampOps BLOOM_OPS;
+
+#endif // BLOOM_CLOCK_H
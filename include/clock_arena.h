@@ -0,0 +1,50 @@
+#ifndef CLOCK_ARENA_H
+#define CLOCK_ARENA_H
+
+#include <stddef.h>
+
+/* ---------- Clock Block Layout ---------- */
+
+// Every clock's header and fixed-size arrays live in one block aligned to a cache line.
+// A block is preceded by one cache line of bookkeeping (owning arena, size class).
+#define CLOCK_BLOCK_ALIGN 64
+
+// Rounds a byte count up to a whole number of cache lines
+#define CLOCK_BLOCK_ROUND(size) (((size) + CLOCK_BLOCK_ALIGN - 1) & ~(size_t)(CLOCK_BLOCK_ALIGN - 1))
+
+/* ---------- Per-Process Arena ---------- */
+
+// Bump allocator over large chunks, with one free list per block size so that the
+// create/destroy churn of a process reuses its own blocks. Not thread-safe: an arena
+// belongs to one process (thread), and only that thread may allocate or free from it.
+#define CLOCK_ARENA_CHUNK (64 * 1024)        // bytes per chunk (2 MB with huge pages)
+#define CLOCK_ARENA_CLASSES 8               // distinct block sizes with a free list
+
+typedef struct ClockArenaChunk ClockArenaChunk;
+
+typedef struct ClockArena {
+    ClockArenaChunk *chunks;    // newest first
+    char *bump;                 // next free byte in the newest chunk
+    size_t left;                // bytes left after bump
+    struct {
+        size_t size;            // block size (0 for an unused class)
+        void *head;             // freed blocks, linked through their first word
+    } free_lists[CLOCK_ARENA_CLASSES];
+    int huge_pages;             // back chunks with transparent huge pages when available
+    size_t reserved;            // bytes taken from the system
+    size_t live_blocks;         // blocks handed out and not yet freed
+} ClockArena;
+
+void clock_arena_init(ClockArena *arena, int huge_pages);
+void clock_arena_release(ClockArena *arena);  // Frees every chunk; blocks must not be used after
+
+/* ---------- Blocks ---------- */
+
+// Zeroed, CLOCK_BLOCK_ALIGN-aligned block. arena == NULL takes it from malloc (one call).
+void *clock_block_alloc(ClockArena *arena, size_t size);
+// Returns the block to the arena it came from, or to the heap
+void clock_block_free(void *block);
+// Arena a block came from, NULL for heap blocks
+ClockArena *clock_block_arena(const void *block);
+
+#endif // CLOCK_ARENA_H
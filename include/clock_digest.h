@@ -0,0 +1,65 @@
+#ifndef CLOCK_DIGEST_H
+#define CLOCK_DIGEST_H
+
+#include <stdint.h>
+
+/* ---------- Clock Digest ---------- */
+
+// Summary of a clock's counter vector, kept by the types whose compare is vector dominance
+// (standard, sparse, differential, compressed, and matrix on its own row). Counters only
+// grow, so every update is a raise of one entry, and each raise costs O(1).
+//
+// hash is the XOR of clock_digest_key(k, v[k]) over all entries (Zobrist hashing): equal
+// vectors have equal hashes whatever their history, and a raise swaps one key for another.
+// Sums are exact as long as they stay below 2^64.
+typedef struct {
+    uint64_t sum;       // sum of the counters
+    uint64_t max;       // largest counter
+    uint64_t hash;      // XOR of clock_digest_key over the entries
+    int valid;          // 0: the type keeps no digest
+} ClockDigest;
+
+// Pseudo-random key for "entry k holds v" (splitmix64 finalizer); a zero entry has key 0,
+// so absent entries of sparse clocks need no key
+static inline uint64_t clock_digest_key(int k, uint64_t v) {
+    if (v == 0) return 0;
+    
+    uint64_t x = v + (uint64_t)(uint32_t)k * 0x9E3779B97F4A7C15ULL;
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ULL;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBULL;
+    x ^= x >> 31;
+    return x;
+}
+
+// Digest of the all-zero vector, which every clock starts from
+static inline void clock_digest_reset(ClockDigest *d) {
+    d->sum = 0;
+    d->max = 0;
+    d->hash = 0;
+    d->valid = 1;
+}
+
+// For types that keep no digest
+static inline void clock_digest_none(ClockDigest *d) {
+    clock_digest_reset(d);
+    d->valid = 0;
+}
+
+// Entry k grew from old to v (v > old)
+static inline void clock_digest_raise(ClockDigest *d, int k, uint64_t old, uint64_t v) {
+    d->sum += v - old;
+    if (v > d->max) d->max = v;
+    d->hash ^= clock_digest_key(k, old) ^ clock_digest_key(k, v);
+}
+
+// Digest of n dense counters from scratch; entries <= 0 count as 0
+static inline void clock_digest_of_vector(ClockDigest *d, const int *v, int n) {
+    clock_digest_reset(d);
+    for (int k = 0; k < n; k++) {
+        if (v[k] > 0) clock_digest_raise(d, k, 0, (uint64_t)v[k]);
+    }
+}
+
+#endif // CLOCK_DIGEST_H
@@ -0,0 +1,39 @@
+#ifndef CLOCK_TABLE_H
+#define CLOCK_TABLE_H
+
+#include "timestamp.h"
+
+/* ---------- Column-Major Clock Table ---------- */
+
+// Many same-type clocks stored as dense columns: entry k of row r lives at
+// cols[k * capacity + r], so one pass over column k touches every row's k-th entry.
+typedef struct {
+    ClockType type;     // clock type of every stored row
+    int n;              // entries per clock
+    int rows;           // number of stored clocks
+    int capacity;       // allocated rows per column
+    int *cols;          // n columns of `capacity` counters each
+} ClockTable;
+
+/* ---------- Clock Table Operations ---------- */
+
+// 1 if ts_compare on the type is plain dominance over ts_to_vector: standard, sparse,
+// differential, encoded, compressed and matrix clocks. A row keeps only the vector, so
+// plausible clocks (equal folded vectors from different pids are concurrent) and the
+// types without to_vector cannot be stored.
+int clock_table_supports(ClockType type);
+
+void clock_table_init(ClockTable *t, int n, ClockType type, int capacity);  // type must be supported
+void clock_table_destroy(ClockTable *t);
+// Returns the new row index, or -1 (nothing stored) for a standard clock with a counter
+// past INT_MAX, which the int columns cannot hold
+int clock_table_add(ClockTable *t, const Timestamp *ts);
+void clock_table_add_all(ClockTable *t, const Timestamp *ts, int count);  // Skips clocks add refuses
+
+/* ---------- Batch Comparison ---------- */
+
+// out_orders[r] = ts_compare(query, row r) for every row, in one columnar pass. Returns 1,
+// or 0 (out_orders untouched) if query is a standard clock with a counter past INT_MAX.
+int ts_compare_many(const Timestamp *query, const ClockTable *table, TSOrder *out_orders);
+
+#endif // CLOCK_TABLE_H
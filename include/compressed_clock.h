@@ -1,36 +1,124 @@
 #ifndef COMPRESSED_CLOCK_H
 #define COMPRESSED_CLOCK_H
 
+#include <stdint.h>
 #include "timestamp.h"
 
+/* ---------- Destination Tracking Configuration ---------- */
+
+// tau rows (what was last sent to each receiver) are only kept for destinations actually
+// sent to, at most K of them. When K is reached the least recently used destination loses
+// its row; its next message is a full vector, which rebuilds the row.
+#define COMPRESSED_UNLIMITED_DESTINATIONS 0
+
+// K for clocks created from now on; 0 tracks every destination
+void compressed_set_max_destinations(int k);
+int compressed_max_destinations(int n);
+
+// Value deltas for clocks created from now on (off by default). Every destination-aware
+// send then carries vt[k] - tau[dest][k] instead of vt[k], and the receiver rebuilds vt[k]
+// from the last vector it got from that sender. Channels must be FIFO and lossless; a
+// frame that arrives out of sequence is ignored.
+void compressed_set_value_deltas(int enabled);
+int compressed_value_deltas(void);
+
 /* ---------- Compressed Vector Clock Data Structure ---------- */
 
+#define COMPRESSED_ROW_NONE -1      // never sent to: last sent state is all zeros
+#define COMPRESSED_ROW_EVICTED -2   // row evicted: last sent state unknown
+
+#define COMPRESSED_DIRTY_WORDS(n) (((n) + 63) / 64)
+
 // Compressed vector clock data (True Delta Compression)
+// The header, vt and row_of share one block (see clock_arena.h); the tau rows grow on
+// demand and live on the heap.
 typedef struct {
-    int *vt;                   // Current vector clock [n]
-    int **tau;                 // Last sent timestamps tau[j][k] - what was last sent to each receiver j
+    int *vt;                   // Current vector clock [n], in the block
     int n;                     // Number of processes (for convenience)
+    // tau: rows of n ints in one arena; row r is what was last sent to dest_of[r]
+    int *tau;                  // [rows_alloc * n]
+    int *row_of;               // [n] row of each destination, or COMPRESSED_ROW_NONE/EVICTED;
+                               // in the block
+    // dirty: one bitset of n bits per row, bit k set when vt[k] may differ from the row.
+    // Updates to vt set the bit in every row; a send visits only the set bits.
+    uint64_t *dirty;           // [rows_alloc * COMPRESSED_DIRTY_WORDS(n)]
+    int *dest_of;              // [rows_alloc] destination owning each row
+    unsigned *last_used;       // [rows_alloc] LRU stamps
+    unsigned *sent_seq;        // [rows_alloc] value-delta frames sent on each row
+    unsigned use_clock;
+    int rows_used;
+    int rows_alloc;
+    int max_rows;              // K, or n when every destination is tracked
+    int evictions;
+    int value_deltas;          // send value-delta frames (fixed at creation)
+    // Value-delta receive state, allocated on the first frame: the vector last rebuilt
+    // from each sender, and the sequence number expected next from it
+    int **recv_rows;           // [n], a row of n ints per sender heard from, else NULL
+    unsigned *recv_seq;        // [n]
 } CompressedClockData;
 
+/* ---------- Delta Message Encodings ---------- */
+
+// A delta message is a sequence of ints led by a header word: (tag << 24) | count.
+// Tag 0 keeps the original [count, (pid, value)...] layout readable as-is.
+// A message of exactly n ints is always the full vector and carries no header.
+typedef enum {
+    COMPRESSED_ENC_PAIRS = 0,   // header(count), then count (pid, value) pairs
+    COMPRESSED_ENC_BITMAP = 1,  // header(count), ceil(n/32) bitmap words, then count values in pid order
+    COMPRESSED_ENC_RUNS = 2,    // header(runs), then per run: start, length, length values
+    COMPRESSED_ENC_VALUE_DELTA = 3  // header(count), then bytes: uvarint sender, uvarint seq,
+                                    // count (uvarint pid gap, zigzag vt[k] - tau[dest][k])
+} CompressedEncoding;
+
+// Sequence 0 restarts a channel: the frame is relative to all zeros (a new or evicted
+// destination row), and frame s + 1 is relative to the state after frame s.
+
+#define COMPRESSED_TAG_SHIFT 24
+#define COMPRESSED_COUNT_MASK ((1 << COMPRESSED_TAG_SHIFT) - 1)
+
 /* ---------- Compressed Vector Clock Operations ---------- */
 
 Timestamp compressed_create(int n, int pid, ClockType type);
+Timestamp compressed_create_in(ClockArena *arena, int n, int pid, ClockType type);
 void compressed_destroy(Timestamp *ts);
 void compressed_increment(Timestamp *ts);
 void compressed_merge(Timestamp *dst, const void *other_data, size_t other_size);
+int compressed_gather(const Timestamp *ts, const void *other_data, size_t other_size, ClockGather *g);
+void compressed_fold(Timestamp *ts, const ClockGather *g, int ticks);
 TSOrder compressed_compare(const Timestamp *a, const Timestamp *b);
 size_t compressed_serialize(const Timestamp *ts, void *buffer, size_t bufsize);
 void compressed_deserialize(Timestamp *ts, const void *buffer, size_t size);
 void compressed_to_string(const Timestamp *ts, char *buf, size_t bufsize);
 Timestamp compressed_clone(const Timestamp *ts);
+Timestamp compressed_clone_in(ClockArena *arena, const Timestamp *ts);
+void compressed_to_vector(const Timestamp *ts, int *out);
 
 /* ---------- Special Functions for Compressed Technique ---------- */
 
+// Row of tau for dest, created (all zeros) if dest has none; may evict another destination.
+// The row may be written: the next send to dest rechecks every entry.
+int* compressed_tau_row(Timestamp *ts, int dest);
+// Bytes held for per-destination state (tau arena, row index, value-delta receive rows)
+size_t compressed_tau_bytes(const Timestamp *ts);
+int compressed_evictions(const Timestamp *ts);
+
 // Destination-aware serialization - core of the compression algorithm
 size_t compressed_serialize_for_dest(const Timestamp *ts, int dest, void *buffer, size_t bufsize);
 
+// Decode any delta message into (pid, value) entries in message order; pids and values
+// must hold n entries. Returns the entry count, or -1 if the message is malformed.
+// Value-delta frames need receive state and also return -1.
+int compressed_decode_entries(int n, const void *buffer, size_t size, int *pids, int *values);
+
+// Nonzero if a serialized message is a value-delta frame
+int compressed_is_value_delta(const void *buffer, size_t size);
+
+// Copies receiver's receive state for sender into ts, so that ts can deserialize the
+// next value-delta frame from sender on receiver's behalf (e.g. to display it)
+void compressed_copy_receive_state(Timestamp *ts, const Timestamp *receiver, int sender);
+
 /* ---------- Operations Table ---------- */
 
-extern TimestampOps COMPRESSED_OPS;
+extern const TimestampOps COMPRESSED_OPS;
 
 #endif // COMPRESSED_CLOCK_H
\ No newline at end of file
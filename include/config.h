@@ -12,6 +12,17 @@
 #define PROB_SEND 40        // 40% probability for send events (35-75)
 #define PROB_RECV 25        // 25% probability for receive events (75-100)
 
+// Membership churn (--churn), rolled before each step of an active process (out of 100)
+#define PROB_FORK 5         // spawn a new process into an unused slot
+#define PROB_RETIRE 4       // leave, handing the clock to a live process
+#define CHURN_CAPACITY_FACTOR 3  // slots (processes ever created) per initial process
+#define CHURN_MIN_ACTIVE 2  // never retire below this many live processes
+
+// Hybrid logical clocks: each process's physical clock is skewed by up to this much
+#define HLC_SIM_SKEW_MS 20
+// Each send is checked against this many recent sends for the ground-truth ordering report
+#define ORDER_SAMPLE_EVENTS 16
+
 // Timing parameters
 #define MIN_SLEEP_MS 5      // Minimum sleep between events
 #define MAX_SLEEP_MS 25     // Maximum sleep between events
@@ -21,10 +32,21 @@
 #define PAYLOAD_SIZE 64
 #define STRING_BUFFER_SIZE 256
 
+// Clock size over time report: messages grouped into this many step ranges
+#define SIZE_BUCKETS 6
+
+// Clock type report (--report): at least this many events per type, from a fixed seed
+#define REPORT_MIN_EVENTS 100000
+#define REPORT_SEED 12345u
+
 /* ---------- Compile-time Validation ---------- */
 
 #if (PROB_INTERNAL + PROB_SEND + PROB_RECV) != 100
 #error "Event probabilities must sum to 100"
 #endif
 
+#if (PROB_FORK + PROB_RETIRE) > 100
+#error "Churn probabilities must not exceed 100"
+#endif
+
 #endif // CONFIG_H
\ No newline at end of file
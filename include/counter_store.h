@@ -0,0 +1,50 @@
+#ifndef COUNTER_STORE_H
+#define COUNTER_STORE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "timestamp.h"
+
+/* ---------- Adaptive-Width Counters ---------- */
+
+// A counter vector is stored at the narrowest width (bytes per entry) that fits its
+// largest value, and promoted when a value grows past it. Logical values are 64-bit.
+// 32-bit cells stop at INT32_MAX, so they can go through the dispatched int kernels.
+#define COUNTER_WIDTH_MIN 1
+#define COUNTER_WIDTH_MAX 8
+
+// Narrowest width (1, 2, 4 or 8) that holds value; 4 holds up to INT32_MAX
+int counter_width_for(uint64_t value);
+
+uint64_t counter_get(const void *cells, int width, int i);
+void counter_set(void *cells, int width, int i, uint64_t value);  // value must fit width
+uint64_t counter_max(const void *cells, int width, int n);
+
+// Copies n counters between widths; narrowing requires every value to fit dst_width.
+// dst and src must not overlap.
+void counter_copy(void *dst, int dst_width, const void *src, int src_width, int n);
+
+/* ---------- Kernels (one loop per width) ---------- */
+
+// dst[i] = max(dst[i], src[i]) from the raw wire layouts; dst_width must already fit the
+// largest source value. Negative int32 entries count as 0. Every entry that grows is
+// raised in digest.
+void counter_merge_i32(void *dst, int dst_width, const int32_t *src, int n, ClockDigest *digest);
+void counter_merge_u64(void *dst, int dst_width, const uint64_t *src, int n, ClockDigest *digest);
+
+// Dominance as in vk_compare. Equal widths run the width's own loop (vk_compare for 32-bit
+// cells, as vk_merge_max backs counter_merge_i32 there); mixed widths widen entry by entry.
+TSOrder counter_compare(const void *a, int a_width, const void *b, int b_width, int n);
+
+/* ---------- Fixed-n Kernels ---------- */
+
+// counter_max_4, counter_copy_4, ... counter_compare_64: the kernels above for exactly N
+// counters, one set per N in FOR_EACH_FIXED_N
+#define DECLARE_FIXED_N_KERNELS(N) \
+    uint64_t counter_max_##N(const void *cells, int width); \
+    void counter_copy_##N(void *dst, int dst_width, const void *src, int src_width); \
+    void counter_merge_i32_##N(void *dst, int dst_width, const int32_t *src, ClockDigest *digest); \
+    TSOrder counter_compare_##N(const void *a, int a_width, const void *b, int b_width);
+FOR_EACH_FIXED_N(DECLARE_FIXED_N_KERNELS)
+
+#endif // COUNTER_STORE_H
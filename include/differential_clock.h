@@ -6,32 +6,49 @@
 /* ---------- Differential Vector Clock Data Structure ---------- */
 
 // Differential clock data (Singhal-Kshemkalyani technique)
+// The header and all five arrays share one block (see clock_arena.h)
 typedef struct {
     int *v;                    // current vector clock
     int *LS;                   // Last Sent: LS[j] = v[pid] when last sent to process j
     int *LU;                   // Last Update: LU[k] = v[pid] when entry k was last updated
+    // Update order: entries linked from oldest to newest update. LU only ever takes
+    // the current v[pid] (or v[pid] + 1), so the list is also sorted by LU and a send
+    // walks back from the newest entry until LU[k] <= LS[dest].
+    int *prev;                 // prev[k]: entry updated before k, -1 for the oldest
+    int *next;                 // next[k]: entry updated after k, -1 for the newest
+    int oldest;
+    int newest;
 } DifferentialClockData;
 
 /* ---------- Differential Vector Clock Operations ---------- */
 
 Timestamp differential_create(int n, int pid, ClockType type);
+Timestamp differential_create_in(ClockArena *arena, int n, int pid, ClockType type);
 void differential_destroy(Timestamp *ts);
 void differential_increment(Timestamp *ts);
 void differential_merge(Timestamp *dst, const void *other_data, size_t other_size);
+int differential_gather(const Timestamp *ts, const void *other_data, size_t other_size, ClockGather *g);
+void differential_fold(Timestamp *ts, const ClockGather *g, int ticks);
 TSOrder differential_compare(const Timestamp *a, const Timestamp *b);
 size_t differential_serialize(const Timestamp *ts, void *buffer, size_t bufsize);
 void differential_deserialize(Timestamp *ts, const void *buffer, size_t size);
 void differential_to_string(const Timestamp *ts, char *buf, size_t bufsize);
 Timestamp differential_clone(const Timestamp *ts);
+Timestamp differential_clone_in(ClockArena *arena, const Timestamp *ts);
+void differential_to_vector(const Timestamp *ts, int *out);
+
+// Ops table with merge/compare/serialize compiled for n (see FOR_EACH_FIXED_N), or NULL
+const TimestampOps *differential_specialize(int n);
 
 /* ---------- Special Functions for Differential Technique ---------- */
 
 // For differential technique, we need a special serialize function that
-// takes destination into account
+// takes destination into account. Sends (pid, value) int pairs while they are fewer than
+// n/2, else the full vector: a message of exactly n ints is always the full vector.
 size_t differential_serialize_for_dest(const Timestamp *ts, int dest, void *buffer, size_t bufsize);
 
 /* ---------- Operations Table ---------- */
 
-extern TimestampOps DIFFERENTIAL_OPS;
+extern const TimestampOps DIFFERENTIAL_OPS;
 
 #endif // DIFFERENTIAL_CLOCK_H
\ No newline at end of file
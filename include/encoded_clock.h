@@ -1,20 +1,80 @@
 #ifndef ENCODED_CLOCK_H
 #define ENCODED_CLOCK_H
 
+#include <stdint.h>
 #include "timestamp.h"
 
 /* ---------- Prime Numbers for Encoded Clocks ---------- */
 
-extern int PRIMES[];
-extern const int MAX_PRIMES;
+// Returns a table of at least `count` primes (primes[i] belongs to process i), sieved on
+// first use and grown on demand. Tables are never freed, so returned pointers stay valid.
+const uint32_t* encoded_primes(int count);
+
+/* ---------- Vector Switch Threshold ---------- */
+
+// An encoded clock switches to the plain vector form once its serialized encoding would
+// exceed this many bytes. 0 (the default) means the vector size, n * sizeof(int).
+void encoded_set_vector_threshold(size_t bytes);
+size_t encoded_vector_threshold(int n);
+
+/* ---------- Compare/Merge Path ---------- */
+
+// Compare and merge stay in the encoded domain (divisibility and LCM via GCD). Forcing the
+// decode path factors both operands on every call instead; meant for benchmarks and tests.
+void encoded_force_decode(int enabled);
+
+/* ---------- Log-Domain Magnitude ---------- */
+
+// Every clock also carries log2 of its product in fixed point, with an error bound in the
+// same units. Compare orders the two magnitudes first and runs only the one divisibility
+// test that can succeed; magnitudes within the combined bound fall back to the exact
+// comparison. The log survives the switch to vector form, where it is a sum of
+// exponent * log2(prime). A Q32.32 value covers products of up to 2^32 bits.
+#define ENCODED_LOG_FRAC_BITS 32
+
+// log2 of the product, rounded down; *err (if non-NULL) receives the bound in the same units
+uint64_t encoded_log2(const Timestamp *ts, uint64_t *err);
+
+// Lower bound on further increments, at any process, before the product no longer
+// serializes in `bytes` (8 is the single 64-bit word), predicted from the log alone
+long long encoded_events_left(const Timestamp *ts, size_t bytes);
+
+/* ---------- Wire Layout ---------- */
+
+// Serialized forms, told apart by size and the first word:
+//   8 bytes                    - unsigned long long product (fits in two limbs)
+//   [ENCODED_BIG_TAG | limbs]  - header word followed by that many little-endian 32-bit limbs
+//   encoded_vector_size(n)     - vector form after the switch
+// The tag has the sign bit set, so it never matches the first counter of a vector.
+#define ENCODED_BIG_TAG 0xB1000000u
+#define ENCODED_LIMB_MASK 0x00FFFFFFu
+
+// The vector form is n ints, followed by one zero word at n = 2, where 8 bytes would
+// read as a product
+static inline size_t encoded_vector_size(int n) {
+    return (size_t)(n == 2 ? 3 : n) * sizeof(int);
+}
 
 /* ---------- Encoded Vector Clock Data Structure ---------- */
 
+// Arbitrary-precision unsigned integer, base 2^32
+typedef struct {
+    uint32_t *limbs;           // little-endian digits
+    int len;                   // limbs in use, always >= 1
+    int cap;                   // limbs allocated
+} EncodedBignum;
+
 // Encoded clock data
 typedef struct {
-    unsigned long long value;  // encoded timestamp
-    int overflow;              // overflow flag
-    int *fallback_v;           // fallback vector on overflow
+    EncodedBignum value;       // encoded timestamp: product of primes[i]^v[i]
+    int overflow;              // set once switched to the vector form
+    int *fallback_v;           // exponent vector: authoritative after the switch, otherwise
+                               // a lazily refreshed shadow of value
+    int shadow_valid;          // fallback_v matches value (always set after the switch)
+    const uint32_t *primes;    // prime table covering all n processes
+    const uint64_t *prime_logs;  // log2(primes[i]) in fixed point, rounded down
+    uint64_t log2_fx;          // log2 of the product (see ENCODED_LOG_FRAC_BITS)
+    uint64_t log_err;          // |log2_fx - true log2| is at most this many units
 } EncodedClockData;
 
 /* ---------- Encoded Vector Clock Operations ---------- */
@@ -28,9 +88,10 @@ size_t encoded_serialize(const Timestamp *ts, void *buffer, size_t bufsize);
 void encoded_deserialize(Timestamp *ts, const void *buffer, size_t size);
 void encoded_to_string(const Timestamp *ts, char *buf, size_t bufsize);
 Timestamp encoded_clone(const Timestamp *ts);
+void encoded_to_vector(const Timestamp *ts, int *out);
 
 /* ---------- Operations Table ---------- */
 
-extern TimestampOps ENCODED_OPS;
+extern const TimestampOps ENCODED_OPS;
 
-#endif // ENCODED_CLOCK_H
\ No newline at end of file
+#endif // ENCODED_CLOCK_H
@@ -0,0 +1,63 @@
+#ifndef HLC_CLOCK_H
+#define HLC_CLOCK_H
+
+#include <stdint.h>
+#include "timestamp.h"
+
+/* ---------- Hybrid Logical Clock Layout ---------- */
+
+// Hybrid Logical Clocks (Kulkarni et al. 2014): 48 bits of physical time in milliseconds
+// and a 16-bit logical counter packed into one uint64_t, so packed values order the same
+// way as (physical, logical) pairs. Timestamps never grow with the number of processes.
+#define HLC_LOGICAL_BITS 16
+#define HLC_LOGICAL_MASK ((1ULL << HLC_LOGICAL_BITS) - 1)
+#define HLC_PHYSICAL_MASK ((1ULL << (64 - HLC_LOGICAL_BITS)) - 1)
+
+#define HLC_PACK(pt, l) ((((uint64_t)(pt) & HLC_PHYSICAL_MASK) << HLC_LOGICAL_BITS) | ((uint64_t)(l) & HLC_LOGICAL_MASK))
+#define HLC_PHYSICAL(hlc) ((uint64_t)(hlc) >> HLC_LOGICAL_BITS)
+#define HLC_LOGICAL(hlc) ((uint64_t)(hlc) & HLC_LOGICAL_MASK)
+
+// Remote timestamps more than this far ahead of the local physical clock are rejected
+#define HLC_DEFAULT_MAX_DRIFT_MS 1000
+
+/* ---------- Hybrid Logical Clock Data Structure ---------- */
+
+typedef struct {
+    uint64_t hlc;               // packed (physical, logical)
+    int64_t offset_ms;          // added to the physical clock, to simulate skew
+    int drift_rejections;       // remote timestamps refused by the drift check
+} HlcClockData;
+
+/* ---------- Physical Clock and Drift Bound ---------- */
+
+// Milliseconds since the epoch; NULL restores CLOCK_REALTIME. Meant for tests.
+void hlc_set_physical_clock(uint64_t (*now_ms)(void));
+void hlc_set_max_drift(uint64_t ms);
+uint64_t hlc_max_drift(void);
+void hlc_set_offset(Timestamp *ts, int64_t offset_ms);
+int hlc_drift_rejections(const Timestamp *ts);
+
+/* ---------- Hybrid Logical Clock Operations ---------- */
+
+Timestamp hlc_create(int n, int pid, ClockType type);
+Timestamp hlc_create_in(ClockArena *arena, int n, int pid, ClockType type);
+void hlc_destroy(Timestamp *ts);
+void hlc_send(Timestamp *ts);                          // local or send event
+int hlc_recv(Timestamp *ts, uint64_t remote);          // 0 if rejected by the drift check
+void hlc_increment(Timestamp *ts);                     // hlc_send
+void hlc_merge(Timestamp *dst, const void *other_data, size_t other_size);  // hlc_recv
+// HLC order is consistent with happened-before but cannot detect concurrency: distinct
+// values are reported as ordered, and only equal values from different processes (which
+// happened-before can never produce) come back as TS_CONCURRENT.
+TSOrder hlc_compare(const Timestamp *a, const Timestamp *b);
+size_t hlc_serialize(const Timestamp *ts, void *buffer, size_t bufsize);
+void hlc_deserialize(Timestamp *ts, const void *buffer, size_t size);
+void hlc_to_string(const Timestamp *ts, char *buf, size_t bufsize);
+Timestamp hlc_clone(const Timestamp *ts);
+Timestamp hlc_clone_in(ClockArena *arena, const Timestamp *ts);
+
+/* ---------- Operations Table ---------- */
+
+extern const TimestampOps HLC_OPS;
+
+#endif // HLC_CLOCK_H
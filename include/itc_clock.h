@@ -0,0 +1,62 @@
+#ifndef ITC_CLOCK_H
+#define ITC_CLOCK_H
+
+#include "timestamp.h"
+
+/* ---------- Interval Tree Clock Data Structure ---------- */
+
+// Interval Tree Clocks (Almeida, Baquero, Fonte 2008). A stamp is an (id, event) pair:
+// the id tree marks which part of [0, 1) this process owns and the event tree maps each
+// part of [0, 1) to a counter. Neither depends on how many processes have ever existed.
+
+// Id tree: a leaf owns nothing (0) or all (1) of its interval; a node splits it in half
+typedef struct ItcId {
+    int value;                  // 0 or 1 for leaves
+    struct ItcId *l, *r;        // both NULL for leaves
+} ItcId;
+
+// Event tree: a leaf is a flat counter; a node adds its base to both halves
+typedef struct ItcEvent {
+    int n;                      // counter (leaf) or base (node)
+    struct ItcEvent *l, *r;     // both NULL for leaves
+} ItcEvent;
+
+typedef struct {
+    ItcId *id;
+    ItcEvent *event;
+} ItcClockData;
+
+// Recursion bound when decoding untrusted stamps
+#define ITC_MAX_DEPTH 256
+
+/* ---------- Interval Tree Clock Operations ---------- */
+
+// Creates the stamp of slot pid out of n initial slots (an id of width ~1/n). Slots
+// beyond the initial membership come from itc_fork.
+Timestamp itc_create(int n, int pid, ClockType type);
+void itc_destroy(Timestamp *ts);
+void itc_increment(Timestamp *ts);                       // event: inflate the owned part
+void itc_merge(Timestamp *dst, const void *other_data, size_t other_size);  // join
+TSOrder itc_compare(const Timestamp *a, const Timestamp *b);
+size_t itc_serialize(const Timestamp *ts, void *buffer, size_t bufsize);    // full stamp
+size_t itc_serialize_for_dest(const Timestamp *ts, int dest, void *buffer, size_t bufsize);  // peek
+void itc_deserialize(Timestamp *ts, const void *buffer, size_t size);
+void itc_to_string(const Timestamp *ts, char *buf, size_t bufsize);
+Timestamp itc_clone(const Timestamp *ts);
+
+/* ---------- Dynamic Membership ---------- */
+
+// Splits ts's id in two: ts keeps one half, the returned stamp owns the other
+Timestamp itc_fork(Timestamp *ts);
+// Anonymous copy (id 0) carrying only causal history, as sent in messages
+Timestamp itc_peek(const Timestamp *ts);
+// Gives up ts's id; serialize the full stamp first and join it into a live process
+void itc_retire(Timestamp *ts);
+// Nonzero if ts owns part of the id space and can record events
+int itc_has_id(const Timestamp *ts);
+
+/* ---------- Operations Table ---------- */
+
+extern const TimestampOps ITC_OPS;
+
+#endif // ITC_CLOCK_H
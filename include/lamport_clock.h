@@ -0,0 +1,38 @@
+#ifndef LAMPORT_CLOCK_H
+#define LAMPORT_CLOCK_H
+
+#include <stdint.h>
+#include "timestamp.h"
+
+/* ---------- Lamport Clock Data Structure ---------- */
+
+// Lamport clocks: one 64-bit counter, the floor for timestamp overhead. a -> b implies
+// C(a) < C(b) but not the converse, so a smaller counter only rules out "after".
+typedef struct {
+    uint64_t counter;
+} LamportClockData;
+
+/* ---------- Lamport Clock Operations ---------- */
+
+Timestamp lamport_create(int n, int pid, ClockType type);
+Timestamp lamport_create_in(ClockArena *arena, int n, int pid, ClockType type);
+void lamport_destroy(Timestamp *ts);
+void lamport_increment(Timestamp *ts);
+void lamport_merge(Timestamp *dst, const void *other_data, size_t other_size);
+void lamport_merge_and_tick(Timestamp *dst, const void *other_data, size_t other_size);
+// Counters order events consistently with happened-before. Equal counters from different
+// processes cannot be causally related and are the only TS_CONCURRENT answer.
+TSOrder lamport_compare(const Timestamp *a, const Timestamp *b);
+// Total order: counters, then pids to break ties. TS_EQUAL only for a clock and its copy.
+TSOrder lamport_total_order(const Timestamp *a, const Timestamp *b);
+size_t lamport_serialize(const Timestamp *ts, void *buffer, size_t bufsize);
+void lamport_deserialize(Timestamp *ts, const void *buffer, size_t size);
+void lamport_to_string(const Timestamp *ts, char *buf, size_t bufsize);
+Timestamp lamport_clone(const Timestamp *ts);
+Timestamp lamport_clone_in(ClockArena *arena, const Timestamp *ts);
+
+/* ---------- Operations Table ---------- */
+
+extern const TimestampOps LAMPORT_OPS;
+
+#endif // LAMPORT_CLOCK_H
@@ -0,0 +1,758 @@
+#ifndef LOGICTIME_HPP
+#define LOGICTIME_HPP
+
+// C++17 header-only layer over the clock representations: logictime::Clock<Rep, N> is a
+// value type (copyable, cheaply movable) with no void* data and no function pointers. The
+// representation is a template argument, so every call is resolved at compile time, and a
+// process count N fixed at compile time keeps the counters inline and unrolls the kernels
+// for small N. Serialized forms are the C clocks' raw wire layouts (WIRE_RAW), so a Clock
+// and a C Timestamp of the matching ClockType can exchange messages.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace logictime {
+
+/* ---------- Configuration ---------- */
+
+// N = dynamic_n: the process count is a constructor argument
+inline constexpr int dynamic_n = 0;
+
+// Fixed N up to this many processes gets fully unrolled kernels
+inline constexpr int unroll_limit = 16;
+
+// Same values as TSOrder
+enum class Order : int {
+    before = 0,
+    after = 1,
+    concurrent = 2,
+    equal = 3
+};
+
+/* ---------- Representations ---------- */
+
+// clock_type is the matching ClockType, whose raw layout the representation reads and writes
+struct Dense { static constexpr int clock_type = 0; };         // n ints
+struct Sparse { static constexpr int clock_type = 1; };        // sorted (pid, counter) pairs
+struct Differential { static constexpr int clock_type = 2; };  // Singhal-Kshemkalyani pairs
+struct Encoded { static constexpr int clock_type = 3; };       // product of primes
+struct Compressed { static constexpr int clock_type = 4; };    // per-destination deltas
+
+namespace detail {
+
+/* ---------- Wire Words ---------- */
+
+// Buffers carry no alignment guarantee; fixed-size memcpy compiles to a plain load/store
+inline int32_t load_i32(const void *buffer, std::size_t i) {
+    int32_t v;
+    std::memcpy(&v, static_cast<const unsigned char*>(buffer) + i * sizeof(v), sizeof(v));
+    return v;
+}
+
+inline void store_i32(void *buffer, std::size_t i, int32_t v) {
+    std::memcpy(static_cast<unsigned char*>(buffer) + i * sizeof(v), &v, sizeof(v));
+}
+
+// Header words of the C formats (compressed_clock.h, encoded_clock.h)
+inline constexpr int compressed_tag_shift = 24;
+inline constexpr uint32_t compressed_count_mask = (1u << compressed_tag_shift) - 1;
+inline constexpr uint32_t compressed_enc_pairs = 0;
+inline constexpr uint32_t compressed_enc_bitmap = 1;
+inline constexpr uint32_t compressed_enc_runs = 2;
+inline constexpr uint32_t encoded_big_tag = 0xB1000000u;
+inline constexpr uint32_t encoded_limb_mask = 0x00FFFFFFu;
+
+// encoded_vector_size: n ints, plus a zero pad word at n = 2 so it never reads as a product
+inline std::size_t encoded_vector_size(int n) {
+    return (std::size_t)(n == 2 ? 3 : n) * sizeof(int32_t);
+}
+
+/* ---------- Counter Storage ---------- */
+
+// Fixed N: counters inline in the clock. Dynamic: one heap array, moved by pointer.
+template <int N>
+struct Counters {
+    std::array<int, N> v{};
+    explicit Counters(int) {}
+    int *data() { return v.data(); }
+    const int *data() const { return v.data(); }
+    int &operator[](int i) { return v[i]; }
+    int operator[](int i) const { return v[i]; }
+};
+
+template <>
+struct Counters<dynamic_n> {
+    std::vector<int> v;
+    explicit Counters(int n) : v(n, 0) {}
+    int *data() { return v.data(); }
+    const int *data() const { return v.data(); }
+    int &operator[](int i) { return v[i]; }
+    int operator[](int i) const { return v[i]; }
+};
+
+/* ---------- Kernels ---------- */
+
+template <class F, int... I>
+inline void unrolled(std::integer_sequence<int, I...>, F &f) {
+    (f(I), ...);
+}
+
+// f(0) .. f(n - 1): expanded in place for a small fixed N, a loop otherwise
+template <int N, class F>
+inline void for_each_index(int n, F &&f) {
+    if constexpr (N != dynamic_n && N <= unroll_limit) {
+        (void)n;
+        unrolled(std::make_integer_sequence<int, N>{}, f);
+    } else {
+        for (int i = 0; i < n; i++) f(i);
+    }
+}
+
+inline Order order_of(bool less, bool greater) {
+    if (less && greater) return Order::concurrent;
+    if (less) return Order::before;
+    if (greater) return Order::after;
+    return Order::equal;
+}
+
+template <int N>
+inline Order compare_counters(const int *a, const int *b, int n) {
+    bool less = false, greater = false;
+    for_each_index<N>(n, [&](int i) {
+        less |= a[i] < b[i];
+        greater |= a[i] > b[i];
+    });
+    return order_of(less, greater);
+}
+
+// Max-merges n ints from a wire buffer, calling on_grow(i) for each entry that grew
+template <int N, class OnGrow>
+inline void merge_wire_counters(int *v, const void *buffer, int n, OnGrow &&on_grow) {
+    for_each_index<N>(n, [&](int i) {
+        int x = load_i32(buffer, i);
+        if (x > v[i]) {
+            v[i] = x;
+            on_grow(i);
+        }
+    });
+}
+
+/* ---------- Prime Tables ---------- */
+
+constexpr bool is_prime(uint32_t p) {
+    if (p < 2) return false;
+    for (uint32_t d = 2; d * d <= p; d++) {
+        if (p % d == 0) return false;
+    }
+    return true;
+}
+
+// primes[i] belongs to process i, as in encoded_primes()
+template <int N>
+constexpr std::array<uint32_t, N> prime_table() {
+    std::array<uint32_t, N> primes{};
+    uint32_t candidate = 2;
+    for (int i = 0; i < N; i++) {
+        while (!is_prime(candidate)) candidate++;
+        primes[i] = candidate++;
+    }
+    return primes;
+}
+
+template <int N>
+inline constexpr std::array<uint32_t, N> fixed_primes = prime_table<N>();
+
+// Runtime-sized tables, shared and never freed, so pointers stay valid (like encoded_primes)
+inline const uint32_t *runtime_primes(int count) {
+    static std::mutex mtx;
+    static std::vector<std::unique_ptr<std::vector<uint32_t>>> tables;
+    std::lock_guard<std::mutex> lock(mtx);
+    if (tables.empty() || (int)tables.back()->size() < count) {
+        int size = tables.empty() ? 64 : (int)tables.back()->size();
+        while (size < count) size *= 2;
+        auto table = std::make_unique<std::vector<uint32_t>>();
+        table->reserve(size);
+        for (uint32_t candidate = 2; (int)table->size() < size; candidate++) {
+            if (is_prime(candidate)) table->push_back(candidate);
+        }
+        tables.push_back(std::move(table));
+    }
+    return tables.back()->data();
+}
+
+/* ---------- Small Bignums (Encoded) ---------- */
+
+// Little-endian base 2^32, as the C encoded clock's limbs
+inline void big_mul_small(std::vector<uint32_t> &b, uint32_t m) {
+    uint64_t carry = 0;
+    for (uint32_t &limb : b) {
+        uint64_t x = (uint64_t)limb * m + carry;
+        limb = (uint32_t)x;
+        carry = x >> 32;
+    }
+    if (carry) b.push_back((uint32_t)carry);
+}
+
+// b /= d if d divides b exactly; returns whether it did
+inline bool big_div_exact(std::vector<uint32_t> &b, uint32_t d) {
+    uint64_t rem = 0;
+    for (std::size_t i = b.size(); i-- > 0;) {
+        rem = ((rem << 32) | b[i]) % d;
+    }
+    if (rem) return false;
+    for (std::size_t i = b.size(); i-- > 0;) {
+        uint64_t x = (rem << 32) | b[i];
+        b[i] = (uint32_t)(x / d);
+        rem = x % d;
+    }
+    while (b.size() > 1 && b.back() == 0) b.pop_back();
+    return true;
+}
+
+/* ---------- Representation State ---------- */
+
+template <class Rep, int N>
+struct State;
+
+// Standard vector clocks (CLOCK_STANDARD): n ints on the wire. The C clock switches to
+// n uint64_t once a counter passes INT32_MAX; those are read while they still fit an int.
+template <int N>
+struct State<Dense, N> {
+    Counters<N> v;
+
+    explicit State(int n) : v(n) {}
+
+    void tick(int pid) { v[pid]++; }
+    int get(int k) const { return v[k]; }
+
+    bool merge(const void *buffer, std::size_t size, int n, int) {
+        if (size == (std::size_t)n * sizeof(int32_t)) {
+            merge_wire_counters<N>(v.data(), buffer, n, [](int) {});
+            return true;
+        }
+        if (size == (std::size_t)n * sizeof(uint64_t)) {
+            const auto *bytes = static_cast<const unsigned char*>(buffer);
+            for (int i = 0; i < n; i++) {
+                uint64_t x;
+                std::memcpy(&x, bytes + i * sizeof(x), sizeof(x));
+                if (x > (uint64_t)INT32_MAX) return false;
+            }
+            for (int i = 0; i < n; i++) {
+                uint64_t x;
+                std::memcpy(&x, bytes + i * sizeof(x), sizeof(x));
+                if ((int)x > v[i]) v[i] = (int)x;
+            }
+            return true;
+        }
+        return false;
+    }
+
+    Order compare(const State &other, int n) const {
+        return compare_counters<N>(v.data(), other.v.data(), n);
+    }
+
+    std::size_t serialize(void *buffer, std::size_t bufsize, int n) const {
+        std::size_t required = (std::size_t)n * sizeof(int32_t);
+        if (bufsize >= required) std::memcpy(buffer, v.data(), required);
+        return required;
+    }
+
+    std::size_t serialize_for(int, void *buffer, std::size_t bufsize, int n, int) {
+        return serialize(buffer, bufsize, n);
+    }
+};
+
+// Sparse clocks (CLOCK_SPARSE): only the non-zero counters, sorted by pid
+template <int N>
+struct State<Sparse, N> {
+    struct Entry {
+        int32_t pid;
+        int32_t counter;
+    };
+    std::vector<Entry> entries;
+
+    explicit State(int) {}
+
+    std::size_t find(int k) const {
+        std::size_t lo = 0, hi = entries.size();
+        while (lo < hi) {
+            std::size_t mid = (lo + hi) / 2;
+            if (entries[mid].pid < k) lo = mid + 1; else hi = mid;
+        }
+        return lo;
+    }
+
+    void tick(int pid) {
+        std::size_t i = find(pid);
+        if (i < entries.size() && entries[i].pid == pid) {
+            entries[i].counter++;
+        } else {
+            entries.insert(entries.begin() + i, Entry{pid, 1});
+        }
+    }
+
+    int get(int k) const {
+        std::size_t i = find(k);
+        return i < entries.size() && entries[i].pid == k ? entries[i].counter : 0;
+    }
+
+    bool merge(const void *buffer, std::size_t size, int n, int) {
+        if (size % sizeof(Entry)) return false;
+        std::vector<Entry> other(size / sizeof(Entry));
+        if (!other.empty()) std::memcpy(other.data(), buffer, size);
+        for (std::size_t j = 0; j < other.size(); j++) {
+            if (other[j].pid < 0 || other[j].pid >= n) return false;
+            if (j > 0 && other[j].pid <= other[j - 1].pid) return false;
+        }
+
+        std::vector<Entry> out;
+        out.reserve(entries.size() + other.size());
+        std::size_t i = 0, j = 0;
+        while (i < entries.size() || j < other.size()) {
+            if (j == other.size() || (i < entries.size() && entries[i].pid < other[j].pid)) {
+                out.push_back(entries[i++]);
+            } else if (i == entries.size() || other[j].pid < entries[i].pid) {
+                if (other[j].counter > 0) out.push_back(other[j]);
+                j++;
+            } else {
+                Entry e = entries[i++];
+                if (other[j].counter > e.counter) e.counter = other[j].counter;
+                out.push_back(e);
+                j++;
+            }
+        }
+        entries = std::move(out);
+        return true;
+    }
+
+    Order compare(const State &other, int) const {
+        bool less = false, greater = false;
+        std::size_t i = 0, j = 0;
+        const auto &a = entries, &b = other.entries;
+        // Merge-join over both sorted lists; a missing pid counts as zero
+        while (i < a.size() || j < b.size()) {
+            if (j == b.size() || (i < a.size() && a[i].pid < b[j].pid)) {
+                greater |= a[i++].counter > 0;
+            } else if (i == a.size() || b[j].pid < a[i].pid) {
+                less |= b[j++].counter > 0;
+            } else {
+                less |= a[i].counter < b[j].counter;
+                greater |= a[i].counter > b[j].counter;
+                i++;
+                j++;
+            }
+        }
+        return order_of(less, greater);
+    }
+
+    std::size_t serialize(void *buffer, std::size_t bufsize, int) const {
+        std::size_t required = entries.size() * sizeof(Entry);
+        if (bufsize >= required && required) std::memcpy(buffer, entries.data(), required);
+        return required;
+    }
+
+    std::size_t serialize_for(int, void *buffer, std::size_t bufsize, int n, int) {
+        return serialize(buffer, bufsize, n);
+    }
+};
+
+// Singhal-Kshemkalyani (CLOCK_DIFFERENTIAL): a send to dest carries the (pid, value) pairs
+// updated since the last send to dest, ascending by pid; plain serialization is n ints
+template <int N>
+struct State<Differential, N> {
+    Counters<N> v;
+    Counters<N> ls;  // ls[j] = v[pid] when last sent to j
+    Counters<N> lu;  // lu[k] = v[pid] when entry k was last updated
+
+    explicit State(int n) : v(n), ls(n), lu(n) {}
+
+    void tick(int pid) {
+        v[pid]++;
+        lu[pid] = v[pid];
+    }
+    int get(int k) const { return v[k]; }
+
+    bool merge(const void *buffer, std::size_t size, int n, int pid) {
+        // Grown entries are stamped with the receive event that follows
+        int stamp = v[pid] + 1;
+        if (size == (std::size_t)n * sizeof(int32_t)) {
+            merge_wire_counters<N>(v.data(), buffer, n, [&](int k) { lu[k] = stamp; });
+            return true;
+        }
+        if (size % (2 * sizeof(int32_t))) return false;
+        std::size_t pairs = size / (2 * sizeof(int32_t));
+        for (std::size_t i = 0; i < pairs; i++) {
+            int k = load_i32(buffer, 2 * i);
+            if (k < 0 || k >= n) return false;
+        }
+        for (std::size_t i = 0; i < pairs; i++) {
+            int k = load_i32(buffer, 2 * i), value = load_i32(buffer, 2 * i + 1);
+            if (value > v[k]) {
+                v[k] = value;
+                lu[k] = stamp;
+            }
+        }
+        return true;
+    }
+
+    Order compare(const State &other, int n) const {
+        return compare_counters<N>(v.data(), other.v.data(), n);
+    }
+
+    std::size_t serialize(void *buffer, std::size_t bufsize, int n) const {
+        std::size_t required = (std::size_t)n * sizeof(int32_t);
+        if (bufsize >= required) std::memcpy(buffer, v.data(), required);
+        return required;
+    }
+
+    std::size_t serialize_for(int dest, void *buffer, std::size_t bufsize, int n, int pid) {
+        int last_sent = ls[dest];
+        int count = 0;
+        for_each_index<N>(n, [&](int k) { count += lu[k] > last_sent || k == pid; });
+
+        // n ints would read as the full vector; send that instead, it is no larger
+        if (2 * count >= n) {
+            std::size_t required = serialize(buffer, bufsize, n);
+            if (bufsize >= required) ls[dest] = v[pid];
+            return required;
+        }
+        std::size_t required = (std::size_t)count * 2 * sizeof(int32_t);
+        if (bufsize >= required) {
+            std::size_t w = 0;
+            for (int k = 0; k < n; k++) {
+                if (lu[k] > last_sent || k == pid) {
+                    store_i32(buffer, w++, k);
+                    store_i32(buffer, w++, v[k]);
+                }
+            }
+            ls[dest] = v[pid];
+        }
+        return required;
+    }
+};
+
+// Compressed clocks (CLOCK_COMPRESSED): a send to dest carries the entries that differ from
+// what dest got last, as a tag-0 (pairs) message, or the full vector when that is no larger.
+// Bitmap and run-length messages from C senders are read too; value-delta frames are not.
+template <int N>
+struct State<Compressed, N> {
+    Counters<N> vt;
+    std::vector<std::vector<int>> tau;  // tau[dest]: last vector sent to dest, empty if none
+
+    explicit State(int n) : vt(n), tau(n) {}
+
+    void tick(int pid) { vt[pid]++; }
+    int get(int k) const { return vt[k]; }
+
+    void raise(int k, int value) {
+        if (value > vt[k]) vt[k] = value;
+    }
+
+    bool merge(const void *buffer, std::size_t size, int n, int) {
+        if (size == (std::size_t)n * sizeof(int32_t)) {
+            merge_wire_counters<N>(vt.data(), buffer, n, [](int) {});
+            return true;
+        }
+        std::size_t words = size / sizeof(int32_t);
+        if (words < 1 || size % sizeof(int32_t)) return false;
+        uint32_t header = (uint32_t)load_i32(buffer, 0);
+        uint32_t tag = header >> compressed_tag_shift;
+        int count = (int)(header & compressed_count_mask);
+
+        // Validate the whole message before applying any of it
+        if (tag == compressed_enc_pairs) {
+            if (count > n || words < 1 + 2 * (std::size_t)count) return false;
+            for (int i = 0; i < count; i++) {
+                int k = load_i32(buffer, 1 + 2 * i);
+                if (k < 0 || k >= n) return false;
+            }
+            for (int i = 0; i < count; i++) {
+                raise(load_i32(buffer, 1 + 2 * i), load_i32(buffer, 2 + 2 * i));
+            }
+            return true;
+        }
+        if (tag == compressed_enc_bitmap) {
+            std::size_t bitmap_words = ((std::size_t)n + 31) / 32;
+            if (count > n || words < 1 + bitmap_words + count) return false;
+            int bits = 0;
+            for (std::size_t w = 0; w < bitmap_words; w++) {
+                uint32_t word = (uint32_t)load_i32(buffer, 1 + w);
+                for (; word; word &= word - 1) bits++;
+            }
+            uint32_t last = (uint32_t)load_i32(buffer, bitmap_words);
+            if (bits != count || (n % 32 && (last >> (n % 32)))) return false;
+            int emitted = 0;
+            for (std::size_t w = 0; w < bitmap_words; w++) {
+                uint32_t word = (uint32_t)load_i32(buffer, 1 + w);
+                for (int b = 0; b < 32; b++) {
+                    if (word >> b & 1) {
+                        raise((int)(w * 32) + b, load_i32(buffer, 1 + bitmap_words + emitted++));
+                    }
+                }
+            }
+            return true;
+        }
+        if (tag == compressed_enc_runs) {
+            std::size_t pos = 1;
+            int emitted = 0;
+            for (int r = 0; r < count; r++) {
+                if (pos + 2 > words) return false;
+                int start = load_i32(buffer, pos), length = load_i32(buffer, pos + 1);
+                if (start < 0 || length < 1 || length > n - start || emitted + length > n) return false;
+                emitted += length;
+                pos += 2 + length;
+            }
+            if (pos > words) return false;
+            pos = 1;
+            for (int r = 0; r < count; r++) {
+                int start = load_i32(buffer, pos), length = load_i32(buffer, pos + 1);
+                for (int i = 0; i < length; i++) raise(start + i, load_i32(buffer, pos + 2 + i));
+                pos += 2 + length;
+            }
+            return true;
+        }
+        return false;
+    }
+
+    Order compare(const State &other, int n) const {
+        return compare_counters<N>(vt.data(), other.vt.data(), n);
+    }
+
+    std::size_t serialize(void *buffer, std::size_t bufsize, int n) const {
+        std::size_t required = (std::size_t)n * sizeof(int32_t);
+        if (bufsize >= required) std::memcpy(buffer, vt.data(), required);
+        return required;
+    }
+
+    std::size_t serialize_for(int dest, void *buffer, std::size_t bufsize, int n, int) {
+        std::vector<int> &row = tau[dest];
+        if (row.empty()) row.assign(n, 0);
+        int count = 0;
+        for_each_index<N>(n, [&](int k) { count += vt[k] != row[k]; });
+
+        std::size_t full = (std::size_t)n * sizeof(int32_t);
+        std::size_t required = (1 + 2 * (std::size_t)count) * sizeof(int32_t);
+        if (required >= full) {
+            if (bufsize >= full) {
+                std::memcpy(buffer, vt.data(), full);
+                std::memcpy(row.data(), vt.data(), full);
+            }
+            return full;
+        }
+        if (bufsize >= required) {
+            store_i32(buffer, 0, (int32_t)((compressed_enc_pairs << compressed_tag_shift) | (uint32_t)count));
+            std::size_t w = 1;
+            for (int k = 0; k < n; k++) {
+                if (vt[k] != row[k]) {
+                    store_i32(buffer, w++, k);
+                    store_i32(buffer, w++, vt[k]);
+                    row[k] = vt[k];
+                }
+            }
+        }
+        return required;
+    }
+};
+
+// Encoded clocks (CLOCK_ENCODED): the product of primes[i]^v[i], as one 64-bit word or as
+// tagged 32-bit limbs, and the vector form (encoded_vector_size) once the product would
+// take more than n ints.
+// The exponents are kept and the product is built when serializing.
+template <int N>
+struct State<Encoded, N> {
+    Counters<N> v;
+    const uint32_t *primes;
+
+    explicit State(int n) : v(n) {
+        if constexpr (N != dynamic_n) {
+            (void)n;
+            primes = fixed_primes<N>.data();
+        } else {
+            primes = runtime_primes(n);
+        }
+    }
+
+    void tick(int pid) { v[pid]++; }
+    int get(int k) const { return v[k]; }
+
+    // Factors a product over the first n primes; fails on zero and on foreign factors
+    bool factor(std::vector<uint32_t> limbs, int n, Counters<N> &out) const {
+        while (limbs.size() > 1 && limbs.back() == 0) limbs.pop_back();
+        if (limbs.size() == 1 && limbs[0] == 0) return false;
+        for (int i = 0; i < n; i++) {
+            while (big_div_exact(limbs, primes[i])) out[i]++;
+        }
+        return limbs.size() == 1 && limbs[0] == 1;
+    }
+
+    bool merge(const void *buffer, std::size_t size, int n, int) {
+        Counters<N> other(n);
+        if (size == sizeof(uint64_t)) {
+            // 8 bytes are always a product; the vector form at n == 2 is padded
+            uint64_t product;
+            std::memcpy(&product, buffer, sizeof(product));
+            if (!factor({(uint32_t)product, (uint32_t)(product >> 32)}, n, other)) return false;
+        } else if (size >= sizeof(uint32_t) &&
+                   ((uint32_t)load_i32(buffer, 0) & ~encoded_limb_mask) == encoded_big_tag) {
+            std::size_t len = (uint32_t)load_i32(buffer, 0) & encoded_limb_mask;
+            if (size != (1 + len) * sizeof(uint32_t) || len == 0) return false;
+            std::vector<uint32_t> limbs(len);
+            std::memcpy(limbs.data(), static_cast<const unsigned char*>(buffer) + sizeof(uint32_t),
+                        len * sizeof(uint32_t));
+            if (!factor(std::move(limbs), n, other)) return false;
+        } else if (size == encoded_vector_size(n)) {
+            merge_wire_counters<N>(v.data(), buffer, n, [](int) {});
+            return true;
+        } else {
+            return false;
+        }
+        for_each_index<N>(n, [&](int i) {
+            if (other[i] > v[i]) v[i] = other[i];
+        });
+        return true;
+    }
+
+    Order compare(const State &other, int n) const {
+        return compare_counters<N>(v.data(), other.v.data(), n);
+    }
+
+    std::size_t serialize(void *buffer, std::size_t bufsize, int n) const {
+        // Vector form past the C clock's default switch: more than n ints of product
+        std::size_t threshold = (std::size_t)n * sizeof(int32_t);
+        std::vector<uint32_t> limbs{1};
+        bool vector_form = false;
+        for (int i = 0; i < n && !vector_form; i++) {
+            uint64_t acc = 1;
+            for (int j = 0; j < v[i]; j++) {
+                if (acc * primes[i] > UINT32_MAX) {
+                    big_mul_small(limbs, (uint32_t)acc);
+                    acc = 1;
+                }
+                acc *= primes[i];
+            }
+            if (acc > 1) big_mul_small(limbs, (uint32_t)acc);
+            std::size_t size = limbs.size() <= 2 ? sizeof(uint64_t) : (1 + limbs.size()) * sizeof(uint32_t);
+            vector_form = v[i] > 0 && size > threshold;
+        }
+
+        if (vector_form) {
+            std::size_t required = encoded_vector_size(n);
+            if (bufsize >= required) {
+                std::memset(buffer, 0, required);
+                std::memcpy(buffer, v.data(), threshold);
+            }
+            return required;
+        }
+        if (limbs.size() <= 2) {
+            uint64_t product = limbs[0] | (limbs.size() == 2 ? (uint64_t)limbs[1] << 32 : 0);
+            if (bufsize >= sizeof(product)) std::memcpy(buffer, &product, sizeof(product));
+            return sizeof(product);
+        }
+        std::size_t required = (1 + limbs.size()) * sizeof(uint32_t);
+        if (bufsize >= required) {
+            store_i32(buffer, 0, (int32_t)(encoded_big_tag | (uint32_t)limbs.size()));
+            std::memcpy(static_cast<unsigned char*>(buffer) + sizeof(uint32_t), limbs.data(),
+                        limbs.size() * sizeof(uint32_t));
+        }
+        return required;
+    }
+
+    std::size_t serialize_for(int, void *buffer, std::size_t bufsize, int n, int) {
+        return serialize(buffer, bufsize, n);
+    }
+};
+
+}  // namespace detail
+
+/* ---------- Clock ---------- */
+
+template <class Rep, int N = dynamic_n>
+class Clock {
+    static_assert(N >= 0, "N is a process count, or dynamic_n");
+
+public:
+    using rep_type = Rep;
+    static constexpr int fixed_n = N;
+    static constexpr int clock_type = Rep::clock_type;
+
+    // Fixed N
+    template <int M = N, std::enable_if_t<M != dynamic_n, int> = 0>
+    explicit Clock(int pid) : n_(N), pid_(pid), state_(N) {}
+
+    // Dynamic N (or a fixed N restated)
+    Clock(int n, int pid) : n_(n), pid_(pid), state_(n) {
+        if (N != dynamic_n && n != N) throw std::invalid_argument("logictime::Clock: n does not match N");
+    }
+
+    Clock(const Clock &) = default;
+    Clock(Clock &&) noexcept = default;
+    Clock &operator=(const Clock &) = default;
+    Clock &operator=(Clock &&) noexcept = default;
+
+    int n() const { return n_; }
+    int pid() const { return pid_; }
+    int operator[](int k) const { return state_.get(k); }
+
+    void to_vector(int *out) const {
+        for (int k = 0; k < n_; k++) out[k] = state_.get(k);
+    }
+
+    // Local or send event
+    void tick() { state_.tick(pid_); }
+
+    // Max-merge of a serialized clock; malformed input is ignored and returns false
+    bool merge(const void *data, std::size_t size) {
+        return state_.merge(data, size, n_, pid_);
+    }
+
+    // Receive event: merge, then tick (ts_merge_and_tick)
+    bool receive(const void *data, std::size_t size) {
+        bool ok = merge(data, size);
+        tick();
+        return ok;
+    }
+
+    Order compare(const Clock &other) const {
+        if (N == dynamic_n && n_ != other.n_) throw std::invalid_argument("logictime::Clock: mismatched n");
+        return state_.compare(other.state_, n_);
+    }
+
+    // Both return the size needed and write only if bufsize is enough, like ts_serialize.
+    // serialize_for updates the per-destination state only when it writes.
+    std::size_t serialize(void *buffer, std::size_t bufsize) const {
+        return state_.serialize(buffer, bufsize, n_);
+    }
+
+    std::size_t serialize_for(int dest, void *buffer, std::size_t bufsize) {
+        return state_.serialize_for(dest, buffer, bufsize, n_, pid_);
+    }
+
+    std::vector<unsigned char> bytes() const {
+        std::vector<unsigned char> out(serialize(nullptr, 0));
+        serialize(out.data(), out.size());
+        return out;
+    }
+
+    std::vector<unsigned char> bytes_for(int dest) {
+        std::vector<unsigned char> out(state_.serialize_for(dest, nullptr, 0, n_, pid_));
+        out.resize(serialize_for(dest, out.data(), out.size()));
+        return out;
+    }
+
+private:
+    int n_;
+    int pid_;
+    detail::State<Rep, N> state_;
+};
+
+}  // namespace logictime
+
+#endif // LOGICTIME_HPP
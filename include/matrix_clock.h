@@ -0,0 +1,64 @@
+#ifndef MATRIX_CLOCK_H
+#define MATRIX_CLOCK_H
+
+#include <stdint.h>
+#include "timestamp.h"
+
+/* ---------- Matrix Clock Data Structure ---------- */
+
+// Matrix clocks (Wuu-Bernstein): row i of a process's matrix is what it knows process i
+// has seen, and its own row is its vector clock. The minimum of column k over all rows is
+// how many of k's events every process has seen, so a replicated log can drop them.
+//
+// A cell's stamp is the send epoch in which the cell last grew. A send to dest carries only
+// the cells stamped after the previous send to dest: the tau rows of compressed_clock.h,
+// reduced to one epoch per destination instead of a copy of the matrix for each.
+// Channels must be FIFO and lossless, as for the compressed clock's deltas.
+typedef struct {
+    int n;
+    unsigned epoch;            // current send epoch, starts at 1
+    int *m;                    // [n * n] row-major matrix
+    unsigned *stamp;           // [n * n] epoch in which each cell last grew, 0 if never
+    unsigned *row_stamp;       // [n] latest stamp in each row, so unchanged rows are skipped
+    unsigned *sent;            // [n] epoch of the last send to each destination, 0 if none
+} MatrixClockData;             // header and arrays share one block (see clock_arena.h)
+
+/* ---------- Wire Layout ---------- */
+
+// Messages are ints led by a header word (tag | sender):
+//   MATRIX_TAG_FULL   - then the n * n matrix
+//   MATRIX_TAG_DELTA  - then a row count and per row: row, count, and either n values
+//                       (count == n) or count (column, value) pairs
+// The tags have the sign bit set, so they never match a counter: a plain vector of n ints
+// is also accepted and merges into the receiver's own row.
+#define MATRIX_TAG_FULL 0xA1000000u
+#define MATRIX_TAG_DELTA 0xA2000000u
+#define MATRIX_TAG_MASK 0xFF000000u
+#define MATRIX_SENDER_MASK 0x00FFFFFFu
+
+/* ---------- Matrix Clock Operations ---------- */
+
+Timestamp matrix_create(int n, int pid, ClockType type);
+Timestamp matrix_create_in(ClockArena *arena, int n, int pid, ClockType type);
+void matrix_destroy(Timestamp *ts);
+void matrix_increment(Timestamp *ts);
+void matrix_merge(Timestamp *dst, const void *other_data, size_t other_size);
+TSOrder matrix_compare(const Timestamp *a, const Timestamp *b);  // on the own rows
+size_t matrix_serialize(const Timestamp *ts, void *buffer, size_t bufsize);
+size_t matrix_serialize_for_dest(const Timestamp *ts, int dest, void *buffer, size_t bufsize);
+void matrix_deserialize(Timestamp *ts, const void *buffer, size_t size);
+void matrix_to_string(const Timestamp *ts, char *buf, size_t bufsize);
+Timestamp matrix_clone(const Timestamp *ts);
+Timestamp matrix_clone_in(ClockArena *arena, const Timestamp *ts);
+void matrix_to_vector(const Timestamp *ts, int *out);
+
+/* ---------- Knowledge Queries ---------- */
+
+// Events of process k that every process is known to have seen: min over i of m[i][k]
+int matrix_min_known(const Timestamp *ts, int k);
+
+/* ---------- Operations Table ---------- */
+
+extern const TimestampOps MATRIX_OPS;
+
+#endif // MATRIX_CLOCK_H
@@ -12,6 +12,8 @@ typedef struct Message {
     void *timestamp_data;   // serialized timestamp data
     size_t timestamp_size;  // size of timestamp data
     ClockType clock_type;   // type of clock used
+    void *truth_data;       // ground-truth vector clock piggybacked for accuracy checks (or NULL)
+    size_t truth_size;      // not counted in message statistics
     char payload[64];
     struct Message *next;
 } Message;
@@ -0,0 +1,45 @@
+#ifndef PLAUSIBLE_CLOCK_H
+#define PLAUSIBLE_CLOCK_H
+
+#include "timestamp.h"
+
+/* ---------- Plausible Clock Configuration ---------- */
+
+// R-entries vector plausible clocks (Torres-Rojas, Ahamad): process pid ticks entry
+// pid % R, so timestamps cost R ints whatever n is. Causally related events are always
+// ordered correctly; some concurrent events may be reported as ordered.
+#define PLAUSIBLE_DEFAULT_ENTRIES 8
+
+// Entries for clocks created from now on; 0 restores the default. Clocks never use more
+// entries than processes, so R >= n gives exact vector clocks.
+void plausible_set_entries(int entries);
+int plausible_entries(int n);
+
+/* ---------- Plausible Clock Data Structure ---------- */
+
+// One block: header and counters together (see clock_arena.h)
+typedef struct {
+    int entries;        // R
+    int v[];            // R folded counters
+} PlausibleClockData;
+
+/* ---------- Plausible Clock Operations ---------- */
+
+Timestamp plausible_create(int n, int pid, ClockType type);
+Timestamp plausible_create_in(ClockArena *arena, int n, int pid, ClockType type);
+void plausible_destroy(Timestamp *ts);
+void plausible_increment(Timestamp *ts);
+void plausible_merge(Timestamp *dst, const void *other_data, size_t other_size);
+TSOrder plausible_compare(const Timestamp *a, const Timestamp *b);
+size_t plausible_serialize(const Timestamp *ts, void *buffer, size_t bufsize);
+void plausible_deserialize(Timestamp *ts, const void *buffer, size_t size);
+void plausible_to_string(const Timestamp *ts, char *buf, size_t bufsize);
+Timestamp plausible_clone(const Timestamp *ts);
+Timestamp plausible_clone_in(ClockArena *arena, const Timestamp *ts);
+void plausible_to_vector(const Timestamp *ts, int *out);  // v[i] = entry i % R
+
+/* ---------- Operations Table ---------- */
+
+extern const TimestampOps PLAUSIBLE_OPS;
+
+#endif // PLAUSIBLE_CLOCK_H
@@ -1,12 +1,34 @@
 #ifndef SIMULATION_H
 #define SIMULATION_H
 
+#include <pthread.h>
 #include "timestamp.h"
 #include "message_queue.h"
+#include "config.h"
 
-/* ---------- Process Context Structure ---------- */
+/* ---------- Dynamic Membership ---------- */
+
+// Slots are never reused: vector clocks need a fresh index for every process ever created
+typedef enum {
+    SLOT_UNUSED,        // not created yet; no timestamp
+    SLOT_ACTIVE,
+    SLOT_RETIRED        // left the system; timestamp kept for the final report
+} SlotState;
+
+struct ProcCtx;
 
 typedef struct {
+    int capacity;               // number of slots
+    SlotState *state;           // per slot, guarded by mtx
+    int active;                 // live processes
+    int created;                // processes ever created (historical membership)
+    struct ProcCtx *procs;      // all slots, so a fork can install the child's timestamp
+    pthread_mutex_t mtx;
+} Churn;
+
+/* ---------- Process Context Structure ---------- */
+
+typedef struct ProcCtx {
     int pid;
     int n;
     int steps;
@@ -14,22 +36,49 @@ typedef struct {
     Timestamp ts;       // timestamp using configured clock type
     MsgQueue *queues;   // array of size n (one per process)
     ClockType clock_type; // clock type for this simulation
+    WireFormat wire_format; // serialization format for messages
+    Churn *churn;       // dynamic membership, NULL for a fixed process set
+    Timestamp truth;    // standard vector clock run alongside clocks that cannot detect
+                        // concurrency (HLC, Lamport), as ground truth; data is NULL otherwise
+    ClockArena arena;   // blocks for this process's clocks; only its own thread allocates
+                        // from it, except the parent filling in a forked child's slot
 } ProcCtx;
 
 /* ---------- Performance Statistics ---------- */
 
 typedef struct {
     size_t total_message_bytes;
+    size_t total_raw_bytes;     // timestamp bytes had every message used WIRE_RAW
+    size_t total_wire_bytes;    // timestamp bytes actually sent
     int total_messages;
     int max_clock_size;
     double avg_clock_size;
+    // Clock size over time, messages bucketed by sender step
+    size_t bucket_bytes[SIZE_BUCKETS];
+    int bucket_messages[SIZE_BUCKETS];
+    int bucket_members[SIZE_BUCKETS];  // processes ever created by the end of the bucket
+    // Orderings reported by the clock vs. the ground-truth vector clock
+    int order_checks;
+    int concurrent_pairs;       // pairs the ground truth calls concurrent
+    int false_orderings;        // ...that the clock ordered anyway
+    int misorderings;           // ordered pairs the clock got wrong
+    int drift_rejections;       // messages refused by the HLC drift check
+    size_t tau_bytes;           // compressed clocks' per-destination state, all processes
+    int tau_evictions;          // destinations evicted by the compressed clocks' LRU cap
+    size_t arena_bytes;         // reserved by the per-process clock arenas
+    long long known_entries;    // matrix clocks: events each process knows, summed
+    long long min_known_entries;  // ...of which every process is known to have seen
 } PerfStats;
 
 extern PerfStats perf_stats;
 
 /* ---------- Simulation Functions ---------- */
 
-void update_perf_stats(size_t message_size, size_t clock_size);
+void update_perf_stats(size_t message_size, size_t clock_size, size_t raw_clock_size);
+void record_size_sample(int step, int steps, size_t clock_size, int members);
+void record_order_check(TSOrder clock_order, TSOrder truth_order);
+int needs_ground_truth(ClockType type);
+void order_samples_clear(void);
 void print_event_header(int pid, int step, const Timestamp *ts, const char *etype);
 void* worker(void *arg);
 
@@ -38,6 +87,29 @@ void* worker(void *arg);
 void do_internal(ProcCtx *ctx);
 void do_send(ProcCtx *ctx, int dest, const char *payload);
 int do_try_recv(ProcCtx *ctx);
+int do_fork(ProcCtx *ctx);
+int do_retire(ProcCtx *ctx, unsigned int *seed);
+
+/* ---------- Membership Setup ---------- */
+
+// n initial processes in procs[0..n-1] out of `capacity` slots
+void churn_init(Churn *churn, ProcCtx *procs, int n, int capacity);
+void churn_destroy(Churn *churn);
+
+/* ---------- Clock Type Report ---------- */
+
+typedef struct {
+    int messages;
+    double bytes_per_message;   // serialized timestamp bytes
+    double ns_per_event;        // local, send or receive event, serialization included
+} TypeCost;
+
+// Replays one seeded event mix (PROB_INTERNAL/SEND/RECV) on n clocks of the given type in a
+// single thread, delivering messages through per-process FIFO queues. The sequence of
+// events does not depend on the type, so costs of different types are comparable.
+// With deferred set, clocks of the types that support it queue receives and ticks
+// (see ts_set_deferred).
+TypeCost measure_type_cost(ClockType type, int n, int events, WireFormat wire, int deferred);
 
 /* ---------- Utility Functions ---------- */
 
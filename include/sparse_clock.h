@@ -11,11 +11,15 @@ typedef struct {
     int counter;
 } SparseEntry;
 
+// Entries held inside SparseClockData before the first heap allocation
+#define SPARSE_INLINE_CAPACITY 4
+
 // Sparse vector clock data
 typedef struct {
-    SparseEntry *entries;
-    int count;          // number of non-zero entries
-    int capacity;       // allocated capacity
+    SparseEntry *entries;   // sorted by pid; points at inline_entries until they overflow
+    int count;              // number of non-zero entries
+    int capacity;           // allocated capacity
+    SparseEntry inline_entries[SPARSE_INLINE_CAPACITY];
 } SparseClockData;
 
 /* ---------- Sparse Vector Clock Operations ---------- */
@@ -29,9 +33,10 @@ size_t sparse_serialize(const Timestamp *ts, void *buffer, size_t bufsize);
 void sparse_deserialize(Timestamp *ts, const void *buffer, size_t size);
 void sparse_to_string(const Timestamp *ts, char *buf, size_t bufsize);
 Timestamp sparse_clone(const Timestamp *ts);
+void sparse_to_vector(const Timestamp *ts, int *out);
 
 /* ---------- Operations Table ---------- */
 
-extern TimestampOps SPARSE_OPS;
+extern const TimestampOps SPARSE_OPS;
 
 #endif // SPARSE_CLOCK_H
\ No newline at end of file
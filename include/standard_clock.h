@@ -1,28 +1,50 @@
 #ifndef STANDARD_CLOCK_H
 #define STANDARD_CLOCK_H
 
+#include <stdint.h>
 #include "timestamp.h"
 
 /* ---------- Standard Vector Clock Data Structure ---------- */
 
+// One block: header and vector together (see clock_arena.h). Counters are kept at the
+// narrowest width that fits the largest one (see counter_store.h); a counter that outgrows
+// it moves the clock to a new, wider block, so ts->data changes on promotion.
 typedef struct {
-    int *v;             // vector clock array
+    int n;              // entries in cells
+    int width;          // bytes per counter: 1, 2, 4 or 8
+    uint64_t cells[];   // n counters of width bytes each (uint64_t only for alignment)
 } StandardClockData;
 
 /* ---------- Standard Vector Clock Operations ---------- */
 
+// Raw serialization is int32[n] while every counter fits in an int, uint64_t[n] after.
+// merge and deserialize accept either, told apart by size (n * 8 bytes means uint64_t).
+
 Timestamp standard_create(int n, int pid, ClockType type);
+Timestamp standard_create_in(ClockArena *arena, int n, int pid, ClockType type);
 void standard_destroy(Timestamp *ts);
 void standard_increment(Timestamp *ts);
 void standard_merge(Timestamp *dst, const void *other_data, size_t other_size);
+// Deferred receives take both forms; a uint64_t vector whose own entry is past INT_MAX is
+// merged in order
+int standard_gather(const Timestamp *ts, const void *other_data, size_t other_size, ClockGather *g);
+void standard_fold(Timestamp *ts, const ClockGather *g, int ticks);
 TSOrder standard_compare(const Timestamp *a, const Timestamp *b);
 size_t standard_serialize(const Timestamp *ts, void *buffer, size_t bufsize);
 void standard_deserialize(Timestamp *ts, const void *buffer, size_t size);
 void standard_to_string(const Timestamp *ts, char *buf, size_t bufsize);
 Timestamp standard_clone(const Timestamp *ts);
+Timestamp standard_clone_in(ClockArena *arena, const Timestamp *ts);
+void standard_to_vector(const Timestamp *ts, int *out);  // Exits if a counter is past INT_MAX
+void standard_to_vector64(const Timestamp *ts, uint64_t *out);
+uint64_t standard_get(const Timestamp *ts, int pid);       // Full 64-bit counter
+int standard_fits_int32(const Timestamp *ts);               // 1 if no counter is past INT32_MAX
+
+// Ops table with merge/compare/serialize compiled for n (see FOR_EACH_FIXED_N), or NULL
+const TimestampOps *standard_specialize(int n);
 
 /* ---------- Operations Table ---------- */
 
-extern TimestampOps STANDARD_OPS;
+extern const TimestampOps STANDARD_OPS;
 
 #endif // STANDARD_CLOCK_H
\ No newline at end of file
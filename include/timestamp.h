@@ -2,6 +2,8 @@
 #define TIMESTAMP_H
 
 #include <stddef.h>
+#include "clock_arena.h"
+#include "clock_digest.h"
 
 /* ---------- Clock Type Configuration ---------- */
 
@@ -10,9 +12,22 @@ typedef enum {
     CLOCK_SPARSE = 1,     // Compressed/sparse representation
     CLOCK_DIFFERENTIAL = 2, // Singhal-Kshemkalyani technique
     CLOCK_ENCODED = 3,    // Prime number encoding
-    CLOCK_COMPRESSED = 4  // True delta compression
+    CLOCK_COMPRESSED = 4, // True delta compression
+    CLOCK_ITC = 5,        // Interval tree clocks (dynamic membership)
+    CLOCK_HLC = 6,        // Hybrid logical clocks (constant 64-bit)
+    CLOCK_PLAUSIBLE = 7,  // R-entry plausible clocks
+    CLOCK_BLOOM = 8,      // Bloom clocks (counting Bloom filter of events)
+    CLOCK_MATRIX = 9,     // Matrix clocks (what each process knows the others know)
+    CLOCK_LAMPORT = 10,   // Lamport scalar clocks (the overhead floor)
+    CLOCK_TYPE_COUNT
 } ClockType;
 
+// Serialization format used by ts_serialize / ts_merge
+typedef enum {
+    WIRE_RAW = 0,       // per-type layouts of fixed-width ints
+    WIRE_COMPACT = 1    // versioned varint frames (see wire_codec.h)
+} WireFormat;
+
 typedef enum {
     TS_BEFORE,
     TS_AFTER,
@@ -22,17 +37,51 @@ typedef enum {
 
 /* ---------- Generic Timestamp Structure ---------- */
 
+struct TimestampOps;
+struct TsPending;
+
 typedef struct {
     int n;              // number of processes
     int pid;            // this process's ID [0..n-1]
     ClockType type;     // clock implementation type
     void *data;         // clock-specific data
     size_t data_size;   // size of serialized data
+    WireFormat wire;    // format emitted by ts_serialize* and expected by ts_merge/ts_deserialize
+    const struct TimestampOps *ops;  // resolved from type at creation; every ts_* call uses it
+    ClockDigest digest; // counter sum, max and hash, kept by the dense-vector types (see clock_digest.h)
+    struct TsPending *pending;  // events a deferred clock has not applied yet, NULL if eager
 } Timestamp;
 
-/* ---------- Abstract Timestamp Operations ---------- */
+/* ---------- Deferred Receive State ---------- */
 
+// Received entries a deferred clock has not applied yet (see ts_set_deferred). Entries
+// only grow, so an entry still 0 in acc has not been gathered.
 typedef struct {
+    int *acc;           // n ints: max of the gathered entries; the own entry is kept out
+    int *touched;       // entries of acc raised above 0, in gather order
+    int count;
+    int dense;          // a whole vector was gathered: any entry of acc may be set
+    int self;           // the clock's own entry (its pid)
+    int self_max;       // largest own entry in the message being gathered
+    uint64_t *wide;     // n counters gathered from uint64_t vectors (standard clocks), own
+                        // entry kept out; NULL until the type allocates it
+} ClockGather;
+
+static inline void clock_gather_entry(ClockGather *g, int k, int value) {
+    if (k == g->self) {
+        if (value > g->self_max) g->self_max = value;
+    } else if (value > g->acc[k]) {
+        if (g->acc[k] == 0) g->touched[g->count++] = k;
+        g->acc[k] = value;
+    }
+}
+
+// A whole vector of n entries, with the SIMD max (see vector_kernels.h)
+void clock_gather_vector(ClockGather *g, const int *v, int n);
+
+/* ---------- Abstract Timestamp Operations ---------- */
+
+typedef struct TimestampOps {
     Timestamp (*create)(int n, int pid, ClockType type);
     void (*destroy)(Timestamp *ts);
     void (*increment)(Timestamp *ts);
@@ -43,20 +92,95 @@ typedef struct {
     void (*deserialize)(Timestamp *ts, const void *buffer, size_t size);
     void (*to_string)(const Timestamp *ts, char *buf, size_t bufsize);
     Timestamp (*clone)(const Timestamp *ts);
+    void (*to_vector)(const Timestamp *ts, int *out);  // expand into n dense counters (NULL if
+                                                       // the type has no fixed process set)
+    // Counter range: standard clocks count to 2^64 - 1 and their to_vector refuses counters
+    // past INT_MAX (standard_to_vector64 has the full width); Lamport and HLC keep one 64-bit
+    // value. Every other type keeps int counters, and counting past INT_MAX is undefined.
+    // Single-block variants taking the block from an arena (NULL: the heap). NULL for
+    // types whose state grows after creation; those always use malloc.
+    Timestamp (*create_in)(ClockArena *arena, int n, int pid, ClockType type);
+    Timestamp (*clone_in)(ClockArena *arena, const Timestamp *ts);
+    // Receive event: merge, then tick. NULL means merge followed by increment; types whose
+    // merge already counts as the receive event point this at merge.
+    void (*merge_and_tick)(Timestamp *dst, const void *other_data, size_t other_size);
+    // Events of process k every process is known to have seen (NULL if the type only
+    // tracks its own knowledge)
+    int (*min_known)(const Timestamp *ts, int k);
+    // Table whose kernels are compiled for exactly n processes, or NULL if n is not one of
+    // FOR_EACH_FIXED_N (NULL member: the type has no fixed-n kernels)
+    const struct TimestampOps *(*specialize)(int n);
+    // Deferred receives (see ts_set_deferred), NULL if the type has none. gather adds a
+    // received message to g without touching the clock, or returns 0 if the message has to
+    // be merged in order. fold raises the clock's entries to those of g (all n if g->dense,
+    // else the touched ones), then records ticks local events at once.
+    int (*gather)(const Timestamp *ts, const void *other_data, size_t other_size, ClockGather *g);
+    void (*fold)(Timestamp *ts, const ClockGather *g, int ticks);
 } TimestampOps;
 
+// Process counts that get fixed-n kernels: loops with a constant trip count unroll or
+// vectorize, and the vector can stay in registers
+#define FOR_EACH_FIXED_N(X) X(4) X(8) X(16) X(32) X(64)
+
 /* ---------- Main Timestamp Interface ---------- */
 
 Timestamp ts_create(int n, int pid, ClockType type);
 void ts_destroy(Timestamp *ts);
 void ts_increment(Timestamp *ts);
 void ts_merge(Timestamp *dst, const void *other_data, size_t other_size);
+void ts_merge_and_tick(Timestamp *dst, const void *other_data, size_t other_size);  // receive event
 TSOrder ts_compare(const Timestamp *a, const Timestamp *b);
 size_t ts_serialize(const Timestamp *ts, void *buffer, size_t bufsize);
 size_t ts_serialize_for_dest(const Timestamp *ts, int dest, void *buffer, size_t bufsize);
 void ts_deserialize(Timestamp *ts, const void *buffer, size_t size);
 void ts_to_string(const Timestamp *ts, char *buf, size_t bufsize);
 Timestamp ts_clone(const Timestamp *ts);
+void ts_to_vector(const Timestamp *ts, int *out);
+int ts_min_known(const Timestamp *ts, int k);  // log entries of k that every process has seen
+// Equal clocks of a type hash equally: O(1) from the digest, else over the vector or the
+// raw serialization
+uint64_t ts_hash(const Timestamp *ts);
+
+/* ---------- Arena Allocation ---------- */
+
+// Like ts_create/ts_clone, but the clock's block comes from the arena: no malloc once the
+// arena has warmed up. Only the thread owning the arena may destroy the result.
+Timestamp ts_create_in(ClockArena *arena, int n, int pid, ClockType type);
+Timestamp ts_clone_in(ClockArena *arena, const Timestamp *ts);
+
+/* ---------- Fixed-n Kernels ---------- */
+
+// ts_create and ts_create_in bind a type's fixed-n table when n matches (on by default);
+// clocks keep the table they were created with
+void ts_set_fixed_kernels(int enabled);
+int ts_fixed_kernels(void);
+
+/* ---------- Digest Compare ---------- */
+
+// ts_compare decides from the digests where they suffice (on by default): equal sums give
+// EQUAL (equal hashes) or CONCURRENT, and a smaller sum with a larger maximum CONCURRENT.
+// EQUAL from hashes is wrong only on a 64-bit key collision.
+void ts_set_digest_compare(int enabled);
+int ts_digest_compare(void);
+
+/* ---------- Deferred Receives ---------- */
+
+// A deferred clock only queues receive events and local ticks: ticks are counted, and
+// received messages are max-merged into one pending vector as they arrive. The first call
+// that needs the clock's value (serialize, compare, to_string, to_vector, clone, hash, a
+// plain merge) settles it with one pass over the gathered entries and one add, giving the
+// clock and the messages it sends from then on the same values as applying the events one
+// by one. Types without TimestampOps.gather stay eager.
+void ts_set_deferred(Timestamp *ts, int enabled);
+int ts_deferred(const Timestamp *ts);
+void ts_settle(Timestamp *ts);
+
+/* ---------- Wire Format ---------- */
+
+// With WIRE_COMPACT, a size query (buffer too small) returns an upper bound and leaves
+// per-destination state untouched; the serializing call returns the exact size written.
+void ts_set_wire_format(Timestamp *ts, WireFormat format);
+size_t ts_raw_size(const Timestamp *ts, int dest);  // Raw-format size; dest < 0 for plain serialize
 
 /* ---------- Clock Type Information ---------- */
 
@@ -0,0 +1,46 @@
+#ifndef VECTOR_KERNELS_H
+#define VECTOR_KERNELS_H
+
+#include "timestamp.h"
+
+/* ---------- Dense Vector Kernels ---------- */
+
+// Instruction set used by the dense-vector kernels
+typedef enum {
+    VK_ISA_SCALAR = 0,  // portable C fallback
+    VK_ISA_SSE41 = 1,   // 4 x int32 per step
+    VK_ISA_AVX2 = 2,    // 8 x int32 per step
+    VK_ISA_AVX512 = 3   // 16 x int32 per step
+} VkIsa;
+
+#define VK_ISA_COUNT 4
+
+// Element-wise max: dst[i] = max(dst[i], src[i]) for i in [0, n)
+void vk_merge_max(int *dst, const int *src, int n);
+
+// Vector dominance: BEFORE if a <= b (and a != b), AFTER if b <= a, EQUAL or CONCURRENT otherwise.
+// Stops scanning as soon as both directions have been seen.
+TSOrder vk_compare(const int *a, const int *b, int n);
+
+// Column pass for one-vs-many compare: for every row r, flags q_gt[r] if q > col[r]
+// and col_gt[r] if col[r] > q. Flags are OR-accumulated (0 or all-ones).
+void vk_accumulate_column(const int *col, int q, int rows, int *q_gt, int *col_gt);
+
+/* ---------- Fixed-n Kernels ---------- */
+
+// vk_merge_max_4, vk_compare_4, ... vk_compare_64: the kernels above for exactly N ints,
+// one pair per N in FOR_EACH_FIXED_N
+#define DECLARE_VK_FIXED_N(N) \
+    void vk_merge_max_##N(int *dst, const int *src); \
+    TSOrder vk_compare_##N(const int *a, const int *b);
+FOR_EACH_FIXED_N(DECLARE_VK_FIXED_N)
+
+/* ---------- Dispatch Control ---------- */
+
+// The best supported ISA is selected at program start; these allow inspection and override
+VkIsa vk_active_isa(void);
+int vk_isa_supported(VkIsa isa);
+int vk_force_isa(VkIsa isa);  // Returns 0 if the ISA is not supported on this CPU
+const char* vk_isa_name(VkIsa isa);
+
+#endif // VECTOR_KERNELS_H
@@ -0,0 +1,65 @@
+#ifndef WIRE_CODEC_H
+#define WIRE_CODEC_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "timestamp.h"
+
+/* ---------- Compact Wire Format ---------- */
+
+// Every compact frame starts with one header byte:
+//   bits 7-6: format version, bits 5-4: payload kind, bits 3-0: ClockType
+#define WIRE_COMPACT_VERSION 2
+
+typedef enum {
+    WIRE_KIND_DENSE = 0,   // uvarint count, then count zigzag counters (entry k = k-th counter)
+    WIRE_KIND_PAIRS = 1,   // uvarint (count << 1 | layout), then (uvarint pid gap, zigzag counter)
+                           // with sorted pids; layout is a WirePairsLayout
+    WIRE_KIND_SCALAR = 2,  // a single uvarint (prime-encoded product)
+    WIRE_KIND_OPAQUE = 3   // uvarint length, then the raw serialized bytes
+} WireKind;
+
+// What the receiver rebuilds from a pairs frame: the entries of a full vector (absent
+// entries are zero), or the clock type's own pair message (sparse entries, differential
+// pairs, compressed tag-0 delta)
+typedef enum {
+    WIRE_PAIRS_OF_MESSAGE = 0,
+    WIRE_PAIRS_OF_VECTOR = 1
+} WirePairsLayout;
+
+// Largest LEB128 encoding of a 64-bit value
+#define WIRE_MAX_VARINT 10
+
+/* ---------- Varint Primitives ---------- */
+
+// LEB128: 7 bits per byte, high bit set on every byte but the last. Returns bytes written.
+size_t wire_put_uvarint(uint8_t *out, uint64_t value);
+// Returns bytes consumed, or 0 if the input is truncated or longer than WIRE_MAX_VARINT
+size_t wire_get_uvarint(const uint8_t *in, size_t avail, uint64_t *value);
+size_t wire_uvarint_size(uint64_t value);
+
+// Zigzag maps small signed values to small unsigned ones: 0,-1,1,-2 -> 0,1,2,3
+static inline uint64_t wire_zigzag_encode(int64_t v) {
+    return ((uint64_t)v << 1) ^ (uint64_t)(v >> 63);
+}
+
+static inline int64_t wire_zigzag_decode(uint64_t v) {
+    return (int64_t)(v >> 1) ^ -(int64_t)(v & 1);
+}
+
+/* ---------- Frame Transcoding ---------- */
+
+// Upper bound on the compact size of a raw serialization of raw_size bytes
+size_t wire_compact_bound(size_t raw_size);
+
+// Re-encode a raw serialized timestamp of the given clock type as a compact frame.
+// Returns the compact size; nothing is written if bufsize is too small.
+size_t wire_encode_compact(ClockType type, int n, const void *raw, size_t raw_size,
+                           void *buffer, size_t bufsize);
+
+// Decode a compact frame back to the clock type's raw layout. On success returns 1 and
+// stores a malloc'd buffer in *raw (caller frees); returns 0 on a malformed frame.
+int wire_decode_compact(ClockType type, int n, const void *frame, size_t frame_size,
+                        void **raw, size_t *raw_size);
+
+#endif // WIRE_CODEC_H
@@ -0,0 +1,204 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bloom_clock.h"
+#include "vector_kernels.h"
+
+/* ---------- Bloom Clock Configuration ---------- */
+
+static int configured_cells = BLOOM_DEFAULT_CELLS;
+static int configured_hashes = BLOOM_DEFAULT_HASHES;
+
+void bloom_set_params(int cells, int hashes) {
+    configured_cells = cells > 0 ? cells : BLOOM_DEFAULT_CELLS;
+    configured_hashes = hashes > 0 ? hashes : BLOOM_DEFAULT_HASHES;
+}
+
+int bloom_cells(void) {
+    return configured_cells;
+}
+
+int bloom_hashes(void) {
+    return configured_hashes;
+}
+
+/* ---------- Hashing ---------- */
+
+// SplitMix64 finalizer
+static uint64_t mix64(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+// Cell i of event (pid, counter), by double hashing
+static int bloom_cell(int pid, uint32_t counter, int i, int m) {
+    uint64_t h = mix64(((uint64_t)(uint32_t)pid << 32) | counter);
+    uint64_t h1 = h & 0xFFFFFFFFu, h2 = (h >> 32) | 1;
+    return (int)((h1 + (uint64_t)i * h2) % (uint64_t)m);
+}
+
+// base^e by squaring (keeps the build free of libm)
+static double pow_int(double base, long long e) {
+    double result = 1.0;
+    while (e > 0) {
+        if (e & 1) result *= base;
+        base *= base;
+        e >>= 1;
+    }
+    return result;
+}
+
+static long long bloom_sum(const BloomClockData *data) {
+    long long sum = 0;
+    for (int i = 0; i < data->m; i++) {
+        sum += data->cells[i];
+    }
+    return sum;
+}
+
+/* ---------- Bloom Clock Implementation ---------- */
+
+static Timestamp bloom_alloc(ClockArena *arena, int n, int pid, ClockType type, int m, int k) {
+    Timestamp ts;
+    ts.n = n;
+    ts.pid = pid;
+    ts.type = type;
+    clock_digest_none(&ts.digest);
+    
+    BloomClockData *data = clock_block_alloc(arena, sizeof(BloomClockData) + m * sizeof(int));
+    data->m = m;
+    data->k = k;
+    data->events = 0;
+    
+    ts.data = data;
+    ts.data_size = m * sizeof(int);
+    return ts;
+}
+
+Timestamp bloom_create_in(ClockArena *arena, int n, int pid, ClockType type) {
+    return bloom_alloc(arena, n, pid, type, configured_cells, configured_hashes);
+}
+
+Timestamp bloom_create(int n, int pid, ClockType type) {
+    return bloom_create_in(NULL, n, pid, type);
+}
+
+void bloom_destroy(Timestamp *ts) {
+    if (ts && ts->data) {
+        clock_block_free(ts->data);
+        ts->data = NULL;
+    }
+}
+
+void bloom_increment(Timestamp *ts) {
+    BloomClockData *data = (BloomClockData*)ts->data;
+    data->events++;
+    for (int i = 0; i < data->k; i++) {
+        data->cells[bloom_cell(ts->pid, data->events, i, data->m)] += 1;
+    }
+}
+
+void bloom_merge(Timestamp *dst, const void *other_data, size_t other_size) {
+    BloomClockData *data = (BloomClockData*)dst->data;
+    
+    if (other_size != data->m * sizeof(int)) {
+        return;
+    }
+    vk_merge_max(data->cells, (const int*)other_data, data->m);
+}
+
+TSOrder bloom_compare(const Timestamp *a, const Timestamp *b) {
+    const BloomClockData *a_data = (const BloomClockData*)a->data;
+    const BloomClockData *b_data = (const BloomClockData*)b->data;
+    
+    if (a_data->m != b_data->m) {
+        fprintf(stderr, "Mismatched bloom clock sizes!\n");
+        exit(1);
+    }
+    
+    TSOrder order = vk_compare(a_data->cells, b_data->cells, a_data->m);
+    // Distinct processes only share a filter before either has recorded an event
+    if (order == TS_EQUAL && a->pid != b->pid) {
+        return TS_CONCURRENT;
+    }
+    return order;
+}
+
+size_t bloom_serialize(const Timestamp *ts, void *buffer, size_t bufsize) {
+    const BloomClockData *data = (const BloomClockData*)ts->data;
+    size_t required = data->m * sizeof(int);
+    
+    if (bufsize >= required) {
+        memcpy(buffer, data->cells, required);
+    }
+    return required;
+}
+
+void bloom_deserialize(Timestamp *ts, const void *buffer, size_t size) {
+    BloomClockData *data = (BloomClockData*)ts->data;
+    
+    if (size == data->m * sizeof(int)) {
+        memcpy(data->cells, buffer, size);
+    }
+}
+
+void bloom_to_string(const Timestamp *ts, char *buf, size_t bufsize) {
+    // The cells mean little individually; show the shape and total count
+    const BloomClockData *data = (const BloomClockData*)ts->data;
+    int nonzero = 0;
+    for (int i = 0; i < data->m; i++) {
+        if (data->cells[i]) nonzero++;
+    }
+    snprintf(buf, bufsize, "B{m=%d,k=%d,sum=%lld,set=%d}", data->m, data->k, bloom_sum(data), nonzero);
+}
+
+Timestamp bloom_clone_in(ClockArena *arena, const Timestamp *ts) {
+    const BloomClockData *src = (const BloomClockData*)ts->data;
+    // Keep the source's shape even if the configured default changed since
+    Timestamp out = bloom_alloc(arena, ts->n, ts->pid, ts->type, src->m, src->k);
+    BloomClockData *dst = (BloomClockData*)out.data;
+    
+    dst->events = src->events;
+    memcpy(dst->cells, src->cells, src->m * sizeof(int));
+    return out;
+}
+
+Timestamp bloom_clone(const Timestamp *ts) {
+    return bloom_clone_in(NULL, ts);
+}
+
+/* ---------- False Positive Estimate ---------- */
+
+double bloom_false_positive(const Timestamp *a, const Timestamp *b) {
+    const BloomClockData *a_data = (const BloomClockData*)a->data;
+    const BloomClockData *b_data = (const BloomClockData*)b->data;
+    
+    TSOrder order = vk_compare(a_data->cells, b_data->cells, a_data->m);
+    if (order != TS_BEFORE && order != TS_EQUAL) {
+        return 0.0;
+    }
+    
+    long long extra = bloom_sum(b_data) - bloom_sum(a_data);
+    double covered = 1.0 - pow_int(1.0 - 1.0 / a_data->m, extra);
+    return pow_int(covered, a_data->k);
+}
+
+/* ---------- Operations Table ---------- */
+
+const TimestampOps BLOOM_OPS = {
+    .create = bloom_create,
+    .destroy = bloom_destroy,
+    .increment = bloom_increment,
+    .merge = bloom_merge,
+    .compare = bloom_compare,
+    .serialize = bloom_serialize,
+    .serialize_for_dest = NULL,  // Already constant size
+    .deserialize = bloom_deserialize,
+    .to_string = bloom_to_string,
+    .clone = bloom_clone,
+    .to_vector = NULL,  // Cells are not per-process counters
+    .create_in = bloom_create_in,
+    .clone_in = bloom_clone_in
+};
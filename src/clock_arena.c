@@ -0,0 +1,168 @@
+#define _DEFAULT_SOURCE  // mmap / madvise
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include "clock_arena.h"
+
+/* ---------- Block Bookkeeping ---------- */
+
+// Stored in the cache line just before each block
+typedef struct {
+    ClockArena *arena;  // owner, NULL for heap blocks
+    void *raw;          // heap blocks: pointer to hand back to free()
+    size_t size;        // rounded block size
+} BlockHeader;
+
+struct ClockArenaChunk {
+    ClockArenaChunk *next;
+    size_t bytes;       // whole mapping, this header included
+    int mapped;         // from mmap rather than malloc
+};
+
+#define HUGE_PAGE_SIZE (2 * 1024 * 1024)
+
+static BlockHeader *header_of(const void *block) {
+    return (BlockHeader*)((char*)block - CLOCK_BLOCK_ALIGN);
+}
+
+static void oom(void) {
+    fprintf(stderr, "OOM\n");
+    exit(1);
+}
+
+/* ---------- Chunks ---------- */
+
+static void chunk_map(ClockArena *arena, size_t bytes) {
+    ClockArenaChunk *chunk = NULL;
+    int mapped = 0;
+    
+#if defined(MAP_ANONYMOUS) && defined(MADV_HUGEPAGE)
+    if (arena->huge_pages) {
+        bytes = (bytes + HUGE_PAGE_SIZE - 1) & ~(size_t)(HUGE_PAGE_SIZE - 1);
+        void *p = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p != MAP_FAILED) {
+            madvise(p, bytes, MADV_HUGEPAGE);  // advisory; ignored without THP support
+            chunk = (ClockArenaChunk*)p;
+            mapped = 1;
+        }
+    }
+#endif
+    if (!chunk) {
+        chunk = (ClockArenaChunk*)malloc(bytes);
+        if (!chunk) oom();
+    }
+    
+    chunk->next = arena->chunks;
+    chunk->bytes = bytes;
+    chunk->mapped = mapped;
+    arena->chunks = chunk;
+    arena->reserved += bytes;
+    
+    // First block line starts at the first aligned address past the chunk header
+    uintptr_t start = ((uintptr_t)(chunk + 1) + CLOCK_BLOCK_ALIGN - 1) & ~(uintptr_t)(CLOCK_BLOCK_ALIGN - 1);
+    arena->bump = (char*)start;
+    arena->left = bytes - (size_t)(start - (uintptr_t)chunk);
+}
+
+/* ---------- Arena ---------- */
+
+void clock_arena_init(ClockArena *arena, int huge_pages) {
+    memset(arena, 0, sizeof(*arena));
+    arena->huge_pages = huge_pages;
+}
+
+void clock_arena_release(ClockArena *arena) {
+    ClockArenaChunk *chunk = arena->chunks;
+    while (chunk) {
+        ClockArenaChunk *next = chunk->next;
+        if (chunk->mapped) {
+            munmap(chunk, chunk->bytes);
+        } else {
+            free(chunk);
+        }
+        chunk = next;
+    }
+    clock_arena_init(arena, arena->huge_pages);
+}
+
+/* ---------- Blocks ---------- */
+
+static void *arena_alloc(ClockArena *arena, size_t size) {
+    // Reuse a freed block of the same size
+    for (int c = 0; c < CLOCK_ARENA_CLASSES; c++) {
+        if (arena->free_lists[c].size == size) {
+            void *block = arena->free_lists[c].head;
+            if (block) {
+                arena->free_lists[c].head = *(void**)block;
+                return block;
+            }
+            break;
+        }
+    }
+    
+    // Bump: one bookkeeping line, then the block
+    size_t need = CLOCK_BLOCK_ALIGN + size;
+    if (arena->left < need) {
+        size_t bytes = need + sizeof(ClockArenaChunk) + CLOCK_BLOCK_ALIGN;
+        chunk_map(arena, bytes > CLOCK_ARENA_CHUNK ? bytes : CLOCK_ARENA_CHUNK);
+    }
+    char *block = arena->bump + CLOCK_BLOCK_ALIGN;
+    arena->bump += need;
+    arena->left -= need;
+    
+    BlockHeader *header = header_of(block);
+    header->arena = arena;
+    header->raw = NULL;
+    header->size = size;
+    return block;
+}
+
+void *clock_block_alloc(ClockArena *arena, size_t size) {
+    size = CLOCK_BLOCK_ROUND(size ? size : 1);
+    char *block;
+    
+    if (arena) {
+        block = (char*)arena_alloc(arena, size);
+        arena->live_blocks++;
+    } else {
+        char *raw = (char*)malloc(size + 2 * CLOCK_BLOCK_ALIGN);
+        if (!raw) oom();
+        uintptr_t aligned = ((uintptr_t)raw + CLOCK_BLOCK_ALIGN - 1) & ~(uintptr_t)(CLOCK_BLOCK_ALIGN - 1);
+        block = (char*)aligned + CLOCK_BLOCK_ALIGN;
+        BlockHeader *header = header_of(block);
+        header->arena = NULL;
+        header->raw = raw;
+        header->size = size;
+    }
+    
+    memset(block, 0, size);
+    return block;
+}
+
+void clock_block_free(void *block) {
+    if (!block) return;
+    BlockHeader *header = header_of(block);
+    ClockArena *arena = header->arena;
+    
+    if (!arena) {
+        free(header->raw);
+        return;
+    }
+    
+    arena->live_blocks--;
+    for (int c = 0; c < CLOCK_ARENA_CLASSES; c++) {
+        if (arena->free_lists[c].size == header->size || arena->free_lists[c].size == 0) {
+            arena->free_lists[c].size = header->size;
+            *(void**)block = arena->free_lists[c].head;
+            arena->free_lists[c].head = block;
+            return;
+        }
+    }
+    // More distinct sizes than classes: the block stays unused until the arena is released
+}
+
+ClockArena *clock_block_arena(const void *block) {
+    return header_of(block)->arena;
+}
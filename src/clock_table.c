@@ -0,0 +1,142 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "clock_table.h"
+#include "standard_clock.h"
+#include "vector_kernels.h"
+
+// Rows classified per pass; keeps both flag arrays (2 x 4 KB) resident in L1
+#define CLOCK_TABLE_TILE 1024
+
+/* ---------- Clock Table Implementation ---------- */
+
+int clock_table_supports(ClockType type) {
+    switch (type) {
+        case CLOCK_STANDARD:
+        case CLOCK_SPARSE:
+        case CLOCK_DIFFERENTIAL:
+        case CLOCK_ENCODED:      // divisibility of prime products is dominance of exponents
+        case CLOCK_COMPRESSED:
+        case CLOCK_MATRIX:       // compared on the own row, which to_vector returns
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+// Standard counters are 64-bit; the rest never leave int. A deferred clock is settled
+// first, as every reader does, so the check sees its final counters.
+static int fits_columns(const Timestamp *ts) {
+    if (ts->type != CLOCK_STANDARD) {
+        return 1;
+    }
+    ts_settle((Timestamp*)ts);
+    return standard_fits_int32(ts);
+}
+
+void clock_table_init(ClockTable *t, int n, ClockType type, int capacity) {
+    if (!clock_table_supports(type)) {
+        fprintf(stderr, "Clock table cannot hold %s clocks!\n", clock_type_names[type]);
+        exit(1);
+    }
+    t->type = type;
+    t->n = n;
+    t->rows = 0;
+    t->capacity = capacity > 0 ? capacity : 16;
+    t->cols = (int*)calloc((size_t)n * t->capacity, sizeof(int));
+    if (!t->cols) {
+        fprintf(stderr, "OOM\n");
+        exit(1);
+    }
+}
+
+void clock_table_destroy(ClockTable *t) {
+    if (t && t->cols) {
+        free(t->cols);
+        t->cols = NULL;
+        t->rows = 0;
+        t->capacity = 0;
+    }
+}
+
+static void clock_table_grow(ClockTable *t) {
+    int new_capacity = t->capacity * 2;
+    int *cols = (int*)malloc((size_t)t->n * new_capacity * sizeof(int));
+    if (!cols) {
+        fprintf(stderr, "OOM\n");
+        exit(1);
+    }
+    // Column stride changes with capacity, so each column moves separately
+    for (int k = 0; k < t->n; k++) {
+        memcpy(cols + (size_t)k * new_capacity, t->cols + (size_t)k * t->capacity,
+               t->rows * sizeof(int));
+    }
+    free(t->cols);
+    t->cols = cols;
+    t->capacity = new_capacity;
+}
+
+int clock_table_add(ClockTable *t, const Timestamp *ts) {
+    if (ts->type != t->type || ts->n != t->n) {
+        fprintf(stderr, "Clock table holds %s clocks of size %d!\n", clock_type_names[t->type], t->n);
+        exit(1);
+    }
+
+    if (!fits_columns(ts)) {
+        return -1;
+    }
+    int *row = (int*)malloc(t->n * sizeof(int));
+    ts_to_vector(ts, row);
+    if (t->rows >= t->capacity) {
+        clock_table_grow(t);
+    }
+    for (int k = 0; k < t->n; k++) {
+        t->cols[(size_t)k * t->capacity + t->rows] = row[k];
+    }
+    free(row);
+    return t->rows++;
+}
+
+void clock_table_add_all(ClockTable *t, const Timestamp *ts, int count) {
+    for (int i = 0; i < count; i++) {
+        clock_table_add(t, &ts[i]);
+    }
+}
+
+/* ---------- Batch Comparison ---------- */
+
+int ts_compare_many(const Timestamp *query, const ClockTable *table, TSOrder *out_orders) {
+    if (query->type != table->type || query->n != table->n) {
+        fprintf(stderr, "Cannot compare different clock types!\n");
+        exit(1);
+    }
+
+    if (!fits_columns(query)) {
+        return 0;
+    }
+    int *q = (int*)malloc(table->n * sizeof(int));
+    ts_to_vector(query, q);
+
+    int q_gt[CLOCK_TABLE_TILE];
+    int row_gt[CLOCK_TABLE_TILE];
+
+    for (int base = 0; base < table->rows; base += CLOCK_TABLE_TILE) {
+        int tile = table->rows - base < CLOCK_TABLE_TILE ? table->rows - base : CLOCK_TABLE_TILE;
+        memset(q_gt, 0, tile * sizeof(int));
+        memset(row_gt, 0, tile * sizeof(int));
+
+        for (int k = 0; k < table->n; k++) {
+            vk_accumulate_column(table->cols + (size_t)k * table->capacity + base, q[k], tile, q_gt, row_gt);
+        }
+
+        for (int r = 0; r < tile; r++) {
+            if (!q_gt[r] && !row_gt[r]) out_orders[base + r] = TS_EQUAL;
+            else if (!q_gt[r]) out_orders[base + r] = TS_BEFORE;
+            else if (!row_gt[r]) out_orders[base + r] = TS_AFTER;
+            else out_orders[base + r] = TS_CONCURRENT;
+        }
+    }
+
+    free(q);
+    return 1;
+}
@@ -2,59 +2,412 @@
 #include <stdlib.h>
 #include <string.h>
 #include "compressed_clock.h"
+#include "vector_kernels.h"
+#include "wire_codec.h"
+
+/* ---------- Destination Tracking Configuration ---------- */
+
+static int configured_max_destinations = COMPRESSED_UNLIMITED_DESTINATIONS;
+
+void compressed_set_max_destinations(int k) {
+    configured_max_destinations = k > 0 ? k : COMPRESSED_UNLIMITED_DESTINATIONS;
+}
+
+int compressed_max_destinations(int n) {
+    if (configured_max_destinations == COMPRESSED_UNLIMITED_DESTINATIONS ||
+        configured_max_destinations > n) {
+        return n;
+    }
+    return configured_max_destinations;
+}
+
+static int configured_value_deltas = 0;
+
+void compressed_set_value_deltas(int enabled) {
+    configured_value_deltas = enabled != 0;
+}
+
+int compressed_value_deltas(void) {
+    return configured_value_deltas;
+}
+
+/* ---------- Tau Arena ---------- */
+
+static void* tau_realloc(void *p, size_t size) {
+    p = realloc(p, size);
+    if (!p) {
+        fprintf(stderr, "OOM\n");
+        exit(1);
+    }
+    return p;
+}
+
+// Doubles the arena, up to max_rows rows
+static void tau_grow(CompressedClockData *data) {
+    int rows = data->rows_alloc ? data->rows_alloc * 2 : 1;
+    if (rows > data->max_rows) rows = data->max_rows;
+    
+    data->tau = (int*)tau_realloc(data->tau, (size_t)rows * data->n * sizeof(int));
+    data->dirty = (uint64_t*)tau_realloc(data->dirty,
+                                         (size_t)rows * COMPRESSED_DIRTY_WORDS(data->n) * sizeof(uint64_t));
+    data->dest_of = (int*)tau_realloc(data->dest_of, rows * sizeof(int));
+    data->last_used = (unsigned*)tau_realloc(data->last_used, rows * sizeof(unsigned));
+    data->sent_seq = (unsigned*)tau_realloc(data->sent_seq, rows * sizeof(unsigned));
+    data->rows_alloc = rows;
+}
+
+static uint64_t* dirty_row(const CompressedClockData *data, int row) {
+    return data->dirty + (size_t)row * COMPRESSED_DIRTY_WORDS(data->n);
+}
+
+// Index of the first dirty bit at or after k, or -1
+static int next_dirty(const uint64_t *dirty, int words, int k) {
+    int w = k / 64;
+    if (w >= words) return -1;
+    uint64_t bits = dirty[w] & (~0ULL << (k % 64));
+    while (!bits) {
+        if (++w >= words) return -1;
+        bits = dirty[w];
+    }
+    return w * 64 + __builtin_ctzll(bits);
+}
+
+// vt[k] changed: every tracked destination may now be behind on it
+static void compressed_mark(CompressedClockData *data, int k) {
+    uint64_t bit = 1ULL << (k % 64);
+    uint64_t *word = data->dirty + k / 64;
+    for (int r = 0; r < data->rows_used; r++) {
+        word[(size_t)r * COMPRESSED_DIRTY_WORDS(data->n)] |= bit;
+    }
+}
+
+// Row for dest, marked most recently used. A new row starts zeroed with no dirty bits
+// (the caller fills it); when every row is taken the least recently used destination
+// gives up its row.
+static int* tau_acquire(CompressedClockData *data, int dest) {
+    int row = data->row_of[dest];
+    
+    if (row < 0) {
+        if (data->rows_used < data->max_rows) {
+            if (data->rows_used == data->rows_alloc) {
+                tau_grow(data);
+            }
+            row = data->rows_used++;
+        } else {
+            row = 0;
+            for (int r = 1; r < data->rows_used; r++) {
+                if (data->last_used[r] < data->last_used[row]) row = r;
+            }
+            data->row_of[data->dest_of[row]] = COMPRESSED_ROW_EVICTED;
+            data->evictions++;
+        }
+        data->row_of[dest] = row;
+        data->dest_of[row] = dest;
+        data->sent_seq[row] = 0;
+        memset(data->tau + (size_t)row * data->n, 0, data->n * sizeof(int));
+        memset(dirty_row(data, row), 0, COMPRESSED_DIRTY_WORDS(data->n) * sizeof(uint64_t));
+    }
+    
+    data->last_used[row] = ++data->use_clock;
+    return data->tau + (size_t)row * data->n;
+}
 
 /* ---------- Compressed Vector Clock Implementation (True Delta Compression) ---------- */
 
-Timestamp compressed_create(int n, int pid, ClockType type) {
+Timestamp compressed_create_in(ClockArena *arena, int n, int pid, ClockType type) {
     Timestamp ts;
     ts.n = n;
     ts.pid = pid;
     ts.type = type;
+    clock_digest_reset(&ts.digest);
     
-    CompressedClockData *data = malloc(sizeof(CompressedClockData));
+    // Header, vt and row_of in one block
+    size_t header = CLOCK_BLOCK_ROUND(sizeof(CompressedClockData));
+    CompressedClockData *data = clock_block_alloc(arena, header + 2 * n * sizeof(int));
     data->n = n;
+    data->vt = (int*)((char*)data + header);
+    data->row_of = data->vt + n;
     
-    // Allocate current vector clock
-    data->vt = (int*)calloc(n, sizeof(int));
-    
-    // Allocate tau matrix: tau[j][k] = last timestamp sent to receiver j
-    data->tau = (int**)malloc(n * sizeof(int*));
+    // tau rows are allocated on first send to each destination
+    data->tau = NULL;
+    data->dirty = NULL;
+    data->dest_of = NULL;
+    data->last_used = NULL;
+    data->sent_seq = NULL;
     for (int j = 0; j < n; j++) {
-        data->tau[j] = (int*)calloc(n, sizeof(int));  // Initialize to [0,0,...,0] for all receivers
+        data->row_of[j] = COMPRESSED_ROW_NONE;
     }
+    data->use_clock = 0;
+    data->rows_used = 0;
+    data->rows_alloc = 0;
+    data->max_rows = compressed_max_destinations(n);
+    data->evictions = 0;
+    data->value_deltas = configured_value_deltas;
+    data->recv_rows = NULL;
+    data->recv_seq = NULL;
     
     ts.data = data;
     ts.data_size = 0; // Dynamic size based on compression
     return ts;
 }
 
+Timestamp compressed_create(int n, int pid, ClockType type) {
+    return compressed_create_in(NULL, n, pid, type);
+}
+
 void compressed_destroy(Timestamp *ts) {
     if (ts && ts->data) {
         CompressedClockData *data = (CompressedClockData*)ts->data;
         
-        // Free vector clock
-        if (data->vt) {
-            free(data->vt);
-        }
-        
-        // Free tau matrix
-        if (data->tau) {
+        free(data->tau);
+        free(data->dirty);
+        free(data->dest_of);
+        free(data->last_used);
+        free(data->sent_seq);
+        if (data->recv_rows) {
             for (int j = 0; j < data->n; j++) {
-                if (data->tau[j]) {
-                    free(data->tau[j]);
-                }
+                free(data->recv_rows[j]);
             }
-            free(data->tau);
+            free(data->recv_rows);
+            free(data->recv_seq);
         }
         
-        free(ts->data);
+        clock_block_free(ts->data);
         ts->data = NULL;
     }
 }
 
+// k local events at once
+static void compressed_advance(Timestamp *ts, int k) {
+    CompressedClockData *data = (CompressedClockData*)ts->data;
+    clock_digest_raise(&ts->digest, ts->pid, data->vt[ts->pid], data->vt[ts->pid] + k);
+    data->vt[ts->pid] += k;
+    compressed_mark(data, ts->pid);
+}
+
 void compressed_increment(Timestamp *ts) {
+    compressed_advance(ts, 1);
+}
+
+// vt[k] grows to a received value
+static void compressed_raise(CompressedClockData *data, ClockDigest *digest, int k, int value) {
+    clock_digest_raise(digest, k, data->vt[k], value);
+    data->vt[k] = value;
+    compressed_mark(data, k);
+}
+
+/* ---------- Delta Message Codec ---------- */
+
+#define BITMAP_WORDS(n) (((n) + 31) / 32)
+
+// Walks a tagged delta message. Each (pid, value) above data's vt is max-merged into it
+// (and digest) when data is non-NULL, or gathered into g instead when g is non-NULL, and
+// every pair is appended to pids/values when those are non-NULL. Returns the entry count, or -1 if the message is
+// malformed (nothing is merged then).
+static int compressed_walk_delta(int n, const void *buffer, size_t size, CompressedClockData *data,
+                                 ClockDigest *digest, ClockGather *g, int *pids, int *values) {
+    const int *buf = (const int*)buffer;
+    size_t words = size / sizeof(int);
+    if (words < 1) return -1;
+    
+    int tag = (unsigned)buf[0] >> COMPRESSED_TAG_SHIFT;
+    int count = buf[0] & COMPRESSED_COUNT_MASK;
+    int emitted = 0;
+    
+    // Validate the whole message first so a truncated one is ignored rather than half-applied
+    switch (tag) {
+        case COMPRESSED_ENC_PAIRS:
+            if (count > n || words < 1 + 2 * (size_t)count) return -1;
+            for (int i = 0; i < count; i++) {
+                if (buf[1 + 2 * i] < 0 || buf[1 + 2 * i] >= n) return -1;
+            }
+            break;
+        case COMPRESSED_ENC_BITMAP: {
+            size_t bitmap_words = BITMAP_WORDS(n);
+            if (count > n || words < 1 + bitmap_words + count) return -1;
+            int bits = 0;
+            for (size_t w = 0; w < bitmap_words; w++) {
+                bits += __builtin_popcount((unsigned)buf[1 + w]);
+            }
+            if (bits != count) return -1;
+            if (n % 32 && ((unsigned)buf[bitmap_words] >> (n % 32))) return -1;  // pids past n
+            break;
+        }
+        case COMPRESSED_ENC_RUNS: {
+            size_t pos = 1;
+            for (int r = 0; r < count; r++) {
+                if (pos + 2 > words) return -1;
+                int start = buf[pos], length = buf[pos + 1];
+                if (start < 0 || length < 1 || length > n - start || emitted + length > n) return -1;
+                emitted += length;
+                pos += 2 + length;
+            }
+            if (pos > words) return -1;
+            emitted = 0;
+            break;
+        }
+        default:
+            return -1;
+    }
+    
+    #define VISIT(pid, value) do {                                      \
+        int p_ = (pid), v_ = (value);                                   \
+        if (data && v_ > data->vt[p_]) {                                \
+            if (g) clock_gather_entry(g, p_, v_);                       \
+            else compressed_raise(data, digest, p_, v_);                \
+        }                                                               \
+        if (pids) { pids[emitted] = p_; values[emitted] = v_; }         \
+        emitted++;                                                      \
+    } while (0)
+    
+    switch (tag) {
+        case COMPRESSED_ENC_PAIRS:
+            for (int i = 0; i < count; i++) {
+                VISIT(buf[1 + 2 * i], buf[2 + 2 * i]);
+            }
+            break;
+        case COMPRESSED_ENC_BITMAP: {
+            const int *vals = buf + 1 + BITMAP_WORDS(n);
+            for (int w = 0; w < BITMAP_WORDS(n); w++) {
+                unsigned bits = (unsigned)buf[1 + w];
+                while (bits) {
+                    int pid = w * 32 + __builtin_ctz(bits);
+                    bits &= bits - 1;
+                    VISIT(pid, vals[emitted]);
+                }
+            }
+            break;
+        }
+        case COMPRESSED_ENC_RUNS: {
+            size_t pos = 1;
+            for (int r = 0; r < count; r++) {
+                int start = buf[pos], length = buf[pos + 1];
+                for (int i = 0; i < length; i++) {
+                    VISIT(start + i, buf[pos + 2 + i]);
+                }
+                pos += 2 + length;
+            }
+            break;
+        }
+    }
+    #undef VISIT
+    return emitted;
+}
+
+static void compressed_apply_delta(CompressedClockData *data, ClockDigest *digest, const void *buffer,
+                                   size_t size) {
+    compressed_walk_delta(data->n, buffer, size, data, digest, NULL, NULL, NULL);
+}
+
+// Max-merges a full vector, marking the entries that grew
+static void compressed_apply_full(CompressedClockData *data, ClockDigest *digest, const int *other) {
+    for (int k = 0; k < data->n; k++) {
+        if (other[k] > data->vt[k]) {
+            compressed_raise(data, digest, k, other[k]);
+        }
+    }
+}
+
+int compressed_decode_entries(int n, const void *buffer, size_t size, int *pids, int *values) {
+    if (size == n * sizeof(int)) {
+        const int *full = (const int*)buffer;
+        for (int k = 0; k < n; k++) {
+            pids[k] = k;
+            values[k] = full[k];
+        }
+        return n;
+    }
+    return compressed_walk_delta(n, buffer, size, NULL, NULL, NULL, pids, values);
+}
+
+/* ---------- Value-Delta Frames ---------- */
+
+int compressed_is_value_delta(const void *buffer, size_t size) {
+    return size >= sizeof(int) &&
+           ((unsigned)((const int*)buffer)[0] >> COMPRESSED_TAG_SHIFT) == COMPRESSED_ENC_VALUE_DELTA;
+}
+
+static void* recv_calloc(size_t count, size_t size) {
+    void *p = calloc(count, size);
+    if (!p) {
+        fprintf(stderr, "OOM\n");
+        exit(1);
+    }
+    return p;
+}
+
+// Receive row for sender, created (all zeros) on its first frame
+static int* recv_row(CompressedClockData *data, int sender) {
+    if (!data->recv_rows) {
+        data->recv_rows = (int**)recv_calloc(data->n, sizeof(int*));
+        data->recv_seq = (unsigned*)recv_calloc(data->n, sizeof(unsigned));
+    }
+    if (!data->recv_rows[sender]) {
+        data->recv_rows[sender] = (int*)recv_calloc(data->n, sizeof(int));
+    }
+    return data->recv_rows[sender];
+}
+
+// Rebuilds each entry of a value-delta frame from the receive row for its sender and
+// max-merges it into vt. A malformed or out-of-sequence frame is ignored as a whole.
+static void compressed_apply_value_delta(CompressedClockData *data, ClockDigest *digest, const void *buffer,
+                                         size_t size) {
+    int n = data->n;
+    int count = ((const int*)buffer)[0] & COMPRESSED_COUNT_MASK;
+    const uint8_t *in = (const uint8_t*)buffer + sizeof(int);
+    size_t avail = size - sizeof(int);
+    uint64_t sender, seq, gap, delta;
+    
+    size_t pos = wire_get_uvarint(in, avail, &sender);
+    if (!pos || sender >= (uint64_t)n || count > n) return;
+    size_t used = wire_get_uvarint(in + pos, avail - pos, &seq);
+    if (!used) return;
+    pos += used;
+    if (seq != 0 && (!data->recv_rows || !data->recv_rows[sender] || data->recv_seq[sender] != seq)) {
+        return;
+    }
+    
+    // Validate the entries first, as for the other encodings
+    size_t entries = pos;
+    long long pid = -1;
+    for (int i = 0; i < count; i++) {
+        used = wire_get_uvarint(in + pos, avail - pos, &gap);
+        if (!used || gap >= (uint64_t)n) return;
+        pos += used;
+        pid += (long long)gap + 1;
+        if (pid >= n) return;
+        used = wire_get_uvarint(in + pos, avail - pos, &delta);
+        if (!used) return;
+        pos += used;
+    }
+    
+    int *row = recv_row(data, (int)sender);
+    if (seq == 0) {
+        memset(row, 0, n * sizeof(int));
+    }
+    pos = entries;
+    pid = -1;
+    for (int i = 0; i < count; i++) {
+        pos += wire_get_uvarint(in + pos, avail - pos, &gap);
+        pos += wire_get_uvarint(in + pos, avail - pos, &delta);
+        pid += (long long)gap + 1;
+        
+        int value = row[pid] + (int)wire_zigzag_decode(delta);
+        row[pid] = value;
+        if (value > data->vt[pid]) {
+            compressed_raise(data, digest, (int)pid, value);
+        }
+    }
+    data->recv_seq[sender] = (unsigned)seq + 1;
+}
+
+void compressed_copy_receive_state(Timestamp *ts, const Timestamp *receiver, int sender) {
+    const CompressedClockData *src = (const CompressedClockData*)receiver->data;
     CompressedClockData *data = (CompressedClockData*)ts->data;
-    data->vt[ts->pid]++;
+    if (!src->recv_rows || !src->recv_rows[sender]) return;
+    
+    memcpy(recv_row(data, sender), src->recv_rows[sender], data->n * sizeof(int));
+    data->recv_seq[sender] = src->recv_seq[sender];
 }
 
 void compressed_merge(Timestamp *dst, const void *other_data, size_t other_size) {
@@ -62,34 +415,47 @@ void compressed_merge(Timestamp *dst, const void *other_data, size_t other_size)
     
     if (other_size == dst->n * sizeof(int)) {
         // Full vector format (for compatibility with other clock types)
-        const int *other_vt = (const int*)other_data;
-        for (int i = 0; i < dst->n; i++) {
-            if (other_vt[i] > dst_data->vt[i]) {
-                dst_data->vt[i] = other_vt[i];
-            }
-        }
+        compressed_apply_full(dst_data, &dst->digest, (const int*)other_data);
+    } else if (compressed_is_value_delta(other_data, other_size)) {
+        compressed_apply_value_delta(dst_data, &dst->digest, other_data, other_size);
     } else {
-        // Compressed format: [count, (index1, value1), (index2, value2), ...]
-        const int *buf = (const int*)other_data;
-        if (other_size >= sizeof(int)) {
-            int count = buf[0];
-            
-            // Ensure we have enough data for all pairs
-            if (other_size >= (1 + 2 * count) * sizeof(int)) {
-                for (int i = 0; i < count; i++) {
-                    int index = buf[1 + i * 2];
-                    int value = buf[1 + i * 2 + 1];
-                    
-                    if (index >= 0 && index < dst->n && value > dst_data->vt[index]) {
-                        dst_data->vt[index] = value;
-                    }
-                }
-            }
-        }
+        // Tagged delta format: pairs, bitmap or runs
+        compressed_apply_delta(dst_data, &dst->digest, other_data, other_size);
     }
     
     // Increment local clock after merge (handles increment internally like differential clocks)
-    dst_data->vt[dst->pid]++;
+    compressed_increment(dst);
+}
+
+// Value-delta frames are decoded against the receive rows, so they are merged in order
+int compressed_gather(const Timestamp *ts, const void *other_data, size_t other_size, ClockGather *g) {
+    if (other_size == ts->n * sizeof(int)) {
+        clock_gather_vector(g, (const int*)other_data, ts->n);
+        return 1;
+    }
+    if (compressed_is_value_delta(other_data, other_size)) {
+        return 0;
+    }
+    // The clock does not change until it settles, so entries it already has are dropped
+    // here; data is only read
+    compressed_walk_delta(ts->n, other_data, other_size, (CompressedClockData*)ts->data, NULL, g,
+                          NULL, NULL);
+    return 1;
+}
+
+void compressed_fold(Timestamp *ts, const ClockGather *g, int ticks) {
+    CompressedClockData *data = (CompressedClockData*)ts->data;
+    if (g->dense) {
+        compressed_apply_full(data, &ts->digest, g->acc);
+    } else {
+        for (int i = 0; i < g->count; i++) {
+            int k = g->touched[i];
+            if (g->acc[k] > data->vt[k]) {
+                compressed_raise(data, &ts->digest, k, g->acc[k]);
+            }
+        }
+    }
+    compressed_advance(ts, ticks);
 }
 
 TSOrder compressed_compare(const Timestamp *a, const Timestamp *b) {
@@ -97,71 +463,174 @@ TSOrder compressed_compare(const Timestamp *a, const Timestamp *b) {
     const CompressedClockData *b_data = (const CompressedClockData*)b->data;
     
     // Compare the underlying vector clocks
-    int a_le_b = 1, b_le_a = 1;
-    int a_lt_b = 0, b_lt_a = 0;
-    
-    for (int i = 0; i < a->n; i++) {
-        if (a_data->vt[i] > b_data->vt[i]) {
-            a_le_b = 0;
-            b_lt_a = 1;
-        }
-        if (b_data->vt[i] > a_data->vt[i]) {
-            b_le_a = 0;
-            a_lt_b = 1;
-        }
-    }
-    
-    if (a_le_b && b_le_a) return TS_EQUAL;
-    if (a_le_b && a_lt_b) return TS_BEFORE;
-    if (b_le_a && b_lt_a) return TS_AFTER;
-    return TS_CONCURRENT;
+    return vk_compare(a_data->vt, b_data->vt, a->n);
 }
 
 // Core compression algorithm - implements the exact algorithm described
 size_t compressed_serialize_for_dest(const Timestamp *ts, int dest, void *buffer, size_t bufsize) {
     CompressedClockData *data = (CompressedClockData*)ts->data;
+    const int *vt = data->vt;
+    int row = data->row_of[dest];
+    int n = data->n;
+    int words = COMPRESSED_DIRTY_WORDS(n);
+    size_t full_size = n * sizeof(int);
+    
+    // An evicted destination's last state is unknown, so it gets the full vector (with value
+    // deltas, a sequence-0 frame against all zeros instead)
+    if (row == COMPRESSED_ROW_EVICTED && !data->value_deltas) {
+        if (bufsize >= full_size) {
+            memcpy(buffer, vt, full_size);
+            memcpy(tau_acquire(data, dest), vt, full_size);
+            memset(dirty_row(data, data->row_of[dest]), 0, words * sizeof(uint64_t));
+        }
+        return full_size;
+    }
+    
+    // Size queries must not claim or evict rows, so a destination without one is compared
+    // against all zeros through a scratch bitset and only gets its row once written
+    const int *tau = row >= 0 ? data->tau + (size_t)row * n : NULL;
+    uint64_t *dirty;
+    if (tau) {
+        dirty = dirty_row(data, row);
+    } else {
+        dirty = (uint64_t*)calloc(words, sizeof(uint64_t));
+        for (int k = 0; k < n; k++) {
+            if (vt[k]) dirty[k / 64] |= 1ULL << (k % 64);
+        }
+    }
+    #define TAU(k) (tau ? tau[k] : 0)
     
     // Note: Clock increment is handled by simulation framework before this call
-    // Step 1: Find the diffs - compare current vt with tau[dest]
+    // Step 1: Find the diffs - visit the dirty bits only, dropping entries that are back in
+    // sync with tau[dest], and count changed runs too
     int diff_count = 0;
-    for (int k = 0; k < data->n; k++) {
-        if (data->tau[dest][k] != data->vt[k]) {
-            diff_count++;
-        }
-    }
-    
-    // Step 2: Calculate size for compressed vs full format
-    size_t compressed_size = (1 + 2 * diff_count) * sizeof(int);
-    size_t full_size = data->n * sizeof(int);
-    
-    // Use compression only if it's actually smaller or equal
-    if (compressed_size <= full_size && diff_count > 0) {
-        // Use compressed format
-        if (bufsize >= compressed_size) {
-            int *buf = (int*)buffer;
-            buf[0] = diff_count;  // Number of changed entries
-            
-            int buf_idx = 1;
-            for (int k = 0; k < data->n; k++) {
-                if (data->tau[dest][k] != data->vt[k]) {
-                    buf[buf_idx++] = k;                // index
-                    buf[buf_idx++] = data->vt[k];      // current value
+    int run_count = 0;
+    uint64_t carry = 0;
+    for (int w = 0; w < words; w++) {
+        uint64_t bits = dirty[w];
+        for (uint64_t b = bits; b; b &= b - 1) {
+            int k = w * 64 + __builtin_ctzll(b);
+            if (TAU(k) == vt[k]) bits &= ~(1ULL << (k % 64));
+        }
+        dirty[w] = bits;
+        diff_count += __builtin_popcountll(bits);
+        run_count += __builtin_popcountll(bits & ~((bits << 1) | carry));
+        carry = bits >> 63;
+    }
+    
+    // Step 2: Size every encoding (in ints) and pick the smallest
+    size_t pairs_words = 1 + 2 * (size_t)diff_count;
+    size_t bitmap_words = 1 + BITMAP_WORDS(n) + (size_t)diff_count;
+    size_t runs_words = 1 + 2 * (size_t)run_count + (size_t)diff_count;
+    
+    CompressedEncoding encoding = COMPRESSED_ENC_PAIRS;
+    size_t best_words = pairs_words;
+    if (runs_words < best_words) {
+        encoding = COMPRESSED_ENC_RUNS;
+        best_words = runs_words;
+    }
+    if (bitmap_words < best_words) {
+        encoding = COMPRESSED_ENC_BITMAP;
+        best_words = bitmap_words;
+    }
+    
+    // A delta must be strictly shorter than n ints, since n ints always means the full vector
+    int full = diff_count == 0 || best_words >= (size_t)n;
+    size_t required = full ? full_size : best_words * sizeof(int);
+    
+    // With value deltas every send is a value-delta frame, so the receiver's copy of
+    // tau[dest] never falls out of step; a frame of exactly n ints gets a pad byte
+    unsigned seq = tau ? data->sent_seq[row] : 0;
+    if (data->value_deltas) {
+        encoding = COMPRESSED_ENC_VALUE_DELTA;
+        full = 0;
+        required = sizeof(int) + wire_uvarint_size(ts->pid) + wire_uvarint_size(seq);
+        int last = -1;
+        for (int k = next_dirty(dirty, words, 0); k >= 0; k = next_dirty(dirty, words, k + 1)) {
+            required += wire_uvarint_size(k - last - 1) +
+                        wire_uvarint_size(wire_zigzag_encode((int64_t)vt[k] - TAU(k)));
+            last = k;
+        }
+        if (required == full_size) required++;
+    }
+    if (bufsize < required) {
+        if (!tau) free(dirty);
+        return required;
+    }
+    
+    int *buf = (int*)buffer;
+    int pos = 1;
+    if (full) {
+        memcpy(buffer, vt, full_size);
+    } else switch (encoding) {
+        case COMPRESSED_ENC_PAIRS:
+            buf[0] = diff_count;
+            for (int k = next_dirty(dirty, words, 0); k >= 0; k = next_dirty(dirty, words, k + 1)) {
+                buf[pos++] = k;        // index
+                buf[pos++] = vt[k];    // current value
+            }
+            break;
+        case COMPRESSED_ENC_BITMAP: {
+            buf[0] = (COMPRESSED_ENC_BITMAP << COMPRESSED_TAG_SHIFT) | diff_count;
+            unsigned *bitmap = (unsigned*)(buf + 1);
+            memset(bitmap, 0, BITMAP_WORDS(n) * sizeof(int));
+            pos += BITMAP_WORDS(n);
+            for (int k = next_dirty(dirty, words, 0); k >= 0; k = next_dirty(dirty, words, k + 1)) {
+                bitmap[k / 32] |= 1u << (k % 32);
+                buf[pos++] = vt[k];
+            }
+            break;
+        }
+        case COMPRESSED_ENC_RUNS: {
+            buf[0] = (COMPRESSED_ENC_RUNS << COMPRESSED_TAG_SHIFT) | run_count;
+            int header = -1, last = -2;
+            for (int k = next_dirty(dirty, words, 0); k >= 0; k = next_dirty(dirty, words, k + 1)) {
+                if (k != last + 1) {
+                    header = pos;
+                    buf[header] = k;
+                    buf[header + 1] = 0;
+                    pos += 2;
                 }
+                buf[header + 1]++;
+                buf[pos++] = vt[k];
+                last = k;
             }
-            
-            // Step 3: Remember what you sent - set tau[dest] := vt
-            memcpy(data->tau[dest], data->vt, data->n * sizeof(int));
+            break;
         }
-        return compressed_size;
-    } else {
-        // Use full format (more efficient)
-        if (bufsize >= full_size) {
-            memcpy(buffer, data->vt, full_size);
-            // Step 3: Remember what you sent - set tau[dest] := vt
-            memcpy(data->tau[dest], data->vt, data->n * sizeof(int));
+        case COMPRESSED_ENC_VALUE_DELTA: {
+            buf[0] = (COMPRESSED_ENC_VALUE_DELTA << COMPRESSED_TAG_SHIFT) | diff_count;
+            uint8_t *out = (uint8_t*)buffer;
+            size_t used = sizeof(int);
+            used += wire_put_uvarint(out + used, ts->pid);
+            used += wire_put_uvarint(out + used, seq);
+            int last = -1;
+            for (int k = next_dirty(dirty, words, 0); k >= 0; k = next_dirty(dirty, words, k + 1)) {
+                used += wire_put_uvarint(out + used, k - last - 1);
+                used += wire_put_uvarint(out + used, wire_zigzag_encode((int64_t)vt[k] - TAU(k)));
+                last = k;
+            }
+            if (used < required) out[used] = 0;  // pad byte
+            break;
         }
-        return full_size;
     }
+    
+    // Step 3: Remember what you sent - set tau[dest] := vt, touching only the dirty
+    // entries of a row that already existed
+    if (tau) {
+        int *row_tau = tau_acquire(data, dest);
+        for (int k = next_dirty(dirty, words, 0); k >= 0; k = next_dirty(dirty, words, k + 1)) {
+            row_tau[k] = vt[k];
+        }
+        memset(dirty, 0, words * sizeof(uint64_t));
+    } else {
+        free(dirty);
+        memcpy(tau_acquire(data, dest), vt, full_size);
+    }
+    if (data->value_deltas) {
+        data->sent_seq[data->row_of[dest]] = seq + 1;
+    }
+    #undef TAU
+    return required;
 }
 
 size_t compressed_serialize(const Timestamp *ts, void *buffer, size_t bufsize) {
@@ -180,29 +649,12 @@ void compressed_deserialize(Timestamp *ts, const void *buffer, size_t size) {
     
     if (size == ts->n * sizeof(int)) {
         // Full vector format
-        const int *full_vt = (const int*)buffer;
-        for (int i = 0; i < ts->n; i++) {
-            if (full_vt[i] > data->vt[i]) {
-                data->vt[i] = full_vt[i];
-            }
-        }
+        compressed_apply_full(data, &ts->digest, (const int*)buffer);
+    } else if (compressed_is_value_delta(buffer, size)) {
+        compressed_apply_value_delta(data, &ts->digest, buffer, size);
     } else {
-        // Compressed format: [count, (index1, value1), (index2, value2), ...]
-        const int *buf = (const int*)buffer;
-        if (size >= sizeof(int)) {
-            int count = buf[0];
-            
-            if (size >= (1 + 2 * count) * sizeof(int)) {
-                for (int i = 0; i < count; i++) {
-                    int index = buf[1 + i * 2];
-                    int value = buf[1 + i * 2 + 1];
-                    
-                    if (index >= 0 && index < ts->n && value > data->vt[index]) {
-                        data->vt[index] = value;
-                    }
-                }
-            }
-        }
+        // Tagged delta format: pairs, bitmap or runs
+        compressed_apply_delta(data, &ts->digest, buffer, size);
     }
 }
 
@@ -214,30 +666,92 @@ void compressed_to_string(const Timestamp *ts, char *buf, size_t bufsize) {
     for (int i = 0; i < ts->n; i++) {
         used += snprintf(buf + used, bufsize - used, "%s%d", 
                         (i ? "," : ""), data->vt[i]);
-        if (used >= bufsize) break;
+        if (used >= bufsize) return;  // truncated
     }
     snprintf(buf + used, bufsize - used, "]");
 }
 
-Timestamp compressed_clone(const Timestamp *ts) {
-    Timestamp out = compressed_create(ts->n, ts->pid, ts->type);
+Timestamp compressed_clone_in(ClockArena *arena, const Timestamp *ts) {
+    Timestamp out = compressed_create_in(arena, ts->n, ts->pid, ts->type);
     const CompressedClockData *src_data = (const CompressedClockData*)ts->data;
     CompressedClockData *dst_data = (CompressedClockData*)out.data;
     
     // Copy vector clock
     memcpy(dst_data->vt, src_data->vt, ts->n * sizeof(int));
+    out.digest = ts->digest;
     
-    // Copy tau matrix
-    for (int j = 0; j < ts->n; j++) {
-        memcpy(dst_data->tau[j], src_data->tau[j], ts->n * sizeof(int));
+    // Copy the tracked rows and their LRU order, keeping the source's K
+    dst_data->max_rows = src_data->max_rows;
+    while (dst_data->rows_alloc < src_data->rows_used) {
+        tau_grow(dst_data);
+    }
+    if (src_data->rows_used) {
+        memcpy(dst_data->tau, src_data->tau, (size_t)src_data->rows_used * ts->n * sizeof(int));
+        memcpy(dst_data->dirty, src_data->dirty,
+               (size_t)src_data->rows_used * COMPRESSED_DIRTY_WORDS(ts->n) * sizeof(uint64_t));
+        memcpy(dst_data->dest_of, src_data->dest_of, src_data->rows_used * sizeof(int));
+        memcpy(dst_data->last_used, src_data->last_used, src_data->rows_used * sizeof(unsigned));
+        memcpy(dst_data->sent_seq, src_data->sent_seq, src_data->rows_used * sizeof(unsigned));
+    }
+    memcpy(dst_data->row_of, src_data->row_of, ts->n * sizeof(int));
+    dst_data->rows_used = src_data->rows_used;
+    dst_data->use_clock = src_data->use_clock;
+    dst_data->evictions = src_data->evictions;
+    dst_data->value_deltas = src_data->value_deltas;
+    for (int j = 0; src_data->recv_rows && j < ts->n; j++) {
+        compressed_copy_receive_state(&out, ts, j);
     }
     
     return out;
 }
 
+Timestamp compressed_clone(const Timestamp *ts) {
+    return compressed_clone_in(NULL, ts);
+}
+
+void compressed_to_vector(const Timestamp *ts, int *out) {
+    const CompressedClockData *data = (const CompressedClockData*)ts->data;
+    memcpy(out, data->vt, ts->n * sizeof(int));
+}
+
+/* ---------- Destination State ---------- */
+
+int* compressed_tau_row(Timestamp *ts, int dest) {
+    CompressedClockData *data = (CompressedClockData*)ts->data;
+    int *row = tau_acquire(data, dest);
+    
+    // The caller may write the row: mark all n entries for rechecking
+    uint64_t *dirty = dirty_row(data, data->row_of[dest]);
+    int words = COMPRESSED_DIRTY_WORDS(data->n);
+    memset(dirty, 0xFF, words * sizeof(uint64_t));
+    if (data->n % 64) {
+        dirty[words - 1] = (1ULL << (data->n % 64)) - 1;
+    }
+    return row;
+}
+
+size_t compressed_tau_bytes(const Timestamp *ts) {
+    const CompressedClockData *data = (const CompressedClockData*)ts->data;
+    size_t per_row = data->n * sizeof(int) + COMPRESSED_DIRTY_WORDS(data->n) * sizeof(uint64_t)
+                     + sizeof(int) + 2 * sizeof(unsigned);
+    size_t bytes = (size_t)data->rows_alloc * per_row + data->n * sizeof(int);
+    
+    if (data->recv_rows) {
+        bytes += data->n * (sizeof(int*) + sizeof(unsigned));
+        for (int j = 0; j < data->n; j++) {
+            if (data->recv_rows[j]) bytes += data->n * sizeof(int);
+        }
+    }
+    return bytes;
+}
+
+int compressed_evictions(const Timestamp *ts) {
+    return ((const CompressedClockData*)ts->data)->evictions;
+}
+
 /* ---------- Operations Table ---------- */
 
-TimestampOps COMPRESSED_OPS = {
+const TimestampOps COMPRESSED_OPS = {
     .create = compressed_create,
     .destroy = compressed_destroy,
     .increment = compressed_increment,
@@ -247,5 +761,11 @@ TimestampOps COMPRESSED_OPS = {
     .serialize_for_dest = compressed_serialize_for_dest,
     .deserialize = compressed_deserialize,
     .to_string = compressed_to_string,
-    .clone = compressed_clone
+    .clone = compressed_clone,
+    .to_vector = compressed_to_vector,
+    .create_in = compressed_create_in,
+    .clone_in = compressed_clone_in,
+    .merge_and_tick = compressed_merge,  // merge records the receive event itself
+    .gather = compressed_gather,
+    .fold = compressed_fold
 };
\ No newline at end of file
@@ -0,0 +1,280 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "counter_store.h"
+#include "vector_kernels.h"
+
+/* ---------- Widths ---------- */
+
+// Every loop below is stamped out once per width
+#define FOR_EACH_WIDTH(X) X(1, uint8_t) X(2, uint16_t) X(4, uint32_t) X(8, uint64_t)
+
+static int width_index(int width) {
+    switch (width) {
+        case 1: return 0;
+        case 2: return 1;
+        case 4: return 2;
+        case 8: return 3;
+        default:
+            fprintf(stderr, "Invalid counter width: %d\n", width);
+            exit(1);
+    }
+}
+
+int counter_width_for(uint64_t value) {
+    if (value <= UINT8_MAX) return 1;
+    if (value <= UINT16_MAX) return 2;
+    if (value <= INT32_MAX) return 4;
+    return 8;
+}
+
+uint64_t counter_get(const void *cells, int width, int i) {
+    switch (width) {
+        case 1: return ((const uint8_t*)cells)[i];
+        case 2: return ((const uint16_t*)cells)[i];
+        case 4: return ((const uint32_t*)cells)[i];
+        default: return ((const uint64_t*)cells)[i];
+    }
+}
+
+void counter_set(void *cells, int width, int i, uint64_t value) {
+    switch (width) {
+        case 1: ((uint8_t*)cells)[i] = (uint8_t)value; break;
+        case 2: ((uint16_t*)cells)[i] = (uint16_t)value; break;
+        case 4: ((uint32_t*)cells)[i] = (uint32_t)value; break;
+        default: ((uint64_t*)cells)[i] = value; break;
+    }
+}
+
+/* ---------- Per-Width Loops ---------- */
+
+// Loops run over fixed-size blocks with a scalar tail: a constant trip count is what lets
+// -O2's vectorizer take them, and compare checks for an early exit once per block
+#define COUNTER_BLOCK 64
+
+// Always inlined, so the fixed-n entry points below get their own copy with n constant
+#ifdef __GNUC__
+#define COUNTER_KERNEL static inline __attribute__((always_inline))
+#else
+#define COUNTER_KERNEL static inline
+#endif
+
+#define DEFINE_WIDTH_KERNELS(W, T)                                              \
+    COUNTER_KERNEL uint64_t max_##W(const void *cells, int n) {                 \
+        const T *c = (const T*)cells;                                           \
+        T best = 0;                                                             \
+        int i = 0;                                                              \
+        for (; i + COUNTER_BLOCK <= n; i += COUNTER_BLOCK) {                    \
+            for (int j = 0; j < COUNTER_BLOCK; j++) {                           \
+                best = c[i + j] > best ? c[i + j] : best;                       \
+            }                                                                   \
+        }                                                                       \
+        for (; i < n; i++) best = c[i] > best ? c[i] : best;                    \
+        return best;                                                            \
+    }                                                                           \
+    static inline T from_i32_##W(int32_t v) {                                   \
+        return (T)(v > 0 ? v : 0);                                              \
+    }                                                                           \
+    static inline T from_u64_##W(uint64_t v) {                                  \
+        return (T)v;                                                            \
+    }                                                                           \
+    /* The per-block flags are T-wide so narrow counters fill whole vectors */   \
+    COUNTER_KERNEL TSOrder compare_##W(const void *a, const void *b, int n) {   \
+        const T *x = (const T*)a;                                               \
+        const T *y = (const T*)b;                                               \
+        int a_gt = 0, b_gt = 0;                                                 \
+        int i = 0;                                                              \
+        for (; i + COUNTER_BLOCK <= n; i += COUNTER_BLOCK) {                    \
+            T x_over = 0, y_over = 0;                                           \
+            for (int j = 0; j < COUNTER_BLOCK; j++) {                           \
+                x_over |= (T)(x[i + j] > y[i + j]);                             \
+                y_over |= (T)(y[i + j] > x[i + j]);                             \
+            }                                                                   \
+            a_gt |= x_over != 0;                                                \
+            b_gt |= y_over != 0;                                                \
+            if (a_gt && b_gt) return TS_CONCURRENT;                             \
+        }                                                                       \
+        for (; i < n; i++) {                                                    \
+            a_gt |= x[i] > y[i];                                                \
+            b_gt |= y[i] > x[i];                                                \
+        }                                                                       \
+        if (a_gt && b_gt) return TS_CONCURRENT;                                 \
+        if (a_gt) return TS_AFTER;                                              \
+        return b_gt ? TS_BEFORE : TS_EQUAL;                                     \
+    }
+FOR_EACH_WIDTH(DEFINE_WIDTH_KERNELS)
+
+// dst[i] = max(dst[i], CONV(src[i])), raising each grown entry in the digest. A block is
+// first checked for a larger source entry in one vectorizable pass; only blocks that have
+// one get the per-entry pass, so a merge that brings nothing new stays a single pass.
+#define DEFINE_MERGE_KERNEL(W, T, NAME, S, CONV)                                \
+    static void NAME##_raise_##W(T *d, const S *src, int lo, int hi, ClockDigest *digest) { \
+        for (int k = lo; k < hi; k++) {                                         \
+            T v = CONV(src[k]);                                                 \
+            if (v > d[k]) {                                                     \
+                clock_digest_raise(digest, k, d[k], v);                         \
+                d[k] = v;                                                       \
+            }                                                                   \
+        }                                                                       \
+    }                                                                           \
+    COUNTER_KERNEL void NAME##_##W(void *dst, const S *src, int n, ClockDigest *digest) { \
+        T *d = (T*)dst;                                                         \
+        int i = 0;                                                              \
+        for (; i + COUNTER_BLOCK <= n; i += COUNTER_BLOCK) {                    \
+            T grew = 0;                                                         \
+            for (int j = 0; j < COUNTER_BLOCK; j++) {                           \
+                grew |= (T)(CONV(src[i + j]) > d[i + j]);                       \
+            }                                                                   \
+            if (grew) NAME##_raise_##W(d, src, i, i + COUNTER_BLOCK, digest);   \
+        }                                                                       \
+        T grew = 0;                                                             \
+        for (int j = i; j < n; j++) {                                           \
+            grew |= (T)(CONV(src[j]) > d[j]);                                   \
+        }                                                                       \
+        if (grew) NAME##_raise_##W(d, src, i, n, digest);                       \
+    }
+#define DEFINE_MERGE_KERNELS(W, T)                                              \
+    DEFINE_MERGE_KERNEL(W, T, merge_i32, int32_t, from_i32_##W)                 \
+    DEFINE_MERGE_KERNEL(W, T, merge_u64, uint64_t, from_u64_##W)
+FOR_EACH_WIDTH(DEFINE_MERGE_KERNELS)
+
+#define DEFINE_COPY(DW, DT, SW, ST)                                             \
+    COUNTER_KERNEL void copy_##DW##_##SW(void *dst, const void *src, int n) {   \
+        DT *d = (DT*)dst;                                                       \
+        const ST *s = (const ST*)src;                                           \
+        for (int i = 0; i < n; i++) d[i] = (DT)s[i];                            \
+    }
+#define DEFINE_COPIES_TO(DW, DT) \
+    DEFINE_COPY(DW, DT, 1, uint8_t) DEFINE_COPY(DW, DT, 2, uint16_t) \
+    DEFINE_COPY(DW, DT, 4, uint32_t) DEFINE_COPY(DW, DT, 8, uint64_t)
+FOR_EACH_WIDTH(DEFINE_COPIES_TO)
+
+/* ---------- 32-Bit Cells ---------- */
+
+// 32-bit cells never hold more than INT32_MAX (counter_width_for), so they are valid ints
+// for the runtime-dispatched kernels of vector_kernels.h. A block is checked with one
+// vk_compare pass; one with a larger source entry is merged with vk_merge_max, and the
+// entries that grew, found against a copy of the old block, are raised in the digest.
+#define DISPATCH_BLOCK 1024
+
+static void merge_i32_dispatched(void *dst, const int32_t *src, int n, ClockDigest *digest) {
+    int *d = (int*)dst;
+    int old[DISPATCH_BLOCK];
+    for (int i = 0; i < n; i += DISPATCH_BLOCK) {
+        int len = n - i < DISPATCH_BLOCK ? n - i : DISPATCH_BLOCK;
+        TSOrder order = vk_compare(d + i, src + i, len);
+        if (order != TS_BEFORE && order != TS_CONCURRENT) continue;
+        memcpy(old, d + i, len * sizeof(int));
+        vk_merge_max(d + i, src + i, len);  // negative entries never beat a counter
+        for (int k = 0; k < len; k++) {
+            if (d[i + k] != old[k]) clock_digest_raise(digest, i + k, (uint64_t)old[k], (uint64_t)d[i + k]);
+        }
+    }
+}
+
+static TSOrder compare_dispatched(const void *a, const void *b, int n) {
+    return vk_compare((const int*)a, (const int*)b, n);
+}
+
+/* ---------- Dispatch Tables (indexed by width_index) ---------- */
+
+static uint64_t (*const max_kernels[4])(const void*, int) = {max_1, max_2, max_4, max_8};
+static void (*const merge_i32_kernels[4])(void*, const int32_t*, int, ClockDigest*) = {
+    merge_i32_1, merge_i32_2, merge_i32_dispatched, merge_i32_8
+};
+static void (*const merge_u64_kernels[4])(void*, const uint64_t*, int, ClockDigest*) = {
+    merge_u64_1, merge_u64_2, merge_u64_4, merge_u64_8
+};
+static TSOrder (*const compare_kernels[4])(const void*, const void*, int) = {
+    compare_1, compare_2, compare_dispatched, compare_8
+};
+static void (*const copy_kernels[4][4])(void*, const void*, int) = {
+    {copy_1_1, copy_1_2, copy_1_4, copy_1_8},
+    {copy_2_1, copy_2_2, copy_2_4, copy_2_8},
+    {copy_4_1, copy_4_2, copy_4_4, copy_4_8},
+    {copy_8_1, copy_8_2, copy_8_4, copy_8_8}
+};
+
+/* ---------- Public Interface ---------- */
+
+uint64_t counter_max(const void *cells, int width, int n) {
+    return max_kernels[width_index(width)](cells, n);
+}
+
+void counter_copy(void *dst, int dst_width, const void *src, int src_width, int n) {
+    copy_kernels[width_index(dst_width)][width_index(src_width)](dst, src, n);
+}
+
+void counter_merge_i32(void *dst, int dst_width, const int32_t *src, int n, ClockDigest *digest) {
+    merge_i32_kernels[width_index(dst_width)](dst, src, n, digest);
+}
+
+void counter_merge_u64(void *dst, int dst_width, const uint64_t *src, int n, ClockDigest *digest) {
+    merge_u64_kernels[width_index(dst_width)](dst, src, n, digest);
+}
+
+TSOrder counter_compare(const void *a, int a_width, const void *b, int b_width, int n) {
+    if (a_width == b_width) {
+        return compare_kernels[width_index(a_width)](a, b, n);
+    }
+
+    int a_gt = 0, b_gt = 0;
+    for (int i = 0; i < n && !(a_gt && b_gt); i++) {
+        uint64_t x = counter_get(a, a_width, i);
+        uint64_t y = counter_get(b, b_width, i);
+        a_gt |= x > y;
+        b_gt |= y > x;
+    }
+    if (a_gt && b_gt) return TS_CONCURRENT;
+    if (a_gt) return TS_AFTER;
+    return b_gt ? TS_BEFORE : TS_EQUAL;
+}
+
+/* ---------- Fixed-n Entry Points ---------- */
+
+// The per-width loops above with n a constant, for each n in FOR_EACH_FIXED_N
+#define COPY_CASES_TO(DW, N)                                                    \
+    switch (width_index(src_width)) {                                           \
+        case 0: copy_##DW##_1(dst, src, N); return;                             \
+        case 1: copy_##DW##_2(dst, src, N); return;                             \
+        case 2: copy_##DW##_4(dst, src, N); return;                             \
+        default: copy_##DW##_8(dst, src, N); return;                            \
+    }
+
+#define DEFINE_FIXED_N_KERNELS(N)                                               \
+    uint64_t counter_max_##N(const void *cells, int width) {                    \
+        switch (width_index(width)) {                                           \
+            case 0: return max_1(cells, N);                                     \
+            case 1: return max_2(cells, N);                                     \
+            case 2: return max_4(cells, N);                                     \
+            default: return max_8(cells, N);                                    \
+        }                                                                       \
+    }                                                                           \
+    void counter_copy_##N(void *dst, int dst_width, const void *src, int src_width) { \
+        switch (width_index(dst_width)) {                                       \
+            case 0: COPY_CASES_TO(1, N)                                         \
+            case 1: COPY_CASES_TO(2, N)                                         \
+            case 2: COPY_CASES_TO(4, N)                                         \
+            default: COPY_CASES_TO(8, N)                                        \
+        }                                                                       \
+    }                                                                           \
+    void counter_merge_i32_##N(void *dst, int dst_width, const int32_t *src, ClockDigest *digest) { \
+        switch (width_index(dst_width)) {                                       \
+            case 0: merge_i32_1(dst, src, N, digest); return;                   \
+            case 1: merge_i32_2(dst, src, N, digest); return;                   \
+            case 2: merge_i32_4(dst, src, N, digest); return;                   \
+            default: merge_i32_8(dst, src, N, digest); return;                  \
+        }                                                                       \
+    }                                                                           \
+    TSOrder counter_compare_##N(const void *a, int a_width, const void *b, int b_width) { \
+        if (a_width != b_width) {                                               \
+            return counter_compare(a, a_width, b, b_width, N);                  \
+        }                                                                       \
+        switch (width_index(a_width)) {                                         \
+            case 0: return compare_1(a, b, N);                                  \
+            case 1: return compare_2(a, b, N);                                  \
+            case 2: return compare_4(a, b, N);                                  \
+            default: return compare_8(a, b, N);                                 \
+        }                                                                       \
+    }
+FOR_EACH_FIXED_N(DEFINE_FIXED_N_KERNELS)
@@ -2,59 +2,99 @@
 #include <stdlib.h>
 #include <string.h>
 #include "differential_clock.h"
+#include "vector_kernels.h"
+
+/* ---------- Update Order ---------- */
+
+// Moves k to the newest end of the update list; call whenever LU[k] is set
+static void differential_touch(DifferentialClockData *data, int k) {
+    if (data->newest == k) return;
+    
+    // Unlink
+    if (data->prev[k] >= 0) data->next[data->prev[k]] = data->next[k];
+    else data->oldest = data->next[k];
+    data->prev[data->next[k]] = data->prev[k];  // k is not the newest, so next[k] exists
+    
+    // Append
+    data->prev[k] = data->newest;
+    data->next[k] = -1;
+    data->next[data->newest] = k;
+    data->newest = k;
+}
+
+// v[k] grows to a received value
+static void differential_raise(Timestamp *ts, DifferentialClockData *data, int k, int value) {
+    clock_digest_raise(&ts->digest, k, data->v[k], value);
+    data->v[k] = value;
+    // Update LU[k] = vt[j] + 1 (next logical time when entry k will be updated)
+    data->LU[k] = data->v[ts->pid] + 1;
+    differential_touch(data, k);
+}
 
 /* ---------- Differential Vector Clock Implementation (Singhal-Kshemkalyani) ---------- */
 
-Timestamp differential_create(int n, int pid, ClockType type) {
+Timestamp differential_create_in(ClockArena *arena, int n, int pid, ClockType type) {
     Timestamp ts;
     ts.n = n;
     ts.pid = pid;
     ts.type = type;
+    clock_digest_reset(&ts.digest);
     
-    DifferentialClockData *data = malloc(sizeof(DifferentialClockData));
-    data->v = (int*)calloc(n, sizeof(int));
-    data->LS = (int*)calloc(n, sizeof(int));  // LS[j] = v[pid] when last sent to process j
-    data->LU = (int*)calloc(n, sizeof(int));  // LU[k] = v[pid] when entry k was last updated
+    // Header followed by the five arrays of n ints, in one zeroed block
+    size_t header = CLOCK_BLOCK_ROUND(sizeof(DifferentialClockData));
+    DifferentialClockData *data = clock_block_alloc(arena, header + 5 * n * sizeof(int));
+    data->v = (int*)((char*)data + header);
+    data->LS = data->v + n;   // LS[j] = v[pid] when last sent to process j
+    data->LU = data->LS + n;  // LU[k] = v[pid] when entry k was last updated
+    
+    // Nothing updated yet: any order of the all-zero LU entries is sorted
+    data->prev = data->LU + n;
+    data->next = data->prev + n;
+    for (int k = 0; k < n; k++) {
+        data->prev[k] = k - 1;
+        data->next[k] = k + 1 < n ? k + 1 : -1;
+    }
+    data->oldest = 0;
+    data->newest = n - 1;
     
     ts.data = data;
     ts.data_size = 0; // Dynamic size based on differences
     return ts;
 }
 
+Timestamp differential_create(int n, int pid, ClockType type) {
+    return differential_create_in(NULL, n, pid, type);
+}
+
 void differential_destroy(Timestamp *ts) {
     if (ts && ts->data) {
-        DifferentialClockData *data = (DifferentialClockData*)ts->data;
-        if (data->v) {
-            free(data->v);
-        }
-        if (data->LS) {
-            free(data->LS);
-        }
-        if (data->LU) {
-            free(data->LU);
-        }
-        free(ts->data);
+        clock_block_free(ts->data);
         ts->data = NULL;
     }
 }
 
-void differential_increment(Timestamp *ts) {
+// k local events at once
+static void differential_advance(Timestamp *ts, int k) {
     DifferentialClockData *data = (DifferentialClockData*)ts->data;
-    data->v[ts->pid] += 1;
+    clock_digest_raise(&ts->digest, ts->pid, data->v[ts->pid], data->v[ts->pid] + k);
+    data->v[ts->pid] += k;
     data->LU[ts->pid] = data->v[ts->pid]; // Update LU when this process's entry is modified
+    differential_touch(data, ts->pid);
+}
+
+void differential_increment(Timestamp *ts) {
+    differential_advance(ts, 1);
 }
 
 void differential_merge(Timestamp *dst, const void *other_data, size_t other_size) {
     DifferentialClockData *dst_data = (DifferentialClockData*)dst->data;
     
     if (other_size == dst->n * sizeof(int)) {
-        // Full vector format (for compatibility)
+        // Full vector format; pair lists are always shorter than n ints
         const int *other_v = (const int*)other_data;
         for (int i = 0; i < dst->n; i++) {
             if (other_v[i] > dst_data->v[i]) {
-                dst_data->v[i] = other_v[i];
-                // Update LU[i] = vt[j] + 1 (next logical time when entry i will be updated)
-                dst_data->LU[i] = dst_data->v[dst->pid] + 1;
+                differential_raise(dst, dst_data, i, other_v[i]);
             }
         }
     } else {
@@ -67,67 +107,104 @@ void differential_merge(Timestamp *dst, const void *other_data, size_t other_siz
             int val = buf[i * 2 + 1]; // value
             
             if (k >= 0 && k < dst->n && val > dst_data->v[k]) {
-                dst_data->v[k] = val;
-                // Update LU[k] = vt[j] + 1 (next logical time when entry k will be updated)
-                dst_data->LU[k] = dst_data->v[dst->pid] + 1;
+                differential_raise(dst, dst_data, k, val);
             }
         }
     }
     
     // Increment own vector clock last (the receive event)
-    dst_data->v[dst->pid]++;
-    dst_data->LU[dst->pid] = dst_data->v[dst->pid];
+    differential_increment(dst);
 }
 
-TSOrder differential_compare(const Timestamp *a, const Timestamp *b) {
-    const DifferentialClockData *a_data = (const DifferentialClockData*)a->data;
-    const DifferentialClockData *b_data = (const DifferentialClockData*)b->data;
-    
-    // Compare the underlying vectors
-    int a_le_b = 1, b_le_a = 1;
-    int a_lt_b = 0, b_lt_a = 0;
+int differential_gather(const Timestamp *ts, const void *other_data, size_t other_size, ClockGather *g) {
+    const DifferentialClockData *data = (const DifferentialClockData*)ts->data;
+    const int *buf = (const int*)other_data;
+    // Same split as differential_merge: senders keep pair lists shorter than n ints
+    if (other_size == ts->n * sizeof(int)) {
+        clock_gather_vector(g, buf, ts->n);
+        return 1;
+    }
     
-    for (int i = 0; i < a->n; i++) {
-        if (a_data->v[i] > b_data->v[i]) {
-            a_le_b = 0;
-            b_lt_a = 1;
+    // The clock does not change until it settles, so entries it already has are dropped
+    int pair_count = other_size / (2 * sizeof(int));
+    for (int i = 0; i < pair_count; i++) {
+        int k = buf[i * 2];
+        if (k >= 0 && k < ts->n && buf[i * 2 + 1] > data->v[k]) {
+            clock_gather_entry(g, k, buf[i * 2 + 1]);
         }
-        if (b_data->v[i] > a_data->v[i]) {
-            b_le_a = 0;
-            a_lt_b = 1;
+    }
+    return 1;
+}
+
+void differential_fold(Timestamp *ts, const ClockGather *g, int ticks) {
+    DifferentialClockData *data = (DifferentialClockData*)ts->data;
+    int count = g->dense ? ts->n : g->count;
+    for (int i = 0; i < count; i++) {
+        int k = g->dense ? i : g->touched[i];
+        if (g->acc[k] > data->v[k]) {
+            differential_raise(ts, data, k, g->acc[k]);
         }
     }
+    differential_advance(ts, ticks);
+}
+
+TSOrder differential_compare(const Timestamp *a, const Timestamp *b) {
+    const DifferentialClockData *a_data = (const DifferentialClockData*)a->data;
+    const DifferentialClockData *b_data = (const DifferentialClockData*)b->data;
     
-    if (a_le_b && b_le_a) return TS_EQUAL;
-    if (a_le_b && a_lt_b) return TS_BEFORE;
-    if (b_le_a && b_lt_a) return TS_AFTER;
-    return TS_CONCURRENT;
+    // Compare the underlying vectors
+    return vk_compare(a_data->v, b_data->v, a->n);
+}
+
+static int compare_pids(const void *a, const void *b) {
+    return *(const int*)a - *(const int*)b;
 }
 
 // For differential technique, we need a special serialize function that
-// takes destination into account - implements true Singhal-Kshemkalyani algorithm
+// takes destination into account - implements true Singhal-Kshemkalyani algorithm.
+// Costs O(c log c) for the c entries sent, independent of n. From n/2 entries up the
+// pairs would be no shorter than the full vector, which is sent instead.
 size_t differential_serialize_for_dest(const Timestamp *ts, int dest, void *buffer, size_t bufsize) {
     DifferentialClockData *data = (DifferentialClockData*)ts->data;
+    int last_sent = data->LS[dest];
+    
+    // Calculate which entries to send: {(k, v[k]) | LS[dest] < LU[k] or k = pid}.
+    // Those with LS[dest] < LU[k] are exactly the newest end of the update list.
+    int send_count = data->LU[ts->pid] <= last_sent;  // pid is always sent
+    for (int k = data->newest; k >= 0 && data->LU[k] > last_sent; k = data->prev[k]) {
+        send_count++;
+    }
     
-    // Calculate which entries to send: {(k, v[k]) | LS[dest] < LU[k] or k = pid}
-    int send_count = 0;
-    for (int k = 0; k < ts->n; k++) {
-        if (data->LS[dest] < data->LU[k] || k == ts->pid) {
-            send_count++;
+    // A message of n ints always reads as the full vector, so a pair list is sent only
+    // while it is strictly shorter than one; otherwise the full vector goes, no larger
+    if (2 * send_count >= ts->n) {
+        size_t required = differential_serialize(ts, buffer, bufsize);
+        if (bufsize >= required) {
+            data->LS[dest] = data->v[ts->pid];
         }
+        return required;
     }
     
     // Store as pairs of (process_id, value)
     size_t required = send_count * 2 * sizeof(int);
     
     if (bufsize >= required) {
+        // Gather the pids into the upper half, sort them (the compact wire format wants
+        // ascending pids), then spread into pairs front to back
         int *buf = (int*)buffer;
+        int *pids = buf + send_count;
         int idx = 0;
-        for (int k = 0; k < ts->n; k++) {
-            if (data->LS[dest] < data->LU[k] || k == ts->pid) {
-                buf[idx++] = k;                // process id
-                buf[idx++] = data->v[k];       // current value
-            }
+        if (data->LU[ts->pid] <= last_sent) {
+            pids[idx++] = ts->pid;
+        }
+        for (int k = data->newest; k >= 0 && data->LU[k] > last_sent; k = data->prev[k]) {
+            pids[idx++] = k;
+        }
+        qsort(pids, send_count, sizeof(int), compare_pids);
+        for (int i = 0; i < send_count; i++) {
+            int k = pids[i];
+            buf[2 * i] = k;                // process id
+            buf[2 * i + 1] = data->v[k];   // current value
         }
         // Update LS[dest] = current vector time after successful serialization
         data->LS[dest] = data->v[ts->pid];
@@ -155,9 +232,7 @@ void differential_deserialize(Timestamp *ts, const void *buffer, size_t size) {
         const int *full_v = (const int*)buffer;
         for (int i = 0; i < ts->n; i++) {
             if (full_v[i] > data->v[i]) {
-                data->v[i] = full_v[i];
-                // Update LU for changed components (next logical time)
-                data->LU[i] = data->v[ts->pid] + 1;
+                differential_raise(ts, data, i, full_v[i]);
             }
         }
     } else {
@@ -170,9 +245,7 @@ void differential_deserialize(Timestamp *ts, const void *buffer, size_t size) {
             int value = buf[i * 2 + 1]; // Extracts value from odd index
             if (pid >= 0 && pid < ts->n) {
                 if (value > data->v[pid]) {
-                    data->v[pid] = value;
-                    // Update LU when component is updated (next logical time)
-                    data->LU[pid] = data->v[ts->pid] + 1;
+                    differential_raise(ts, data, pid, value);
                 }
             }
         }
@@ -187,26 +260,110 @@ void differential_to_string(const Timestamp *ts, char *buf, size_t bufsize) {
     for (int i = 0; i < ts->n; i++) {
         used += snprintf(buf + used, bufsize - used, "%s%d", 
                         (i ? "," : ""), data->v[i]);
-        if (used >= bufsize) break;
+        if (used >= bufsize) return;  // truncated
     }
     snprintf(buf + used, bufsize - used, "]");
 }
 
-Timestamp differential_clone(const Timestamp *ts) {
-    Timestamp out = differential_create(ts->n, ts->pid, ts->type);
+Timestamp differential_clone_in(ClockArena *arena, const Timestamp *ts) {
+    Timestamp out = differential_create_in(arena, ts->n, ts->pid, ts->type);
     const DifferentialClockData *src_data = (const DifferentialClockData*)ts->data;
     DifferentialClockData *dst_data = (DifferentialClockData*)out.data;
     
-    memcpy(dst_data->v, src_data->v, ts->n * sizeof(int));
-    memcpy(dst_data->LS, src_data->LS, ts->n * sizeof(int));
-    memcpy(dst_data->LU, src_data->LU, ts->n * sizeof(int));
+    // The arrays are contiguous: v, LS, LU, prev, next
+    memcpy(dst_data->v, src_data->v, 5 * ts->n * sizeof(int));
+    dst_data->oldest = src_data->oldest;
+    dst_data->newest = src_data->newest;
+    out.digest = ts->digest;
     
     return out;
 }
 
+Timestamp differential_clone(const Timestamp *ts) {
+    return differential_clone_in(NULL, ts);
+}
+
+void differential_to_vector(const Timestamp *ts, int *out) {
+    const DifferentialClockData *data = (const DifferentialClockData*)ts->data;
+    memcpy(out, data->v, ts->n * sizeof(int));
+}
+
+/* ---------- Fixed-n Kernels ---------- */
+
+// Full-vector merge, compare and serialize for exactly N entries on the fixed-n vector
+// kernels; pair messages take the generic merge. From DIFFERENTIAL_PRECHECK_MIN entries
+// up, the merge first checks whether the sender knows anything new before walking them.
+#define DIFFERENTIAL_PRECHECK_MIN 32
+
+#define DEFINE_DIFFERENTIAL_FIXED_N(N)                                         \
+    static void differential_merge_##N(Timestamp *dst, const void *other_data, size_t other_size) { \
+        if (other_size != N * sizeof(int)) {                                   \
+            differential_merge(dst, other_data, other_size);                   \
+            return;                                                            \
+        }                                                                      \
+        DifferentialClockData *dst_data = (DifferentialClockData*)dst->data;   \
+        const int *other_v = (const int*)other_data;                           \
+        int grew = 1;                                                          \
+        if (N >= DIFFERENTIAL_PRECHECK_MIN) {                                  \
+            grew = 0;                                                          \
+            for (int i = 0; i < N; i++) {                                      \
+                grew |= other_v[i] > dst_data->v[i];                           \
+            }                                                                  \
+        }                                                                      \
+        if (grew) {                                                            \
+            for (int i = 0; i < N; i++) {                                      \
+                if (other_v[i] > dst_data->v[i]) {                             \
+                    differential_raise(dst, dst_data, i, other_v[i]);          \
+                }                                                              \
+            }                                                                  \
+        }                                                                      \
+        differential_increment(dst);                                           \
+    }                                                                          \
+    static TSOrder differential_compare_##N(const Timestamp *a, const Timestamp *b) { \
+        const DifferentialClockData *a_data = (const DifferentialClockData*)a->data; \
+        const DifferentialClockData *b_data = (const DifferentialClockData*)b->data; \
+        return vk_compare_##N(a_data->v, b_data->v);                           \
+    }                                                                          \
+    static size_t differential_serialize_##N(const Timestamp *ts, void *buffer, size_t bufsize) { \
+        const DifferentialClockData *data = (const DifferentialClockData*)ts->data; \
+        if (bufsize >= N * sizeof(int)) {                                      \
+            memcpy(buffer, data->v, N * sizeof(int));                          \
+        }                                                                      \
+        return N * sizeof(int);                                                \
+    }                                                                          \
+    static const TimestampOps DIFFERENTIAL_OPS_##N = {                         \
+        .create = differential_create,                                         \
+        .destroy = differential_destroy,                                       \
+        .increment = differential_increment,                                   \
+        .merge = differential_merge_##N,                                       \
+        .compare = differential_compare_##N,                                   \
+        .serialize = differential_serialize_##N,                               \
+        .serialize_for_dest = differential_serialize_for_dest,                 \
+        .deserialize = differential_deserialize,                               \
+        .to_string = differential_to_string,                                   \
+        .clone = differential_clone,                                           \
+        .to_vector = differential_to_vector,                                   \
+        .create_in = differential_create_in,                                   \
+        .clone_in = differential_clone_in,                                     \
+        .merge_and_tick = differential_merge_##N,                              \
+        .specialize = differential_specialize,                                 \
+        .gather = differential_gather,                                         \
+        .fold = differential_fold                                              \
+    };
+FOR_EACH_FIXED_N(DEFINE_DIFFERENTIAL_FIXED_N)
+
+#define DIFFERENTIAL_FIXED_CASE(N) case N: return &DIFFERENTIAL_OPS_##N;
+
+const TimestampOps *differential_specialize(int n) {
+    switch (n) {
+        FOR_EACH_FIXED_N(DIFFERENTIAL_FIXED_CASE)
+        default: return NULL;
+    }
+}
+
 /* ---------- Operations Table ---------- */
 
-TimestampOps DIFFERENTIAL_OPS = {
+const TimestampOps DIFFERENTIAL_OPS = {
     .create = differential_create,
     .destroy = differential_destroy,
     .increment = differential_increment,
@@ -216,5 +373,12 @@ TimestampOps DIFFERENTIAL_OPS = {
     .serialize_for_dest = differential_serialize_for_dest,
     .deserialize = differential_deserialize,
     .to_string = differential_to_string,
-    .clone = differential_clone
+    .clone = differential_clone,
+    .to_vector = differential_to_vector,
+    .create_in = differential_create_in,
+    .clone_in = differential_clone_in,
+    .merge_and_tick = differential_merge,  // merge records the receive event itself
+    .specialize = differential_specialize,
+    .gather = differential_gather,
+    .fold = differential_fold
 };
\ No newline at end of file
@@ -1,30 +1,636 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <pthread.h>
 #include "encoded_clock.h"
+#include "vector_kernels.h"
+
+/* ---------- Fixed-Point Logarithms ---------- */
+
+// Each computed log is rounded down and lands within this many units of the true value
+#define LOG_ERR_UNITS 2
+
+// High 64 bits of the 128-bit product a * b
+static uint64_t mul_hi64(uint64_t a, uint64_t b) {
+    uint64_t al = (uint32_t)a, ah = a >> 32, bl = (uint32_t)b, bh = b >> 32;
+    uint64_t lh = al * bh, hl = ah * bl;
+    uint64_t mid = ((al * bl) >> 32) + (uint32_t)lh + (uint32_t)hl;
+    return ah * bh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+}
+
+// log2(mant * 2^(exp - 63)) for a normalized mantissa (top bit set). The integer part is
+// exp; each squaring of the mantissa yields one fraction bit.
+static uint64_t log2_fx_normalized(int exp, uint64_t mant) {
+    uint64_t frac = 0;
+    for (int i = 0; i < ENCODED_LOG_FRAC_BITS; i++) {
+        mant = mul_hi64(mant, mant);  // [1,2)^2 in Q2.62
+        frac <<= 1;
+        if (mant >> 63) {
+            frac |= 1;
+        } else {
+            mant <<= 1;
+        }
+    }
+    return ((uint64_t)exp << ENCODED_LOG_FRAC_BITS) | frac;
+}
+
+static uint64_t log2_fx_u32(uint32_t x) {
+    int s = __builtin_clz(x);
+    return log2_fx_normalized(31 - s, (uint64_t)x << (32 + s));
+}
 
 /* ---------- Prime Numbers for Encoded Clocks ---------- */
 
-int PRIMES[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53, 59, 61, 67, 71, 73, 79, 83, 89, 97};
-const int MAX_PRIMES = 25;
+static const uint32_t *g_primes = NULL;
+static const uint64_t *g_prime_logs = NULL;
+static int g_prime_count = 0;
+static pthread_mutex_t g_primes_lock = PTHREAD_MUTEX_INITIALIZER;
 
-/* ---------- Encoded Vector Clock Implementation (Prime Numbers) ---------- */
+// Sieve of Eratosthenes, doubling the limit until `count` primes are found
+static uint32_t* sieve_primes(int count) {
+    uint32_t *primes = (uint32_t*)malloc(count * sizeof(uint32_t));
+    size_t limit = count < 16 ? 64 : (size_t)count * 16;
+    
+    for (;;) {
+        unsigned char *composite = (unsigned char*)calloc(limit + 1, 1);
+        if (!primes || !composite) {
+            fprintf(stderr, "OOM\n");
+            exit(1);
+        }
+        
+        int found = 0;
+        for (size_t i = 2; i <= limit && found < count; i++) {
+            if (composite[i]) continue;
+            primes[found++] = (uint32_t)i;
+            for (size_t j = i * i; j <= limit; j += i) {
+                composite[j] = 1;
+            }
+        }
+        free(composite);
+        
+        if (found == count) return primes;
+        limit *= 2;
+    }
+}
 
-Timestamp encoded_create(int n, int pid, ClockType type) {
-    if (n > MAX_PRIMES) {
-        fprintf(stderr, "Too many processes for encoded clock (max %d)\n", MAX_PRIMES);
+// Prime and log tables covering `count` processes, grown together
+static const uint32_t* prime_tables(int count, const uint64_t **logs) {
+    pthread_mutex_lock(&g_primes_lock);
+    if (count > g_prime_count) {
+        // Older tables stay allocated: clocks keep pointers into them
+        int grow = count > 2 * g_prime_count ? count : 2 * g_prime_count;
+        uint32_t *primes = sieve_primes(grow);
+        uint64_t *prime_logs = (uint64_t*)malloc(grow * sizeof(uint64_t));
+        if (!prime_logs) {
+            fprintf(stderr, "OOM\n");
+            exit(1);
+        }
+        for (int i = 0; i < grow; i++) {
+            prime_logs[i] = log2_fx_u32(primes[i]);
+        }
+        g_primes = primes;
+        g_prime_logs = prime_logs;
+        g_prime_count = grow;
+    }
+    const uint32_t *primes = g_primes;
+    if (logs) *logs = g_prime_logs;
+    pthread_mutex_unlock(&g_primes_lock);
+    return primes;
+}
+
+const uint32_t* encoded_primes(int count) {
+    return prime_tables(count, NULL);
+}
+
+/* ---------- Vector Switch Threshold ---------- */
+
+static size_t g_vector_threshold = 0;
+
+void encoded_set_vector_threshold(size_t bytes) {
+    g_vector_threshold = bytes;
+}
+
+size_t encoded_vector_threshold(int n) {
+    return g_vector_threshold ? g_vector_threshold : n * sizeof(int);
+}
+
+/* ---------- Bignum Arithmetic ---------- */
+
+static void big_reserve(EncodedBignum *b, int cap) {
+    if (cap <= b->cap) return;
+    int new_cap = b->cap ? b->cap : 2;
+    while (new_cap < cap) new_cap *= 2;
+    uint32_t *limbs = (uint32_t*)realloc(b->limbs, new_cap * sizeof(uint32_t));
+    if (!limbs) {
+        fprintf(stderr, "OOM\n");
         exit(1);
     }
+    b->limbs = limbs;
+    b->cap = new_cap;
+}
+
+static void big_init(EncodedBignum *b) {
+    b->limbs = NULL;
+    b->len = 0;
+    b->cap = 0;
+    big_reserve(b, 2);
+    b->limbs[0] = 1;  // Start with 1 (multiplicative identity)
+    b->len = 1;
+}
+
+static void big_free(EncodedBignum *b) {
+    free(b->limbs);
+    b->limbs = NULL;
+    b->len = b->cap = 0;
+}
+
+static void big_set_one(EncodedBignum *b) {
+    b->limbs[0] = 1;
+    b->len = 1;
+}
+
+static void big_copy(EncodedBignum *dst, const EncodedBignum *src) {
+    big_reserve(dst, src->len);
+    memcpy(dst->limbs, src->limbs, src->len * sizeof(uint32_t));
+    dst->len = src->len;
+}
+
+static void big_set_limbs(EncodedBignum *b, const uint32_t *limbs, int len) {
+    big_reserve(b, len > 0 ? len : 1);
+    if (len > 0) memcpy(b->limbs, limbs, len * sizeof(uint32_t));
+    b->len = len > 0 ? len : 1;
+    if (len <= 0) b->limbs[0] = 0;
+    while (b->len > 1 && b->limbs[b->len - 1] == 0) b->len--;
+}
+
+static int big_is_one(const EncodedBignum *b) {
+    return b->len == 1 && b->limbs[0] == 1;
+}
+
+// b *= m
+static void big_mul_small(EncodedBignum *b, uint32_t m) {
+    uint64_t carry = 0;
+    for (int i = 0; i < b->len; i++) {
+        uint64_t t = (uint64_t)b->limbs[i] * m + carry;
+        b->limbs[i] = (uint32_t)t;
+        carry = t >> 32;
+    }
+    if (carry) {
+        big_reserve(b, b->len + 1);
+        b->limbs[b->len++] = (uint32_t)carry;
+    }
+}
+
+static uint32_t big_mod_small(const EncodedBignum *b, uint32_t m) {
+    uint64_t rem = 0;
+    for (int i = b->len - 1; i >= 0; i--) {
+        rem = ((rem << 32) | b->limbs[i]) % m;
+    }
+    return (uint32_t)rem;
+}
+
+// b /= m, discarding the remainder
+static void big_div_small(EncodedBignum *b, uint32_t m) {
+    uint64_t rem = 0;
+    for (int i = b->len - 1; i >= 0; i--) {
+        uint64_t cur = (rem << 32) | b->limbs[i];
+        b->limbs[i] = (uint32_t)(cur / m);
+        rem = cur % m;
+    }
+    while (b->len > 1 && b->limbs[b->len - 1] == 0) b->len--;
+}
+
+// Factor b over the first n primes into exponents. Returns 0 if b has other factors.
+static int big_decode(const EncodedBignum *b, int n, const uint32_t *primes, int *out) {
+    memset(out, 0, n * sizeof(int));
+    if (b->len == 1 && b->limbs[0] == 0) {
+        return 0;  // Zero is divisible by everything; not a valid encoding
+    }
+    
+    EncodedBignum temp;
+    big_init(&temp);
+    big_copy(&temp, b);
+    
+    for (int i = 0; i < n && !big_is_one(&temp); i++) {
+        while (big_mod_small(&temp, primes[i]) == 0) {
+            big_div_small(&temp, primes[i]);
+            out[i]++;
+        }
+    }
+    
+    int ok = big_is_one(&temp);
+    big_free(&temp);
+    return ok;
+}
+
+// b = product of primes[i]^v[i]
+static void big_encode(EncodedBignum *b, int n, const uint32_t *primes, const int *v) {
+    big_set_one(b);
+    for (int i = 0; i < n; i++) {
+        // Batch as many factors as fit in one limb before each multiply pass
+        uint64_t acc = 1;
+        for (int j = 0; j < v[i]; j++) {
+            if (acc * primes[i] > UINT32_MAX) {
+                big_mul_small(b, (uint32_t)acc);
+                acc = 1;
+            }
+            acc *= primes[i];
+        }
+        if (acc > 1) big_mul_small(b, (uint32_t)acc);
+    }
+}
+
+static int big_is_zero(const EncodedBignum *b) {
+    return b->len == 1 && b->limbs[0] == 0;
+}
+
+static int big_cmp(const EncodedBignum *a, const EncodedBignum *b) {
+    if (a->len != b->len) return a->len < b->len ? -1 : 1;
+    for (int i = a->len - 1; i >= 0; i--) {
+        if (a->limbs[i] != b->limbs[i]) return a->limbs[i] < b->limbs[i] ? -1 : 1;
+    }
+    return 0;
+}
+
+// out = a * b (out must not alias either operand)
+static void big_mul(EncodedBignum *out, const EncodedBignum *a, const EncodedBignum *b) {
+    big_reserve(out, a->len + b->len);
+    memset(out->limbs, 0, (a->len + b->len) * sizeof(uint32_t));
+    for (int i = 0; i < a->len; i++) {
+        uint64_t carry = 0;
+        for (int j = 0; j < b->len; j++) {
+            uint64_t t = (uint64_t)a->limbs[i] * b->limbs[j] + out->limbs[i + j] + carry;
+            out->limbs[i + j] = (uint32_t)t;
+            carry = t >> 32;
+        }
+        out->limbs[i + b->len] = (uint32_t)carry;
+    }
+    out->len = a->len + b->len;
+    while (out->len > 1 && out->limbs[out->len - 1] == 0) out->len--;
+}
+
+// Operands up to this many limbs (together) divide without touching the heap
+#define BIG_STACK_LIMBS 256
+
+// q = u / v and r = u % v for v != 0 (Knuth algorithm D). Either output may be NULL;
+// outputs must not alias the inputs.
+static void big_divmod(const EncodedBignum *u, const EncodedBignum *v, EncodedBignum *q, EncodedBignum *r) {
+    if (big_cmp(u, v) < 0) {
+        if (q) big_set_limbs(q, NULL, 0);
+        if (r) big_copy(r, u);
+        return;
+    }
+    
+    int n = v->len, m = u->len - v->len;
+    if (n == 1) {
+        // Single-limb divisor: one pass of short division
+        uint64_t rem = 0;
+        if (q) big_reserve(q, u->len);
+        for (int i = u->len - 1; i >= 0; i--) {
+            uint64_t cur = (rem << 32) | u->limbs[i];
+            if (q) q->limbs[i] = (uint32_t)(cur / v->limbs[0]);
+            rem = cur % v->limbs[0];
+        }
+        if (q) {
+            q->len = u->len;
+            while (q->len > 1 && q->limbs[q->len - 1] == 0) q->len--;
+        }
+        if (r) {
+            uint32_t rem32 = (uint32_t)rem;
+            big_set_limbs(r, &rem32, 1);
+        }
+        return;
+    }
+    
+    // Normalize so the divisor's top limb has its high bit set
+    int s = __builtin_clz(v->limbs[n - 1]);
+    uint32_t stack_scratch[BIG_STACK_LIMBS];
+    uint32_t *scratch = stack_scratch;
+    if (n + u->len + 1 > BIG_STACK_LIMBS) {
+        scratch = (uint32_t*)malloc((n + u->len + 1) * sizeof(uint32_t));
+    }
+    uint32_t *vn = scratch;
+    uint32_t *un = scratch + n;
+    for (int i = n - 1; i > 0; i--) {
+        vn[i] = (v->limbs[i] << s) | (s ? (uint32_t)((uint64_t)v->limbs[i - 1] >> (32 - s)) : 0);
+    }
+    vn[0] = v->limbs[0] << s;
+    un[u->len] = s ? (uint32_t)((uint64_t)u->limbs[u->len - 1] >> (32 - s)) : 0;
+    for (int i = u->len - 1; i > 0; i--) {
+        un[i] = (u->limbs[i] << s) | (s ? (uint32_t)((uint64_t)u->limbs[i - 1] >> (32 - s)) : 0);
+    }
+    un[0] = u->limbs[0] << s;
+    
+    if (q) {
+        big_reserve(q, m + 1);
+        q->len = m + 1;
+    }
+    for (int j = m; j >= 0; j--) {
+        // Estimate the quotient digit from the top two limbs, then correct it
+        uint64_t num = ((uint64_t)un[j + n] << 32) | un[j + n - 1];
+        uint64_t qhat = num / vn[n - 1];
+        uint64_t rhat = num % vn[n - 1];
+        while (qhat > UINT32_MAX || qhat * vn[n - 2] > ((rhat << 32) | un[j + n - 2])) {
+            qhat--;
+            rhat += vn[n - 1];
+            if (rhat > UINT32_MAX) break;
+        }
+        
+        // Multiply and subtract
+        int64_t borrow = 0, t;
+        for (int i = 0; i < n; i++) {
+            uint64_t p = qhat * vn[i];
+            t = (int64_t)un[i + j] - borrow - (int64_t)(p & 0xFFFFFFFFu);
+            un[i + j] = (uint32_t)t;
+            borrow = (int64_t)(p >> 32) - (t >> 32);
+        }
+        t = (int64_t)un[j + n] - borrow;
+        un[j + n] = (uint32_t)t;
+        
+        // Estimate was one too large: add the divisor back
+        if (t < 0) {
+            qhat--;
+            uint64_t carry = 0;
+            for (int i = 0; i < n; i++) {
+                uint64_t sum = (uint64_t)un[i + j] + vn[i] + carry;
+                un[i + j] = (uint32_t)sum;
+                carry = sum >> 32;
+            }
+            un[j + n] += (uint32_t)carry;
+        }
+        if (q) q->limbs[j] = (uint32_t)qhat;
+    }
+    if (q) {
+        while (q->len > 1 && q->limbs[q->len - 1] == 0) q->len--;
+    }
+    
+    if (r) {
+        // Unnormalize the remainder
+        big_reserve(r, n);
+        for (int i = 0; i < n; i++) {
+            r->limbs[i] = (un[i] >> s) | (s ? (uint32_t)((uint64_t)un[i + 1] << (32 - s)) : 0);
+        }
+        r->len = n;
+        while (r->len > 1 && r->limbs[r->len - 1] == 0) r->len--;
+    }
+    if (scratch != stack_scratch) free(scratch);
+}
+
+// Nonzero if a divides b
+static int big_divides(const EncodedBignum *a, const EncodedBignum *b) {
+    EncodedBignum r;
+    big_init(&r);
+    big_divmod(b, a, NULL, &r);
+    int divides = big_is_zero(&r);
+    big_free(&r);
+    return divides;
+}
+
+// Top 31 bits of b >> shift (shift may exceed b's length, giving 0)
+static int64_t big_top_bits(const EncodedBignum *b, int shift) {
+    int limb = shift / 32, bit = shift % 32;
+    if (limb >= b->len) return 0;
+    uint64_t window = b->limbs[limb];
+    if (limb + 1 < b->len) window |= (uint64_t)b->limbs[limb + 1] << 32;
+    return (int64_t)((window >> bit) & 0x7FFFFFFF);
+}
+
+// out = a * x + b * y for cofactors below 2^31 in magnitude; the result must be >= 0
+static void big_lin_comb(EncodedBignum *out, int64_t a, const EncodedBignum *x, int64_t b, const EncodedBignum *y) {
+    int len = x->len > y->len ? x->len : y->len;
+    big_reserve(out, len + 1);
+    int64_t carry = 0;
+    for (int i = 0; i < len; i++) {
+        int64_t xi = i < x->len ? x->limbs[i] : 0;
+        int64_t yi = i < y->len ? y->limbs[i] : 0;
+        int64_t t = a * xi + b * yi + carry;
+        out->limbs[i] = (uint32_t)t;
+        carry = t >> 32;
+    }
+    out->limbs[len] = (uint32_t)carry;
+    out->len = len + 1;
+    while (out->len > 1 && out->limbs[out->len - 1] == 0) out->len--;
+}
+
+// x = gcd(x, y), destroying y. Lehmer's algorithm: run Euclid on the leading 31 bits and
+// apply the accumulated cofactors to the full numbers, so most multi-limb steps collapse
+// into one linear combination.
+static void big_gcd_into(EncodedBignum *x, EncodedBignum *y) {
+    EncodedBignum t, u;
+    big_init(&t);
+    big_init(&u);
+    if (big_cmp(x, y) < 0) {
+        EncodedBignum swap = *x;
+        *x = *y;
+        *y = swap;
+    }
+    
+    while (!big_is_zero(y)) {
+        if (x->len <= 2) {
+            // Both fit in 64 bits: finish with machine Euclid
+            uint64_t a = x->limbs[0] | (x->len > 1 ? (uint64_t)x->limbs[1] << 32 : 0);
+            uint64_t b = y->limbs[0] | (y->len > 1 ? (uint64_t)y->limbs[1] << 32 : 0);
+            while (b) {
+                uint64_t r = a % b;
+                a = b;
+                b = r;
+            }
+            uint32_t limbs[2] = {(uint32_t)a, (uint32_t)(a >> 32)};
+            big_set_limbs(x, limbs, 2);
+            break;
+        }
+        
+        int bits = 32 * x->len - __builtin_clz(x->limbs[x->len - 1]);
+        int shift = bits - 31;
+        int64_t xh = big_top_bits(x, shift), yh = big_top_bits(y, shift);
+        int64_t A = 1, B = 0, C = 0, D = 1;
+        while (yh + C != 0 && yh + D != 0) {
+            int64_t q = (xh + A) / (yh + C);
+            if (q != (xh + B) / (yh + D)) break;
+            int64_t tmp = A - q * C; A = C; C = tmp;
+            tmp = B - q * D; B = D; D = tmp;
+            tmp = xh - q * yh; xh = yh; yh = tmp;
+        }
+        
+        if (B == 0) {
+            // No progress on the leading bits: take one full division step
+            big_divmod(x, y, NULL, &t);
+            EncodedBignum swap = *x;
+            *x = *y;
+            *y = t;
+            t = swap;
+        } else {
+            big_lin_comb(&t, A, x, B, y);
+            big_lin_comb(&u, C, x, D, y);
+            EncodedBignum swap = *x;
+            *x = t;
+            t = swap;
+            swap = *y;
+            *y = u;
+            u = swap;
+        }
+    }
+    
+    big_free(&t);
+    big_free(&u);
+}
+
+// a = lcm(a, b) = a * (b / gcd(a, b))
+static void big_lcm_into(EncodedBignum *a, const EncodedBignum *b) {
+    EncodedBignum x, y, quot, product;
+    big_init(&x);
+    big_init(&y);
+    big_init(&quot);
+    big_init(&product);
+    
+    big_copy(&x, a);
+    big_copy(&y, b);
+    big_gcd_into(&x, &y);
+    
+    // Dividing first keeps the intermediate no larger than the result
+    big_divmod(b, &x, &quot, NULL);
+    big_mul(&product, a, &quot);
+    big_copy(a, &product);
+    
+    big_free(&x);
+    big_free(&y);
+    big_free(&quot);
+    big_free(&product);
+}
+
+// Fixed-point log2 of b >= 1 from its top 64 significant bits
+static uint64_t big_log2_fx(const EncodedBignum *b) {
+    int top = b->len - 1;
+    int s = __builtin_clz(b->limbs[top]);
+    uint64_t mant = (uint64_t)b->limbs[top] << (32 + s);
+    if (top >= 1) mant |= (uint64_t)b->limbs[top - 1] << s;
+    if (top >= 2 && s) mant |= b->limbs[top - 2] >> (32 - s);
+    return log2_fx_normalized(32 * top + 31 - s, mant);
+}
+
+/* ---------- Serialized Forms ---------- */
+
+static size_t big_serialized_size(const EncodedBignum *b) {
+    if (b->len <= 2) return sizeof(unsigned long long);
+    return (1 + (size_t)b->len) * sizeof(uint32_t);
+}
+
+// Read a product form (8-byte value or tagged limbs) into out. Returns 0 for the vector
+// form, unrecognized sizes and zero. Products are not factored, so foreign primes pass.
+static int encoded_parse_product(const void *buffer, size_t size, EncodedBignum *out) {
+    const uint32_t *words = (const uint32_t*)buffer;
+    
+    if (size == sizeof(unsigned long long)) {
+        unsigned long long v;
+        memcpy(&v, buffer, sizeof(v));
+        uint32_t limbs[2] = {(uint32_t)v, (uint32_t)(v >> 32)};
+        big_set_limbs(out, limbs, 2);
+    } else if (size >= sizeof(uint32_t) && (words[0] & ~ENCODED_LIMB_MASK) == ENCODED_BIG_TAG &&
+               size == (1 + (size_t)(words[0] & ENCODED_LIMB_MASK)) * sizeof(uint32_t)) {
+        big_set_limbs(out, words + 1, words[0] & ENCODED_LIMB_MASK);
+    } else {
+        return 0;
+    }
+    return !big_is_zero(out);
+}
+
+/* ---------- Exponent Shadow ---------- */
+
+static int g_force_decode = 0;
+
+void encoded_force_decode(int enabled) {
+    g_force_decode = enabled;
+}
+
+// Exponent vector of the clock, factoring the product only if the shadow is stale
+static const int* encoded_exponents(const Timestamp *ts) {
+    EncodedClockData *data = (EncodedClockData*)ts->data;
+    if (!data->shadow_valid) {
+        big_decode(&data->value, ts->n, data->primes, data->fallback_v);
+        data->shadow_valid = 1;
+    }
+    return data->fallback_v;
+}
+
+/* ---------- Log-Domain Magnitude ---------- */
+
+// Recompute the log after a merge or load: from the product while it is authoritative,
+// otherwise as the exponent sum (each table entry contributes its own error)
+static void encoded_refresh_log(Timestamp *ts) {
+    EncodedClockData *data = (EncodedClockData*)ts->data;
+    if (!data->overflow) {
+        data->log2_fx = big_log2_fx(&data->value);
+        data->log_err = LOG_ERR_UNITS;
+        return;
+    }
+    uint64_t sum = 0, events = 0;
+    for (int i = 0; i < ts->n; i++) {
+        if (data->fallback_v[i] <= 0) continue;
+        sum += (uint64_t)data->fallback_v[i] * data->prime_logs[i];
+        events += (uint64_t)data->fallback_v[i];
+    }
+    data->log2_fx = sum;
+    data->log_err = events * LOG_ERR_UNITS;
+}
+
+// -1 if a's product is certainly smaller, 1 if certainly larger, 0 if too close to call
+static int encoded_log_order(const EncodedClockData *a, const EncodedClockData *b) {
+    uint64_t bound = a->log_err + b->log_err;
+    if (a->log2_fx > b->log2_fx && a->log2_fx - b->log2_fx > bound) return 1;
+    if (b->log2_fx > a->log2_fx && b->log2_fx - a->log2_fx > bound) return -1;
+    return 0;
+}
+
+uint64_t encoded_log2(const Timestamp *ts, uint64_t *err) {
+    const EncodedClockData *data = (const EncodedClockData*)ts->data;
+    if (err) *err = data->log_err;
+    return data->log2_fx;
+}
+
+long long encoded_events_left(const Timestamp *ts, size_t bytes) {
+    const EncodedClockData *data = (const EncodedClockData*)ts->data;
+    if (data->overflow || bytes < sizeof(unsigned long long)) return 0;
+    
+    // Largest product that serializes in `bytes`: two limbs in the plain word, otherwise
+    // whatever fits behind the tag
+    uint64_t limbs = bytes / sizeof(uint32_t) - 1;
+    if (limbs < 2) limbs = 2;
+    uint64_t cap = (32 * limbs) << ENCODED_LOG_FRAC_BITS;
     
+    // Worst case every event lands on the largest prime
+    uint64_t used = data->log2_fx + data->log_err;
+    uint64_t per_event = data->prime_logs[ts->n - 1] + LOG_ERR_UNITS;
+    if (used >= cap) return 0;
+    return (long long)((cap - used - 1) / per_event);
+}
+
+// Switch to the vector form once the encoding outgrows the configured threshold
+static void encoded_check_threshold(Timestamp *ts) {
+    EncodedClockData *data = (EncodedClockData*)ts->data;
+    if (data->overflow || big_serialized_size(&data->value) <= encoded_vector_threshold(ts->n)) {
+        return;
+    }
+    encoded_exponents(ts);
+    data->overflow = 1;
+}
+
+/* ---------- Encoded Vector Clock Implementation (Prime Numbers) ---------- */
+
+Timestamp encoded_create(int n, int pid, ClockType type) {
     Timestamp ts;
     ts.n = n;
     ts.pid = pid;
     ts.type = type;
+    clock_digest_none(&ts.digest);
     
     EncodedClockData *data = malloc(sizeof(EncodedClockData));
-    data->value = 1;  // Start with 1 (multiplicative identity)
+    big_init(&data->value);
     data->overflow = 0;
     data->fallback_v = (int*)calloc(n, sizeof(int));
+    data->shadow_valid = 1;  // 1 <-> all zeros
+    data->primes = prime_tables(n, &data->prime_logs);
+    data->log2_fx = 0;  // log2(1)
+    data->log_err = 0;
     
     ts.data = data;
     ts.data_size = sizeof(unsigned long long);
@@ -34,6 +640,7 @@ Timestamp encoded_create(int n, int pid, ClockType type) {
 void encoded_destroy(Timestamp *ts) {
     if (ts && ts->data) {
         EncodedClockData *data = (EncodedClockData*)ts->data;
+        big_free(&data->value);
         if (data->fallback_v) {
             free(data->fallback_v);
         }
@@ -45,198 +652,102 @@ void encoded_destroy(Timestamp *ts) {
 void encoded_increment(Timestamp *ts) {
     EncodedClockData *data = (EncodedClockData*)ts->data;
     
-    if (data->overflow) {
-        // Use fallback vector
+    // The vector form is authoritative after the switch, and a valid shadow tracks it too
+    if (data->overflow || data->shadow_valid) {
         data->fallback_v[ts->pid] += 1;
+    }
+    data->log2_fx += data->prime_logs[ts->pid];
+    data->log_err += LOG_ERR_UNITS;
+    if (data->overflow) {
         return;
     }
     
-    // Try to multiply by the prime for this process
-    unsigned long long new_value = data->value * PRIMES[ts->pid];
+    // Multiply by the prime for this process
+    big_mul_small(&data->value, data->primes[ts->pid]);
+    encoded_check_threshold(ts);
+}
+
+// Legacy path: factor both sides, take the element-wise max and re-encode
+static void encoded_merge_decoded(Timestamp *dst, const EncodedBignum *other) {
+    EncodedClockData *dst_data = (EncodedClockData*)dst->data;
+    int *other_v = (int*)malloc(dst->n * sizeof(int));
     
-    // Check for overflow
-    if (new_value / PRIMES[ts->pid] != data->value) {
-        // Overflow detected, switch to fallback
-        data->overflow = 1;
-        // Convert current encoded value to vector
-        unsigned long long temp = data->value;
-        for (int i = 0; i < ts->n; i++) {
-            while (temp % PRIMES[i] == 0) {
-                data->fallback_v[i]++;
-                temp /= PRIMES[i];
-            }
-        }
-        data->fallback_v[ts->pid] += 1;
-    } else {
-        data->value = new_value;
-    }
+    big_decode(&dst_data->value, dst->n, dst_data->primes, dst_data->fallback_v);
+    big_decode(other, dst->n, dst_data->primes, other_v);
+    vk_merge_max(dst_data->fallback_v, other_v, dst->n);
+    big_encode(&dst_data->value, dst->n, dst_data->primes, dst_data->fallback_v);
+    dst_data->shadow_valid = 1;
+    
+    free(other_v);
 }
 
 void encoded_merge(Timestamp *dst, const void *other_data, size_t other_size) {
     EncodedClockData *dst_data = (EncodedClockData*)dst->data;
+    EncodedBignum other;
+    big_init(&other);
     
-    if (other_size == sizeof(unsigned long long)) {
-        // Other is encoded format
-        unsigned long long other_value = *(const unsigned long long*)other_data;
-        
+    if (encoded_parse_product(other_data, other_size, &other)) {
         if (dst_data->overflow) {
-            // We're in fallback mode, decode the other value
-            int other_v[MAX_PRIMES];
-            memset(other_v, 0, sizeof(other_v));
-            unsigned long long temp = other_value;
-            for (int i = 0; i < dst->n; i++) {
-                while (temp % PRIMES[i] == 0) {
-                    other_v[i]++;
-                    temp /= PRIMES[i];
-                }
-            }
-            
-            // Merge with fallback vector
-            for (int i = 0; i < dst->n; i++) {
-                if (other_v[i] > dst_data->fallback_v[i]) {
-                    dst_data->fallback_v[i] = other_v[i];
-                }
-            }
+            // Already in vector form: the product has to be factored
+            int *other_v = (int*)malloc(dst->n * sizeof(int));
+            big_decode(&other, dst->n, dst_data->primes, other_v);
+            vk_merge_max(dst_data->fallback_v, other_v, dst->n);
+            free(other_v);
+        } else if (g_force_decode) {
+            encoded_merge_decoded(dst, &other);
         } else {
-            // Both are encoded, take the LCM (but this is complex)
-            // For simplicity, decode both and merge
-            int dst_v[MAX_PRIMES];
-            int other_v[MAX_PRIMES];
-            memset(dst_v, 0, sizeof(dst_v));
-            memset(other_v, 0, sizeof(other_v));
-            
-            // Decode dst
-            unsigned long long temp = dst_data->value;
-            for (int i = 0; i < dst->n; i++) {
-                while (temp % PRIMES[i] == 0) {
-                    dst_v[i]++;
-                    temp /= PRIMES[i];
-                }
-            }
-            
-            // Decode other
-            temp = other_value;
-            for (int i = 0; i < dst->n; i++) {
-                while (temp % PRIMES[i] == 0) {
-                    other_v[i]++;
-                    temp /= PRIMES[i];
-                }
-            }
-            
-            // Merge vectors
-            for (int i = 0; i < dst->n; i++) {
-                if (other_v[i] > dst_v[i]) {
-                    dst_v[i] = other_v[i];
-                }
-            }
-            
-            // Try to re-encode
-            unsigned long long result = 1;
-            int overflow_check = 0;
-            
-            for (int i = 0; i < dst->n && !overflow_check; i++) {
-                for (int j = 0; j < dst_v[i]; j++) {
-                    unsigned long long new_result = result * PRIMES[i];
-                    if (new_result / PRIMES[i] != result) {
-                        overflow_check = 1;
-                        break;
-                    }
-                    result = new_result;
-                }
-            }
-            
-            if (overflow_check) {
-                // Switch to fallback
-                dst_data->overflow = 1;
-                memcpy(dst_data->fallback_v, dst_v, dst->n * sizeof(int));
-            } else {
-                dst_data->value = result;
-            }
+            // max of exponents = lcm of products; the shadow goes stale
+            big_lcm_into(&dst_data->value, &other);
+            dst_data->shadow_valid = 0;
         }
-    } else {
-        // Other is vector format
-        const int *other_v = (const int*)other_data;
-        
+    } else if (other_size == encoded_vector_size(dst->n)) {
+        // Vector form: merge exponents and re-encode unless already switched
+        int *dst_v = (int*)encoded_exponents(dst);
+        vk_merge_max(dst_v, (const int*)other_data, dst->n);
         if (!dst_data->overflow) {
-            // Decode our value first
-            int dst_v[MAX_PRIMES];
-            memset(dst_v, 0, sizeof(dst_v));
-            unsigned long long temp = dst_data->value;
-            for (int i = 0; i < dst->n; i++) {
-                while (temp % PRIMES[i] == 0) {
-                    dst_v[i]++;
-                    temp /= PRIMES[i];
-                }
-            }
-            
-            // Switch to fallback mode
-            dst_data->overflow = 1;
-            memcpy(dst_data->fallback_v, dst_v, dst->n * sizeof(int));
-        }
-        
-        // Merge with fallback vector
-        for (int i = 0; i < dst->n; i++) {
-            if (other_v[i] > dst_data->fallback_v[i]) {
-                dst_data->fallback_v[i] = other_v[i];
-            }
+            big_encode(&dst_data->value, dst->n, dst_data->primes, dst_v);
         }
     }
+    
+    big_free(&other);
+    if (!dst_data->overflow) {
+        encoded_check_threshold(dst);
+    }
+    encoded_refresh_log(dst);
 }
 
 TSOrder encoded_compare(const Timestamp *a, const Timestamp *b) {
     const EncodedClockData *a_data = (const EncodedClockData*)a->data;
     const EncodedClockData *b_data = (const EncodedClockData*)b->data;
     
-    int a_v[MAX_PRIMES];
-    int b_v[MAX_PRIMES];
-    memset(a_v, 0, sizeof(a_v));
-    memset(b_v, 0, sizeof(b_v));
-    
-    // Decode a
-    if (a_data->overflow) {
-        memcpy(a_v, a_data->fallback_v, a->n * sizeof(int));
-    } else {
-        unsigned long long temp = a_data->value;
-        for (int i = 0; i < a->n; i++) {
-            while (temp % PRIMES[i] == 0) {
-                a_v[i]++;
-                temp /= PRIMES[i];
-            }
+    if (a_data->overflow || b_data->overflow || g_force_decode) {
+        int *a_v = (int*)malloc(a->n * sizeof(int));
+        int *b_v = (int*)malloc(b->n * sizeof(int));
+        if (g_force_decode) {
+            // Legacy path: factor both products on every call
+            if (a_data->overflow) memcpy(a_v, a_data->fallback_v, a->n * sizeof(int));
+            else big_decode(&a_data->value, a->n, a_data->primes, a_v);
+            if (b_data->overflow) memcpy(b_v, b_data->fallback_v, b->n * sizeof(int));
+            else big_decode(&b_data->value, b->n, b_data->primes, b_v);
+        } else {
+            memcpy(a_v, encoded_exponents(a), a->n * sizeof(int));
+            memcpy(b_v, encoded_exponents(b), b->n * sizeof(int));
         }
+        TSOrder result = vk_compare(a_v, b_v, a->n);
+        free(a_v);
+        free(b_v);
+        return result;
     }
     
-    // Decode b
-    if (b_data->overflow) {
-        memcpy(b_v, b_data->fallback_v, b->n * sizeof(int));
-    } else {
-        unsigned long long temp = b_data->value;
-        for (int i = 0; i < b->n; i++) {
-            while (temp % PRIMES[i] == 0) {
-                b_v[i]++;
-                temp /= PRIMES[i];
-            }
-        }
+    // Happened-before is divisibility: a -> b iff a | b and a != b. Only the smaller
+    // product can divide the larger; magnitudes the logs cannot separate are compared exactly.
+    int order = encoded_log_order(a_data, b_data);
+    if (order == 0) {
+        order = big_cmp(&a_data->value, &b_data->value);
+        if (order == 0) return TS_EQUAL;
     }
-    
-    // Compare vectors
-    int a_le_b = 1, b_le_a = 1;
-    int a_lt_b = 0, b_lt_a = 0;
-    
-    for (int i = 0; i < a->n; i++) {
-        if (a_v[i] > b_v[i]) {
-            a_le_b = 0;
-            b_lt_a = 1;
-        }
-        if (b_v[i] > a_v[i]) {
-            b_le_a = 0;
-            a_lt_b = 1;
-        }
-    }
-    
-    if (a_le_b && b_le_a) return TS_EQUAL;
-    if (a_le_b && a_lt_b) return TS_BEFORE;
-    if (b_le_a && b_lt_a) return TS_AFTER;
-    return TS_CONCURRENT;
+    if (order < 0) return big_divides(&a_data->value, &b_data->value) ? TS_BEFORE : TS_CONCURRENT;
+    return big_divides(&b_data->value, &a_data->value) ? TS_AFTER : TS_CONCURRENT;
 }
 
 size_t encoded_serialize(const Timestamp *ts, void *buffer, size_t bufsize) {
@@ -244,33 +755,53 @@ size_t encoded_serialize(const Timestamp *ts, void *buffer, size_t bufsize) {
     
     if (data->overflow) {
         // Serialize as vector
-        size_t required = ts->n * sizeof(int);
+        size_t required = encoded_vector_size(ts->n);
         if (bufsize >= required) {
-            memcpy(buffer, data->fallback_v, required);
+            memset(buffer, 0, required);
+            memcpy(buffer, data->fallback_v, ts->n * sizeof(int));
         }
         return required;
-    } else {
-        // Serialize as encoded value
-        size_t required = sizeof(unsigned long long);
-        if (bufsize >= required) {
-            memcpy(buffer, &data->value, required);
-        }
+    }
+    
+    size_t required = big_serialized_size(&data->value);
+    if (bufsize < required) {
         return required;
     }
+    
+    if (data->value.len <= 2) {
+        // Serialize as a single encoded value
+        unsigned long long value = data->value.limbs[0];
+        if (data->value.len == 2) value |= (unsigned long long)data->value.limbs[1] << 32;
+        memcpy(buffer, &value, required);
+    } else {
+        // Serialize as tagged limbs
+        uint32_t *words = (uint32_t*)buffer;
+        words[0] = ENCODED_BIG_TAG | (uint32_t)data->value.len;
+        memcpy(words + 1, data->value.limbs, data->value.len * sizeof(uint32_t));
+    }
+    return required;
 }
 
 void encoded_deserialize(Timestamp *ts, const void *buffer, size_t size) {
     EncodedClockData *data = (EncodedClockData*)ts->data;
+    EncodedBignum value;
+    big_init(&value);
     
-    if (size == sizeof(unsigned long long)) {
+    // Malformed input (unknown size, zero product) leaves the clock as it was
+    if (encoded_parse_product(buffer, size, &value)) {
         // Encoded format
-        data->value = *(const unsigned long long*)buffer;
+        big_copy(&data->value, &value);
         data->overflow = 0;
-    } else if (size == ts->n * sizeof(int)) {
+        data->shadow_valid = 0;
+        encoded_refresh_log(ts);
+    } else if (size == encoded_vector_size(ts->n)) {
         // Vector format
         data->overflow = 1;
-        memcpy(data->fallback_v, buffer, size);
+        data->shadow_valid = 1;
+        memcpy(data->fallback_v, buffer, ts->n * sizeof(int));
+        encoded_refresh_log(ts);
     }
+    big_free(&value);
 }
 
 void encoded_to_string(const Timestamp *ts, char *buf, size_t bufsize) {
@@ -281,11 +812,19 @@ void encoded_to_string(const Timestamp *ts, char *buf, size_t bufsize) {
         for (int i = 0; i < ts->n; i++) {
             used += snprintf(buf + used, bufsize - used, "%s%d", 
                             (i ? "," : ""), data->fallback_v[i]);
-            if (used >= bufsize) break;
+            if (used >= bufsize) return;  // truncated
         }
         snprintf(buf + used, bufsize - used, "]");
+    } else if (data->value.len <= 2) {
+        unsigned long long value = data->value.limbs[0];
+        if (data->value.len == 2) value |= (unsigned long long)data->value.limbs[1] << 32;
+        snprintf(buf, bufsize, "E:%llu", value);
     } else {
-        snprintf(buf, bufsize, "E:%llu", data->value);
+        // Too wide for decimal here: print hex, most significant limb first
+        size_t used = snprintf(buf, bufsize, "E:0x%x", data->value.limbs[data->value.len - 1]);
+        for (int i = data->value.len - 2; i >= 0 && used < bufsize; i--) {
+            used += snprintf(buf + used, bufsize - used, "%08x", data->value.limbs[i]);
+        }
     }
 }
 
@@ -294,16 +833,23 @@ Timestamp encoded_clone(const Timestamp *ts) {
     const EncodedClockData *src_data = (const EncodedClockData*)ts->data;
     EncodedClockData *dst_data = (EncodedClockData*)out.data;
     
-    dst_data->value = src_data->value;
+    big_copy(&dst_data->value, &src_data->value);
     dst_data->overflow = src_data->overflow;
+    dst_data->shadow_valid = src_data->shadow_valid;
     memcpy(dst_data->fallback_v, src_data->fallback_v, ts->n * sizeof(int));
+    dst_data->log2_fx = src_data->log2_fx;
+    dst_data->log_err = src_data->log_err;
     
     return out;
 }
 
+void encoded_to_vector(const Timestamp *ts, int *out) {
+    memcpy(out, encoded_exponents(ts), ts->n * sizeof(int));
+}
+
 /* ---------- Operations Table ---------- */
 
-TimestampOps ENCODED_OPS = {
+const TimestampOps ENCODED_OPS = {
     .create = encoded_create,
     .destroy = encoded_destroy,
     .increment = encoded_increment,
@@ -313,5 +859,6 @@ TimestampOps ENCODED_OPS = {
     .serialize_for_dest = NULL,  // Encoded clocks don't need destination-aware serialization
     .deserialize = encoded_deserialize,
     .to_string = encoded_to_string,
-    .clone = encoded_clone
-};
\ No newline at end of file
+    .clone = encoded_clone,
+    .to_vector = encoded_to_vector
+};
@@ -0,0 +1,196 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "hlc_clock.h"
+
+/* ---------- Physical Clock and Drift Bound ---------- */
+
+static uint64_t realtime_ms(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+    return (uint64_t)now.tv_sec * 1000 + (uint64_t)now.tv_nsec / 1000000;
+}
+
+static uint64_t (*physical_clock)(void) = realtime_ms;
+static uint64_t max_drift_ms = HLC_DEFAULT_MAX_DRIFT_MS;
+
+void hlc_set_physical_clock(uint64_t (*now_ms)(void)) {
+    physical_clock = now_ms ? now_ms : realtime_ms;
+}
+
+void hlc_set_max_drift(uint64_t ms) {
+    max_drift_ms = ms;
+}
+
+uint64_t hlc_max_drift(void) {
+    return max_drift_ms;
+}
+
+void hlc_set_offset(Timestamp *ts, int64_t offset_ms) {
+    ((HlcClockData*)ts->data)->offset_ms = offset_ms;
+}
+
+int hlc_drift_rejections(const Timestamp *ts) {
+    return ((const HlcClockData*)ts->data)->drift_rejections;
+}
+
+// This process's (possibly skewed) physical time, truncated to 48 bits
+static uint64_t local_physical(const HlcClockData *data) {
+    int64_t now = (int64_t)physical_clock() + data->offset_ms;
+    return now < 0 ? 0 : (uint64_t)now & HLC_PHYSICAL_MASK;
+}
+
+// Packs (pt, l), spilling a full logical counter into the physical part so the value
+// still increases
+static uint64_t hlc_advance(uint64_t pt, uint64_t l) {
+    if (l > HLC_LOGICAL_MASK) {
+        return HLC_PACK(pt + 1, 0);
+    }
+    return HLC_PACK(pt, l);
+}
+
+/* ---------- Hybrid Logical Clock Implementation ---------- */
+
+Timestamp hlc_create_in(ClockArena *arena, int n, int pid, ClockType type) {
+    Timestamp ts;
+    ts.n = n;
+    ts.pid = pid;
+    ts.type = type;
+    clock_digest_none(&ts.digest);
+    
+    HlcClockData *data = clock_block_alloc(arena, sizeof(HlcClockData));
+    data->hlc = 0;
+    data->offset_ms = 0;
+    data->drift_rejections = 0;
+    
+    ts.data = data;
+    ts.data_size = sizeof(uint64_t);
+    return ts;
+}
+
+Timestamp hlc_create(int n, int pid, ClockType type) {
+    return hlc_create_in(NULL, n, pid, type);
+}
+
+void hlc_destroy(Timestamp *ts) {
+    if (ts && ts->data) {
+        clock_block_free(ts->data);
+        ts->data = NULL;
+    }
+}
+
+void hlc_send(Timestamp *ts) {
+    HlcClockData *data = (HlcClockData*)ts->data;
+    uint64_t pt = HLC_PHYSICAL(data->hlc);
+    uint64_t now = local_physical(data);
+    
+    if (now > pt) {
+        data->hlc = HLC_PACK(now, 0);
+    } else {
+        data->hlc = hlc_advance(pt, HLC_LOGICAL(data->hlc) + 1);
+    }
+}
+
+int hlc_recv(Timestamp *ts, uint64_t remote) {
+    HlcClockData *data = (HlcClockData*)ts->data;
+    uint64_t pt = HLC_PHYSICAL(data->hlc), l = HLC_LOGICAL(data->hlc);
+    uint64_t mpt = HLC_PHYSICAL(remote), ml = HLC_LOGICAL(remote);
+    uint64_t now = local_physical(data);
+    
+    // A sender this far ahead would drag our clock away from physical time
+    if (mpt > now + max_drift_ms) {
+        data->drift_rejections++;
+        return 0;
+    }
+    
+    uint64_t npt = pt > mpt ? pt : mpt;
+    if (now > npt) npt = now;
+    
+    if (npt == pt && npt == mpt) {
+        data->hlc = hlc_advance(npt, (l > ml ? l : ml) + 1);
+    } else if (npt == pt) {
+        data->hlc = hlc_advance(npt, l + 1);
+    } else if (npt == mpt) {
+        data->hlc = hlc_advance(npt, ml + 1);
+    } else {
+        data->hlc = HLC_PACK(npt, 0);
+    }
+    return 1;
+}
+
+void hlc_increment(Timestamp *ts) {
+    hlc_send(ts);
+}
+
+void hlc_merge(Timestamp *dst, const void *other_data, size_t other_size) {
+    uint64_t remote;
+    
+    if (other_size != sizeof(remote)) {
+        return;
+    }
+    memcpy(&remote, other_data, sizeof(remote));
+    hlc_recv(dst, remote);
+}
+
+TSOrder hlc_compare(const Timestamp *a, const Timestamp *b) {
+    uint64_t ha = ((const HlcClockData*)a->data)->hlc;
+    uint64_t hb = ((const HlcClockData*)b->data)->hlc;
+    
+    if (ha < hb) return TS_BEFORE;
+    if (ha > hb) return TS_AFTER;
+    return a->pid == b->pid ? TS_EQUAL : TS_CONCURRENT;
+}
+
+size_t hlc_serialize(const Timestamp *ts, void *buffer, size_t bufsize) {
+    const HlcClockData *data = (const HlcClockData*)ts->data;
+    size_t required = sizeof(data->hlc);
+    
+    if (bufsize >= required) {
+        memcpy(buffer, &data->hlc, required);
+    }
+    return required;
+}
+
+void hlc_deserialize(Timestamp *ts, const void *buffer, size_t size) {
+    HlcClockData *data = (HlcClockData*)ts->data;
+    
+    if (size == sizeof(data->hlc)) {
+        memcpy(&data->hlc, buffer, sizeof(data->hlc));
+    }
+}
+
+void hlc_to_string(const Timestamp *ts, char *buf, size_t bufsize) {
+    const HlcClockData *data = (const HlcClockData*)ts->data;
+    snprintf(buf, bufsize, "H:%llu.%llu", (unsigned long long)HLC_PHYSICAL(data->hlc),
+             (unsigned long long)HLC_LOGICAL(data->hlc));
+}
+
+Timestamp hlc_clone_in(ClockArena *arena, const Timestamp *ts) {
+    Timestamp clone = hlc_create_in(arena, ts->n, ts->pid, ts->type);
+    memcpy(clone.data, ts->data, sizeof(HlcClockData));
+    return clone;
+}
+
+Timestamp hlc_clone(const Timestamp *ts) {
+    return hlc_clone_in(NULL, ts);
+}
+
+/* ---------- Operations Table ---------- */
+
+const TimestampOps HLC_OPS = {
+    .create = hlc_create,
+    .destroy = hlc_destroy,
+    .increment = hlc_increment,
+    .merge = hlc_merge,
+    .compare = hlc_compare,
+    .serialize = hlc_serialize,
+    .serialize_for_dest = NULL,  // Constant size, nothing to tailor per destination
+    .deserialize = hlc_deserialize,
+    .to_string = hlc_to_string,
+    .clone = hlc_clone,
+    .to_vector = NULL,  // No per-process counters
+    .create_in = hlc_create_in,
+    .clone_in = hlc_clone_in,
+    .merge_and_tick = hlc_merge  // the HLC receive rule is the merge
+};
@@ -0,0 +1,627 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "itc_clock.h"
+
+// Grow prefers any path through the existing tree over expanding a leaf
+#define ITC_GROW_EXPAND (1LL << 20)
+#define ITC_GROW_NEVER (1LL << 40)
+
+/* ---------- Tree Allocation ---------- */
+
+static void* itc_alloc(size_t size) {
+    void *p = malloc(size);
+    if (!p) {
+        fprintf(stderr, "OOM\n");
+        exit(1);
+    }
+    return p;
+}
+
+static ItcId* id_leaf(int value) {
+    ItcId *i = (ItcId*)itc_alloc(sizeof(ItcId));
+    i->value = value;
+    i->l = i->r = NULL;
+    return i;
+}
+
+static ItcId* id_node(ItcId *l, ItcId *r) {
+    ItcId *i = (ItcId*)itc_alloc(sizeof(ItcId));
+    i->value = 0;
+    i->l = l;
+    i->r = r;
+    return i;
+}
+
+static void id_free(ItcId *i) {
+    if (!i) return;
+    id_free(i->l);
+    id_free(i->r);
+    free(i);
+}
+
+static ItcId* id_copy(const ItcId *i) {
+    if (!i->l) return id_leaf(i->value);
+    return id_node(id_copy(i->l), id_copy(i->r));
+}
+
+static int id_is_leaf(const ItcId *i, int value) {
+    return !i->l && i->value == value;
+}
+
+static ItcEvent* ev_leaf(int n) {
+    ItcEvent *e = (ItcEvent*)itc_alloc(sizeof(ItcEvent));
+    e->n = n;
+    e->l = e->r = NULL;
+    return e;
+}
+
+static ItcEvent* ev_node(int n, ItcEvent *l, ItcEvent *r) {
+    ItcEvent *e = (ItcEvent*)itc_alloc(sizeof(ItcEvent));
+    e->n = n;
+    e->l = l;
+    e->r = r;
+    return e;
+}
+
+static void ev_free(ItcEvent *e) {
+    if (!e) return;
+    ev_free(e->l);
+    ev_free(e->r);
+    free(e);
+}
+
+static ItcEvent* ev_copy(const ItcEvent *e) {
+    if (!e->l) return ev_leaf(e->n);
+    return ev_node(e->n, ev_copy(e->l), ev_copy(e->r));
+}
+
+static int ev_equal(const ItcEvent *a, const ItcEvent *b) {
+    if (a->n != b->n || !a->l != !b->l) return 0;
+    return !a->l || (ev_equal(a->l, b->l) && ev_equal(a->r, b->r));
+}
+
+/* ---------- Normalization ---------- */
+
+// (0, 0) -> 0 and (1, 1) -> 1; children must already be normal
+static ItcId* id_norm(ItcId *i) {
+    if (i->l && !i->l->l && !i->r->l && i->l->value == i->r->value) {
+        int value = i->l->value;
+        id_free(i->l);
+        id_free(i->r);
+        i->l = i->r = NULL;
+        i->value = value;
+    }
+    return i;
+}
+
+// (n, m, m) -> n + m, otherwise sink the children's common minimum into the base.
+// Children must already be normal, so each child's minimum is its own base.
+static ItcEvent* ev_norm(ItcEvent *e) {
+    if (!e->l) return e;
+    if (!e->l->l && !e->r->l && e->l->n == e->r->n) {
+        e->n += e->l->n;
+        ev_free(e->l);
+        ev_free(e->r);
+        e->l = e->r = NULL;
+        return e;
+    }
+    int m = e->l->n < e->r->n ? e->l->n : e->r->n;
+    e->n += m;
+    e->l->n -= m;
+    e->r->n -= m;
+    return e;
+}
+
+static int ev_min(const ItcEvent *e) {
+    return e->n;  // normal trees keep a zero-minimum child under every node
+}
+
+static int ev_max(const ItcEvent *e) {
+    if (!e->l) return e->n;
+    int l = ev_max(e->l), r = ev_max(e->r);
+    return e->n + (l > r ? l : r);
+}
+
+/* ---------- Id Algebra ---------- */
+
+// Two disjoint ids whose union is i
+static void id_split(const ItcId *i, ItcId **a, ItcId **b) {
+    if (!i->l) {
+        if (i->value == 0) {
+            *a = id_leaf(0);
+            *b = id_leaf(0);
+        } else {
+            *a = id_node(id_leaf(1), id_leaf(0));
+            *b = id_node(id_leaf(0), id_leaf(1));
+        }
+    } else if (id_is_leaf(i->l, 0)) {
+        ItcId *r1, *r2;
+        id_split(i->r, &r1, &r2);
+        *a = id_node(id_leaf(0), r1);
+        *b = id_node(id_leaf(0), r2);
+    } else if (id_is_leaf(i->r, 0)) {
+        ItcId *l1, *l2;
+        id_split(i->l, &l1, &l2);
+        *a = id_node(l1, id_leaf(0));
+        *b = id_node(l2, id_leaf(0));
+    } else {
+        *a = id_node(id_copy(i->l), id_leaf(0));
+        *b = id_node(id_leaf(0), id_copy(i->r));
+    }
+}
+
+// Union of two ids; consumes both
+static ItcId* id_sum(ItcId *a, ItcId *b) {
+    if (id_is_leaf(a, 0)) {
+        id_free(a);
+        return b;
+    }
+    if (id_is_leaf(b, 0)) {
+        id_free(b);
+        return a;
+    }
+    if (!a->l || !b->l) {
+        // Overlapping ids (only possible with a duplicated stamp): the union owns everything
+        id_free(a);
+        id_free(b);
+        return id_leaf(1);
+    }
+    ItcId *sum = id_node(id_sum(a->l, b->l), id_sum(a->r, b->r));
+    free(a);
+    free(b);
+    return id_norm(sum);
+}
+
+/* ---------- Event Algebra ---------- */
+
+static const ItcEvent ITC_ZERO = {0, NULL, NULL};
+
+// Pointwise max of a + ao and b + bo, as a new normal tree
+static ItcEvent* ev_join(const ItcEvent *a, int ao, const ItcEvent *b, int bo) {
+    int an = a->n + ao, bn = b->n + bo;
+    if (!a->l && !b->l) {
+        return ev_leaf(an > bn ? an : bn);
+    }
+    if (an > bn) {
+        const ItcEvent *t = a;
+        a = b;
+        b = t;
+        int tn = an;
+        an = bn;
+        bn = tn;
+    }
+    // A leaf joins as (n, 0, 0)
+    const ItcEvent *al = a->l ? a->l : &ITC_ZERO, *ar = a->r ? a->r : &ITC_ZERO;
+    const ItcEvent *bl = b->l ? b->l : &ITC_ZERO, *br = b->r ? b->r : &ITC_ZERO;
+    return ev_norm(ev_node(an, ev_join(al, 0, bl, bn - an), ev_join(ar, 0, br, bn - an)));
+}
+
+// Pointwise a + ao <= b + bo
+static int ev_leq(const ItcEvent *a, int ao, const ItcEvent *b, int bo) {
+    int an = a->n + ao, bn = b->n + bo;
+    if (an > bn) return 0;
+    if (!a->l) return 1;
+    if (!b->l) return ev_leq(a->l, an, b, bo) && ev_leq(a->r, an, b, bo);
+    return ev_leq(a->l, an, b->l, bn) && ev_leq(a->r, an, b->r, bn);
+}
+
+// Raise the owned parts of e as far as possible without exceeding existing counters.
+// Consumes e and returns the normal result.
+static ItcEvent* ev_fill(const ItcId *i, ItcEvent *e) {
+    if (id_is_leaf(i, 0) || !e->l) {
+        return e;
+    }
+    if (id_is_leaf(i, 1)) {
+        int m = ev_max(e);
+        ev_free(e->l);
+        ev_free(e->r);
+        e->l = e->r = NULL;
+        e->n = m;
+        return e;
+    }
+    if (id_is_leaf(i->l, 1)) {
+        e->r = ev_fill(i->r, e->r);
+        int m = ev_max(e->l) > ev_min(e->r) ? ev_max(e->l) : ev_min(e->r);
+        ev_free(e->l);
+        e->l = ev_leaf(m);
+    } else if (id_is_leaf(i->r, 1)) {
+        e->l = ev_fill(i->l, e->l);
+        int m = ev_max(e->r) > ev_min(e->l) ? ev_max(e->r) : ev_min(e->l);
+        ev_free(e->r);
+        e->r = ev_leaf(m);
+    } else {
+        e->l = ev_fill(i->l, e->l);
+        e->r = ev_fill(i->r, e->r);
+    }
+    return ev_norm(e);
+}
+
+// Cost of the cheapest single-counter increment under i: tree depth touched, with
+// leaf expansion priced so high it is only chosen when nothing else is owned
+static long long ev_grow_cost(const ItcId *i, const ItcEvent *e) {
+    if (id_is_leaf(i, 0)) return ITC_GROW_NEVER;
+    if (!i->l) return 0;
+    if (!e->l) {
+        ItcEvent expanded = {e->n, (ItcEvent*)&ITC_ZERO, (ItcEvent*)&ITC_ZERO};
+        return ev_grow_cost(i, &expanded) + ITC_GROW_EXPAND;
+    }
+    long long l = ev_grow_cost(i->l, e->l), r = ev_grow_cost(i->r, e->r);
+    return (l < r ? l : r) + 1;
+}
+
+// Increment one owned counter along the cheapest path, in place
+static ItcEvent* ev_grow(const ItcId *i, ItcEvent *e) {
+    if (!i->l) {
+        // Owns the whole interval: flatten to the max and bump it
+        int m = ev_max(e);
+        ev_free(e->l);
+        ev_free(e->r);
+        e->l = e->r = NULL;
+        e->n = m + 1;
+        return e;
+    }
+    if (!e->l) {
+        e->l = ev_leaf(0);
+        e->r = ev_leaf(0);
+    }
+    if (ev_grow_cost(i->l, e->l) <= ev_grow_cost(i->r, e->r)) {
+        e->l = ev_grow(i->l, e->l);
+    } else {
+        e->r = ev_grow(i->r, e->r);
+    }
+    return ev_norm(e);
+}
+
+/* ---------- Binary Encoding ---------- */
+
+// Stamps are bit-packed, most significant bit first:
+//   id:    leaf = 0 v (1 bit value)   node = 1 <l> <r>
+//   event: leaf = 0 N(n)              node = 1 (0 | 1 N(n-1)) <l> <r>
+// where N(x) is the Elias gamma code of x + 1. The last byte is zero-padded.
+
+typedef struct {
+    uint8_t *buf;       // NULL to only count bits
+    size_t cap;         // bytes available
+    size_t bits;
+} BitWriter;
+
+static void put_bit(BitWriter *w, int bit) {
+    if (w->buf && w->bits / 8 < w->cap) {
+        if (w->bits % 8 == 0) w->buf[w->bits / 8] = 0;
+        if (bit) w->buf[w->bits / 8] |= (uint8_t)(0x80 >> (w->bits % 8));
+    }
+    w->bits++;
+}
+
+static void put_num(BitWriter *w, int n) {
+    uint32_t v = (uint32_t)n + 1;
+    int k = 31 - __builtin_clz(v);
+    for (int b = 0; b < k; b++) put_bit(w, 0);
+    for (int b = k; b >= 0; b--) put_bit(w, (v >> b) & 1);
+}
+
+static void put_id(BitWriter *w, const ItcId *i) {
+    if (!i->l) {
+        put_bit(w, 0);
+        put_bit(w, i->value);
+        return;
+    }
+    put_bit(w, 1);
+    put_id(w, i->l);
+    put_id(w, i->r);
+}
+
+static void put_event(BitWriter *w, const ItcEvent *e) {
+    if (!e->l) {
+        put_bit(w, 0);
+        put_num(w, e->n);
+        return;
+    }
+    put_bit(w, 1);
+    if (e->n == 0) {
+        put_bit(w, 0);
+    } else {
+        put_bit(w, 1);
+        put_num(w, e->n - 1);
+    }
+    put_event(w, e->l);
+    put_event(w, e->r);
+}
+
+typedef struct {
+    const uint8_t *buf;
+    size_t bits;        // bits available
+    size_t pos;
+} BitReader;
+
+static int get_bit(BitReader *r) {
+    if (r->pos >= r->bits) return -1;
+    int bit = (r->buf[r->pos / 8] >> (7 - r->pos % 8)) & 1;
+    r->pos++;
+    return bit;
+}
+
+static int get_num(BitReader *r, int *n) {
+    int k = 0, bit;
+    while ((bit = get_bit(r)) == 0) {
+        if (++k > 30) return 0;
+    }
+    if (bit < 0) return 0;
+    uint32_t v = 1;
+    for (int b = 0; b < k; b++) {
+        if ((bit = get_bit(r)) < 0) return 0;
+        v = (v << 1) | (uint32_t)bit;
+    }
+    *n = (int)(v - 1);
+    return 1;
+}
+
+static ItcId* get_id(BitReader *r, int depth) {
+    int bit = get_bit(r);
+    if (bit < 0 || depth > ITC_MAX_DEPTH) return NULL;
+    if (bit == 0) {
+        int value = get_bit(r);
+        return value < 0 ? NULL : id_leaf(value);
+    }
+    ItcId *l = get_id(r, depth + 1);
+    ItcId *rr = l ? get_id(r, depth + 1) : NULL;
+    if (!rr) {
+        id_free(l);
+        return NULL;
+    }
+    return id_norm(id_node(l, rr));
+}
+
+static ItcEvent* get_event(BitReader *r, int depth) {
+    int bit = get_bit(r), n = 0;
+    if (bit < 0 || depth > ITC_MAX_DEPTH) return NULL;
+    if (bit == 0) {
+        return get_num(r, &n) ? ev_leaf(n) : NULL;
+    }
+    int has_base = get_bit(r);
+    if (has_base < 0 || (has_base && !get_num(r, &n))) return NULL;
+    n += has_base;
+    ItcEvent *l = get_event(r, depth + 1);
+    ItcEvent *rr = l ? get_event(r, depth + 1) : NULL;
+    if (!rr) {
+        ev_free(l);
+        return NULL;
+    }
+    // Senders emit normal trees; normalizing again keeps hand-made input canonical
+    return ev_norm(ev_node(n, l, rr));
+}
+
+static size_t encode_stamp(const ItcId *id, const ItcEvent *event, void *buffer, size_t bufsize) {
+    BitWriter count = {NULL, 0, 0};
+    put_id(&count, id);
+    put_event(&count, event);
+    size_t required = (count.bits + 7) / 8;
+
+    if (bufsize >= required) {
+        BitWriter w = {(uint8_t*)buffer, bufsize, 0};
+        put_id(&w, id);
+        put_event(&w, event);
+    }
+    return required;
+}
+
+static int decode_stamp(const void *buffer, size_t size, ItcId **id, ItcEvent **event) {
+    BitReader r = {(const uint8_t*)buffer, size * 8, 0};
+    *id = get_id(&r, 0);
+    if (!*id) return 0;
+    *event = get_event(&r, 0);
+    if (!*event) {
+        id_free(*id);
+        return 0;
+    }
+    return 1;
+}
+
+/* ---------- Interval Tree Clock Implementation ---------- */
+
+static Timestamp itc_wrap(int n, int pid, ClockType type, ItcId *id, ItcEvent *event) {
+    Timestamp ts;
+    ts.n = n;
+    ts.pid = pid;
+    ts.type = type;
+    clock_digest_none(&ts.digest);
+    ts.wire = WIRE_RAW;  // fork and peek hand out stamps without going through ts_create
+    ts.ops = &ITC_OPS;
+    ts.pending = NULL;
+
+    ItcClockData *data = (ItcClockData*)itc_alloc(sizeof(ItcClockData));
+    data->id = id;
+    data->event = event;
+
+    ts.data = data;
+    ts.data_size = 0; // Dynamic size based on tree shape
+    return ts;
+}
+
+Timestamp itc_create(int n, int pid, ClockType type) {
+    // Slot pid owns leaf pid of a complete tree deep enough for n slots; leaves past n
+    // stay unowned until a fork hands them out
+    int depth = 0;
+    while ((1 << depth) < n) depth++;
+
+    ItcId *id = id_leaf(1);
+    for (int level = 0; level < depth; level++) {
+        if ((pid >> level) & 1) id = id_node(id_leaf(0), id);
+        else id = id_node(id, id_leaf(0));
+    }
+    return itc_wrap(n, pid, type, id, ev_leaf(0));
+}
+
+void itc_destroy(Timestamp *ts) {
+    if (ts && ts->data) {
+        ItcClockData *data = (ItcClockData*)ts->data;
+        id_free(data->id);
+        ev_free(data->event);
+        free(ts->data);
+        ts->data = NULL;
+    }
+}
+
+void itc_increment(Timestamp *ts) {
+    ItcClockData *data = (ItcClockData*)ts->data;
+    if (id_is_leaf(data->id, 0)) {
+        return;  // Anonymous stamps cannot record events
+    }
+
+    // Fill the owned parts up to what is already known; grow one counter only if that
+    // does not inflate anything
+    ItcEvent *before = ev_copy(data->event);
+    data->event = ev_fill(data->id, data->event);
+    if (ev_equal(before, data->event)) {
+        data->event = ev_grow(data->id, data->event);
+    }
+    ev_free(before);
+}
+
+void itc_merge(Timestamp *dst, const void *other_data, size_t other_size) {
+    ItcClockData *data = (ItcClockData*)dst->data;
+    ItcId *id;
+    ItcEvent *event;
+
+    if (!decode_stamp(other_data, other_size, &id, &event)) {
+        return;
+    }
+
+    // Join: union of ids (a peek carries id 0) and pointwise max of events
+    data->id = id_sum(data->id, id);
+    ItcEvent *joined = ev_join(data->event, 0, event, 0);
+    ev_free(data->event);
+    ev_free(event);
+    data->event = joined;
+}
+
+TSOrder itc_compare(const Timestamp *a, const Timestamp *b) {
+    const ItcEvent *ea = ((const ItcClockData*)a->data)->event;
+    const ItcEvent *eb = ((const ItcClockData*)b->data)->event;
+    int a_le_b = ev_leq(ea, 0, eb, 0);
+    int b_le_a = ev_leq(eb, 0, ea, 0);
+
+    if (a_le_b && b_le_a) return TS_EQUAL;
+    if (a_le_b) return TS_BEFORE;
+    if (b_le_a) return TS_AFTER;
+    return TS_CONCURRENT;
+}
+
+size_t itc_serialize(const Timestamp *ts, void *buffer, size_t bufsize) {
+    const ItcClockData *data = (const ItcClockData*)ts->data;
+    return encode_stamp(data->id, data->event, buffer, bufsize);
+}
+
+size_t itc_serialize_for_dest(const Timestamp *ts, int dest, void *buffer, size_t bufsize) {
+    (void)dest;
+    // Messages carry a peek: the receiver joins causal history, never the sender's id
+    static const ItcId anonymous = {0, NULL, NULL};
+    const ItcClockData *data = (const ItcClockData*)ts->data;
+    return encode_stamp(&anonymous, data->event, buffer, bufsize);
+}
+
+void itc_deserialize(Timestamp *ts, const void *buffer, size_t size) {
+    ItcClockData *data = (ItcClockData*)ts->data;
+    ItcId *id;
+    ItcEvent *event;
+
+    if (decode_stamp(buffer, size, &id, &event)) {
+        id_free(data->id);
+        ev_free(data->event);
+        data->id = id;
+        data->event = event;
+    }
+}
+
+static void append(char *buf, size_t bufsize, size_t *used, const char *fmt, int value) {
+    if (*used < bufsize) {
+        *used += snprintf(buf + *used, bufsize - *used, fmt, value);
+    }
+}
+
+static void id_to_string(const ItcId *i, char *buf, size_t bufsize, size_t *used) {
+    if (!i->l) {
+        append(buf, bufsize, used, "%d", i->value);
+        return;
+    }
+    append(buf, bufsize, used, "(", 0);
+    id_to_string(i->l, buf, bufsize, used);
+    append(buf, bufsize, used, ",", 0);
+    id_to_string(i->r, buf, bufsize, used);
+    append(buf, bufsize, used, ")", 0);
+}
+
+static void ev_to_string(const ItcEvent *e, char *buf, size_t bufsize, size_t *used) {
+    if (!e->l) {
+        append(buf, bufsize, used, "%d", e->n);
+        return;
+    }
+    append(buf, bufsize, used, "(%d,", e->n);
+    ev_to_string(e->l, buf, bufsize, used);
+    append(buf, bufsize, used, ",", 0);
+    ev_to_string(e->r, buf, bufsize, used);
+    append(buf, bufsize, used, ")", 0);
+}
+
+void itc_to_string(const Timestamp *ts, char *buf, size_t bufsize) {
+    const ItcClockData *data = (const ItcClockData*)ts->data;
+    size_t used = 0;
+
+    if (bufsize == 0) return;
+    buf[0] = '\0';
+    append(buf, bufsize, &used, "I:", 0);
+    id_to_string(data->id, buf, bufsize, &used);
+    append(buf, bufsize, &used, " E:", 0);
+    ev_to_string(data->event, buf, bufsize, &used);
+}
+
+Timestamp itc_clone(const Timestamp *ts) {
+    const ItcClockData *data = (const ItcClockData*)ts->data;
+    return itc_wrap(ts->n, ts->pid, ts->type, id_copy(data->id), ev_copy(data->event));
+}
+
+/* ---------- Dynamic Membership ---------- */
+
+Timestamp itc_fork(Timestamp *ts) {
+    ItcClockData *data = (ItcClockData*)ts->data;
+    ItcId *mine, *theirs;
+
+    id_split(data->id, &mine, &theirs);
+    id_free(data->id);
+    data->id = mine;
+    return itc_wrap(ts->n, ts->pid, ts->type, theirs, ev_copy(data->event));
+}
+
+Timestamp itc_peek(const Timestamp *ts) {
+    const ItcClockData *data = (const ItcClockData*)ts->data;
+    return itc_wrap(ts->n, ts->pid, ts->type, id_leaf(0), ev_copy(data->event));
+}
+
+void itc_retire(Timestamp *ts) {
+    ItcClockData *data = (ItcClockData*)ts->data;
+    id_free(data->id);
+    data->id = id_leaf(0);
+}
+
+int itc_has_id(const Timestamp *ts) {
+    const ItcClockData *data = (const ItcClockData*)ts->data;
+    return !id_is_leaf(data->id, 0);
+}
+
+/* ---------- Operations Table ---------- */
+
+const TimestampOps ITC_OPS = {
+    .create = itc_create,
+    .destroy = itc_destroy,
+    .increment = itc_increment,
+    .merge = itc_merge,
+    .compare = itc_compare,
+    .serialize = itc_serialize,
+    .serialize_for_dest = itc_serialize_for_dest,
+    .deserialize = itc_deserialize,
+    .to_string = itc_to_string,
+    .clone = itc_clone,
+    .to_vector = NULL  // No fixed process set to expand into
+};
@@ -0,0 +1,124 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "lamport_clock.h"
+
+/* ---------- Lamport Clock Implementation ---------- */
+
+Timestamp lamport_create_in(ClockArena *arena, int n, int pid, ClockType type) {
+    Timestamp ts;
+    ts.n = n;
+    ts.pid = pid;
+    ts.type = type;
+    clock_digest_none(&ts.digest);
+    
+    LamportClockData *data = clock_block_alloc(arena, sizeof(LamportClockData));
+    data->counter = 0;
+    
+    ts.data = data;
+    ts.data_size = sizeof(uint64_t);
+    return ts;
+}
+
+Timestamp lamport_create(int n, int pid, ClockType type) {
+    return lamport_create_in(NULL, n, pid, type);
+}
+
+void lamport_destroy(Timestamp *ts) {
+    if (ts && ts->data) {
+        clock_block_free(ts->data);
+        ts->data = NULL;
+    }
+}
+
+void lamport_increment(Timestamp *ts) {
+    ((LamportClockData*)ts->data)->counter++;
+}
+
+void lamport_merge(Timestamp *dst, const void *other_data, size_t other_size) {
+    LamportClockData *data = (LamportClockData*)dst->data;
+    uint64_t remote;
+    
+    if (other_size != sizeof(remote)) {
+        return;
+    }
+    memcpy(&remote, other_data, sizeof(remote));
+    if (remote > data->counter) {
+        data->counter = remote;
+    }
+}
+
+void lamport_merge_and_tick(Timestamp *dst, const void *other_data, size_t other_size) {
+    lamport_merge(dst, other_data, other_size);
+    lamport_increment(dst);
+}
+
+TSOrder lamport_compare(const Timestamp *a, const Timestamp *b) {
+    uint64_t ca = ((const LamportClockData*)a->data)->counter;
+    uint64_t cb = ((const LamportClockData*)b->data)->counter;
+    
+    if (ca < cb) return TS_BEFORE;
+    if (ca > cb) return TS_AFTER;
+    return a->pid == b->pid ? TS_EQUAL : TS_CONCURRENT;
+}
+
+TSOrder lamport_total_order(const Timestamp *a, const Timestamp *b) {
+    TSOrder order = lamport_compare(a, b);
+    
+    if (order != TS_CONCURRENT) {
+        return order;
+    }
+    return a->pid < b->pid ? TS_BEFORE : TS_AFTER;
+}
+
+size_t lamport_serialize(const Timestamp *ts, void *buffer, size_t bufsize) {
+    const LamportClockData *data = (const LamportClockData*)ts->data;
+    size_t required = sizeof(data->counter);
+    
+    if (bufsize >= required) {
+        memcpy(buffer, &data->counter, required);
+    }
+    return required;
+}
+
+void lamport_deserialize(Timestamp *ts, const void *buffer, size_t size) {
+    LamportClockData *data = (LamportClockData*)ts->data;
+    
+    if (size == sizeof(data->counter)) {
+        memcpy(&data->counter, buffer, sizeof(data->counter));
+    }
+}
+
+void lamport_to_string(const Timestamp *ts, char *buf, size_t bufsize) {
+    const LamportClockData *data = (const LamportClockData*)ts->data;
+    snprintf(buf, bufsize, "L:%llu.%d", (unsigned long long)data->counter, ts->pid);
+}
+
+Timestamp lamport_clone_in(ClockArena *arena, const Timestamp *ts) {
+    Timestamp clone = lamport_create_in(arena, ts->n, ts->pid, ts->type);
+    memcpy(clone.data, ts->data, sizeof(LamportClockData));
+    return clone;
+}
+
+Timestamp lamport_clone(const Timestamp *ts) {
+    return lamport_clone_in(NULL, ts);
+}
+
+/* ---------- Operations Table ---------- */
+
+const TimestampOps LAMPORT_OPS = {
+    .create = lamport_create,
+    .destroy = lamport_destroy,
+    .increment = lamport_increment,
+    .merge = lamport_merge,
+    .compare = lamport_compare,
+    .serialize = lamport_serialize,
+    .serialize_for_dest = NULL,  // Constant size, nothing to tailor per destination
+    .deserialize = lamport_deserialize,
+    .to_string = lamport_to_string,
+    .clone = lamport_clone,
+    .to_vector = NULL,  // No per-process counters
+    .create_in = lamport_create_in,
+    .clone_in = lamport_clone_in,
+    .merge_and_tick = lamport_merge_and_tick
+};
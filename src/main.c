@@ -2,29 +2,83 @@
 #include <stdlib.h>
 #include <string.h>
 #include <pthread.h>
+#include <sys/resource.h>
 #include "timestamp.h"
 #include "message_queue.h"
 #include "simulation.h"
+#include "encoded_clock.h"
+#include "compressed_clock.h"
+#include "hlc_clock.h"
+#include "plausible_clock.h"
+#include "bloom_clock.h"
 #include "config.h"
 
 /* ---------- Help and Usage ---------- */
 
 void print_usage(const char* prog_name) {
-    printf("Usage: %s [num_processes] [steps_per_process] [clock_type]\n\n", prog_name);
+    printf("Usage: %s [options] [num_processes] [steps_per_process] [clock_type]\n\n", prog_name);
     printf("Parameters:\n");
     printf("  num_processes     : Number of simulated processes (default: %d, min: 2)\n", DEFAULT_PROCESSES);
     printf("  steps_per_process : Number of steps per process (default: %d)\n", DEFAULT_STEPS);
     printf("  clock_type       : Clock implementation type (default: 0)\n\n");
     printf("Clock Types:\n");
-    for (int i = 0; i < 5; i++) {
+    for (int i = 0; i < CLOCK_TYPE_COUNT; i++) {
         printf("  %d - %s: %s\n", i, clock_type_names[i], clock_type_descriptions[i]);
     }
+    printf("\nOptions:\n");
+    printf("  --compact        : Send timestamps in the compact varint wire format\n");
+    printf("  --churn          : Processes fork new processes and retire during the run\n");
+    printf("                     (up to %d times num_processes ever created)\n", CHURN_CAPACITY_FACTOR);
+    printf("  --encoded-limit=BYTES : Encoded clocks switch to vector form above this size\n");
+    printf("                          (default: the vector size, num_processes * %zu)\n", sizeof(int));
+    printf("  --compressed-destinations=K : Compressed clocks keep delta state for at most K\n");
+    printf("                                destinations, evicting the least recently used\n");
+    printf("  --value-deltas   : Compressed clocks send vt[k] - tau[dest][k] instead of vt[k]\n");
+    printf("                     (needs FIFO, lossless channels: not with --churn)\n");
+    printf("  --plausible-entries=R : Plausible clocks fold processes into R entries (default: %d)\n",
+           PLAUSIBLE_DEFAULT_ENTRIES);
+    printf("  --bloom-cells=M  : Bloom clocks use M counters (default: %d)\n", BLOOM_DEFAULT_CELLS);
+    printf("  --bloom-hashes=K : Bloom clocks set K cells per event (default: %d)\n", BLOOM_DEFAULT_HASHES);
+    printf("  --hlc-skew=MS    : HLC processes get physical clocks skewed by up to +/-MS (default: %d)\n",
+           HLC_SIM_SKEW_MS);
+    printf("  --hlc-max-drift=MS : HLC rejects messages this far ahead of local time (default: %d)\n",
+           HLC_DEFAULT_MAX_DRIFT_MS);
+    printf("  --huge-pages     : Back the per-process clock arenas with transparent huge pages\n");
+    printf("  --deferred       : Standard, differential and compressed clocks queue receives and\n");
+    printf("                     local ticks, applying them when the clock is next read\n");
+    printf("  --report         : Instead of the simulation, replay one workload on every clock type\n");
+    printf("                     and compare bytes/message and ns/event to Lamport and standard\n");
+    printf("                     (num_processes * steps_per_process events, at least %d)\n", REPORT_MIN_EVENTS);
     printf("\nExample: %s 5 20 1    # 5 processes, 20 steps each, sparse clocks\n", prog_name);
 }
 
 /* ---------- Performance Display ---------- */
 
-void display_performance_stats(int n, ClockType clock_type) {
+// Average timestamp size per step range next to a standard vector sized for every process
+// created so far, which is what a fixed-n vector clock would need to cover the same history
+static void display_size_over_time(int steps) {
+    printf("\nClock Size Over Time:\n");
+    printf("%-13s %8s %10s %8s %14s\n", "Steps", "Messages", "Avg bytes", "Members", "Vector bytes");
+    int members = 0;
+    for (int b = 0; b < SIZE_BUCKETS; b++) {
+        int lo = b * steps / SIZE_BUCKETS;
+        int hi = (b + 1) * steps / SIZE_BUCKETS - 1;
+        if (perf_stats.bucket_members[b] > members) members = perf_stats.bucket_members[b];
+        if (hi < lo) continue;
+        
+        char range[32];
+        snprintf(range, sizeof(range), "%d-%d", lo, hi);
+        if (perf_stats.bucket_messages[b] == 0) {
+            printf("%-13s %8d %10s %8d %14zu\n", range, 0, "-", members, members * sizeof(int));
+        } else {
+            printf("%-13s %8d %10.2f %8d %14zu\n", range, perf_stats.bucket_messages[b],
+                   (double)perf_stats.bucket_bytes[b] / perf_stats.bucket_messages[b],
+                   members, members * sizeof(int));
+        }
+    }
+}
+
+void display_performance_stats(int n, ClockType clock_type, WireFormat wire_format) {
     // Display performance statistics
     printf("\n=== Performance Statistics ===\n");
     printf("Total messages sent: %d\n", perf_stats.total_messages);
@@ -36,7 +90,8 @@ void display_performance_stats(int n, ClockType clock_type) {
                (double)perf_stats.total_message_bytes / perf_stats.total_messages);
     }
     
-    // Calculate baseline comparison (standard vector clock for same n)
+    // Calculate baseline comparison (standard vector clock for same n, i.e. every process
+    // ever created when membership changes)
     size_t standard_size = n * sizeof(int);
     printf("\nComparison to Standard Vector Clock:\n");
     printf("Standard timestamp size: %zu bytes\n", standard_size);
@@ -46,6 +101,81 @@ void display_performance_stats(int n, ClockType clock_type) {
                compression_ratio < 1.0 ? 1.0/compression_ratio : compression_ratio,
                compression_ratio < 1.0 ? "(smaller)" : "(larger)");
     }
+    
+    // ...and to the floor: a Lamport clock's single counter
+    size_t lamport_size = sizeof(uint64_t);
+    if (perf_stats.total_messages > 0) {
+        printf("Lamport timestamp size: %zu bytes (average is %.2fx the floor)\n", lamport_size,
+               perf_stats.avg_clock_size / (double)lamport_size);
+    }
+    
+    if (perf_stats.order_checks > 0) {
+        printf("\nOrdering vs. Vector Clock Ground Truth (pairs of send events):\n");
+        printf("Pairs checked: %d\n", perf_stats.order_checks);
+        printf("Concurrent pairs: %d\n", perf_stats.concurrent_pairs);
+        printf("Falsely ordered: %d (%.1f%% of concurrent pairs)\n", perf_stats.false_orderings,
+               perf_stats.concurrent_pairs > 0
+                   ? 100.0 * perf_stats.false_orderings / perf_stats.concurrent_pairs : 0.0);
+        printf("Misordered: %d\n", perf_stats.misorderings);
+    }
+    if (clock_type == CLOCK_HLC) {
+        printf("Messages rejected by drift check (> %llu ms ahead): %d\n",
+               (unsigned long long)hlc_max_drift(), perf_stats.drift_rejections);
+    }
+    
+    // ru_maxrss is in kilobytes on Linux
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    printf("\nMemory:\n");
+    printf("Peak RSS: %ld KB\n", usage.ru_maxrss);
+    if (clock_type == CLOCK_COMPRESSED) {
+        printf("Delta state (tau) across processes: %zu bytes, %d evictions\n",
+               perf_stats.tau_bytes, perf_stats.tau_evictions);
+    }
+    if (clock_type == CLOCK_MATRIX && perf_stats.known_entries > 0) {
+        // What a replicated log could truncate, by each process's own knowledge
+        printf("Log entries seen by every process: %lld of %lld known (%.1f%%), summed over processes\n",
+               perf_stats.min_known_entries, perf_stats.known_entries,
+               100.0 * perf_stats.min_known_entries / perf_stats.known_entries);
+    }
+    printf("Clock arenas: %zu bytes reserved\n", perf_stats.arena_bytes);
+    
+    if (wire_format == WIRE_COMPACT && perf_stats.total_raw_bytes > 0) {
+        long saved = (long)perf_stats.total_raw_bytes - (long)perf_stats.total_wire_bytes;
+        printf("\nCompact Wire Format:\n");
+        printf("Raw-format timestamp bytes: %zu bytes\n", perf_stats.total_raw_bytes);
+        printf("Compact timestamp bytes: %zu bytes\n", perf_stats.total_wire_bytes);
+        printf("Bytes saved: %ld bytes (%.1f%%)\n", saved,
+               100.0 * saved / (double)perf_stats.total_raw_bytes);
+    }
+}
+
+/* ---------- Clock Type Report ---------- */
+
+// Every clock type on the same replayed workload, against the Lamport floor (one counter)
+// and the standard ceiling (one int per process)
+static void display_type_report(int n, int steps, WireFormat wire_format, int deferred) {
+    int events = n * steps > REPORT_MIN_EVENTS ? n * steps : REPORT_MIN_EVENTS;
+    TypeCost costs[CLOCK_TYPE_COUNT];
+    for (int t = 0; t < CLOCK_TYPE_COUNT; t++) {
+        costs[t] = measure_type_cost((ClockType)t, n, events, wire_format, deferred);
+    }
+    const TypeCost *floor = &costs[CLOCK_LAMPORT];
+    const TypeCost *ceiling = &costs[CLOCK_STANDARD];
+    
+    printf("=== Clock Type Report ===\n");
+    printf("Configuration: %d processes, %d events (%d messages), %s wire format%s\n\n", n, events,
+           ceiling->messages, wire_format == WIRE_COMPACT ? "compact" : "raw",
+           deferred ? ", deferred receives" : "");
+    printf("%-13s %10s %10s %10s %10s %10s %10s\n", "Type", "Bytes/msg", "x Lamport", "x Standard",
+           "ns/event", "x Lamport", "x Standard");
+    for (int t = 0; t < CLOCK_TYPE_COUNT; t++) {
+        const TypeCost *c = &costs[t];
+        printf("%-13s %10.2f %9.2fx %9.2fx %10.1f %9.2fx %9.2fx\n", clock_type_names[t],
+               c->bytes_per_message, c->bytes_per_message / floor->bytes_per_message,
+               c->bytes_per_message / ceiling->bytes_per_message, c->ns_per_event,
+               c->ns_per_event / floor->ns_per_event, c->ns_per_event / ceiling->ns_per_event);
+    }
 }
 
 /* ---------- Main Demo Driver ---------- */
@@ -54,22 +184,125 @@ int main(int argc, char **argv) {
     int n = DEFAULT_PROCESSES;
     int steps = DEFAULT_STEPS;
     ClockType clock_type = CLOCK_STANDARD;
+    WireFormat wire_format = WIRE_RAW;
+    int churn_enabled = 0;
+    int huge_pages = 0;
+    int report = 0;
+    int deferred = 0;
+    int hlc_skew = HLC_SIM_SKEW_MS;
     
-    // Handle help request
-    if (argc > 1 && (strcmp(argv[1], "-h") == 0 || strcmp(argv[1], "--help") == 0)) {
-        print_usage(argv[0]);
-        return 0;
-    }
-    
-    if (argc >= 2) n = atoi(argv[1]);
-    if (argc >= 3) steps = atoi(argv[2]);
-    if (argc >= 4) {
-        clock_type = (ClockType)atoi(argv[3]);
-        if (clock_type < 0 || clock_type > 4) {
-            fprintf(stderr, "Invalid clock type. Use 0-4.\n");
+    // Options may appear anywhere; everything else is positional
+    int positional = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            print_usage(argv[0]);
+            return 0;
+        }
+        if (strcmp(argv[i], "--compact") == 0) {
+            wire_format = WIRE_COMPACT;
+            continue;
+        }
+        if (strcmp(argv[i], "--churn") == 0) {
+            churn_enabled = 1;
+            continue;
+        }
+        if (strcmp(argv[i], "--huge-pages") == 0) {
+            huge_pages = 1;
+            continue;
+        }
+        if (strcmp(argv[i], "--report") == 0) {
+            report = 1;
+            continue;
+        }
+        if (strcmp(argv[i], "--deferred") == 0) {
+            deferred = 1;
+            continue;
+        }
+        if (strncmp(argv[i], "--encoded-limit=", 16) == 0) {
+            long limit = atol(argv[i] + 16);
+            if (limit <= 0) {
+                fprintf(stderr, "Invalid encoded limit: %s\n", argv[i] + 16);
+                return 1;
+            }
+            encoded_set_vector_threshold((size_t)limit);
+            continue;
+        }
+        if (strncmp(argv[i], "--compressed-destinations=", 26) == 0) {
+            int k = atoi(argv[i] + 26);
+            if (k <= 0) {
+                fprintf(stderr, "Invalid destination count: %s\n", argv[i] + 26);
+                return 1;
+            }
+            compressed_set_max_destinations(k);
+            continue;
+        }
+        if (strcmp(argv[i], "--value-deltas") == 0) {
+            compressed_set_value_deltas(1);
+            continue;
+        }
+        if (strncmp(argv[i], "--plausible-entries=", 20) == 0) {
+            int entries = atoi(argv[i] + 20);
+            if (entries <= 0) {
+                fprintf(stderr, "Invalid plausible entry count: %s\n", argv[i] + 20);
+                return 1;
+            }
+            plausible_set_entries(entries);
+            continue;
+        }
+        if (strncmp(argv[i], "--bloom-cells=", 14) == 0) {
+            int cells = atoi(argv[i] + 14);
+            if (cells <= 0) {
+                fprintf(stderr, "Invalid bloom cell count: %s\n", argv[i] + 14);
+                return 1;
+            }
+            bloom_set_params(cells, bloom_hashes());
+            continue;
+        }
+        if (strncmp(argv[i], "--bloom-hashes=", 15) == 0) {
+            int hashes = atoi(argv[i] + 15);
+            if (hashes <= 0) {
+                fprintf(stderr, "Invalid bloom hash count: %s\n", argv[i] + 15);
+                return 1;
+            }
+            bloom_set_params(bloom_cells(), hashes);
+            continue;
+        }
+        if (strncmp(argv[i], "--hlc-skew=", 11) == 0) {
+            hlc_skew = atoi(argv[i] + 11);
+            if (hlc_skew < 0) {
+                fprintf(stderr, "Invalid HLC skew: %s\n", argv[i] + 11);
+                return 1;
+            }
+            continue;
+        }
+        if (strncmp(argv[i], "--hlc-max-drift=", 16) == 0) {
+            long drift = atol(argv[i] + 16);
+            if (drift < 0) {
+                fprintf(stderr, "Invalid HLC drift bound: %s\n", argv[i] + 16);
+                return 1;
+            }
+            hlc_set_max_drift((uint64_t)drift);
+            continue;
+        }
+        if (strncmp(argv[i], "--", 2) == 0) {
+            fprintf(stderr, "Unknown option: %s\n", argv[i]);
             print_usage(argv[0]);
             return 1;
         }
+        
+        switch (positional++) {
+            case 0: n = atoi(argv[i]); break;
+            case 1: steps = atoi(argv[i]); break;
+            case 2:
+                clock_type = (ClockType)atoi(argv[i]);
+                if (clock_type < 0 || clock_type >= CLOCK_TYPE_COUNT) {
+                    fprintf(stderr, "Invalid clock type. Use 0-%d.\n", CLOCK_TYPE_COUNT - 1);
+                    print_usage(argv[0]);
+                    return 1;
+                }
+                break;
+            default: break;
+        }
     }
     
     if (n < 2) { 
@@ -77,67 +310,194 @@ int main(int argc, char **argv) {
         print_usage(argv[0]);
         return 1; 
     }
+    if (churn_enabled && compressed_value_deltas()) {
+        // Messages to retired processes are dropped, and a dropped frame stalls its channel
+        fprintf(stderr, "--value-deltas cannot be combined with --churn.\n");
+        return 1;
+    }
+    if (report) {
+        display_type_report(n, steps, wire_format, deferred);
+        return 0;
+    }
 
-    MsgQueue *queues = (MsgQueue*)malloc(n * sizeof(MsgQueue));
-    for (int i = 0; i < n; i++) mq_init(&queues[i]);
+    // With churn, every process that may ever exist gets a slot (queue, thread, index)
+    int slots = churn_enabled ? n * CHURN_CAPACITY_FACTOR : n;
+    Churn churn;
+    
+    MsgQueue *queues = (MsgQueue*)malloc(slots * sizeof(MsgQueue));
+    for (int i = 0; i < slots; i++) mq_init(&queues[i]);
 
-    ProcCtx *procs = (ProcCtx*)malloc(n * sizeof(ProcCtx));
-    pthread_t *threads = (pthread_t*)malloc(n * sizeof(pthread_t));
+    ProcCtx *procs = (ProcCtx*)malloc(slots * sizeof(ProcCtx));
+    pthread_t *threads = (pthread_t*)malloc(slots * sizeof(pthread_t));
+    if (churn_enabled) {
+        churn_init(&churn, procs, n, slots);
+    }
 
-    for (int i = 0; i < n; i++) {
+    for (int i = 0; i < slots; i++) {
         procs[i].pid = i;
-        procs[i].n = n;
+        procs[i].n = slots;
         procs[i].steps = steps;
         procs[i].current_step = 0;  // Initialize current step
         procs[i].clock_type = clock_type;
-        procs[i].ts = ts_create(n, i, clock_type);
+        procs[i].wire_format = wire_format;
         procs[i].queues = queues;
+        procs[i].churn = churn_enabled ? &churn : NULL;
+        procs[i].ts.data = NULL;  // Slots beyond the initial processes are filled by forks
+        procs[i].truth.data = NULL;
+        clock_arena_init(&procs[i].arena, huge_pages);
+        if (i < n) {
+            // ITC ids only split the initial membership; vector types need an index per slot
+            procs[i].ts = ts_create_in(&procs[i].arena, clock_type == CLOCK_ITC ? n : slots, i, clock_type);
+            ts_set_wire_format(&procs[i].ts, wire_format);
+            ts_set_deferred(&procs[i].ts, deferred);
+            if (needs_ground_truth(clock_type)) {
+                procs[i].truth = ts_create_in(&procs[i].arena, slots, i, CLOCK_STANDARD);
+            }
+            if (clock_type == CLOCK_HLC) {
+                unsigned int seed = (unsigned int)i * 2654435761u + 1;
+                hlc_set_offset(&procs[i].ts, hlc_skew ? rand_in_range(&seed, -hlc_skew, hlc_skew) : 0);
+            }
+        }
     }
 
     printf("=== %s Clock Demo ===\n", clock_type_names[clock_type]);
     printf("Configuration: %d processes, %d steps each\n", n, steps);
-    printf("Description: %s\n\n", clock_type_descriptions[clock_type]);
+    printf("Description: %s\n", clock_type_descriptions[clock_type]);
+    if (clock_type == CLOCK_ENCODED) {
+        printf("Encoded vector switch: above %zu bytes\n", encoded_vector_threshold(slots));
+    }
+    if (clock_type == CLOCK_COMPRESSED) {
+        printf("Tracked destinations per process: %d of %d\n", compressed_max_destinations(slots), slots);
+        if (compressed_value_deltas()) {
+            printf("Value deltas: entries carry vt[k] - tau[dest][k]\n");
+        }
+    }
+    if (churn_enabled) {
+        printf("Membership churn: up to %d processes ever created\n", slots);
+    }
+    if (deferred) {
+        printf("Deferred receives: %s\n", ts_deferred(&procs[0].ts) ? "on (applied when the clock is read)"
+                                                                    : "not supported by this type, off");
+    }
+    if (clock_type == CLOCK_PLAUSIBLE) {
+        printf("Plausible entries: %d (%zu bytes per timestamp)\n", plausible_entries(slots),
+               plausible_entries(slots) * sizeof(int));
+    }
+    if (clock_type == CLOCK_BLOOM) {
+        printf("Bloom filter: %d cells, %d hashes per event (%zu bytes per timestamp)\n",
+               bloom_cells(), bloom_hashes(), bloom_cells() * sizeof(int));
+    }
+    if (clock_type == CLOCK_MATRIX) {
+        printf("Matrix: %d x %d cells (%zu bytes per full timestamp)\n", slots, slots,
+               (1 + (size_t)slots * slots) * sizeof(int));
+    }
+    if (clock_type == CLOCK_HLC) {
+        printf("Physical clock skew: up to +/-%d ms, drift bound %llu ms\n", hlc_skew,
+               (unsigned long long)hlc_max_drift());
+    }
+    printf("Wire format: %s\n\n", wire_format == WIRE_COMPACT ? "compact (varint)" : "raw");
     
     // Reset performance stats
     memset(&perf_stats, 0, sizeof(perf_stats));
 
-    for (int i = 0; i < n; i++) {
+    for (int i = 0; i < slots; i++) {
         pthread_create(&threads[i], NULL, worker, &procs[i]);
     }
-    for (int i = 0; i < n; i++) {
+    for (int i = 0; i < slots; i++) {
         pthread_join(threads[i], NULL);
     }
 
-    // Show pairwise comparisons of final clocks
+    // Show pairwise comparisons of final clocks (every process that existed)
     printf("\n=== Final %s clocks ===\n", clock_type_names[clock_type]);
-    for (int i = 0; i < n; i++) {
+    for (int i = 0; i < slots; i++) {
+        if (!procs[i].ts.data) continue;
         char buf[256];
         ts_to_string(&procs[i].ts, buf, sizeof(buf));
-        printf("P%d: %s\n", i, buf);
+        printf("P%d: %s%s\n", i, buf,
+               churn_enabled && churn.state[i] == SLOT_RETIRED ? " (retired)" : "");
     }
 
     printf("\n=== Pairwise partial order (A ? B) ===\n");
-    for (int i = 0; i < n; i++) {
-        for (int j = i + 1; j < n; j++) {
+    double fp_total = 0.0;
+    int fp_pairs = 0;
+    for (int i = 0; i < slots; i++) {
+        for (int j = i + 1; j < slots; j++) {
+            if (!procs[i].ts.data || !procs[j].ts.data) continue;
             TSOrder o = ts_compare(&procs[i].ts, &procs[j].ts);
             const char *rel = (o == TS_BEFORE) ? "BEFORE"
                                : (o == TS_AFTER) ? "AFTER"
                                : (o == TS_EQUAL) ? "EQUAL"
                                : "CONCURRENT";
-            printf("P%d vs P%d: %s\n", i, j, rel);
+            // Bloom orderings carry the probability that they are false positives
+            char fp[32] = "";
+            if (clock_type == CLOCK_BLOOM && (o == TS_BEFORE || o == TS_AFTER)) {
+                double p = o == TS_BEFORE ? bloom_false_positive(&procs[i].ts, &procs[j].ts)
+                                          : bloom_false_positive(&procs[j].ts, &procs[i].ts);
+                snprintf(fp, sizeof(fp), " (fp %.2f%%)", p * 100.0);
+                fp_total += p;
+                fp_pairs++;
+            }
+            if (procs[i].truth.data && procs[j].truth.data) {
+                TSOrder truth = ts_compare(&procs[i].truth, &procs[j].truth);
+                printf("P%d vs P%d: %s%s%s\n", i, j, rel, fp,
+                       truth == TS_CONCURRENT && o != TS_CONCURRENT ? " (actually CONCURRENT)" : "");
+            } else {
+                printf("P%d vs P%d: %s%s\n", i, j, rel, fp);
+            }
         }
     }
+    if (fp_pairs > 0) {
+        printf("Bloom false-positive estimate: %.2f%% average over %d ordered pairs\n",
+               fp_total / fp_pairs * 100.0, fp_pairs);
+    }
     
-    display_performance_stats(n, clock_type);
+    if (clock_type == CLOCK_HLC) {
+        for (int i = 0; i < slots; i++) {
+            if (procs[i].ts.data) perf_stats.drift_rejections += hlc_drift_rejections(&procs[i].ts);
+        }
+    }
+    if (clock_type == CLOCK_COMPRESSED) {
+        for (int i = 0; i < slots; i++) {
+            if (!procs[i].ts.data) continue;
+            perf_stats.tau_bytes += compressed_tau_bytes(&procs[i].ts);
+            perf_stats.tau_evictions += compressed_evictions(&procs[i].ts);
+        }
+    }
+    if (clock_type == CLOCK_MATRIX) {
+        int *own = (int*)malloc(slots * sizeof(int));
+        for (int i = 0; i < slots; i++) {
+            if (!procs[i].ts.data) continue;
+            ts_to_vector(&procs[i].ts, own);
+            for (int k = 0; k < slots; k++) {
+                perf_stats.known_entries += own[k];
+                perf_stats.min_known_entries += ts_min_known(&procs[i].ts, k);
+            }
+        }
+        free(own);
+    }
+    for (int i = 0; i < slots; i++) {
+        perf_stats.arena_bytes += procs[i].arena.reserved;
+    }
+    
+    display_performance_stats(churn_enabled ? churn.created : n, clock_type, wire_format);
+    if (churn_enabled) {
+        display_size_over_time(steps);
+    }
 
     // Cleanup
-    for (int i = 0; i < n; i++) {
-        ts_destroy(&procs[i].ts);
+    for (int i = 0; i < slots; i++) {
+        if (procs[i].ts.data) ts_destroy(&procs[i].ts);
+        if (procs[i].truth.data) ts_destroy(&procs[i].truth);
+        clock_arena_release(&procs[i].arena);
+    }
+    for (int i = 0; i < slots; i++) mq_destroy(&queues[i]);
+    order_samples_clear();
+    if (churn_enabled) {
+        churn_destroy(&churn);
     }
-    for (int i = 0; i < n; i++) mq_destroy(&queues[i]);
     free(queues);
     free(procs);
     free(threads);
 
     return 0;
-}
\ No newline at end of file
+}
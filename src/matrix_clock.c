@@ -0,0 +1,336 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "matrix_clock.h"
+#include "vector_kernels.h"
+
+/* ---------- Block Layout ---------- */
+
+static size_t full_size(int n) {
+    return (1 + (size_t)n * n) * sizeof(int);
+}
+
+// Header, matrix, stamps, row stamps and send epochs in one zeroed block
+static MatrixClockData* matrix_alloc(ClockArena *arena, int n) {
+    size_t header = CLOCK_BLOCK_ROUND(sizeof(MatrixClockData));
+    size_t cells = (size_t)n * n;
+    MatrixClockData *data = clock_block_alloc(arena, header + (2 * cells + 2 * (size_t)n) * sizeof(int));
+    data->n = n;
+    data->epoch = 1;
+    data->m = (int*)((char*)data + header);
+    data->stamp = (unsigned*)(data->m + cells);
+    data->row_stamp = data->stamp + cells;
+    data->sent = data->row_stamp + n;
+    return data;
+}
+
+/* ---------- Cell Updates ---------- */
+
+// Cells per block of the row merge: each block is checked with one vk_compare pass, and
+// only blocks with a larger incoming cell are merged with vk_merge_max and restamped
+#define MATRIX_BLOCK 64
+
+// own is the clock's digest when row i is its own row, else NULL
+static void matrix_raise(MatrixClockData *data, ClockDigest *own, int i, int k, int value) {
+    size_t cell = (size_t)i * data->n + k;
+    if (value > data->m[cell]) {
+        if (own) clock_digest_raise(own, k, data->m[cell], value);
+        data->m[cell] = value;
+        data->stamp[cell] = data->epoch;
+        data->row_stamp[i] = data->epoch;
+    }
+}
+
+// Row i = max(row i, src). A block is merged in place and its cells that grew, found
+// against a copy of the old values, take the current epoch.
+static void matrix_merge_row(MatrixClockData *data, ClockDigest *own, int i, const int *src) {
+    int n = data->n;
+    int *row = data->m + (size_t)i * n;
+    unsigned *stamp = data->stamp + (size_t)i * n;
+    int old[MATRIX_BLOCK];
+    for (int b = 0; b < n; b += MATRIX_BLOCK) {
+        int len = n - b < MATRIX_BLOCK ? n - b : MATRIX_BLOCK;
+        TSOrder order = vk_compare(row + b, src + b, len);
+        if (order != TS_BEFORE && order != TS_CONCURRENT) continue;
+        memcpy(old, row + b, len * sizeof(int));
+        vk_merge_max(row + b, src + b, len);
+        for (int k = 0; k < len; k++) {
+            if (row[b + k] != old[k]) {
+                if (own) clock_digest_raise(own, b + k, old[k], row[b + k]);
+                stamp[b + k] = data->epoch;
+            }
+        }
+        data->row_stamp[i] = data->epoch;
+    }
+}
+
+/* ---------- Matrix Clock Implementation ---------- */
+
+Timestamp matrix_create_in(ClockArena *arena, int n, int pid, ClockType type) {
+    Timestamp ts;
+    ts.n = n;
+    ts.pid = pid;
+    ts.type = type;
+    clock_digest_reset(&ts.digest);
+    ts.data = matrix_alloc(arena, n);
+    ts.data_size = full_size(n);  // full form; destination-aware sends are usually far smaller
+    return ts;
+}
+
+Timestamp matrix_create(int n, int pid, ClockType type) {
+    return matrix_create_in(NULL, n, pid, type);
+}
+
+void matrix_destroy(Timestamp *ts) {
+    if (ts && ts->data) {
+        clock_block_free(ts->data);
+        ts->data = NULL;
+    }
+}
+
+void matrix_increment(Timestamp *ts) {
+    MatrixClockData *data = (MatrixClockData*)ts->data;
+    matrix_raise(data, &ts->digest, ts->pid, ts->pid, data->m[(size_t)ts->pid * data->n + ts->pid] + 1);
+}
+
+/* ---------- Delta Frames ---------- */
+
+// Number of cells of row i stamped after `since`
+static int changed_cells(const MatrixClockData *data, int i, unsigned since) {
+    const unsigned *stamp = data->stamp + (size_t)i * data->n;
+    int count = 0;
+    for (int k = 0; k < data->n; k++) {
+        count += stamp[k] > since;
+    }
+    return count;
+}
+
+// Checks a whole delta frame before anything is applied; 0 if malformed
+static int matrix_check_delta(int n, const uint32_t *w, size_t words) {
+    if (words < 2 || w[1] > (uint32_t)n) return 0;
+    size_t pos = 2;
+    for (uint32_t r = 0; r < w[1]; r++) {
+        if (pos + 2 > words) return 0;
+        uint32_t row = w[pos], count = w[pos + 1];
+        if (row >= (uint32_t)n || count > (uint32_t)n) return 0;
+        pos += 2;
+        if (count == (uint32_t)n) {
+            pos += n;
+        } else {
+            if (pos + 2 * (size_t)count > words) return 0;
+            for (uint32_t c = 0; c < count; c++) {
+                if (w[pos + 2 * c] >= (uint32_t)n) return 0;
+            }
+            pos += 2 * (size_t)count;
+        }
+        if (pos > words) return 0;
+    }
+    return pos == words;
+}
+
+static void matrix_apply_delta(Timestamp *ts, const uint32_t *w) {
+    MatrixClockData *data = (MatrixClockData*)ts->data;
+    int n = data->n;
+    size_t pos = 2;
+    for (uint32_t r = 0; r < w[1]; r++) {
+        int row = (int)w[pos];
+        uint32_t count = w[pos + 1];
+        ClockDigest *own = row == ts->pid ? &ts->digest : NULL;
+        pos += 2;
+        if (count == (uint32_t)n) {
+            matrix_merge_row(data, own, row, (const int*)(w + pos));
+            pos += n;
+        } else {
+            for (uint32_t c = 0; c < count; c++, pos += 2) {
+                matrix_raise(data, own, row, (int)w[pos], (int)w[pos + 1]);
+            }
+        }
+    }
+}
+
+void matrix_merge(Timestamp *dst, const void *other_data, size_t other_size) {
+    MatrixClockData *data = (MatrixClockData*)dst->data;
+    int n = data->n;
+    const uint32_t *w = (const uint32_t*)other_data;
+    size_t words = other_size / sizeof(uint32_t);
+    if (words < 1 || other_size % sizeof(uint32_t)) return;
+    
+    uint32_t tag = w[0] & MATRIX_TAG_MASK;
+    int sender = (int)(w[0] & MATRIX_SENDER_MASK);
+    if (tag == MATRIX_TAG_FULL || tag == MATRIX_TAG_DELTA) {
+        if (sender >= n) return;
+        if (tag == MATRIX_TAG_FULL) {
+            if (other_size != full_size(n)) return;
+            const int *src = (const int*)(w + 1);
+            for (int i = 0; i < n; i++) {
+                matrix_merge_row(data, i == dst->pid ? &dst->digest : NULL, i, src + (size_t)i * n);
+            }
+        } else {
+            if (!matrix_check_delta(n, w, words)) return;
+            matrix_apply_delta(dst, w);
+        }
+        // Everything the sender had seen is now seen here too
+        matrix_merge_row(data, &dst->digest, dst->pid, data->m + (size_t)sender * n);
+    } else if (other_size == (size_t)n * sizeof(int)) {
+        // Plain vector from another type: only this process's own knowledge grows
+        matrix_merge_row(data, &dst->digest, dst->pid, (const int*)other_data);
+    }
+}
+
+TSOrder matrix_compare(const Timestamp *a, const Timestamp *b) {
+    const MatrixClockData *a_data = (const MatrixClockData*)a->data;
+    const MatrixClockData *b_data = (const MatrixClockData*)b->data;
+    if (a_data->n != b_data->n) {
+        fprintf(stderr, "Mismatched matrix sizes!\n");
+        exit(1);
+    }
+    return vk_compare(a_data->m + (size_t)a->pid * a_data->n, b_data->m + (size_t)b->pid * b_data->n,
+                      a_data->n);
+}
+
+size_t matrix_serialize(const Timestamp *ts, void *buffer, size_t bufsize) {
+    const MatrixClockData *data = (const MatrixClockData*)ts->data;
+    size_t required = full_size(data->n);
+    if (bufsize >= required) {
+        uint32_t *w = (uint32_t*)buffer;
+        w[0] = MATRIX_TAG_FULL | (uint32_t)ts->pid;
+        memcpy(w + 1, data->m, (size_t)data->n * data->n * sizeof(int));
+    }
+    return required;
+}
+
+// Cells that grew since the last send to dest, by row. A row with at least half its cells
+// changed goes out whole; a delta no smaller than the full matrix becomes the full matrix.
+size_t matrix_serialize_for_dest(const Timestamp *ts, int dest, void *buffer, size_t bufsize) {
+    MatrixClockData *data = (MatrixClockData*)ts->data;
+    int n = data->n;
+    unsigned since = data->sent[dest];
+    
+    size_t words = 2;
+    for (int i = 0; i < n; i++) {
+        if (data->row_stamp[i] <= since) continue;
+        int count = changed_cells(data, i, since);
+        words += 2 + (2 * count >= n ? (size_t)n : 2 * (size_t)count);
+    }
+    size_t required = words * sizeof(uint32_t);
+    int full = required >= full_size(n);
+    if (full) required = full_size(n);
+    if (bufsize < required) {
+        return required;  // size query: send state untouched
+    }
+    
+    if (full) {
+        matrix_serialize(ts, buffer, bufsize);
+    } else {
+        uint32_t *w = (uint32_t*)buffer;
+        size_t pos = 2;
+        w[0] = MATRIX_TAG_DELTA | (uint32_t)ts->pid;
+        w[1] = 0;
+        for (int i = 0; i < n; i++) {
+            if (data->row_stamp[i] <= since) continue;
+            const int *row = data->m + (size_t)i * n;
+            const unsigned *stamp = data->stamp + (size_t)i * n;
+            int count = changed_cells(data, i, since);
+            w[1]++;
+            w[pos++] = (uint32_t)i;
+            if (2 * count >= n) {
+                w[pos++] = (uint32_t)n;
+                memcpy(w + pos, row, n * sizeof(int));
+                pos += n;
+                continue;
+            }
+            w[pos++] = (uint32_t)count;
+            for (int k = 0; k < n; k++) {
+                if (stamp[k] <= since) continue;
+                w[pos++] = (uint32_t)k;
+                w[pos++] = (uint32_t)row[k];
+            }
+        }
+    }
+    
+    // Later growth is stamped with the next epoch, so it is newer than this send
+    data->sent[dest] = data->epoch++;
+    return required;
+}
+
+void matrix_deserialize(Timestamp *ts, const void *buffer, size_t size) {
+    MatrixClockData *data = (MatrixClockData*)ts->data;
+    size_t cells = (size_t)data->n * data->n;
+    
+    // Replace the state; send epochs stay so destinations are still tracked correctly
+    memset(data->m, 0, cells * sizeof(int));
+    memset(data->stamp, 0, cells * sizeof(unsigned));
+    memset(data->row_stamp, 0, data->n * sizeof(unsigned));
+    clock_digest_reset(&ts->digest);
+    matrix_merge(ts, buffer, size);
+}
+
+void matrix_to_string(const Timestamp *ts, char *buf, size_t bufsize) {
+    const MatrixClockData *data = (const MatrixClockData*)ts->data;
+    const int *own = data->m + (size_t)ts->pid * data->n;
+    size_t used = snprintf(buf, bufsize, "M[");
+    for (int k = 0; k < data->n; k++) {
+        used += snprintf(buf + used, bufsize - used, "%s%d", (k ? "," : ""), own[k]);
+        if (used >= bufsize) return;  // truncated
+    }
+    used += snprintf(buf + used, bufsize - used, "] known[");
+    if (used >= bufsize) return;
+    for (int k = 0; k < data->n; k++) {
+        used += snprintf(buf + used, bufsize - used, "%s%d", (k ? "," : ""), matrix_min_known(ts, k));
+        if (used >= bufsize) return;
+    }
+    snprintf(buf + used, bufsize - used, "]");
+}
+
+Timestamp matrix_clone_in(ClockArena *arena, const Timestamp *ts) {
+    const MatrixClockData *src = (const MatrixClockData*)ts->data;
+    Timestamp out = matrix_create_in(arena, ts->n, ts->pid, ts->type);
+    MatrixClockData *dst = (MatrixClockData*)out.data;
+    
+    // Matrix, stamps, row stamps and send epochs are contiguous
+    size_t cells = (size_t)src->n * src->n;
+    memcpy(dst->m, src->m, (2 * cells + 2 * (size_t)src->n) * sizeof(int));
+    dst->epoch = src->epoch;
+    out.digest = ts->digest;
+    return out;
+}
+
+Timestamp matrix_clone(const Timestamp *ts) {
+    return matrix_clone_in(NULL, ts);
+}
+
+void matrix_to_vector(const Timestamp *ts, int *out) {
+    const MatrixClockData *data = (const MatrixClockData*)ts->data;
+    memcpy(out, data->m + (size_t)ts->pid * data->n, data->n * sizeof(int));
+}
+
+/* ---------- Knowledge Queries ---------- */
+
+int matrix_min_known(const Timestamp *ts, int k) {
+    const MatrixClockData *data = (const MatrixClockData*)ts->data;
+    int known = data->m[k];
+    for (int i = 1; i < data->n; i++) {
+        int v = data->m[(size_t)i * data->n + k];
+        if (v < known) known = v;
+    }
+    return known;
+}
+
+/* ---------- Operations Table ---------- */
+
+const TimestampOps MATRIX_OPS = {
+    .create = matrix_create,
+    .destroy = matrix_destroy,
+    .increment = matrix_increment,
+    .merge = matrix_merge,
+    .compare = matrix_compare,
+    .serialize = matrix_serialize,
+    .serialize_for_dest = matrix_serialize_for_dest,
+    .deserialize = matrix_deserialize,
+    .to_string = matrix_to_string,
+    .clone = matrix_clone,
+    .to_vector = matrix_to_vector,
+    .create_in = matrix_create_in,
+    .clone_in = matrix_clone_in,
+    .min_known = matrix_min_known
+};
@@ -19,6 +19,7 @@ void mq_destroy(MsgQueue *q) {
         if (cur->timestamp_data) {
             free(cur->timestamp_data);
         }
+        free(cur->truth_data);
         free(cur);
         cur = nxt;
     }
@@ -0,0 +1,154 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "plausible_clock.h"
+#include "vector_kernels.h"
+
+/* ---------- Plausible Clock Configuration ---------- */
+
+static int configured_entries = PLAUSIBLE_DEFAULT_ENTRIES;
+
+void plausible_set_entries(int entries) {
+    configured_entries = entries > 0 ? entries : PLAUSIBLE_DEFAULT_ENTRIES;
+}
+
+int plausible_entries(int n) {
+    return configured_entries < n ? configured_entries : n;
+}
+
+/* ---------- Plausible Clock Implementation ---------- */
+
+static Timestamp plausible_alloc(ClockArena *arena, int n, int pid, ClockType type, int entries) {
+    Timestamp ts;
+    ts.n = n;
+    ts.pid = pid;
+    ts.type = type;
+    clock_digest_none(&ts.digest);
+    
+    PlausibleClockData *data = clock_block_alloc(arena, sizeof(PlausibleClockData) + entries * sizeof(int));
+    data->entries = entries;
+    
+    ts.data = data;
+    ts.data_size = entries * sizeof(int);
+    return ts;
+}
+
+Timestamp plausible_create_in(ClockArena *arena, int n, int pid, ClockType type) {
+    return plausible_alloc(arena, n, pid, type, plausible_entries(n));
+}
+
+Timestamp plausible_create(int n, int pid, ClockType type) {
+    return plausible_create_in(NULL, n, pid, type);
+}
+
+void plausible_destroy(Timestamp *ts) {
+    if (ts && ts->data) {
+        clock_block_free(ts->data);
+        ts->data = NULL;
+    }
+}
+
+void plausible_increment(Timestamp *ts) {
+    PlausibleClockData *data = (PlausibleClockData*)ts->data;
+    data->v[ts->pid % data->entries] += 1;
+}
+
+void plausible_merge(Timestamp *dst, const void *other_data, size_t other_size) {
+    PlausibleClockData *data = (PlausibleClockData*)dst->data;
+    
+    // Timestamps from clocks with a different R cannot be folded together
+    if (other_size != data->entries * sizeof(int)) {
+        return;
+    }
+    vk_merge_max(data->v, (const int*)other_data, data->entries);
+}
+
+TSOrder plausible_compare(const Timestamp *a, const Timestamp *b) {
+    const PlausibleClockData *a_data = (const PlausibleClockData*)a->data;
+    const PlausibleClockData *b_data = (const PlausibleClockData*)b->data;
+    
+    if (a_data->entries != b_data->entries) {
+        fprintf(stderr, "Mismatched plausible clock sizes!\n");
+        exit(1);
+    }
+    
+    TSOrder order = vk_compare(a_data->v, b_data->v, a_data->entries);
+    // Processes sharing an entry can reach the same counters independently
+    if (order == TS_EQUAL && a->pid != b->pid) {
+        return TS_CONCURRENT;
+    }
+    return order;
+}
+
+size_t plausible_serialize(const Timestamp *ts, void *buffer, size_t bufsize) {
+    const PlausibleClockData *data = (const PlausibleClockData*)ts->data;
+    size_t required = data->entries * sizeof(int);
+    
+    if (bufsize >= required) {
+        memcpy(buffer, data->v, required);
+    }
+    return required;
+}
+
+void plausible_deserialize(Timestamp *ts, const void *buffer, size_t size) {
+    PlausibleClockData *data = (PlausibleClockData*)ts->data;
+    
+    if (size == data->entries * sizeof(int)) {
+        memcpy(data->v, buffer, size);
+    }
+}
+
+void plausible_to_string(const Timestamp *ts, char *buf, size_t bufsize) {
+    const PlausibleClockData *data = (const PlausibleClockData*)ts->data;
+    size_t used = 0;
+    
+    if (bufsize == 0) return;
+    used += snprintf(buf + used, bufsize - used, "P[");
+    for (int i = 0; i < data->entries && used < bufsize; i++) {
+        used += snprintf(buf + used, bufsize - used, "%s%d", (i ? "," : ""), data->v[i]);
+    }
+    if (used < bufsize) {
+        snprintf(buf + used, bufsize - used, "]");
+    }
+}
+
+Timestamp plausible_clone_in(ClockArena *arena, const Timestamp *ts) {
+    const PlausibleClockData *src_data = (const PlausibleClockData*)ts->data;
+    // Keep the source's R even if the configured default changed since
+    Timestamp out = plausible_alloc(arena, ts->n, ts->pid, ts->type, src_data->entries);
+    PlausibleClockData *dst_data = (PlausibleClockData*)out.data;
+    
+    memcpy(dst_data->v, src_data->v, src_data->entries * sizeof(int));
+    return out;
+}
+
+Timestamp plausible_clone(const Timestamp *ts) {
+    return plausible_clone_in(NULL, ts);
+}
+
+void plausible_to_vector(const Timestamp *ts, int *out) {
+    // Every process reads its folded entry; dominance between expansions matches
+    // dominance between the folded vectors
+    const PlausibleClockData *data = (const PlausibleClockData*)ts->data;
+    for (int i = 0; i < ts->n; i++) {
+        out[i] = data->v[i % data->entries];
+    }
+}
+
+/* ---------- Operations Table ---------- */
+
+const TimestampOps PLAUSIBLE_OPS = {
+    .create = plausible_create,
+    .destroy = plausible_destroy,
+    .increment = plausible_increment,
+    .merge = plausible_merge,
+    .compare = plausible_compare,
+    .serialize = plausible_serialize,
+    .serialize_for_dest = NULL,  // Already constant size
+    .deserialize = plausible_deserialize,
+    .to_string = plausible_to_string,
+    .clone = plausible_clone,
+    .to_vector = plausible_to_vector,
+    .create_in = plausible_create_in,
+    .clone_in = plausible_clone_in
+};
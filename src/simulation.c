@@ -5,14 +5,29 @@
 #include <unistd.h>
 #include <pthread.h>
 #include "simulation.h"
+#include "itc_clock.h"
+#include "compressed_clock.h"
 #include "config.h"
+#ifdef SIM_SPECIALIZE
+#include "standard_clock.h"
+#include "sparse_clock.h"
+#include "differential_clock.h"
+#include "encoded_clock.h"
+#include "hlc_clock.h"
+#include "plausible_clock.h"
+#include "bloom_clock.h"
+#include "matrix_clock.h"
+#include "lamport_clock.h"
+#endif
 
 /* ---------- Performance Statistics ---------- */
 
 PerfStats perf_stats = {0};
 
-void update_perf_stats(size_t message_size, size_t clock_size) {
+void update_perf_stats(size_t message_size, size_t clock_size, size_t raw_clock_size) {
     perf_stats.total_message_bytes += message_size;
+    perf_stats.total_raw_bytes += raw_clock_size;
+    perf_stats.total_wire_bytes += clock_size;
     perf_stats.total_messages++;
     if (clock_size > perf_stats.max_clock_size) {
         perf_stats.max_clock_size = clock_size;
@@ -20,6 +35,73 @@ void update_perf_stats(size_t message_size, size_t clock_size) {
     perf_stats.avg_clock_size = ((perf_stats.avg_clock_size * (perf_stats.total_messages - 1)) + clock_size) / perf_stats.total_messages;
 }
 
+void record_size_sample(int step, int steps, size_t clock_size, int members) {
+    int bucket = steps > 0 ? step * SIZE_BUCKETS / steps : 0;
+    if (bucket < 0) bucket = 0;
+    if (bucket >= SIZE_BUCKETS) bucket = SIZE_BUCKETS - 1;
+    
+    perf_stats.bucket_bytes[bucket] += clock_size;
+    perf_stats.bucket_messages[bucket]++;
+    if (members > perf_stats.bucket_members[bucket]) {
+        perf_stats.bucket_members[bucket] = members;
+    }
+}
+
+void record_order_check(TSOrder clock_order, TSOrder truth_order) {
+    perf_stats.order_checks++;
+    if (truth_order == TS_CONCURRENT) {
+        perf_stats.concurrent_pairs++;
+        if (clock_order != TS_CONCURRENT) perf_stats.false_orderings++;
+    } else if (clock_order != truth_order) {
+        perf_stats.misorderings++;
+    }
+}
+
+int needs_ground_truth(ClockType type) {
+    return type == CLOCK_HLC || type == CLOCK_PLAUSIBLE || type == CLOCK_BLOOM || type == CLOCK_LAMPORT;
+}
+
+// Recent send events from all processes; each new send is checked against all of them
+static struct {
+    Timestamp ts[ORDER_SAMPLE_EVENTS];
+    Timestamp truth[ORDER_SAMPLE_EVENTS];
+    int count;
+    int next;
+    pthread_mutex_t mtx;
+} order_samples = {.count = 0, .next = 0, .mtx = PTHREAD_MUTEX_INITIALIZER};
+
+static void check_send_order(const ProcCtx *ctx) {
+    pthread_mutex_lock(&order_samples.mtx);
+    for (int i = 0; i < order_samples.count; i++) {
+        record_order_check(ts_compare(&order_samples.ts[i], &ctx->ts),
+                           ts_compare(&order_samples.truth[i], &ctx->truth));
+    }
+    
+    int slot = order_samples.next;
+    if (order_samples.count == ORDER_SAMPLE_EVENTS) {
+        ts_destroy(&order_samples.ts[slot]);
+        ts_destroy(&order_samples.truth[slot]);
+    } else {
+        order_samples.count++;
+    }
+    // Heap clones: samples are destroyed by whichever thread overwrites the slot
+    order_samples.ts[slot] = ts_clone(&ctx->ts);
+    order_samples.truth[slot] = ts_clone(&ctx->truth);
+    order_samples.next = (slot + 1) % ORDER_SAMPLE_EVENTS;
+    pthread_mutex_unlock(&order_samples.mtx);
+}
+
+void order_samples_clear(void) {
+    pthread_mutex_lock(&order_samples.mtx);
+    for (int i = 0; i < order_samples.count; i++) {
+        ts_destroy(&order_samples.ts[i]);
+        ts_destroy(&order_samples.truth[i]);
+    }
+    order_samples.count = 0;
+    order_samples.next = 0;
+    pthread_mutex_unlock(&order_samples.mtx);
+}
+
 /* ---------- Utility Functions ---------- */
 
 void ms_sleep(int ms) {
@@ -41,55 +123,129 @@ void print_event_header(int pid, int step, const Timestamp *ts, const char *etyp
     printf("P%d Step%d %s | TS=%s | ", pid, step, etype, buf);
 }
 
+/* ---------- Clock Dispatch ---------- */
+
+// The hot event handlers take the clock's ops as a parameter. NULL reads the pointer cached
+// in the timestamp (the generic worker, whose slot may not have a clock yet). Workers
+// generated with -DSIM_SPECIALIZE pass a constant table, so the compiler can resolve the
+// calls (and, with LTO, inline them) in that copy of the event loop.
+#define CLOCK_OPS(ctx, ops) ((ops) ? (ops) : (ctx)->ts.ops)
+
+#ifdef __GNUC__
+#define SIM_INLINE static inline __attribute__((always_inline))
+#else
+#define SIM_INLINE static inline
+#endif
+
 /* ---------- Event Handlers ---------- */
 
-void do_internal(ProcCtx *ctx) {
+// Local tick of the clock and of its ground truth, if any. Deferred clocks (--deferred)
+// go through ts_increment and ts_merge_and_tick, which queue the event.
+SIM_INLINE void tick(ProcCtx *ctx, const TimestampOps *ops) {
+    if (ctx->ts.pending) {
+        ts_increment(&ctx->ts);
+    } else {
+        CLOCK_OPS(ctx, ops)->increment(&ctx->ts);
+    }
+    if (ctx->truth.data) {
+        ts_increment(&ctx->truth);
+    }
+}
+
+// Receive event on ctx's clock. Compact frames go through ts_merge_and_tick to be decoded.
+SIM_INLINE void receive(ProcCtx *ctx, const TimestampOps *ops, const void *data, size_t size) {
+    ops = CLOCK_OPS(ctx, ops);
+    if (ctx->ts.wire != WIRE_RAW || ctx->ts.pending) {
+        ts_merge_and_tick(&ctx->ts, data, size);
+    } else if (ops->merge_and_tick) {
+        ops->merge_and_tick(&ctx->ts, data, size);
+    } else {
+        ops->merge(&ctx->ts, data, size);
+        ops->increment(&ctx->ts);
+    }
+}
+
+SIM_INLINE void internal_event(ProcCtx *ctx, const TimestampOps *ops) {
     print_event_header(ctx->pid, ctx->current_step, &ctx->ts, "INTERNAL(BEFORE)");
     printf("local computation\n");
     
-    ts_increment(&ctx->ts);
+    tick(ctx, ops);
     
     print_event_header(ctx->pid, ctx->current_step, &ctx->ts, "INTERNAL(AFTER) ");
     printf("clock incremented\n");
 }
 
-void do_send(ProcCtx *ctx, int dest, const char *payload) {
-    if (dest == ctx->pid) return; // shouldn't happen
-    
-    print_event_header(ctx->pid, ctx->current_step, &ctx->ts, "SEND(BEFORE)   ");
-    printf("to P%d, payload=\"%s\"\n", dest, payload);
-    
-    // Always increment timestamp for send events (step 1 of SK algorithm)
-    ts_increment(&ctx->ts);
-    
-    // Prepare message
+void do_internal(ProcCtx *ctx) {
+    internal_event(ctx, NULL);
+}
+
+// Serializes ctx's clock into a new message for dest and queues it. full_stamp sends the
+// plain serialization, which for ITC carries the sender's id along with its history.
+static void push_message(ProcCtx *ctx, int dest, const char *payload, int full_stamp) {
     Message *m = (Message*)malloc(sizeof(Message));
     m->from = ctx->pid;
     m->to = dest;
     m->clock_type = ctx->clock_type;
+    m->truth_data = NULL;
+    m->truth_size = 0;
     
-    // Use destination-aware serialization for differential and compressed clocks
-    if (ctx->clock_type == CLOCK_DIFFERENTIAL || ctx->clock_type == CLOCK_COMPRESSED) {
+    // Destination-aware serialization (differential and compressed deltas, ITC's anonymous
+    // peek); types without one fall back to the plain form
+    // (the size query may be an upper bound, so keep the size actually written)
+    size_t raw_size;
+    if (!full_stamp) {
+        raw_size = ts_raw_size(&ctx->ts, dest);
         m->timestamp_size = ts_serialize_for_dest(&ctx->ts, dest, NULL, 0); // Get required size
         m->timestamp_data = malloc(m->timestamp_size);
-        ts_serialize_for_dest(&ctx->ts, dest, m->timestamp_data, m->timestamp_size);
+        m->timestamp_size = ts_serialize_for_dest(&ctx->ts, dest, m->timestamp_data, m->timestamp_size);
     } else {
-        // Use standard serialization for other clock types
+        // The full stamp, which for ITC also carries the sender's id
+        raw_size = ts_raw_size(&ctx->ts, -1);
         m->timestamp_size = ts_serialize(&ctx->ts, NULL, 0); // Get required size
         m->timestamp_data = malloc(m->timestamp_size);
-        ts_serialize(&ctx->ts, m->timestamp_data, m->timestamp_size);
+        m->timestamp_size = ts_serialize(&ctx->ts, m->timestamp_data, m->timestamp_size);
     }
     
     // Update performance statistics
-    update_perf_stats(sizeof(Message) + m->timestamp_size, m->timestamp_size);
+    update_perf_stats(sizeof(Message) + m->timestamp_size, m->timestamp_size, raw_size);
+    int members = ctx->n;
+    if (ctx->churn) {
+        pthread_mutex_lock(&ctx->churn->mtx);
+        members = ctx->churn->created;
+        pthread_mutex_unlock(&ctx->churn->mtx);
+    }
+    record_size_sample(ctx->current_step, ctx->steps, m->timestamp_size, members);
+    
+    if (ctx->truth.data) {
+        check_send_order(ctx);
+        m->truth_size = ts_serialize(&ctx->truth, NULL, 0);
+        m->truth_data = malloc(m->truth_size);
+        ts_serialize(&ctx->truth, m->truth_data, m->truth_size);
+    }
     
     snprintf(m->payload, sizeof(m->payload), "%s", payload);
     mq_push(&ctx->queues[dest], m);
+}
+
+SIM_INLINE void send_event(ProcCtx *ctx, const TimestampOps *ops, int dest, const char *payload) {
+    if (dest == ctx->pid) return; // shouldn't happen
+    
+    print_event_header(ctx->pid, ctx->current_step, &ctx->ts, "SEND(BEFORE)   ");
+    printf("to P%d, payload=\"%s\"\n", dest, payload);
+    
+    // Always increment timestamp for send events (step 1 of SK algorithm)
+    tick(ctx, ops);
+    
+    push_message(ctx, dest, payload, 0);
     print_event_header(ctx->pid, ctx->current_step, &ctx->ts, "SEND(AFTER)    ");
     printf("clock incremented and message sent\n");
 }
 
-int do_try_recv(ProcCtx *ctx) {
+void do_send(ProcCtx *ctx, int dest, const char *payload) {
+    send_event(ctx, NULL, dest, payload);
+}
+
+SIM_INLINE int recv_event(ProcCtx *ctx, const TimestampOps *ops) {
     Message *m = mq_try_pop(&ctx->queues[ctx->pid]);
     if (!m) return 0;
 
@@ -97,20 +253,25 @@ int do_try_recv(ProcCtx *ctx) {
     print_event_header(ctx->pid, ctx->current_step, &ctx->ts, "RECV(BEFORE)");
     
     // Create temporary timestamp for message display
-    Timestamp msg_ts = ts_create(ctx->n, m->from, m->clock_type);
+    Timestamp msg_ts = ts_create_in(&ctx->arena, ctx->n, m->from, m->clock_type);
+    ts_set_wire_format(&msg_ts, ctx->wire_format);
+    if (m->clock_type == CLOCK_COMPRESSED) {
+        // Value-delta frames decode against what this process last got from the sender
+        compressed_copy_receive_state(&msg_ts, &ctx->ts, m->from);
+    }
     ts_deserialize(&msg_ts, m->timestamp_data, m->timestamp_size);
     
     char buf[STRING_BUFFER_SIZE];
     ts_to_string(&msg_ts, buf, sizeof(buf));
     printf("from P%d: payload=\"%s\", msgTS=%s\n", m->from, m->payload, buf);
 
-    // For differential and compressed clocks, merge handles the increment internally
-    // For other clocks, merge then increment separately
-    ts_merge(&ctx->ts, m->timestamp_data, m->timestamp_size);
-    if (ctx->clock_type != CLOCK_DIFFERENTIAL && ctx->clock_type != CLOCK_COMPRESSED) {
-        ts_increment(&ctx->ts);
+    if (ctx->truth.data && m->truth_data) {
+        ts_merge(&ctx->truth, m->truth_data, m->truth_size);
+        ts_increment(&ctx->truth);
     }
 
+    receive(ctx, ops, m->timestamp_data, m->timestamp_size);
+
     print_event_header(ctx->pid, ctx->current_step, &ctx->ts, "RECV(AFTER) ");
     printf("merged with sender and incremented\n");
 
@@ -118,33 +279,212 @@ int do_try_recv(ProcCtx *ctx) {
     if (m->timestamp_data) {
         free(m->timestamp_data);
     }
+    free(m->truth_data);
     free(m);
     return 1;
 }
 
+int do_try_recv(ProcCtx *ctx) {
+    return recv_event(ctx, NULL);
+}
+
+/* ---------- Dynamic Membership ---------- */
+
+void churn_init(Churn *churn, ProcCtx *procs, int n, int capacity) {
+    churn->capacity = capacity;
+    churn->state = (SlotState*)malloc(capacity * sizeof(SlotState));
+    for (int i = 0; i < capacity; i++) {
+        churn->state[i] = i < n ? SLOT_ACTIVE : SLOT_UNUSED;
+    }
+    churn->active = n;
+    churn->created = n;
+    churn->procs = procs;
+    pthread_mutex_init(&churn->mtx, NULL);
+}
+
+void churn_destroy(Churn *churn) {
+    pthread_mutex_destroy(&churn->mtx);
+    free(churn->state);
+}
+
+static SlotState slot_state(ProcCtx *ctx) {
+    if (!ctx->churn) return SLOT_ACTIVE;
+    pthread_mutex_lock(&ctx->churn->mtx);
+    SlotState state = ctx->churn->state[ctx->pid];
+    pthread_mutex_unlock(&ctx->churn->mtx);
+    return state;
+}
+
+// Random live process other than self, or -1; caller holds churn->mtx
+static int pick_active_locked(Churn *churn, int self, unsigned int *seed) {
+    int candidates = 0;
+    for (int i = 0; i < churn->capacity; i++) {
+        if (i != self && churn->state[i] == SLOT_ACTIVE) candidates++;
+    }
+    if (candidates == 0) return -1;
+    
+    int k = rand_in_range(seed, 0, candidates - 1);
+    for (int i = 0; i < churn->capacity; i++) {
+        if (i != self && churn->state[i] == SLOT_ACTIVE && k-- == 0) return i;
+    }
+    return -1;
+}
+
+static int pick_active_dest(ProcCtx *ctx, unsigned int *seed) {
+    pthread_mutex_lock(&ctx->churn->mtx);
+    int dest = pick_active_locked(ctx->churn, ctx->pid, seed);
+    pthread_mutex_unlock(&ctx->churn->mtx);
+    return dest;
+}
+
+int do_fork(ProcCtx *ctx) {
+    Churn *churn = ctx->churn;
+    pthread_mutex_lock(&churn->mtx);
+    
+    int slot = -1;
+    for (int i = 0; i < churn->capacity && slot < 0; i++) {
+        if (churn->state[i] == SLOT_UNUSED) slot = i;
+    }
+    if (slot < 0) {
+        pthread_mutex_unlock(&churn->mtx);
+        return 0;
+    }
+    
+    print_event_header(ctx->pid, ctx->current_step, &ctx->ts, "FORK(BEFORE)   ");
+    printf("spawning P%d\n", slot);
+    
+    // The child thread only reads its timestamp after seeing SLOT_ACTIVE under the lock
+    ProcCtx *child = &churn->procs[slot];
+    if (ctx->clock_type == CLOCK_ITC) {
+        // Split the id space; the child starts with the parent's history
+        child->ts = itc_fork(&ctx->ts);
+        child->ts.pid = slot;
+    } else {
+        // Vector clocks need a fresh index that starts from the parent's history
+        child->ts = ts_create_in(&child->arena, ctx->n, slot, ctx->clock_type);
+        ts_set_wire_format(&child->ts, ctx->wire_format);
+        size_t size = ts_serialize(&ctx->ts, NULL, 0);
+        void *buffer = malloc(size);
+        size = ts_serialize(&ctx->ts, buffer, size);
+        ts_merge(&child->ts, buffer, size);
+        free(buffer);
+    }
+    ts_set_wire_format(&child->ts, ctx->wire_format);
+    ts_set_deferred(&child->ts, ts_deferred(&ctx->ts));
+    if (ctx->truth.data) {
+        child->truth = ts_create_in(&child->arena, ctx->n, slot, ctx->truth.type);
+        size_t size = ts_serialize(&ctx->truth, NULL, 0);
+        void *buffer = malloc(size);
+        ts_serialize(&ctx->truth, buffer, size);
+        ts_merge(&child->truth, buffer, size);
+        free(buffer);
+    }
+    
+    churn->state[slot] = SLOT_ACTIVE;
+    churn->active++;
+    churn->created++;
+    pthread_mutex_unlock(&churn->mtx);
+    
+    print_event_header(ctx->pid, ctx->current_step, &ctx->ts, "FORK(AFTER)    ");
+    printf("P%d joined\n", slot);
+    return 1;
+}
+
+int do_retire(ProcCtx *ctx, unsigned int *seed) {
+    Churn *churn = ctx->churn;
+
+    // Take in what already arrived so it is passed on rather than dropped
+    while (do_try_recv(ctx)) {}
+
+    pthread_mutex_lock(&churn->mtx);
+    
+    int heir = churn->active > CHURN_MIN_ACTIVE ? pick_active_locked(churn, ctx->pid, seed) : -1;
+    if (heir < 0) {
+        pthread_mutex_unlock(&churn->mtx);
+        return 0;
+    }
+    churn->state[ctx->pid] = SLOT_RETIRED;
+    churn->active--;
+    pthread_mutex_unlock(&churn->mtx);
+    
+    print_event_header(ctx->pid, ctx->current_step, &ctx->ts, "RETIRE(BEFORE) ");
+    printf("handing clock to P%d\n", heir);
+    
+    // The heir joins the full stamp, so for ITC it takes over this process's id. If the
+    // heir retires before receiving it, the id is lost: harmless, but it stays unusable.
+    tick(ctx, NULL);
+    char payload[PAYLOAD_SIZE];
+    snprintf(payload, sizeof(payload), "step %d: P%d_retiring", ctx->current_step, ctx->pid);
+    push_message(ctx, heir, payload, 1);
+    if (ctx->clock_type == CLOCK_ITC) {
+        itc_retire(&ctx->ts);
+    }
+    
+    print_event_header(ctx->pid, ctx->current_step, &ctx->ts, "RETIRE(AFTER)  ");
+    printf("left the system\n");
+    return 1;
+}
+
+// Messages that reach a retired process are dropped
+static void drop_messages(ProcCtx *ctx) {
+    Message *m;
+    while ((m = mq_try_pop(&ctx->queues[ctx->pid])) != NULL) {
+        printf("P%d Step%d DROPPED | from P%d: payload=\"%s\" (retired)\n",
+               ctx->pid, ctx->current_step, m->from, m->payload);
+        free(m->timestamp_data);
+        free(m->truth_data);
+        free(m);
+    }
+}
+
 /* ---------- Worker Thread ---------- */
 
-void* worker(void *arg) {
-    ProcCtx *ctx = (ProcCtx*)arg;
+SIM_INLINE void *worker_loop(ProcCtx *ctx, const TimestampOps *ops) {
     unsigned int seed = (unsigned int)time(NULL) ^ (ctx->pid * 2654435761u);
 
     for (int step = 0; step < ctx->steps; step++) {
         ctx->current_step = step;  // Set current step in context
+        
+        if (ctx->churn) {
+            SlotState state = slot_state(ctx);
+            if (state != SLOT_ACTIVE) {
+                // Unused slots wait for a fork; retired ones only discard late messages
+                if (state == SLOT_RETIRED) drop_messages(ctx);
+                ms_sleep(rand_in_range(&seed, MIN_SLEEP_MS, MAX_SLEEP_MS));
+                continue;
+            }
+            
+            int roll = rand_in_range(&seed, 0, 99);
+            if ((roll < PROB_FORK && do_fork(ctx)) ||
+                (roll >= PROB_FORK && roll < PROB_FORK + PROB_RETIRE && do_retire(ctx, &seed))) {
+                ms_sleep(rand_in_range(&seed, MIN_SLEEP_MS, MAX_SLEEP_MS));
+                continue;
+            }
+        }
+        
         int choice = rand_in_range(&seed, 0, 99);
 
         if (choice < PROB_INTERNAL) {
-            do_internal(ctx);
+            internal_event(ctx, ops);
         } else if (choice < PROB_INTERNAL + PROB_SEND) {
             // SEND
             int dest;
-            do { dest = rand_in_range(&seed, 0, ctx->n - 1); } while (dest == ctx->pid);
-            char payload[PAYLOAD_SIZE];
-            snprintf(payload, sizeof(payload), "step %d: hello_from_P%d_to_P%d", step, ctx->pid, dest);
-            do_send(ctx, dest, payload);
+            if (ctx->churn) {
+                dest = pick_active_dest(ctx, &seed);
+            } else {
+                do { dest = rand_in_range(&seed, 0, ctx->n - 1); } while (dest == ctx->pid);
+            }
+            if (dest < 0) {
+                internal_event(ctx, ops);
+            } else {
+                char payload[PAYLOAD_SIZE];
+                snprintf(payload, sizeof(payload), "step %d: hello_from_P%d_to_P%d", step, ctx->pid, dest);
+                send_event(ctx, ops, dest, payload);
+            }
         } else {
             // TRY RECEIVE; if nothing, do internal
-            if (!do_try_recv(ctx)) {
-                do_internal(ctx);
+            if (!recv_event(ctx, ops)) {
+                internal_event(ctx, ops);
             }
         }
 
@@ -153,10 +493,117 @@ void* worker(void *arg) {
     }
 
     // Drain a few possible remaining messages (non-blocking)
-    for (int i = 0; i < DRAIN_ATTEMPTS; i++) {
-        if (!do_try_recv(ctx)) break;
+    SlotState state = slot_state(ctx);
+    for (int i = 0; i < DRAIN_ATTEMPTS && state == SLOT_ACTIVE; i++) {
+        if (!recv_event(ctx, ops)) break;
         ms_sleep(3);
     }
+    if (state == SLOT_RETIRED) {
+        drop_messages(ctx);
+    }
 
     return NULL;
-}
\ No newline at end of file
+}
+
+#ifdef SIM_SPECIALIZE
+// One copy of the event loop per clock type, with that type's ops table as a constant
+#define SIM_CLOCK_TYPES(X) \
+    X(CLOCK_STANDARD, standard, STANDARD_OPS) \
+    X(CLOCK_SPARSE, sparse, SPARSE_OPS) \
+    X(CLOCK_DIFFERENTIAL, differential, DIFFERENTIAL_OPS) \
+    X(CLOCK_ENCODED, encoded, ENCODED_OPS) \
+    X(CLOCK_COMPRESSED, compressed, COMPRESSED_OPS) \
+    X(CLOCK_ITC, itc, ITC_OPS) \
+    X(CLOCK_HLC, hlc, HLC_OPS) \
+    X(CLOCK_PLAUSIBLE, plausible, PLAUSIBLE_OPS) \
+    X(CLOCK_BLOOM, bloom, BLOOM_OPS) \
+    X(CLOCK_MATRIX, matrix, MATRIX_OPS) \
+    X(CLOCK_LAMPORT, lamport, LAMPORT_OPS)
+
+#define DEFINE_WORKER(type, name, table) \
+    static void *worker_##name(ProcCtx *ctx) { return worker_loop(ctx, &table); }
+SIM_CLOCK_TYPES(DEFINE_WORKER)
+#endif
+
+void* worker(void *arg) {
+    ProcCtx *ctx = (ProcCtx*)arg;
+#ifdef SIM_SPECIALIZE
+    // Clocks bound to a fixed-n table (see FOR_EACH_FIXED_N) keep it: generic loop below
+#define WORKER_CASE(type, name, table) \
+    case type: if (ctx->ts.ops == &table) return worker_##name(ctx); break;
+    switch (ctx->clock_type) {
+        SIM_CLOCK_TYPES(WORKER_CASE)
+        default: break;
+    }
+#endif
+    return worker_loop(ctx, NULL);
+}
+
+/* ---------- Clock Type Report ---------- */
+
+static double monotonic_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1e9 + now.tv_nsec;
+}
+
+TypeCost measure_type_cost(ClockType type, int n, int events, WireFormat wire, int deferred) {
+    Timestamp *clocks = (Timestamp*)malloc(n * sizeof(Timestamp));
+    MsgQueue *queues = (MsgQueue*)malloc(n * sizeof(MsgQueue));
+    for (int i = 0; i < n; i++) {
+        clocks[i] = ts_create(n, i, type);
+        ts_set_wire_format(&clocks[i], wire);
+        ts_set_deferred(&clocks[i], deferred);
+        mq_init(&queues[i]);
+    }
+    
+    TypeCost cost = {0, 0.0, 0.0};
+    size_t bytes = 0;
+    unsigned int seed = REPORT_SEED;
+    double start = monotonic_ns();
+    for (int e = 0; e < events; e++) {
+        int pid = rand_in_range(&seed, 0, n - 1);
+        int roll = rand_in_range(&seed, 0, 99);
+        
+        if (roll >= PROB_INTERNAL + PROB_SEND) {
+            Message *m = mq_try_pop(&queues[pid]);
+            if (m) {
+                ts_merge_and_tick(&clocks[pid], m->timestamp_data, m->timestamp_size);
+                free(m->timestamp_data);
+                free(m);
+                continue;
+            }
+            roll = 0;  // nothing to receive: a local event instead
+        }
+        if (roll < PROB_INTERNAL) {
+            ts_increment(&clocks[pid]);
+            continue;
+        }
+        
+        int dest = rand_in_range(&seed, 0, n - 2);
+        if (dest >= pid) dest++;
+        ts_increment(&clocks[pid]);
+        Message *m = (Message*)malloc(sizeof(Message));
+        m->from = pid;
+        m->to = dest;
+        m->clock_type = type;
+        m->truth_data = NULL;
+        m->truth_size = 0;
+        m->timestamp_size = ts_serialize_for_dest(&clocks[pid], dest, NULL, 0);
+        m->timestamp_data = malloc(m->timestamp_size);
+        m->timestamp_size = ts_serialize_for_dest(&clocks[pid], dest, m->timestamp_data, m->timestamp_size);
+        mq_push(&queues[dest], m);
+        bytes += m->timestamp_size;
+        cost.messages++;
+    }
+    cost.ns_per_event = events > 0 ? (monotonic_ns() - start) / events : 0.0;
+    cost.bytes_per_message = cost.messages > 0 ? (double)bytes / cost.messages : 0.0;
+    
+    for (int i = 0; i < n; i++) {
+        mq_destroy(&queues[i]);  // frees undelivered messages
+        ts_destroy(&clocks[i]);
+    }
+    free(queues);
+    free(clocks);
+    return cost;
+}
@@ -3,6 +3,74 @@
 #include <string.h>
 #include "sparse_clock.h"
 
+/* ---------- Sorted Entry Helpers ---------- */
+
+// Grow the entry array to hold at least `needed` entries, leaving the inline buffer when full
+static void sparse_reserve(SparseClockData *data, int needed) {
+    if (needed <= data->capacity) return;
+    
+    int capacity = data->capacity * 2;
+    if (capacity < needed) capacity = needed;
+    
+    if (data->entries == data->inline_entries) {
+        data->entries = malloc(capacity * sizeof(SparseEntry));
+        memcpy(data->entries, data->inline_entries, data->count * sizeof(SparseEntry));
+    } else {
+        data->entries = realloc(data->entries, capacity * sizeof(SparseEntry));
+    }
+    if (!data->entries) {
+        fprintf(stderr, "OOM\n");
+        exit(1);
+    }
+    data->capacity = capacity;
+}
+
+// Index of the first entry with entry.pid >= pid
+static int sparse_lower_bound(const SparseEntry *entries, int count, int pid) {
+    int lo = 0, hi = count;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (entries[mid].pid < pid) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+static int sparse_entry_cmp(const void *a, const void *b) {
+    const SparseEntry *ea = (const SparseEntry*)a;
+    const SparseEntry *eb = (const SparseEntry*)b;
+    return (ea->pid > eb->pid) - (ea->pid < eb->pid);
+}
+
+// 1 if pids are strictly increasing and within [0, n), as sparse_serialize emits them
+static int sparse_is_canonical(const SparseEntry *entries, int count, int n) {
+    if (count > 0 && (entries[0].pid < 0 || entries[count - 1].pid >= n)) return 0;
+    for (int i = 1; i < count; i++) {
+        if (entries[i - 1].pid >= entries[i].pid) return 0;
+    }
+    return 1;
+}
+
+// Copies entries to out in canonical form: pids outside [0, n) dropped, the rest sorted and
+// repeated pids collapsed to their largest counter. out may be entries. Returns the count.
+static int sparse_canonicalize(const SparseEntry *entries, int count, int n, SparseEntry *out) {
+    int kept = 0;
+    for (int i = 0; i < count; i++) {
+        if (entries[i].pid >= 0 && entries[i].pid < n) out[kept++] = entries[i];
+    }
+    qsort(out, kept, sizeof(SparseEntry), sparse_entry_cmp);
+    
+    int unique = 0;
+    for (int i = 0; i < kept; i++) {
+        if (unique > 0 && out[unique - 1].pid == out[i].pid) {
+            if (out[i].counter > out[unique - 1].counter) out[unique - 1].counter = out[i].counter;
+        } else {
+            out[unique++] = out[i];
+        }
+    }
+    return unique;
+}
+
 /* ---------- Sparse Vector Clock Implementation ---------- */
 
 Timestamp sparse_create(int n, int pid, ClockType type) {
@@ -10,11 +78,12 @@ Timestamp sparse_create(int n, int pid, ClockType type) {
     ts.n = n;
     ts.pid = pid;
     ts.type = type;
+    clock_digest_reset(&ts.digest);
     
     SparseClockData *data = malloc(sizeof(SparseClockData));
-    data->entries = malloc(n * sizeof(SparseEntry));
+    data->entries = data->inline_entries;
     data->count = 0;
-    data->capacity = n;
+    data->capacity = SPARSE_INLINE_CAPACITY;
     
     ts.data = data;
     ts.data_size = 0; // Dynamic size
@@ -24,10 +93,10 @@ Timestamp sparse_create(int n, int pid, ClockType type) {
 void sparse_destroy(Timestamp *ts) {
     if (ts && ts->data) {
         SparseClockData *data = (SparseClockData*)ts->data;
-        if (data->entries) {
+        if (data->entries && data->entries != data->inline_entries) {
             free(data->entries);
-            data->entries = NULL;
         }
+        data->entries = NULL;
         free(ts->data);
         ts->data = NULL;
     }
@@ -36,103 +105,114 @@ void sparse_destroy(Timestamp *ts) {
 void sparse_increment(Timestamp *ts) {
     SparseClockData *data = (SparseClockData*)ts->data;
     
-    // Find entry for this process
-    for (int i = 0; i < data->count; i++) {
-        if (data->entries[i].pid == ts->pid) {
-            data->entries[i].counter++;
-            return;
-        }
+    int pos = sparse_lower_bound(data->entries, data->count, ts->pid);
+    if (pos < data->count && data->entries[pos].pid == ts->pid) {
+        int counter = ++data->entries[pos].counter;
+        if (counter > 0) clock_digest_raise(&ts->digest, ts->pid, counter - 1, counter);
+        return;
     }
     
-    // Add new entry
-    if (data->count >= data->capacity) {
-        data->capacity *= 2;
-        data->entries = realloc(data->entries, data->capacity * sizeof(SparseEntry));
-    }
-    data->entries[data->count].pid = ts->pid;
-    data->entries[data->count].counter = 1;
+    // Insert a new entry at its sorted position
+    sparse_reserve(data, data->count + 1);
+    memmove(&data->entries[pos + 1], &data->entries[pos],
+            (data->count - pos) * sizeof(SparseEntry));
+    data->entries[pos].pid = ts->pid;
+    data->entries[pos].counter = 1;
     data->count++;
+    clock_digest_raise(&ts->digest, ts->pid, 0, 1);
 }
 
 void sparse_merge(Timestamp *dst, const void *other_data, size_t other_size) {
     SparseClockData *dst_data = (SparseClockData*)dst->data;
     const SparseEntry *other_entries = (const SparseEntry*)other_data;
     int other_count = other_size / sizeof(SparseEntry);
+    SparseEntry *sorted_copy = NULL;
     
-    for (int i = 0; i < other_count; i++) {
-        int other_pid = other_entries[i].pid;
-        int other_counter = other_entries[i].counter;
-        
-        // Find corresponding entry in destination
-        int found = 0;
-        for (int j = 0; j < dst_data->count; j++) {
-            if (dst_data->entries[j].pid == other_pid) {
-                if (other_counter > dst_data->entries[j].counter) {
-                    dst_data->entries[j].counter = other_counter;
-                }
-                found = 1;
-                break;
+    // Senders emit canonical entries; only input that did not come from sparse_serialize
+    // is copied, filtered, sorted and deduplicated
+    if (!sparse_is_canonical(other_entries, other_count, dst->n)) {
+        sorted_copy = malloc((other_count ? other_count : 1) * sizeof(SparseEntry));
+        other_count = sparse_canonicalize(other_entries, other_count, dst->n, sorted_copy);
+        other_entries = sorted_copy;
+    }
+    
+    // Pass 1: size of the union of both pid sets
+    int union_count = 0;
+    int i = 0, j = 0;
+    while (i < dst_data->count && j < other_count) {
+        int a_pid = dst_data->entries[i].pid;
+        int b_pid = other_entries[j].pid;
+        if (a_pid <= b_pid) i++;
+        if (b_pid <= a_pid) j++;
+        union_count++;
+    }
+    union_count += (dst_data->count - i) + (other_count - j);
+    
+    // Pass 2: merge from the back so the result can be built in place
+    sparse_reserve(dst_data, union_count);
+    SparseEntry *out = dst_data->entries;
+    i = dst_data->count - 1;
+    j = other_count - 1;
+    for (int k = union_count - 1; k >= 0; k--) {
+        if (j < 0 || (i >= 0 && out[i].pid > other_entries[j].pid)) {
+            out[k] = out[i--];
+        } else if (i < 0 || other_entries[j].pid > out[i].pid) {
+            if (other_entries[j].counter > 0) {
+                clock_digest_raise(&dst->digest, other_entries[j].pid, 0, other_entries[j].counter);
             }
-        }
-        
-        if (!found) {
-            // Add new entry
-            if (dst_data->count >= dst_data->capacity) {
-                dst_data->capacity *= 2;
-                dst_data->entries = realloc(dst_data->entries, 
-                    dst_data->capacity * sizeof(SparseEntry));
+            out[k] = other_entries[j--];
+        } else {
+            // Entries below zero (malformed input) count as 0 in the digest
+            int counter = out[i].counter;
+            if (other_entries[j].counter > counter) {
+                if (other_entries[j].counter > 0) {
+                    clock_digest_raise(&dst->digest, out[i].pid, counter > 0 ? counter : 0,
+                                       other_entries[j].counter);
+                }
+                counter = other_entries[j].counter;
             }
-            dst_data->entries[dst_data->count].pid = other_pid;
-            dst_data->entries[dst_data->count].counter = other_counter;
-            dst_data->count++;
+            out[k].pid = out[i].pid;
+            out[k].counter = counter;
+            i--;
+            j--;
         }
     }
+    dst_data->count = union_count;
+    
+    free(sorted_copy);
 }
 
 TSOrder sparse_compare(const Timestamp *a, const Timestamp *b) {
     const SparseClockData *a_data = (const SparseClockData*)a->data;
     const SparseClockData *b_data = (const SparseClockData*)b->data;
     
-    int a_le_b = 1, b_le_a = 1;
-    int a_lt_b = 0, b_lt_a = 0;
-    
-    // Check all processes in both clocks
-    for (int pid = 0; pid < a->n; pid++) {
-        int a_val = 0, b_val = 0;
-        
-        // Get value for process pid in clock a
-        for (int i = 0; i < a_data->count; i++) {
-            if (a_data->entries[i].pid == pid) {
-                a_val = a_data->entries[i].counter;
-                break;
-            }
-        }
-        
-        // Get value for process pid in clock b
-        for (int i = 0; i < b_data->count; i++) {
-            if (b_data->entries[i].pid == pid) {
-                b_val = b_data->entries[i].counter;
-                break;
-            }
-        }
-        
-        if (a_val > b_val) {
-            a_le_b = 0;
-            b_lt_a = 1;
-        }
-        if (b_val > a_val) {
-            b_le_a = 0;
-            a_lt_b = 1;
+    int a_gt = 0, b_gt = 0;  // some entry of a (resp. b) exceeds the other clock
+    int i = 0, j = 0;
+    
+    // Merge-join over both sorted entry lists; a missing pid counts as zero
+    while ((i < a_data->count || j < b_data->count) && !(a_gt && b_gt)) {
+        if (j >= b_data->count || (i < a_data->count && a_data->entries[i].pid < b_data->entries[j].pid)) {
+            if (a_data->entries[i].counter > 0) a_gt = 1;
+            i++;
+        } else if (i >= a_data->count || b_data->entries[j].pid < a_data->entries[i].pid) {
+            if (b_data->entries[j].counter > 0) b_gt = 1;
+            j++;
+        } else {
+            if (a_data->entries[i].counter > b_data->entries[j].counter) a_gt = 1;
+            if (b_data->entries[j].counter > a_data->entries[i].counter) b_gt = 1;
+            i++;
+            j++;
         }
     }
     
-    if (a_le_b && b_le_a) return TS_EQUAL;
-    if (a_le_b && a_lt_b) return TS_BEFORE;
-    if (b_le_a && b_lt_a) return TS_AFTER;
+    if (!a_gt && !b_gt) return TS_EQUAL;
+    if (!a_gt) return TS_BEFORE;
+    if (!b_gt) return TS_AFTER;
     return TS_CONCURRENT;
 }
 
 size_t sparse_serialize(const Timestamp *ts, void *buffer, size_t bufsize) {
+    // Entries are kept sorted by pid, so the wire form is sorted as well
     const SparseClockData *data = (const SparseClockData*)ts->data;
     size_t required = data->count * sizeof(SparseEntry);
     
@@ -146,13 +226,21 @@ void sparse_deserialize(Timestamp *ts, const void *buffer, size_t size) {
     SparseClockData *data = (SparseClockData*)ts->data;
     int count = size / sizeof(SparseEntry);
     
-    if (count > data->capacity) {
-        data->capacity = count;
-        data->entries = realloc(data->entries, data->capacity * sizeof(SparseEntry));
+    sparse_reserve(data, count);
+    memcpy(data->entries, buffer, count * sizeof(SparseEntry));
+    data->count = count;
+    
+    if (!sparse_is_canonical(data->entries, count, ts->n)) {
+        count = sparse_canonicalize(data->entries, count, ts->n, data->entries);
+        data->count = count;
     }
     
-    memcpy(data->entries, buffer, size);
-    data->count = count;
+    clock_digest_reset(&ts->digest);
+    for (int i = 0; i < count; i++) {
+        if (data->entries[i].counter > 0) {
+            clock_digest_raise(&ts->digest, data->entries[i].pid, 0, data->entries[i].counter);
+        }
+    }
 }
 
 void sparse_to_string(const Timestamp *ts, char *buf, size_t bufsize) {
@@ -163,7 +251,7 @@ void sparse_to_string(const Timestamp *ts, char *buf, size_t bufsize) {
     for (int i = 0; i < data->count; i++) {
         used += snprintf(buf + used, bufsize - used, "%sP%d:%d", 
                         (i ? "," : ""), data->entries[i].pid, data->entries[i].counter);
-        if (used >= bufsize) break;
+        if (used >= bufsize) return;  // truncated
     }
     snprintf(buf + used, bufsize - used, "}");
 }
@@ -173,20 +261,25 @@ Timestamp sparse_clone(const Timestamp *ts) {
     const SparseClockData *src_data = (const SparseClockData*)ts->data;
     SparseClockData *dst_data = (SparseClockData*)out.data;
     
-    if (src_data->count > 0) {
-        dst_data->entries = realloc(dst_data->entries, 
-            src_data->count * sizeof(SparseEntry));
-        memcpy(dst_data->entries, src_data->entries, 
-            src_data->count * sizeof(SparseEntry));
-        dst_data->count = src_data->count;
-        dst_data->capacity = src_data->count;
-    }
+    sparse_reserve(dst_data, src_data->count);
+    memcpy(dst_data->entries, src_data->entries, 
+        src_data->count * sizeof(SparseEntry));
+    dst_data->count = src_data->count;
+    out.digest = ts->digest;
     return out;
 }
 
+void sparse_to_vector(const Timestamp *ts, int *out) {
+    const SparseClockData *data = (const SparseClockData*)ts->data;
+    memset(out, 0, ts->n * sizeof(int));
+    for (int i = 0; i < data->count; i++) {
+        out[data->entries[i].pid] = data->entries[i].counter;
+    }
+}
+
 /* ---------- Operations Table ---------- */
 
-TimestampOps SPARSE_OPS = {
+const TimestampOps SPARSE_OPS = {
     .create = sparse_create,
     .destroy = sparse_destroy,
     .increment = sparse_increment,
@@ -196,5 +289,6 @@ TimestampOps SPARSE_OPS = {
     .serialize_for_dest = NULL,  // Sparse clocks don't need destination-aware serialization
     .deserialize = sparse_deserialize,
     .to_string = sparse_to_string,
-    .clone = sparse_clone
+    .clone = sparse_clone,
+    .to_vector = sparse_to_vector
 };
\ No newline at end of file
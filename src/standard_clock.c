@@ -1,54 +1,149 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <limits.h>
 #include "standard_clock.h"
+#include "counter_store.h"
 
 /* ---------- Standard Vector Clock Implementation ---------- */
 
-Timestamp standard_create(int n, int pid, ClockType type) {
+static StandardClockData *alloc_block(ClockArena *arena, int n, int width) {
+    StandardClockData *data = clock_block_alloc(arena, sizeof(StandardClockData) + (size_t)n * width);
+    data->n = n;
+    data->width = width;
+    return data;
+}
+
+// Moves the clock to a block of the given width from the same arena (or the heap).
+// Counters are carried over only if keep is set.
+static StandardClockData *resize(Timestamp *ts, int width, int keep) {
+    StandardClockData *old = (StandardClockData*)ts->data;
+    StandardClockData *data = alloc_block(clock_block_arena(old), ts->n, width);
+    if (keep) {
+        counter_copy(data->cells, width, old->cells, old->width, ts->n);
+    }
+    clock_block_free(old);
+    ts->data = data;
+    ts->data_size = (size_t)ts->n * width;
+    return data;
+}
+
+// Raw serializations of n counters in each layout
+static int is_wide_size(int n, size_t size) {
+    return n > 0 && size == (size_t)n * sizeof(uint64_t);
+}
+
+Timestamp standard_create_in(ClockArena *arena, int n, int pid, ClockType type) {
     Timestamp ts;
     ts.n = n;
     ts.pid = pid;
     ts.type = type;
+    clock_digest_reset(&ts.digest);
     
-    StandardClockData *data = malloc(sizeof(StandardClockData));
-    data->v = (int*)calloc(n, sizeof(int));
-    if (!data->v) {
-        fprintf(stderr, "OOM\n");
-        exit(1);
-    }
-    
-    ts.data = data;
-    ts.data_size = n * sizeof(int);
+    ts.data = alloc_block(arena, n, COUNTER_WIDTH_MIN);
+    ts.data_size = (size_t)n * COUNTER_WIDTH_MIN;
     return ts;
 }
 
+Timestamp standard_create(int n, int pid, ClockType type) {
+    return standard_create_in(NULL, n, pid, type);
+}
+
 void standard_destroy(Timestamp *ts) {
     if (ts && ts->data) {
-        StandardClockData *data = (StandardClockData*)ts->data;
-        if (data->v) {
-            free(data->v);
-            data->v = NULL;
-        }
-        free(ts->data);
+        clock_block_free(ts->data);
         ts->data = NULL;
     }
 }
 
-void standard_increment(Timestamp *ts) {
+// Counter k grows from old to next
+static void standard_raise(Timestamp *ts, int k, uint64_t old, uint64_t next) {
     StandardClockData *data = (StandardClockData*)ts->data;
-    data->v[ts->pid] += 1;
+    int width = counter_width_for(next);
+    if (width > data->width) {
+        data = resize(ts, width, 1);
+    }
+    counter_set(data->cells, data->width, k, next);
+    clock_digest_raise(&ts->digest, k, old, next);
+}
+
+void standard_increment(Timestamp *ts) {
+    uint64_t old = standard_get(ts, ts->pid);
+    standard_raise(ts, ts->pid, old, old + 1);
 }
 
 void standard_merge(Timestamp *dst, const void *other_data, size_t other_size) {
     StandardClockData *dst_data = (StandardClockData*)dst->data;
-    const int *other_v = (const int*)other_data;
+    int n = dst->n;
+    
+    if (is_wide_size(n, other_size)) {
+        const uint64_t *src = (const uint64_t*)other_data;
+        int width = counter_width_for(counter_max(src, sizeof(uint64_t), n));
+        if (width > dst_data->width) {
+            dst_data = resize(dst, width, 1);
+        }
+        counter_merge_u64(dst_data->cells, dst_data->width, src, n, &dst->digest);
+        return;
+    }
     
-    for (int i = 0; i < dst->n; i++) {
-        if (other_v[i] > dst_data->v[i]) {
-            dst_data->v[i] = other_v[i];
+    if (other_size < (size_t)n * sizeof(int32_t)) {
+        return;
+    }
+    const int32_t *src = (const int32_t*)other_data;
+    int width = counter_width_for(counter_max(src, sizeof(int32_t), n));
+    if (width > dst_data->width) {
+        dst_data = resize(dst, width, 1);
+    }
+    counter_merge_i32(dst_data->cells, dst_data->width, src, n, &dst->digest);
+}
+
+int standard_gather(const Timestamp *ts, const void *other_data, size_t other_size, ClockGather *g) {
+    int n = ts->n;
+    if (is_wide_size(n, other_size)) {
+        // The other entries go to g->wide; the own entry joins the int bookkeeping of the
+        // pending ticks, so one past INT_MAX is merged in order
+        const uint64_t *src = (const uint64_t*)other_data;
+        if (src[ts->pid] > INT_MAX) {
+            return 0;
         }
+        if (!g->wide) {
+            g->wide = calloc(n, sizeof(uint64_t));
+            if (!g->wide) {
+                fprintf(stderr, "OOM\n");
+                exit(1);
+            }
+        }
+        for (int i = 0; i < n; i++) {
+            if (src[i] > g->wide[i]) g->wide[i] = src[i];
+        }
+        if ((int)src[ts->pid] > g->self_max) g->self_max = (int)src[ts->pid];
+        g->wide[ts->pid] = 0;
+        return 1;
+    }
+    if (other_size != (size_t)n * sizeof(int32_t)) {
+        return 0;
     }
+    clock_gather_vector(g, (const int*)other_data, n);
+    return 1;
+}
+
+void standard_fold(Timestamp *ts, const ClockGather *g, int ticks) {
+    if (g->wide) {
+        standard_merge(ts, g->wide, (size_t)ts->n * sizeof(uint64_t));
+    }
+    if (g->dense) {
+        standard_merge(ts, g->acc, (size_t)ts->n * sizeof(int32_t));
+    } else {
+        for (int i = 0; i < g->count; i++) {
+            int k = g->touched[i];
+            uint64_t old = standard_get(ts, k);
+            if ((uint64_t)g->acc[k] > old) {
+                standard_raise(ts, k, old, (uint64_t)g->acc[k]);
+            }
+        }
+    }
+    uint64_t old = standard_get(ts, ts->pid);
+    standard_raise(ts, ts->pid, old, old + (uint64_t)ticks);
 }
 
 TSOrder standard_compare(const Timestamp *a, const Timestamp *b) {
@@ -60,42 +155,50 @@ TSOrder standard_compare(const Timestamp *a, const Timestamp *b) {
     const StandardClockData *a_data = (const StandardClockData*)a->data;
     const StandardClockData *b_data = (const StandardClockData*)b->data;
     
-    int a_le_b = 1, b_le_a = 1;
-    int a_lt_b = 0, b_lt_a = 0;
-    
-    for (int i = 0; i < a->n; i++) {
-        if (a_data->v[i] > b_data->v[i]) {
-            a_le_b = 0;
-            b_lt_a = 1;
-        }
-        if (b_data->v[i] > a_data->v[i]) {
-            b_le_a = 0;
-            a_lt_b = 1;
-        }
-    }
-    
-    if (a_le_b && b_le_a) return TS_EQUAL;
-    if (a_le_b && a_lt_b) return TS_BEFORE;
-    if (b_le_a && b_lt_a) return TS_AFTER;
-    return TS_CONCURRENT;
+    return counter_compare(a_data->cells, a_data->width, b_data->cells, b_data->width, a->n);
+}
+
+// 32-bit cells stop at INT32_MAX; 64-bit ones have to be checked
+static int fits_int32(const StandardClockData *data) {
+    return data->width <= 4 || counter_max(data->cells, data->width, data->n) <= INT32_MAX;
 }
 
 size_t standard_serialize(const Timestamp *ts, void *buffer, size_t bufsize) {
     const StandardClockData *data = (const StandardClockData*)ts->data;
-    size_t required = ts->n * sizeof(int);
+    int width = fits_int32(data) ? (int)sizeof(int32_t) : (int)sizeof(uint64_t);
+    size_t required = (size_t)ts->n * width;
     
     if (bufsize >= required) {
-        memcpy(buffer, data->v, required);
+        counter_copy(buffer, width, data->cells, data->width, ts->n);
     }
     return required;
 }
 
 void standard_deserialize(Timestamp *ts, const void *buffer, size_t size) {
     StandardClockData *data = (StandardClockData*)ts->data;
-    size_t expected = ts->n * sizeof(int);
+    int n = ts->n;
+    int src_width;
+    
+    if (is_wide_size(n, size)) {
+        src_width = sizeof(uint64_t);
+    } else if (size == (size_t)n * sizeof(int32_t)) {
+        src_width = sizeof(int32_t);
+    } else {
+        return;
+    }
+    
+    // The old counters are overwritten, so a wider block needs no copy
+    int width = counter_width_for(counter_max(buffer, src_width, n));
+    if (width > data->width) {
+        data = resize(ts, width, 0);
+    }
+    counter_copy(data->cells, data->width, buffer, src_width, n);
     
-    if (size == expected) {
-        memcpy(data->v, buffer, size);
+    // Counters may have gone down, so the digest is rebuilt rather than raised
+    clock_digest_reset(&ts->digest);
+    for (int i = 0; i < n; i++) {
+        uint64_t v = counter_get(data->cells, data->width, i);
+        if (v) clock_digest_raise(&ts->digest, i, 0, v);
     }
 }
 
@@ -105,25 +208,123 @@ void standard_to_string(const Timestamp *ts, char *buf, size_t bufsize) {
     
     used += snprintf(buf + used, bufsize - used, "[");
     for (int i = 0; i < ts->n; i++) {
-        used += snprintf(buf + used, bufsize - used, "%s%d", 
-                        (i ? "," : ""), data->v[i]);
-        if (used >= bufsize) break;
+        used += snprintf(buf + used, bufsize - used, "%s%llu", 
+                        (i ? "," : ""), (unsigned long long)counter_get(data->cells, data->width, i));
+        if (used >= bufsize) return;  // truncated
     }
     snprintf(buf + used, bufsize - used, "]");
 }
 
-Timestamp standard_clone(const Timestamp *ts) {
-    Timestamp out = standard_create(ts->n, ts->pid, ts->type);
+Timestamp standard_clone_in(ClockArena *arena, const Timestamp *ts) {
     const StandardClockData *src_data = (const StandardClockData*)ts->data;
-    StandardClockData *dst_data = (StandardClockData*)out.data;
+    Timestamp out = *ts;
     
-    memcpy(dst_data->v, src_data->v, ts->n * sizeof(int));
+    // Clones keep the source's width
+    StandardClockData *dst_data = alloc_block(arena, ts->n, src_data->width);
+    memcpy(dst_data->cells, src_data->cells, (size_t)ts->n * src_data->width);
+    out.data = dst_data;
+    out.data_size = (size_t)ts->n * src_data->width;
     return out;
 }
 
+Timestamp standard_clone(const Timestamp *ts) {
+    return standard_clone_in(NULL, ts);
+}
+
+void standard_to_vector(const Timestamp *ts, int *out) {
+    const StandardClockData *data = (const StandardClockData*)ts->data;
+    if (!fits_int32(data)) {
+        fprintf(stderr, "Counter past INT_MAX: use standard_to_vector64\n");
+        exit(1);
+    }
+    for (int i = 0; i < ts->n; i++) {
+        out[i] = (int)counter_get(data->cells, data->width, i);
+    }
+}
+
+void standard_to_vector64(const Timestamp *ts, uint64_t *out) {
+    const StandardClockData *data = (const StandardClockData*)ts->data;
+    counter_copy(out, sizeof(uint64_t), data->cells, data->width, ts->n);
+}
+
+uint64_t standard_get(const Timestamp *ts, int pid) {
+    const StandardClockData *data = (const StandardClockData*)ts->data;
+    return counter_get(data->cells, data->width, pid);
+}
+
+int standard_fits_int32(const Timestamp *ts) {
+    return fits_int32((const StandardClockData*)ts->data);
+}
+
+/* ---------- Fixed-n Kernels ---------- */
+
+// merge, compare and serialize for exactly N counters, built on the counter_store kernels
+// for that N; increment and the rest do not loop over n and stay shared. Sizes other
+// than N int32s (64-bit counters, malformed input) take the generic merge.
+#define DEFINE_STANDARD_FIXED_N(N)                                             \
+    static void standard_merge_##N(Timestamp *dst, const void *other_data, size_t other_size) { \
+        if (other_size != N * sizeof(int32_t)) {                               \
+            standard_merge(dst, other_data, other_size);                       \
+            return;                                                            \
+        }                                                                      \
+        StandardClockData *dst_data = (StandardClockData*)dst->data;           \
+        const int32_t *src = (const int32_t*)other_data;                       \
+        int width = counter_width_for(counter_max_##N(src, sizeof(int32_t)));  \
+        if (width > dst_data->width) {                                         \
+            dst_data = resize(dst, width, 1);                                  \
+        }                                                                      \
+        counter_merge_i32_##N(dst_data->cells, dst_data->width, src, &dst->digest); \
+    }                                                                          \
+    static TSOrder standard_compare_##N(const Timestamp *a, const Timestamp *b) { \
+        if (b->n != N) {                                                       \
+            fprintf(stderr, "Mismatched vector sizes!\n");                     \
+            exit(1);                                                           \
+        }                                                                      \
+        const StandardClockData *a_data = (const StandardClockData*)a->data;   \
+        const StandardClockData *b_data = (const StandardClockData*)b->data;   \
+        return counter_compare_##N(a_data->cells, a_data->width, b_data->cells, b_data->width); \
+    }                                                                          \
+    static size_t standard_serialize_##N(const Timestamp *ts, void *buffer, size_t bufsize) { \
+        const StandardClockData *data = (const StandardClockData*)ts->data;    \
+        int fits = data->width <= 2 || counter_max_##N(data->cells, data->width) <= INT32_MAX; \
+        int width = fits ? (int)sizeof(int32_t) : (int)sizeof(uint64_t);       \
+        size_t required = (size_t)N * width;                                   \
+        if (bufsize >= required) {                                             \
+            counter_copy_##N(buffer, width, data->cells, data->width);         \
+        }                                                                      \
+        return required;                                                       \
+    }                                                                          \
+    static const TimestampOps STANDARD_OPS_##N = {                             \
+        .create = standard_create,                                             \
+        .destroy = standard_destroy,                                           \
+        .increment = standard_increment,                                       \
+        .merge = standard_merge_##N,                                           \
+        .compare = standard_compare_##N,                                       \
+        .serialize = standard_serialize_##N,                                   \
+        .deserialize = standard_deserialize,                                   \
+        .to_string = standard_to_string,                                       \
+        .clone = standard_clone,                                               \
+        .to_vector = standard_to_vector,                                       \
+        .create_in = standard_create_in,                                       \
+        .clone_in = standard_clone_in,                                         \
+        .specialize = standard_specialize,                                     \
+        .gather = standard_gather,                                             \
+        .fold = standard_fold                                                  \
+    };
+FOR_EACH_FIXED_N(DEFINE_STANDARD_FIXED_N)
+
+#define STANDARD_FIXED_CASE(N) case N: return &STANDARD_OPS_##N;
+
+const TimestampOps *standard_specialize(int n) {
+    switch (n) {
+        FOR_EACH_FIXED_N(STANDARD_FIXED_CASE)
+        default: return NULL;
+    }
+}
+
 /* ---------- Operations Table ---------- */
 
-TimestampOps STANDARD_OPS = {
+const TimestampOps STANDARD_OPS = {
     .create = standard_create,
     .destroy = standard_destroy,
     .increment = standard_increment,
@@ -133,5 +334,11 @@ TimestampOps STANDARD_OPS = {
     .serialize_for_dest = NULL,  // Standard clocks don't need destination-aware serialization
     .deserialize = standard_deserialize,
     .to_string = standard_to_string,
-    .clone = standard_clone
+    .clone = standard_clone,
+    .to_vector = standard_to_vector,
+    .create_in = standard_create_in,
+    .clone_in = standard_clone_in,
+    .specialize = standard_specialize,
+    .gather = standard_gather,
+    .fold = standard_fold
 };
\ No newline at end of file
@@ -1,16 +1,26 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "timestamp.h"
 #include "standard_clock.h"
 #include "sparse_clock.h"
 #include "differential_clock.h"
 #include "encoded_clock.h"
 #include "compressed_clock.h"
+#include "itc_clock.h"
+#include "hlc_clock.h"
+#include "plausible_clock.h"
+#include "bloom_clock.h"
+#include "matrix_clock.h"
+#include "lamport_clock.h"
+#include "wire_codec.h"
+#include "vector_kernels.h"
 
 /* ---------- Clock Type Information ---------- */
 
 const char* clock_type_names[] = {
-    "Standard", "Sparse", "Differential", "Encoded", "Compressed"
+    "Standard", "Sparse", "Differential", "Encoded", "Compressed", "ITC", "HLC", "Plausible", "Bloom", "Matrix",
+    "Lamport"
 };
 
 const char* clock_type_descriptions[] = {
@@ -18,40 +28,253 @@ const char* clock_type_descriptions[] = {
     "Sparse representation (only non-zero entries)",
     "Differential technique (Singhal-Kshemkalyani)",
     "Prime number encoding (single integer)",
-    "True delta compression (only send changes per receiver)"
+    "True delta compression (only send changes per receiver)",
+    "Interval tree clocks (fork/join ids, no fixed process count)",
+    "Hybrid logical clocks (48-bit physical + 16-bit logical, 8 bytes)",
+    "Plausible clocks (pids folded into R entries, may order concurrent events)",
+    "Bloom clocks (counting Bloom filter of events, fixed size for any n)",
+    "Matrix clocks (n x n knowledge matrix, changed cells per destination)",
+    "Lamport clocks (one 64-bit counter, ties broken by pid)"
 };
 
 /* ---------- Operations Dispatch ---------- */
 
-static TimestampOps* get_ops(ClockType type) {
+// Only creation looks the type up; the result is cached in Timestamp.ops
+static const TimestampOps* get_ops(ClockType type) {
     switch (type) {
         case CLOCK_STANDARD: return &STANDARD_OPS;
         case CLOCK_SPARSE: return &SPARSE_OPS;
         case CLOCK_DIFFERENTIAL: return &DIFFERENTIAL_OPS;
         case CLOCK_ENCODED: return &ENCODED_OPS;
         case CLOCK_COMPRESSED: return &COMPRESSED_OPS;
+        case CLOCK_ITC: return &ITC_OPS;
+        case CLOCK_HLC: return &HLC_OPS;
+        case CLOCK_PLAUSIBLE: return &PLAUSIBLE_OPS;
+        case CLOCK_BLOOM: return &BLOOM_OPS;
+        case CLOCK_MATRIX: return &MATRIX_OPS;
+        case CLOCK_LAMPORT: return &LAMPORT_OPS;
         default:
             fprintf(stderr, "Unknown clock type: %d\n", type);
             exit(1);
     }
 }
 
+/* ---------- Fixed-n Kernels ---------- */
+
+static int g_fixed_kernels = 1;
+
+void ts_set_fixed_kernels(int enabled) {
+    g_fixed_kernels = enabled != 0;
+}
+
+int ts_fixed_kernels(void) {
+    return g_fixed_kernels;
+}
+
+// The type's table, or its fixed-n table when it has one for n
+static const TimestampOps* bind_ops(ClockType type, int n) {
+    const TimestampOps *ops = get_ops(type);
+    if (g_fixed_kernels && ops->specialize) {
+        const TimestampOps *fixed = ops->specialize(n);
+        if (fixed) return fixed;
+    }
+    return ops;
+}
+
+/* ---------- Deferred Receives ---------- */
+
+// Events a deferred clock has not applied yet. Local ticks and the tick of each receive
+// are only counted; the received messages are gathered into g (see TimestampOps.gather).
+struct TsPending {
+    int ticks;      // events to add to the own entry
+    int own;        // max over the gathered messages of (own entry - ticks counted before it)
+    ClockGather g;
+    int slots[];    // g.acc and g.touched, n each
+};
+
+void clock_gather_vector(ClockGather *g, const int *v, int n) {
+    vk_merge_max(g->acc, v, n);
+    if (v[g->self] > g->self_max) g->self_max = v[g->self];
+    g->acc[g->self] = 0;
+    g->dense = 1;
+}
+
+static void free_pending(Timestamp *ts) {
+    if (ts->pending) {
+        free(ts->pending->g.wide);
+        free(ts->pending);
+        ts->pending = NULL;
+    }
+}
+
+void ts_set_deferred(Timestamp *ts, int enabled) {
+    if (!enabled) {
+        ts_settle(ts);
+        free_pending(ts);
+        return;
+    }
+    if (ts->pending || !ts->ops->gather) {
+        return;
+    }
+    
+    struct TsPending *p = calloc(1, sizeof(struct TsPending) + 2 * (size_t)ts->n * sizeof(int));
+    if (!p) {
+        fprintf(stderr, "OOM\n");
+        exit(1);
+    }
+    p->g.acc = p->slots;
+    p->g.touched = p->slots + ts->n;
+    p->g.self = ts->pid;
+    ts->pending = p;
+}
+
+int ts_deferred(const Timestamp *ts) {
+    return ts->pending != NULL;
+}
+
+// Queues a receive event, or returns 0 if the message has to be merged in order. The own
+// entry goes through max-then-add steps, so after all events it is
+// max(v[pid], m_i[pid] - t_i over the messages) + ticks, t_i being the ticks before m_i.
+static int defer_receive(Timestamp *ts, const void *other_data, size_t other_size) {
+    struct TsPending *p = ts->pending;
+    p->g.self_max = 0;
+    if (!ts->ops->gather(ts, other_data, other_size, &p->g)) {
+        return 0;
+    }
+    
+    if (p->g.self_max - p->ticks > p->own) {
+        p->own = p->g.self_max - p->ticks;
+    }
+    p->ticks++;
+    return 1;
+}
+
+void ts_settle(Timestamp *ts) {
+    struct TsPending *p = ts->pending;
+    if (!p || p->ticks == 0) {
+        return;
+    }
+    
+    // The own entry goes in like any other, so the type folds in one pass
+    ClockGather *g = &p->g;
+    if (p->own > 0) {
+        g->acc[g->self] = p->own;
+        g->touched[g->count++] = g->self;
+    }
+    ts->ops->fold(ts, g, p->ticks);
+    
+    if (g->dense) {
+        memset(g->acc, 0, (size_t)ts->n * sizeof(int));
+    } else {
+        for (int i = 0; i < g->count; i++) g->acc[g->touched[i]] = 0;
+    }
+    if (g->wide) {
+        memset(g->wide, 0, (size_t)ts->n * sizeof(uint64_t));
+    }
+    g->count = 0;
+    g->dense = 0;
+    p->ticks = 0;
+    p->own = 0;
+}
+
+// Readers take const clocks; settling changes how the events are stored, not the value
+static void settle_for_read(const Timestamp *ts) {
+    if (ts->pending) {
+        ts_settle((Timestamp*)ts);
+    }
+}
+
 /* ---------- Main Timestamp Interface Implementation ---------- */
 
 Timestamp ts_create(int n, int pid, ClockType type) {
-    return get_ops(type)->create(n, pid, type);
+    const TimestampOps *ops = bind_ops(type, n);
+    Timestamp ts = ops->create(n, pid, type);
+    ts.wire = WIRE_RAW;
+    ts.ops = ops;
+    ts.pending = NULL;
+    return ts;
 }
 
 void ts_destroy(Timestamp *ts) {
-    get_ops(ts->type)->destroy(ts);
+    free_pending(ts);
+    ts->ops->destroy(ts);
 }
 
 void ts_increment(Timestamp *ts) {
-    get_ops(ts->type)->increment(ts);
+    if (ts->pending) {
+        ts->pending->ticks++;
+        return;
+    }
+    ts->ops->increment(ts);
+}
+
+static void merge_raw(Timestamp *dst, const void *other_data, size_t other_size, int tick) {
+    const TimestampOps *ops = dst->ops;
+    if (dst->pending) {
+        if (tick && defer_receive(dst, other_data, other_size)) {
+            return;
+        }
+        ts_settle(dst);
+    }
+    
+    if (!tick) {
+        ops->merge(dst, other_data, other_size);
+    } else if (ops->merge_and_tick) {
+        ops->merge_and_tick(dst, other_data, other_size);
+    } else {
+        ops->merge(dst, other_data, other_size);
+        ops->increment(dst);
+    }
+}
+
+static void merge_wire(Timestamp *dst, const void *other_data, size_t other_size, int tick) {
+    if (dst->wire == WIRE_COMPACT) {
+        void *raw;
+        size_t raw_size;
+        if (!wire_decode_compact(dst->type, dst->n, other_data, other_size, &raw, &raw_size)) {
+            fprintf(stderr, "Malformed compact timestamp frame\n");
+            return;
+        }
+        merge_raw(dst, raw, raw_size, tick);
+        free(raw);
+        return;
+    }
+    merge_raw(dst, other_data, other_size, tick);
 }
 
 void ts_merge(Timestamp *dst, const void *other_data, size_t other_size) {
-    get_ops(dst->type)->merge(dst, other_data, other_size);
+    merge_wire(dst, other_data, other_size, 0);
+}
+
+void ts_merge_and_tick(Timestamp *dst, const void *other_data, size_t other_size) {
+    merge_wire(dst, other_data, other_size, 1);
+}
+
+/* ---------- Digest Compare ---------- */
+
+static int g_digest_compare = 1;
+
+void ts_set_digest_compare(int enabled) {
+    g_digest_compare = enabled != 0;
+}
+
+int ts_digest_compare(void) {
+    return g_digest_compare;
+}
+
+// Order of two clocks from their digests alone; 0 if the counters have to be scanned.
+// A dominated clock has the smaller sum, so equal sums leave only EQUAL or CONCURRENT,
+// and the smaller sum with the larger maximum dominates nothing either.
+static int digest_order(const ClockDigest *a, const ClockDigest *b, TSOrder *order) {
+    if (a->sum == b->sum) {
+        *order = a->hash == b->hash && a->max == b->max ? TS_EQUAL : TS_CONCURRENT;
+        return 1;
+    }
+    if (a->sum < b->sum ? a->max > b->max : b->max > a->max) {
+        *order = TS_CONCURRENT;
+        return 1;
+    }
+    return 0;
 }
 
 TSOrder ts_compare(const Timestamp *a, const Timestamp *b) {
@@ -59,16 +282,21 @@ TSOrder ts_compare(const Timestamp *a, const Timestamp *b) {
         fprintf(stderr, "Cannot compare different clock types!\n");
         exit(1);
     }
-    return get_ops(a->type)->compare(a, b);
-}
-
-size_t ts_serialize(const Timestamp *ts, void *buffer, size_t bufsize) {
-    return get_ops(ts->type)->serialize(ts, buffer, bufsize);
+    
+    settle_for_read(a);
+    settle_for_read(b);
+    TSOrder order;
+    if (g_digest_compare && a->digest.valid && b->digest.valid && a->n == b->n &&
+        digest_order(&a->digest, &b->digest, &order)) {
+        return order;
+    }
+    return a->ops->compare(a, b);
 }
 
-size_t ts_serialize_for_dest(const Timestamp *ts, int dest, void *buffer, size_t bufsize) {
-    TimestampOps *ops = get_ops(ts->type);
-    if (ops->serialize_for_dest) {
+// Raw serialization; dest < 0 selects the plain (destination-independent) form
+static size_t serialize_raw(const Timestamp *ts, int dest, void *buffer, size_t bufsize) {
+    const TimestampOps *ops = ts->ops;
+    if (dest >= 0 && ops->serialize_for_dest) {
         return ops->serialize_for_dest(ts, dest, buffer, bufsize);
     } else {
         // Fallback to regular serialize for clock types that don't support destination-aware serialization
@@ -76,14 +304,141 @@ size_t ts_serialize_for_dest(const Timestamp *ts, int dest, void *buffer, size_t
     }
 }
 
+static size_t serialize_wire(const Timestamp *ts, int dest, void *buffer, size_t bufsize) {
+    settle_for_read(ts);
+    if (ts->wire != WIRE_COMPACT) {
+        return serialize_raw(ts, dest, buffer, bufsize);
+    }
+    
+    // Answer size queries with a bound: serializing for real would consume LS/tau state
+    size_t raw_size = serialize_raw(ts, dest, NULL, 0);
+    size_t bound = wire_compact_bound(raw_size);
+    if (bufsize < bound) {
+        return bound;
+    }
+    
+    void *raw = malloc(raw_size ? raw_size : 1);
+    serialize_raw(ts, dest, raw, raw_size);
+    size_t used = wire_encode_compact(ts->type, ts->n, raw, raw_size, buffer, bufsize);
+    free(raw);
+    return used;
+}
+
+size_t ts_serialize(const Timestamp *ts, void *buffer, size_t bufsize) {
+    return serialize_wire(ts, -1, buffer, bufsize);
+}
+
+size_t ts_serialize_for_dest(const Timestamp *ts, int dest, void *buffer, size_t bufsize) {
+    return serialize_wire(ts, dest, buffer, bufsize);
+}
+
 void ts_deserialize(Timestamp *ts, const void *buffer, size_t size) {
-    get_ops(ts->type)->deserialize(ts, buffer, size);
+    ts_settle(ts);
+    if (ts->wire == WIRE_COMPACT) {
+        void *raw;
+        size_t raw_size;
+        if (!wire_decode_compact(ts->type, ts->n, buffer, size, &raw, &raw_size)) {
+            fprintf(stderr, "Malformed compact timestamp frame\n");
+            return;
+        }
+        ts->ops->deserialize(ts, raw, raw_size);
+        free(raw);
+        return;
+    }
+    ts->ops->deserialize(ts, buffer, size);
 }
 
 void ts_to_string(const Timestamp *ts, char *buf, size_t bufsize) {
-    get_ops(ts->type)->to_string(ts, buf, bufsize);
+    settle_for_read(ts);
+    ts->ops->to_string(ts, buf, bufsize);
 }
 
 Timestamp ts_clone(const Timestamp *ts) {
-    return get_ops(ts->type)->clone(ts);
+    settle_for_read(ts);
+    Timestamp out = ts->ops->clone(ts);
+    out.wire = ts->wire;
+    out.ops = ts->ops;
+    out.pending = NULL;
+    return out;
+}
+
+void ts_to_vector(const Timestamp *ts, int *out) {
+    const TimestampOps *ops = ts->ops;
+    if (!ops->to_vector) {
+        fprintf(stderr, "%s clocks cannot be expanded to a vector\n", clock_type_names[ts->type]);
+        exit(1);
+    }
+    settle_for_read(ts);
+    ops->to_vector(ts, out);
+}
+
+int ts_min_known(const Timestamp *ts, int k) {
+    const TimestampOps *ops = ts->ops;
+    if (!ops->min_known) {
+        fprintf(stderr, "%s clocks do not track what other processes know\n", clock_type_names[ts->type]);
+        exit(1);
+    }
+    settle_for_read(ts);
+    return ops->min_known(ts, k);
+}
+
+uint64_t ts_hash(const Timestamp *ts) {
+    settle_for_read(ts);
+    if (ts->digest.valid) {
+        return ts->digest.hash;
+    }
+    
+    // The digest hash of the dense vector, computed on the spot
+    const TimestampOps *ops = ts->ops;
+    if (ops->to_vector) {
+        int *v = malloc(ts->n * sizeof(int));
+        ClockDigest digest;
+        ops->to_vector(ts, v);
+        clock_digest_of_vector(&digest, v, ts->n);
+        free(v);
+        return digest.hash;
+    }
+    
+    // No fixed process set: FNV-1a over the raw serialization
+    size_t size = ops->serialize(ts, NULL, 0);
+    unsigned char *raw = malloc(size ? size : 1);
+    ops->serialize(ts, raw, size);
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ raw[i]) * 0x100000001B3ULL;
+    }
+    free(raw);
+    return hash;
+}
+
+/* ---------- Arena Allocation ---------- */
+
+Timestamp ts_create_in(ClockArena *arena, int n, int pid, ClockType type) {
+    const TimestampOps *ops = bind_ops(type, n);
+    Timestamp ts = ops->create_in ? ops->create_in(arena, n, pid, type) : ops->create(n, pid, type);
+    ts.wire = WIRE_RAW;
+    ts.ops = ops;
+    ts.pending = NULL;
+    return ts;
+}
+
+Timestamp ts_clone_in(ClockArena *arena, const Timestamp *ts) {
+    const TimestampOps *ops = ts->ops;
+    settle_for_read(ts);
+    Timestamp out = ops->clone_in ? ops->clone_in(arena, ts) : ops->clone(ts);
+    out.wire = ts->wire;
+    out.ops = ops;
+    out.pending = NULL;
+    return out;
+}
+
+/* ---------- Wire Format ---------- */
+
+void ts_set_wire_format(Timestamp *ts, WireFormat format) {
+    ts->wire = format;
+}
+
+size_t ts_raw_size(const Timestamp *ts, int dest) {
+    settle_for_read(ts);
+    return serialize_raw(ts, dest, NULL, 0);
 }
\ No newline at end of file
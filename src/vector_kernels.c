@@ -0,0 +1,338 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "vector_kernels.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define VK_HAVE_X86 1
+#include <immintrin.h>
+#else
+#define VK_HAVE_X86 0
+#endif
+
+// Number of elements scanned between early-exit checks in the compare kernels
+#define VK_COMPARE_BLOCK 64
+
+/* ---------- Shared Helpers ---------- */
+
+static TSOrder order_from_flags(int a_gt, int b_gt) {
+    if (!a_gt && !b_gt) return TS_EQUAL;
+    if (!a_gt) return TS_BEFORE;
+    if (!b_gt) return TS_AFTER;
+    return TS_CONCURRENT;
+}
+
+/* ---------- Scalar Kernels ---------- */
+
+static void merge_max_scalar(int *dst, const int *src, int n) {
+    for (int i = 0; i < n; i++) {
+        if (src[i] > dst[i]) {
+            dst[i] = src[i];
+        }
+    }
+}
+
+static void scalar_flags(const int *a, const int *b, int lo, int hi, int *a_gt, int *b_gt) {
+    // Local accumulators keep the loop branch-free so the compiler can vectorize it
+    int gt = 0, lt = 0;
+    for (int i = lo; i < hi; i++) {
+        if (a[i] > b[i]) gt = 1;
+        if (b[i] > a[i]) lt = 1;
+    }
+    *a_gt |= gt;
+    *b_gt |= lt;
+}
+
+static TSOrder compare_scalar(const int *a, const int *b, int n) {
+    int a_gt = 0, b_gt = 0;
+    for (int lo = 0; lo < n; lo += VK_COMPARE_BLOCK) {
+        int hi = lo + VK_COMPARE_BLOCK < n ? lo + VK_COMPARE_BLOCK : n;
+        scalar_flags(a, b, lo, hi, &a_gt, &b_gt);
+        if (a_gt && b_gt) return TS_CONCURRENT;
+    }
+    return order_from_flags(a_gt, b_gt);
+}
+
+static void accumulate_column_scalar(const int *col, int q, int rows, int *q_gt, int *col_gt) {
+    for (int r = 0; r < rows; r++) {
+        q_gt[r] |= -(q > col[r]);
+        col_gt[r] |= -(col[r] > q);
+    }
+}
+
+#if VK_HAVE_X86
+
+/* ---------- SSE4.1 Kernels ---------- */
+
+__attribute__((target("sse4.1")))
+static void merge_max_sse41(int *dst, const int *src, int n) {
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i d = _mm_loadu_si128((const __m128i*)(dst + i));
+        __m128i s = _mm_loadu_si128((const __m128i*)(src + i));
+        _mm_storeu_si128((__m128i*)(dst + i), _mm_max_epi32(d, s));
+    }
+    merge_max_scalar(dst + i, src + i, n - i);
+}
+
+__attribute__((target("sse4.1")))
+static TSOrder compare_sse41(const int *a, const int *b, int n) {
+    int a_gt = 0, b_gt = 0;
+    int i = 0;
+    while (i + 4 <= n) {
+        __m128i gt = _mm_setzero_si128();
+        __m128i lt = _mm_setzero_si128();
+        int end = i + VK_COMPARE_BLOCK < n ? i + VK_COMPARE_BLOCK : n;
+        for (; i + 4 <= end; i += 4) {
+            __m128i va = _mm_loadu_si128((const __m128i*)(a + i));
+            __m128i vb = _mm_loadu_si128((const __m128i*)(b + i));
+            gt = _mm_or_si128(gt, _mm_cmpgt_epi32(va, vb));
+            lt = _mm_or_si128(lt, _mm_cmpgt_epi32(vb, va));
+        }
+        a_gt |= !_mm_testz_si128(gt, gt);
+        b_gt |= !_mm_testz_si128(lt, lt);
+        if (a_gt && b_gt) return TS_CONCURRENT;
+    }
+    scalar_flags(a, b, i, n, &a_gt, &b_gt);
+    return order_from_flags(a_gt, b_gt);
+}
+
+__attribute__((target("sse4.1")))
+static void accumulate_column_sse41(const int *col, int q, int rows, int *q_gt, int *col_gt) {
+    __m128i vq = _mm_set1_epi32(q);
+    int r = 0;
+    for (; r + 4 <= rows; r += 4) {
+        __m128i vc = _mm_loadu_si128((const __m128i*)(col + r));
+        __m128i fq = _mm_loadu_si128((const __m128i*)(q_gt + r));
+        __m128i fc = _mm_loadu_si128((const __m128i*)(col_gt + r));
+        _mm_storeu_si128((__m128i*)(q_gt + r), _mm_or_si128(fq, _mm_cmpgt_epi32(vq, vc)));
+        _mm_storeu_si128((__m128i*)(col_gt + r), _mm_or_si128(fc, _mm_cmpgt_epi32(vc, vq)));
+    }
+    accumulate_column_scalar(col + r, q, rows - r, q_gt + r, col_gt + r);
+}
+
+/* ---------- AVX2 Kernels ---------- */
+
+__attribute__((target("avx2")))
+static void merge_max_avx2(int *dst, const int *src, int n) {
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i d = _mm256_loadu_si256((const __m256i*)(dst + i));
+        __m256i s = _mm256_loadu_si256((const __m256i*)(src + i));
+        _mm256_storeu_si256((__m256i*)(dst + i), _mm256_max_epi32(d, s));
+    }
+    merge_max_scalar(dst + i, src + i, n - i);
+}
+
+__attribute__((target("avx2")))
+static TSOrder compare_avx2(const int *a, const int *b, int n) {
+    int a_gt = 0, b_gt = 0;
+    int i = 0;
+    while (i + 8 <= n) {
+        __m256i gt = _mm256_setzero_si256();
+        __m256i lt = _mm256_setzero_si256();
+        int end = i + VK_COMPARE_BLOCK < n ? i + VK_COMPARE_BLOCK : n;
+        for (; i + 8 <= end; i += 8) {
+            __m256i va = _mm256_loadu_si256((const __m256i*)(a + i));
+            __m256i vb = _mm256_loadu_si256((const __m256i*)(b + i));
+            gt = _mm256_or_si256(gt, _mm256_cmpgt_epi32(va, vb));
+            lt = _mm256_or_si256(lt, _mm256_cmpgt_epi32(vb, va));
+        }
+        a_gt |= !_mm256_testz_si256(gt, gt);
+        b_gt |= !_mm256_testz_si256(lt, lt);
+        if (a_gt && b_gt) return TS_CONCURRENT;
+    }
+    scalar_flags(a, b, i, n, &a_gt, &b_gt);
+    return order_from_flags(a_gt, b_gt);
+}
+
+__attribute__((target("avx2")))
+static void accumulate_column_avx2(const int *col, int q, int rows, int *q_gt, int *col_gt) {
+    __m256i vq = _mm256_set1_epi32(q);
+    int r = 0;
+    for (; r + 8 <= rows; r += 8) {
+        __m256i vc = _mm256_loadu_si256((const __m256i*)(col + r));
+        __m256i fq = _mm256_loadu_si256((const __m256i*)(q_gt + r));
+        __m256i fc = _mm256_loadu_si256((const __m256i*)(col_gt + r));
+        _mm256_storeu_si256((__m256i*)(q_gt + r), _mm256_or_si256(fq, _mm256_cmpgt_epi32(vq, vc)));
+        _mm256_storeu_si256((__m256i*)(col_gt + r), _mm256_or_si256(fc, _mm256_cmpgt_epi32(vc, vq)));
+    }
+    accumulate_column_scalar(col + r, q, rows - r, q_gt + r, col_gt + r);
+}
+
+/* ---------- AVX-512 Kernels ---------- */
+
+__attribute__((target("avx512f")))
+static void merge_max_avx512(int *dst, const int *src, int n) {
+    int i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512i d = _mm512_loadu_si512((const void*)(dst + i));
+        __m512i s = _mm512_loadu_si512((const void*)(src + i));
+        _mm512_storeu_si512((void*)(dst + i), _mm512_max_epi32(d, s));
+    }
+    if (i < n) {
+        // Masked tail avoids a scalar loop of up to 15 elements
+        __mmask16 m = (__mmask16)((1u << (n - i)) - 1);
+        __m512i d = _mm512_maskz_loadu_epi32(m, dst + i);
+        __m512i s = _mm512_maskz_loadu_epi32(m, src + i);
+        _mm512_mask_storeu_epi32(dst + i, m, _mm512_max_epi32(d, s));
+    }
+}
+
+__attribute__((target("avx512f")))
+static TSOrder compare_avx512(const int *a, const int *b, int n) {
+    int a_gt = 0, b_gt = 0;
+    int i = 0;
+    while (i + 16 <= n) {
+        __mmask16 gt = 0, lt = 0;
+        int end = i + VK_COMPARE_BLOCK < n ? i + VK_COMPARE_BLOCK : n;
+        for (; i + 16 <= end; i += 16) {
+            __m512i va = _mm512_loadu_si512((const void*)(a + i));
+            __m512i vb = _mm512_loadu_si512((const void*)(b + i));
+            gt |= _mm512_cmpgt_epi32_mask(va, vb);
+            lt |= _mm512_cmpgt_epi32_mask(vb, va);
+        }
+        a_gt |= gt != 0;
+        b_gt |= lt != 0;
+        if (a_gt && b_gt) return TS_CONCURRENT;
+    }
+    if (i < n) {
+        __mmask16 m = (__mmask16)((1u << (n - i)) - 1);
+        __m512i va = _mm512_maskz_loadu_epi32(m, a + i);
+        __m512i vb = _mm512_maskz_loadu_epi32(m, b + i);
+        a_gt |= _mm512_mask_cmpgt_epi32_mask(m, va, vb) != 0;
+        b_gt |= _mm512_mask_cmpgt_epi32_mask(m, vb, va) != 0;
+    }
+    return order_from_flags(a_gt, b_gt);
+}
+
+__attribute__((target("avx512f")))
+static void accumulate_column_avx512(const int *col, int q, int rows, int *q_gt, int *col_gt) {
+    __m512i vq = _mm512_set1_epi32(q);
+    __m512i ones = _mm512_set1_epi32(-1);
+    int r = 0;
+    for (; r + 16 <= rows; r += 16) {
+        __m512i vc = _mm512_loadu_si512((const void*)(col + r));
+        __m512i fq = _mm512_loadu_si512((const void*)(q_gt + r));
+        __m512i fc = _mm512_loadu_si512((const void*)(col_gt + r));
+        fq = _mm512_mask_mov_epi32(fq, _mm512_cmpgt_epi32_mask(vq, vc), ones);
+        fc = _mm512_mask_mov_epi32(fc, _mm512_cmpgt_epi32_mask(vc, vq), ones);
+        _mm512_storeu_si512((void*)(q_gt + r), fq);
+        _mm512_storeu_si512((void*)(col_gt + r), fc);
+    }
+    accumulate_column_scalar(col + r, q, rows - r, q_gt + r, col_gt + r);
+}
+
+#endif // VK_HAVE_X86
+
+/* ---------- Runtime Dispatch ---------- */
+
+typedef struct {
+    void (*merge_max)(int *dst, const int *src, int n);
+    TSOrder (*compare)(const int *a, const int *b, int n);
+    void (*accumulate_column)(const int *col, int q, int rows, int *q_gt, int *col_gt);
+} VkKernels;
+
+static const VkKernels VK_TABLE[VK_ISA_COUNT] = {
+    { merge_max_scalar, compare_scalar, accumulate_column_scalar },
+#if VK_HAVE_X86
+    { merge_max_sse41, compare_sse41, accumulate_column_sse41 },
+    { merge_max_avx2, compare_avx2, accumulate_column_avx2 },
+    { merge_max_avx512, compare_avx512, accumulate_column_avx512 },
+#else
+    { merge_max_scalar, compare_scalar, accumulate_column_scalar },
+    { merge_max_scalar, compare_scalar, accumulate_column_scalar },
+    { merge_max_scalar, compare_scalar, accumulate_column_scalar },
+#endif
+};
+
+static const char* VK_ISA_NAMES[VK_ISA_COUNT] = {
+    "scalar", "sse4.1", "avx2", "avx512f"
+};
+
+static VkIsa vk_isa = VK_ISA_SCALAR;
+static const VkKernels *vk_active = &VK_TABLE[VK_ISA_SCALAR];
+
+int vk_isa_supported(VkIsa isa) {
+    switch (isa) {
+        case VK_ISA_SCALAR: return 1;
+#if VK_HAVE_X86
+        case VK_ISA_SSE41: return __builtin_cpu_supports("sse4.1");
+        case VK_ISA_AVX2: return __builtin_cpu_supports("avx2");
+        case VK_ISA_AVX512: return __builtin_cpu_supports("avx512f");
+#endif
+        default: return 0;
+    }
+}
+
+int vk_force_isa(VkIsa isa) {
+    if ((int)isa < 0 || (int)isa >= VK_ISA_COUNT || !vk_isa_supported(isa)) {
+        return 0;
+    }
+    vk_isa = isa;
+    vk_active = &VK_TABLE[isa];
+    return 1;
+}
+
+VkIsa vk_active_isa(void) {
+    return vk_isa;
+}
+
+const char* vk_isa_name(VkIsa isa) {
+    return ((int)isa >= 0 && (int)isa < VK_ISA_COUNT) ? VK_ISA_NAMES[isa] : "unknown";
+}
+
+// Pick the widest supported kernel before any thread can touch a clock
+__attribute__((constructor))
+static void vk_select_isa(void) {
+#if VK_HAVE_X86
+    __builtin_cpu_init();
+#endif
+    for (int isa = VK_ISA_COUNT - 1; isa > VK_ISA_SCALAR; isa--) {
+        if (vk_force_isa((VkIsa)isa)) return;
+    }
+    vk_force_isa(VK_ISA_SCALAR);
+}
+
+/* ---------- Public Kernels ---------- */
+
+void vk_merge_max(int *dst, const int *src, int n) {
+    vk_active->merge_max(dst, src, n);
+}
+
+TSOrder vk_compare(const int *a, const int *b, int n) {
+    return vk_active->compare(a, b, n);
+}
+
+void vk_accumulate_column(const int *col, int q, int rows, int *q_gt, int *col_gt) {
+    vk_active->accumulate_column(col, q, rows, q_gt, col_gt);
+}
+
+/* ---------- Fixed-n Kernels ---------- */
+
+// Exactly N ints: with the trip count known the compiler unrolls or vectorizes the loops
+// for the baseline ISA. Past VK_FIXED_INLINE_MAX ints the dispatched AVX2/AVX-512 kernels
+// are faster, so larger N goes to them, still with n a constant.
+#define VK_FIXED_INLINE_MAX 16
+
+#define DEFINE_VK_FIXED_N(N)                                                   \
+    void vk_merge_max_##N(int *dst, const int *src) {                          \
+        if (N > VK_FIXED_INLINE_MAX) {                                         \
+            vk_active->merge_max(dst, src, N);                                 \
+            return;                                                            \
+        }                                                                      \
+        for (int i = 0; i < N; i++) {                                          \
+            dst[i] = src[i] > dst[i] ? src[i] : dst[i];                        \
+        }                                                                      \
+    }                                                                          \
+    TSOrder vk_compare_##N(const int *a, const int *b) {                       \
+        if (N > VK_FIXED_INLINE_MAX) {                                         \
+            return vk_active->compare(a, b, N);                                \
+        }                                                                      \
+        int gt = 0, lt = 0;                                                    \
+        for (int i = 0; i < N; i++) {                                          \
+            gt |= a[i] > b[i];                                                 \
+            lt |= b[i] > a[i];                                                 \
+        }                                                                      \
+        return order_from_flags(gt, lt);                                       \
+    }
+FOR_EACH_FIXED_N(DEFINE_VK_FIXED_N)
@@ -0,0 +1,436 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "wire_codec.h"
+#include "compressed_clock.h"
+#include "encoded_clock.h"
+
+/* ---------- Varint Primitives ---------- */
+
+size_t wire_put_uvarint(uint8_t *out, uint64_t value) {
+    size_t i = 0;
+    while (value >= 0x80) {
+        out[i++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    out[i++] = (uint8_t)value;
+    return i;
+}
+
+size_t wire_get_uvarint(const uint8_t *in, size_t avail, uint64_t *value) {
+    uint64_t result = 0;
+    for (size_t i = 0; i < avail && i < WIRE_MAX_VARINT; i++) {
+        result |= (uint64_t)(in[i] & 0x7F) << (7 * i);
+        if (!(in[i] & 0x80)) {
+            *value = result;
+            return i + 1;
+        }
+    }
+    return 0;
+}
+
+size_t wire_uvarint_size(uint64_t value) {
+    size_t size = 1;
+    while (value >= 0x80) {
+        value >>= 7;
+        size++;
+    }
+    return size;
+}
+
+/* ---------- Raw Layouts ---------- */
+
+// How each clock type lays out its raw (4-byte int) serialization
+typedef enum {
+    RAW_DENSE,          // int[n]
+    RAW_DENSE64,        // uint64_t[n], standard vectors with a counter past INT32_MAX
+    RAW_PAIRS,          // (pid, counter) int pairs, SparseEntry-compatible
+    RAW_TAGGED_DELTA,   // CompressedClock delta message (pairs, bitmap or runs)
+    RAW_SCALAR,         // one unsigned long long
+    RAW_OPAQUE          // no entry structure known to the codec
+} RawLayout;
+
+static RawLayout raw_layout(ClockType type, int n, const void *raw, size_t raw_size) {
+    size_t dense_size = (size_t)n * sizeof(int);
+    switch (type) {
+        case CLOCK_STANDARD:
+            if (n > 0 && raw_size == (size_t)n * sizeof(uint64_t)) return RAW_DENSE64;
+            return raw_size == dense_size ? RAW_DENSE : RAW_OPAQUE;
+        case CLOCK_SPARSE:
+            return RAW_PAIRS;
+        case CLOCK_DIFFERENTIAL:
+            // Pair lists are always shorter than n ints (differential_serialize_for_dest)
+            return raw_size == dense_size ? RAW_DENSE : RAW_PAIRS;
+        case CLOCK_ENCODED:
+            if (raw_size == sizeof(unsigned long long)) return RAW_SCALAR;
+            // Multi-limb products have no per-process entries to pack
+            if (raw_size >= sizeof(uint32_t) &&
+                (*(const uint32_t*)raw & ~ENCODED_LIMB_MASK) == ENCODED_BIG_TAG) return RAW_OPAQUE;
+            return raw_size == dense_size ? RAW_DENSE : RAW_OPAQUE;
+        case CLOCK_COMPRESSED:
+            if (raw_size == dense_size) return RAW_DENSE;
+            // Value-delta frames are already byte-packed and only the receiver can decode them
+            return compressed_is_value_delta(raw, raw_size) ? RAW_OPAQUE : RAW_TAGGED_DELTA;
+        case CLOCK_ITC:
+            return RAW_OPAQUE;  // already bit-packed trees
+        case CLOCK_HLC:
+            return raw_size == sizeof(unsigned long long) ? RAW_SCALAR : RAW_OPAQUE;
+        case CLOCK_PLAUSIBLE:
+            return RAW_OPAQUE;  // R folded counters, not an n-entry vector
+        case CLOCK_BLOOM:
+            return RAW_OPAQUE;  // m filter cells, not an n-entry vector
+        case CLOCK_MATRIX:
+            return RAW_OPAQUE;  // tagged rows of (column, value) pairs
+        case CLOCK_LAMPORT:
+            return raw_size == sizeof(unsigned long long) ? RAW_SCALAR : RAW_OPAQUE;
+        default:
+            return RAW_OPAQUE;
+    }
+}
+
+/* ---------- Encoding ---------- */
+
+static uint8_t frame_header(WireKind kind, ClockType type) {
+    return (uint8_t)((WIRE_COMPACT_VERSION << 6) | (kind << 4) | (type & 0x0F));
+}
+
+size_t wire_compact_bound(size_t raw_size) {
+    // The encoder never emits more than the opaque framing: header + length + raw bytes
+    return 1 + WIRE_MAX_VARINT + raw_size;
+}
+
+// Entry i of a counter array: ints, or uint64_t when wide (dense input only)
+static int64_t counter_at(const void *values, int wide, int i) {
+    return wide ? (int64_t)((const uint64_t*)values)[i] : ((const int*)values)[i];
+}
+
+static size_t dense_size(const void *v, int wide, int count) {
+    size_t size = wire_uvarint_size(count);
+    for (int i = 0; i < count; i++) {
+        size += wire_uvarint_size(wire_zigzag_encode(counter_at(v, wide, i)));
+    }
+    return size;
+}
+
+// Pair list sizes; pids must be strictly increasing. Returns 0 if they are not.
+// A stride of 2 walks interleaved (pid, counter) ints, 1 walks separate pid/value
+// arrays, and dense input uses stride 0.
+static size_t pairs_size(const int *pids, const void *values, int wide, int count, int stride,
+                         int skip_zero, WirePairsLayout layout) {
+    size_t size = 0;
+    int prev = -1, emitted = 0;
+    for (int i = 0; i < count; i++) {
+        int pid = stride ? pids[i * stride] : i;
+        int64_t value = counter_at(values, wide, stride ? i * stride : i);
+        if (skip_zero && value == 0) continue;
+        if (pid <= prev) return 0;
+        size += wire_uvarint_size(pid - prev - 1) + wire_uvarint_size(wire_zigzag_encode(value));
+        prev = pid;
+        emitted++;
+    }
+    return size + wire_uvarint_size(((uint64_t)emitted << 1) | layout);
+}
+
+static size_t emit_dense(uint8_t *out, const void *v, int wide, int count) {
+    size_t used = wire_put_uvarint(out, count);
+    for (int i = 0; i < count; i++) {
+        used += wire_put_uvarint(out + used, wire_zigzag_encode(counter_at(v, wide, i)));
+    }
+    return used;
+}
+
+static size_t emit_pairs(uint8_t *out, const int *pids, const void *values, int wide, int count, int stride,
+                         int skip_zero, WirePairsLayout layout) {
+    int emitted = 0;
+    for (int i = 0; i < count; i++) {
+        int64_t value = counter_at(values, wide, stride ? i * stride : i);
+        if (!(skip_zero && value == 0)) emitted++;
+    }
+
+    size_t used = wire_put_uvarint(out, ((uint64_t)emitted << 1) | layout);
+    int prev = -1;
+    for (int i = 0; i < count; i++) {
+        int pid = stride ? pids[i * stride] : i;
+        int64_t value = counter_at(values, wide, stride ? i * stride : i);
+        if (skip_zero && value == 0) continue;
+        used += wire_put_uvarint(out + used, pid - prev - 1);
+        used += wire_put_uvarint(out + used, wire_zigzag_encode(value));
+        prev = pid;
+    }
+    return used;
+}
+
+size_t wire_encode_compact(ClockType type, int n, const void *raw, size_t raw_size,
+                           void *buffer, size_t bufsize) {
+    uint8_t *out = (uint8_t*)buffer;
+    const int *ints = (const int*)raw;
+    RawLayout layout = raw_layout(type, n, raw, raw_size);
+    WireKind kind = WIRE_KIND_OPAQUE;
+    size_t payload = 0;
+    int count = 0;
+    const int *pids = NULL;
+    const void *values = ints;
+    int wide = 0;
+    int stride = 0;
+    int skip_zero = 0;
+    WirePairsLayout pairs_layout = WIRE_PAIRS_OF_MESSAGE;
+    int *decoded = NULL;
+
+    switch (layout) {
+        case RAW_DENSE64:
+            wide = 1;
+            // fall through
+        case RAW_DENSE: {
+            // Dense vectors go out as whichever of dense or nonzero pairs is smaller
+            size_t as_dense = dense_size(values, wide, n);
+            size_t as_pairs = pairs_size(NULL, values, wide, n, 0, 1, WIRE_PAIRS_OF_VECTOR);
+            count = n;
+            if (as_pairs < as_dense) {
+                kind = WIRE_KIND_PAIRS;
+                payload = as_pairs;
+                skip_zero = 1;
+                pairs_layout = WIRE_PAIRS_OF_VECTOR;
+            } else {
+                kind = WIRE_KIND_DENSE;
+                payload = as_dense;
+            }
+            break;
+        }
+        case RAW_PAIRS:
+            count = raw_size / (2 * sizeof(int));
+            pids = ints;
+            values = ints + 1;
+            stride = 2;
+            payload = pairs_size(pids, values, 0, count, stride, 0, pairs_layout);
+            if (payload) kind = WIRE_KIND_PAIRS;
+            break;
+        case RAW_TAGGED_DELTA:
+            // Every tagged encoding flattens to the same sorted pair list
+            decoded = (int*)malloc(2 * (size_t)(n > 0 ? n : 1) * sizeof(int));
+            count = compressed_decode_entries(n, raw, raw_size, decoded, decoded + n);
+            if (count < 0) break;
+            pids = decoded;
+            values = decoded + n;
+            stride = 1;
+            payload = pairs_size(pids, values, 0, count, stride, 0, pairs_layout);
+            if (payload) kind = WIRE_KIND_PAIRS;
+            break;
+        case RAW_SCALAR: {
+            unsigned long long value;
+            memcpy(&value, raw, sizeof(value));
+            kind = WIRE_KIND_SCALAR;
+            payload = wire_uvarint_size(value);
+            break;
+        }
+        case RAW_OPAQUE:
+            break;
+    }
+
+    // Varints of large counters (and bitmap or runs deltas flattened to pairs) can outgrow
+    // the raw bytes; those go out opaque, which keeps every frame within wire_compact_bound
+    size_t opaque_payload = wire_uvarint_size(raw_size) + raw_size;
+    if (kind == WIRE_KIND_OPAQUE || payload > opaque_payload) {
+        kind = WIRE_KIND_OPAQUE;
+        payload = opaque_payload;
+    }
+
+    size_t required = 1 + payload;
+    if (bufsize < required) {
+        free(decoded);
+        return required;
+    }
+
+    out[0] = frame_header(kind, type);
+    switch (kind) {
+        case WIRE_KIND_DENSE:
+            emit_dense(out + 1, values, wide, count);
+            break;
+        case WIRE_KIND_PAIRS:
+            emit_pairs(out + 1, pids, values, wide, count, stride, skip_zero, pairs_layout);
+            break;
+        case WIRE_KIND_SCALAR: {
+            unsigned long long value;
+            memcpy(&value, raw, sizeof(value));
+            wire_put_uvarint(out + 1, value);
+            break;
+        }
+        case WIRE_KIND_OPAQUE: {
+            size_t used = wire_put_uvarint(out + 1, raw_size);
+            memcpy(out + 1 + used, raw, raw_size);
+            break;
+        }
+    }
+    free(decoded);
+    return required;
+}
+
+/* ---------- Decoding ---------- */
+
+// Counters are 64-bit on the wire; clock types other than standard narrow them to int
+static int read_counter(const uint8_t *in, size_t avail, size_t *pos, int64_t *value) {
+    uint64_t v;
+    size_t used = wire_get_uvarint(in + *pos, avail - *pos, &v);
+    if (!used) return 0;
+    *pos += used;
+    *value = wire_zigzag_decode(v);
+    return 1;
+}
+
+// Standard vectors rebuild the 64-bit layout only when some counter needs it
+static int needs_wide(ClockType type, const int64_t *values, int count) {
+    if (type != CLOCK_STANDARD) return 0;
+    for (int i = 0; i < count; i++) {
+        if (values[i] > INT32_MAX || values[i] < INT32_MIN) return 1;
+    }
+    return 0;
+}
+
+static int decode_pairs(int n, const uint8_t *in, size_t avail, int **pids, int64_t **values, int *count,
+                        WirePairsLayout *layout) {
+    size_t pos = 0;
+    uint64_t c;
+    size_t used = wire_get_uvarint(in, avail, &c);
+    if (!used) return 0;
+    *layout = (WirePairsLayout)(c & 1);
+    c >>= 1;
+    if (c > (uint64_t)n) return 0;
+    pos += used;
+
+    *count = (int)c;
+    *pids = (int*)malloc((c ? c : 1) * sizeof(int));
+    *values = (int64_t*)malloc((c ? c : 1) * sizeof(int64_t));
+    long long prev = -1;
+    for (int i = 0; i < *count; i++) {
+        uint64_t gap;
+        used = wire_get_uvarint(in + pos, avail - pos, &gap);
+        if (!used || gap >= (uint64_t)n) goto malformed;
+        pos += used;
+        prev += (long long)gap + 1;
+        if (prev >= n) goto malformed;
+        (*pids)[i] = (int)prev;
+        if (!read_counter(in, avail, &pos, &(*values)[i])) goto malformed;
+    }
+    return 1;
+
+malformed:
+    free(*pids);
+    free(*values);
+    return 0;
+}
+
+int wire_decode_compact(ClockType type, int n, const void *frame, size_t frame_size,
+                        void **raw, size_t *raw_size) {
+    const uint8_t *in = (const uint8_t*)frame;
+    if (frame_size < 1) return 0;
+
+    int version = in[0] >> 6;
+    WireKind kind = (WireKind)((in[0] >> 4) & 0x3);
+    if (version != WIRE_COMPACT_VERSION || (ClockType)(in[0] & 0x0F) != (type & 0x0F)) {
+        return 0;
+    }
+    in++;
+    frame_size--;
+
+    switch (kind) {
+        case WIRE_KIND_DENSE: {
+            uint64_t count;
+            size_t pos = wire_get_uvarint(in, frame_size, &count);
+            if (!pos || count != (uint64_t)n) return 0;
+            int64_t *v = (int64_t*)malloc((n ? n : 1) * sizeof(int64_t));
+            for (int i = 0; i < n; i++) {
+                if (!read_counter(in, frame_size, &pos, &v[i])) {
+                    free(v);
+                    return 0;
+                }
+            }
+            if (needs_wide(type, v, n)) {
+                *raw = v;  // int64_t and uint64_t share a layout
+                *raw_size = n * sizeof(uint64_t);
+                return 1;
+            }
+            int *out = (int*)malloc((n ? n : 1) * sizeof(int));
+            for (int i = 0; i < n; i++) out[i] = (int)v[i];
+            free(v);
+            *raw = out;
+            *raw_size = n * sizeof(int);
+            return 1;
+        }
+        case WIRE_KIND_PAIRS: {
+            int *pids, count;
+            int64_t *values;
+            WirePairsLayout pairs_layout;
+            if (!decode_pairs(n, in, frame_size, &pids, &values, &count, &pairs_layout)) return 0;
+
+            // The frame says which raw layout it came from. Pair messages are rebuilt only
+            // for the types that send them. Differential senders keep pair lists shorter
+            // than n ints, so a longer one is malformed. A compressed delta flattened from a
+            // bitmap or runs can come to exactly n ints as tag-0 pairs; it goes back as the
+            // vector with its other entries zero, which every compressed decoder max-merges
+            // to the same clock.
+            RawLayout layout = RAW_OPAQUE;
+            if (pairs_layout == WIRE_PAIRS_OF_VECTOR) {
+                if (type != CLOCK_SPARSE) layout = needs_wide(type, values, count) ? RAW_DENSE64 : RAW_DENSE;
+            } else if (type == CLOCK_SPARSE) {
+                layout = RAW_PAIRS;
+            } else if (type == CLOCK_DIFFERENTIAL) {
+                if (2 * count < n) layout = RAW_PAIRS;
+            } else if (type == CLOCK_COMPRESSED) {
+                layout = 1 + 2 * count == n ? RAW_DENSE : RAW_TAGGED_DELTA;
+            }
+
+            if (layout == RAW_OPAQUE) {
+                free(pids);
+                free(values);
+                return 0;
+            }
+            if (layout == RAW_DENSE64) {
+                uint64_t *wide = (uint64_t*)calloc(n, sizeof(uint64_t));
+                for (int i = 0; i < count; i++) wide[pids[i]] = (uint64_t)values[i];
+                free(pids);
+                free(values);
+                *raw = wide;
+                *raw_size = n * sizeof(uint64_t);
+                return 1;
+            }
+
+            int *out;
+            if (layout == RAW_DENSE) {
+                out = (int*)calloc(n, sizeof(int));
+                for (int i = 0; i < count; i++) out[pids[i]] = (int)values[i];
+                *raw_size = n * sizeof(int);
+            } else {
+                int header = layout == RAW_TAGGED_DELTA ? 1 : 0;  // COMPRESSED_ENC_PAIRS header
+                out = (int*)malloc((header + 2 * count + 1) * sizeof(int));
+                if (header) out[0] = count;
+                for (int i = 0; i < count; i++) {
+                    out[header + 2 * i] = pids[i];
+                    out[header + 2 * i + 1] = (int)values[i];
+                }
+                *raw_size = (header + 2 * count) * sizeof(int);
+            }
+            free(pids);
+            free(values);
+            *raw = out;
+            return 1;
+        }
+        case WIRE_KIND_SCALAR: {
+            uint64_t value;
+            if (!wire_get_uvarint(in, frame_size, &value)) return 0;
+            unsigned long long *out = (unsigned long long*)malloc(sizeof(unsigned long long));
+            *out = value;
+            *raw = out;
+            *raw_size = sizeof(unsigned long long);
+            return 1;
+        }
+        case WIRE_KIND_OPAQUE: {
+            uint64_t length;
+            size_t pos = wire_get_uvarint(in, frame_size, &length);
+            if (!pos || length > frame_size - pos) return 0;
+            *raw = malloc(length ? length : 1);
+            memcpy(*raw, in + pos, length);
+            *raw_size = length;
+            return 1;
+        }
+    }
+    return 0;
+}
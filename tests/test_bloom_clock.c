@@ -0,0 +1,257 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "bloom_clock.h"
+#include "standard_clock.h"
+
+/* ---------- Test Framework ---------- */
+
+typedef struct {
+    int tests_run;
+    int tests_passed;
+    int tests_failed;
+    char current_test[256];
+} TestStats;
+
+static TestStats g_stats = {0};
+
+#define TEST_ASSERT(condition, message) do { \
+    if (!(condition)) { \
+        printf("FAIL: %s - %s\n", g_stats.current_test, message); \
+        g_stats.tests_failed++; \
+        return 0; \
+    } \
+} while(0)
+
+#define TEST_ASSERT_EQ(expected, actual, message) do { \
+    if ((expected) != (actual)) { \
+        printf("FAIL: %s - %s (expected: %d, actual: %d)\n", \
+               g_stats.current_test, message, (int)(expected), (int)(actual)); \
+        g_stats.tests_failed++; \
+        return 0; \
+    } \
+} while(0)
+
+#define RUN_TEST(test_func) do { \
+    snprintf(g_stats.current_test, sizeof(g_stats.current_test), #test_func); \
+    g_stats.tests_run++; \
+    if (test_func()) { \
+        printf("PASS: %s\n", #test_func); \
+        g_stats.tests_passed++; \
+    } \
+} while(0)
+
+/* ---------- Helper Functions ---------- */
+
+
+// Random events and messages driven identically over bloom and standard clocks.
+// Returns the number of concurrent pairs ordered by the bloom clocks, or -1 if a
+// causally related pair was reported wrongly.
+static int run_against_standard(int n, int cells, unsigned int seed) {
+    Timestamp bc[32], vec[32];
+    int false_orderings = 0;
+    assert(n <= 32);
+    
+    bloom_set_params(cells, 0);
+    for (int i = 0; i < n; i++) {
+        bc[i] = bloom_create(n, i, CLOCK_BLOOM);
+        vec[i] = standard_create(n, i, CLOCK_STANDARD);
+    }
+    
+    for (int op = 0; op < 8 * n; op++) {
+        int p = rand_r(&seed) % n;
+        int q = rand_r(&seed) % n;
+        bloom_increment(&bc[p]);
+        standard_increment(&vec[p]);
+        if (p != q && rand_r(&seed) % 2) {
+            int buf[256];
+            size_t size = bloom_serialize(&bc[p], buf, sizeof(buf));
+            bloom_merge(&bc[q], buf, size);
+            standard_serialize(&vec[p], buf, sizeof(buf));
+            standard_merge(&vec[q], buf, n * sizeof(int));
+            bloom_increment(&bc[q]);
+            standard_increment(&vec[q]);
+        }
+    }
+    
+    for (int i = 0; i < n && false_orderings >= 0; i++) {
+        for (int j = 0; j < n; j++) {
+            TSOrder truth = standard_compare(&vec[i], &vec[j]);
+            TSOrder bloom = bloom_compare(&bc[i], &bc[j]);
+            if (truth == TS_CONCURRENT) {
+                if (bloom != TS_CONCURRENT) false_orderings++;
+            } else if (bloom != truth) {
+                false_orderings = -1;
+                break;
+            }
+        }
+    }
+    
+    for (int i = 0; i < n; i++) {
+        bloom_destroy(&bc[i]);
+        standard_destroy(&vec[i]);
+    }
+    bloom_set_params(0, 0);
+    return false_orderings;
+}
+
+static int cell_sum(const Timestamp *ts) {
+    const BloomClockData *data = (const BloomClockData*)ts->data;
+    int sum = 0;
+    for (int i = 0; i < data->m; i++) sum += data->cells[i];
+    return sum;
+}
+
+/* ---------- Filter Tests ---------- */
+
+static int test_bloom_constant_size() {
+    Timestamp small = bloom_create(4, 1, CLOCK_BLOOM);
+    Timestamp large = bloom_create(5000, 4321, CLOCK_BLOOM);
+    
+    TEST_ASSERT_EQ(BLOOM_DEFAULT_CELLS * sizeof(int), bloom_serialize(&small, NULL, 0), "Timestamps should hold m cells");
+    TEST_ASSERT_EQ(bloom_serialize(&small, NULL, 0), bloom_serialize(&large, NULL, 0), "Size should not depend on n");
+    
+    bloom_destroy(&small);
+    bloom_destroy(&large);
+    return 1;
+}
+
+static int test_bloom_increment_hashes_k_cells() {
+    bloom_set_params(32, 4);
+    Timestamp a = bloom_create(8, 2, CLOCK_BLOOM);
+    Timestamp b = bloom_create(8, 2, CLOCK_BLOOM);
+    Timestamp c = bloom_create(8, 3, CLOCK_BLOOM);
+    Timestamp d = bloom_create(8, 4, CLOCK_BLOOM);
+    bloom_set_params(0, 0);
+    
+    bloom_increment(&a);
+    TEST_ASSERT_EQ(4, cell_sum(&a), "An event should add k to the filter");
+    bloom_increment(&a);
+    TEST_ASSERT_EQ(8, cell_sum(&a), "Each event should add k to the filter");
+    
+    // The same (pid, counter) events always land in the same cells
+    bloom_increment(&b);
+    bloom_increment(&b);
+    TEST_ASSERT_EQ(TS_EQUAL, bloom_compare(&a, &b), "Hashing should be deterministic");
+    
+    TEST_ASSERT_EQ(TS_BEFORE, bloom_compare(&c, &b), "An empty filter precedes any history");
+    TEST_ASSERT_EQ(TS_CONCURRENT, bloom_compare(&c, &d), "Empty filters of different processes are concurrent");
+    
+    bloom_destroy(&a);
+    bloom_destroy(&b);
+    bloom_destroy(&c);
+    bloom_destroy(&d);
+    return 1;
+}
+
+/* ---------- Accuracy Tests ---------- */
+
+static int test_bloom_never_misorders_causality() {
+    int narrow = 0, wide = 0;
+    for (unsigned int seed = 1; seed <= 30; seed++) {
+        int false_orderings = run_against_standard(16, 8, seed);
+        TEST_ASSERT(false_orderings >= 0, "Causally related pairs must keep their order");
+        narrow += false_orderings;
+        
+        false_orderings = run_against_standard(16, 256, seed);
+        TEST_ASSERT(false_orderings >= 0, "Causally related pairs must keep their order");
+        wide += false_orderings;
+    }
+    TEST_ASSERT(narrow > 0, "An 8-cell filter should order some concurrent pairs");
+    TEST_ASSERT(wide < narrow, "A wider filter should order fewer concurrent pairs");
+    return 1;
+}
+
+static int test_bloom_false_positive_estimate() {
+    bloom_set_params(16, 2);
+    Timestamp a = bloom_create(4, 0, CLOCK_BLOOM);
+    Timestamp b = bloom_create(4, 1, CLOCK_BLOOM);
+    bloom_set_params(0, 0);
+    
+    bloom_increment(&a);
+    bloom_increment(&b);
+    if (bloom_compare(&a, &b) == TS_CONCURRENT) {
+        TEST_ASSERT(bloom_false_positive(&a, &b) == 0.0, "Concurrent answers carry no false-positive risk");
+    }
+    
+    // b learns a and moves on: a is truly BEFORE b
+    int buf[16];
+    bloom_merge(&b, buf, bloom_serialize(&a, buf, sizeof(buf)));
+    bloom_increment(&b);
+    TEST_ASSERT_EQ(TS_BEFORE, bloom_compare(&a, &b), "Merged history should dominate");
+    double few = bloom_false_positive(&a, &b);
+    TEST_ASSERT(few > 0.0 && few < 1.0, "Estimate should be a probability");
+    
+    // The more b has seen beyond a, the more a missing event could hide in it
+    for (int i = 0; i < 20; i++) bloom_increment(&b);
+    double many = bloom_false_positive(&a, &b);
+    TEST_ASSERT(many > few, "Estimate should grow with b's extra history");
+    TEST_ASSERT(bloom_false_positive(&b, &a) == 0.0, "Non-dominated filters have no estimate");
+    
+    bloom_destroy(&a);
+    bloom_destroy(&b);
+    return 1;
+}
+
+/* ---------- Serialization Tests ---------- */
+
+static int test_bloom_serialize() {
+    bloom_set_params(8, 0);
+    Timestamp ts = bloom_create(100, 42, CLOCK_BLOOM);
+    Timestamp copy = bloom_create(100, 42, CLOCK_BLOOM);
+    bloom_set_params(0, 0);
+    bloom_increment(&ts);
+    bloom_increment(&ts);
+    
+    int buf[8];
+    size_t size = bloom_serialize(&ts, buf, sizeof(buf));
+    bloom_deserialize(&copy, buf, size);
+    TEST_ASSERT_EQ(TS_EQUAL, bloom_compare(&ts, &copy), "Round trip should preserve the cells");
+    
+    // Filters of another width are ignored
+    int other[4] = {9, 9, 9, 9};
+    bloom_merge(&copy, other, sizeof(other));
+    TEST_ASSERT_EQ(TS_EQUAL, bloom_compare(&ts, &copy), "Mismatched sizes should be ignored");
+    
+    Timestamp clone = bloom_clone(&ts);
+    TEST_ASSERT_EQ(TS_EQUAL, bloom_compare(&ts, &clone), "Clone should keep m after the default changed");
+    
+    bloom_destroy(&ts);
+    bloom_destroy(&copy);
+    bloom_destroy(&clone);
+    return 1;
+}
+
+/* ---------- Test Runner ---------- */
+
+static void print_test_summary() {
+    printf("\n=== Test Summary ===\n");
+    printf("Tests run: %d\n", g_stats.tests_run);
+    printf("Tests passed: %d\n", g_stats.tests_passed);
+    printf("Tests failed: %d\n", g_stats.tests_failed);
+    printf("Success rate: %.1f%%\n", 
+           g_stats.tests_run > 0 ? (100.0 * g_stats.tests_passed / g_stats.tests_run) : 0.0);
+}
+
+int main() {
+    printf("=== Bloom Clock Test Suite ===\n\n");
+    
+    // Filter Tests
+    printf("--- Filter Tests ---\n");
+    RUN_TEST(test_bloom_constant_size);
+    RUN_TEST(test_bloom_increment_hashes_k_cells);
+    
+    // Accuracy Tests
+    printf("\n--- Accuracy Tests ---\n");
+    RUN_TEST(test_bloom_never_misorders_causality);
+    RUN_TEST(test_bloom_false_positive_estimate);
+    
+    // Serialization Tests
+    printf("\n--- Serialization Tests ---\n");
+    RUN_TEST(test_bloom_serialize);
+    
+    print_test_summary();
+    
+    return g_stats.tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,218 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "clock_arena.h"
+#include "timestamp.h"
+#include "standard_clock.h"
+#include "differential_clock.h"
+#include "compressed_clock.h"
+
+/* ---------- Test Framework ---------- */
+
+typedef struct {
+    int tests_run;
+    int tests_passed;
+    int tests_failed;
+    char current_test[256];
+} TestStats;
+
+static TestStats g_stats = {0};
+
+#define TEST_ASSERT(condition, message) do { \
+    if (!(condition)) { \
+        printf("FAIL: %s - %s\n", g_stats.current_test, message); \
+        g_stats.tests_failed++; \
+        return 0; \
+    } \
+} while(0)
+
+#define TEST_ASSERT_EQ(expected, actual, message) do { \
+    if ((expected) != (actual)) { \
+        printf("FAIL: %s - %s (expected: %d, actual: %d)\n", \
+               g_stats.current_test, message, (int)(expected), (int)(actual)); \
+        g_stats.tests_failed++; \
+        return 0; \
+    } \
+} while(0)
+
+#define RUN_TEST(test_func) do { \
+    snprintf(g_stats.current_test, sizeof(g_stats.current_test), #test_func); \
+    g_stats.tests_run++; \
+    if (test_func()) { \
+        printf("PASS: %s\n", #test_func); \
+        g_stats.tests_passed++; \
+    } \
+} while(0)
+
+/* ---------- Block Tests ---------- */
+
+static int test_block_alignment_and_zeroing() {
+    ClockArena arena;
+    clock_arena_init(&arena, 0);
+    
+    for (size_t size = 1; size < 1000; size += 37) {
+        unsigned char *a = clock_block_alloc(&arena, size);
+        unsigned char *h = clock_block_alloc(NULL, size);
+        TEST_ASSERT((uintptr_t)a % CLOCK_BLOCK_ALIGN == 0, "Arena block should be cache-line aligned");
+        TEST_ASSERT((uintptr_t)h % CLOCK_BLOCK_ALIGN == 0, "Heap block should be cache-line aligned");
+        TEST_ASSERT(clock_block_arena(a) == &arena, "Arena block should record its arena");
+        TEST_ASSERT(clock_block_arena(h) == NULL, "Heap block should have no arena");
+        for (size_t i = 0; i < size; i++) {
+            TEST_ASSERT(a[i] == 0 && h[i] == 0, "Blocks should be zeroed");
+        }
+        memset(a, 0xAB, size);
+        clock_block_free(a);
+        clock_block_free(h);
+    }
+    TEST_ASSERT_EQ(0, (int)arena.live_blocks, "Every block should have been returned");
+    
+    clock_arena_release(&arena);
+    return 1;
+}
+
+static int test_block_reuse() {
+    ClockArena arena;
+    clock_arena_init(&arena, 0);
+    
+    // A freed block is handed out again, zeroed, without reserving more memory
+    int *first = clock_block_alloc(&arena, 40 * sizeof(int));
+    first[3] = 7;
+    size_t reserved = arena.reserved;
+    clock_block_free(first);
+    int *second = clock_block_alloc(&arena, 40 * sizeof(int));
+    TEST_ASSERT(second == first, "Same-size block should come off the free list");
+    TEST_ASSERT_EQ(0, second[3], "Reused block should be zeroed");
+    
+    for (int i = 0; i < 1000; i++) {
+        int *tmp = clock_block_alloc(&arena, 40 * sizeof(int));
+        clock_block_free(tmp);
+    }
+    TEST_ASSERT(arena.reserved == reserved, "Create/destroy churn should not grow the arena");
+    
+    // Blocks larger than a chunk get a chunk of their own
+    char *big = clock_block_alloc(&arena, 3 * CLOCK_ARENA_CHUNK);
+    big[3 * CLOCK_ARENA_CHUNK - 1] = 1;
+    clock_block_free(big);
+    clock_block_free(second);
+    
+    clock_arena_release(&arena);
+    return 1;
+}
+
+/* ---------- Timestamp Tests ---------- */
+
+static int test_ts_create_in_matches_heap() {
+    ClockType types[] = {CLOCK_STANDARD, CLOCK_SPARSE, CLOCK_DIFFERENTIAL, CLOCK_COMPRESSED,
+                         CLOCK_HLC, CLOCK_PLAUSIBLE, CLOCK_BLOOM};
+    int n = 6;
+    ClockArena arena;
+    clock_arena_init(&arena, 0);
+    
+    for (size_t t = 0; t < sizeof(types) / sizeof(types[0]); t++) {
+        Timestamp a = ts_create_in(&arena, n, 1, types[t]);
+        Timestamp h = ts_create(n, 1, types[t]);
+        ts_increment(&a);
+        ts_increment(&a);
+        ts_increment(&h);
+        ts_increment(&h);
+        
+        char abuf[256], hbuf[256];
+        ts_to_string(&a, abuf, sizeof(abuf));
+        ts_to_string(&h, hbuf, sizeof(hbuf));
+        TEST_ASSERT(strcmp(abuf, hbuf) == 0, "Arena and heap clocks should behave the same");
+        
+        Timestamp c = ts_clone_in(&arena, &a);
+        TEST_ASSERT_EQ(TS_EQUAL, ts_compare(&c, &a), "Arena clone should equal its source");
+        ts_increment(&c);
+        TEST_ASSERT_EQ(TS_BEFORE, ts_compare(&a, &c), "Clone should not share state with its source");
+        
+        ts_destroy(&c);
+        ts_destroy(&a);
+        ts_destroy(&h);
+    }
+    TEST_ASSERT_EQ(0, (int)arena.live_blocks, "Destroy should return every block");
+    
+    clock_arena_release(&arena);
+    return 1;
+}
+
+static int test_single_block_layout() {
+    ClockArena arena;
+    clock_arena_init(&arena, 0);
+    int n = 10;
+    
+    // Differential: all five arrays follow the header in the same block
+    Timestamp d = ts_create_in(&arena, n, 0, CLOCK_DIFFERENTIAL);
+    DifferentialClockData *dd = (DifferentialClockData*)d.data;
+    TEST_ASSERT((uintptr_t)dd % CLOCK_BLOCK_ALIGN == 0, "Header should be cache-line aligned");
+    TEST_ASSERT((char*)dd->v == (char*)dd + CLOCK_BLOCK_ROUND(sizeof(*dd)), "v should follow the header");
+    TEST_ASSERT(dd->next == dd->v + 4 * n, "Arrays should be contiguous");
+    
+    // Compressed: vt and row_of in the block, tau rows only after the first send
+    Timestamp c = ts_create_in(&arena, n, 0, CLOCK_COMPRESSED);
+    CompressedClockData *cd = (CompressedClockData*)c.data;
+    TEST_ASSERT(cd->row_of == cd->vt + n, "row_of should follow vt");
+    TEST_ASSERT(cd->tau == NULL, "No tau rows before the first send");
+    
+    // Standard: the vector is a flexible array member
+    Timestamp s = ts_create_in(&arena, n, 0, CLOCK_STANDARD);
+    StandardClockData *sd = (StandardClockData*)s.data;
+    TEST_ASSERT_EQ(n, sd->n, "Vector length should be recorded in the block");
+    TEST_ASSERT_EQ(1, sd->width, "New vectors should start at the narrowest width");
+    TEST_ASSERT((char*)sd->cells < (char*)sd + CLOCK_BLOCK_ALIGN, "Vector should start in the header's cache line");
+    
+    ts_destroy(&s);
+    ts_destroy(&c);
+    ts_destroy(&d);
+    clock_arena_release(&arena);
+    return 1;
+}
+
+static int test_huge_page_arena() {
+    // Huge pages are advisory: the arena must work whether or not they are granted
+    ClockArena arena;
+    clock_arena_init(&arena, 1);
+    Timestamp ts[64];
+    for (int i = 0; i < 64; i++) {
+        ts[i] = ts_create_in(&arena, 32, i % 32, CLOCK_STANDARD);
+        ts_increment(&ts[i]);
+    }
+    TEST_ASSERT_EQ(TS_CONCURRENT, ts_compare(&ts[0], &ts[1]), "Clocks should stay independent");
+    for (int i = 0; i < 64; i++) {
+        ts_destroy(&ts[i]);
+    }
+    clock_arena_release(&arena);
+    TEST_ASSERT(arena.reserved == 0, "Release should return every chunk");
+    return 1;
+}
+
+/* ---------- Test Runner ---------- */
+
+static void print_test_summary() {
+    printf("\n=== Test Summary ===\n");
+    printf("Tests run: %d\n", g_stats.tests_run);
+    printf("Tests passed: %d\n", g_stats.tests_passed);
+    printf("Tests failed: %d\n", g_stats.tests_failed);
+    printf("Success rate: %.1f%%\n", 
+           g_stats.tests_run > 0 ? (100.0 * g_stats.tests_passed / g_stats.tests_run) : 0.0);
+}
+
+int main() {
+    printf("=== Clock Arena Test Suite ===\n\n");
+    
+    // Block Tests
+    printf("--- Block Tests ---\n");
+    RUN_TEST(test_block_alignment_and_zeroing);
+    RUN_TEST(test_block_reuse);
+    
+    // Timestamp Tests
+    printf("\n--- Timestamp Tests ---\n");
+    RUN_TEST(test_ts_create_in_matches_heap);
+    RUN_TEST(test_single_block_layout);
+    RUN_TEST(test_huge_page_arena);
+    
+    print_test_summary();
+    
+    return g_stats.tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,219 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "timestamp.h"
+#include "clock_table.h"
+
+/* ---------- Test Framework ---------- */
+
+typedef struct {
+    int tests_run;
+    int tests_passed;
+    int tests_failed;
+    char current_test[256];
+} TestStats;
+
+static TestStats g_stats = {0};
+
+#define TEST_ASSERT(condition, message) do { \
+    if (!(condition)) { \
+        printf("FAIL: %s - %s\n", g_stats.current_test, message); \
+        g_stats.tests_failed++; \
+        return 0; \
+    } \
+} while(0)
+
+#define TEST_ASSERT_EQ(expected, actual, message) do { \
+    if ((expected) != (actual)) { \
+        printf("FAIL: %s - %s (expected: %d, actual: %d)\n", \
+               g_stats.current_test, message, (int)(expected), (int)(actual)); \
+        g_stats.tests_failed++; \
+        return 0; \
+    } \
+} while(0)
+
+#define RUN_TEST(test_func) do { \
+    snprintf(g_stats.current_test, sizeof(g_stats.current_test), #test_func); \
+    g_stats.tests_run++; \
+    if (test_func()) { \
+        printf("PASS: %s\n", #test_func); \
+        g_stats.tests_passed++; \
+    } \
+} while(0)
+
+/* ---------- Helpers ---------- */
+
+// Random gossip among n processes; a snapshot of the acting process after every event
+// fills rows[0 .. count), so the rows are a mix of ordered and concurrent clocks
+static void make_history(ClockType type, int n, Timestamp *rows, int count, unsigned int seed) {
+    Timestamp *procs = malloc(n * sizeof(Timestamp));
+    for (int i = 0; i < n; i++) procs[i] = ts_create(n, i, type);
+
+    for (int r = 0; r < count; r++) {
+        int p = rand_r(&seed) % n;
+        int q = rand_r(&seed) % n;
+        ts_increment(&procs[p]);
+        if (q != p && rand_r(&seed) % 2) {
+            unsigned char buffer[1 << 14];
+            size_t size = ts_serialize_for_dest(&procs[p], q, buffer, sizeof(buffer));
+            ts_merge_and_tick(&procs[q], buffer, size);
+            p = q;
+        }
+        rows[r] = ts_clone(&procs[p]);
+    }
+
+    for (int i = 0; i < n; i++) ts_destroy(&procs[i]);
+    free(procs);
+}
+
+// Every row of the table against ts_compare, for query
+static int matches_compare(const Timestamp *query, const ClockTable *table, const Timestamp *rows) {
+    TSOrder *orders = malloc((table->rows ? table->rows : 1) * sizeof(TSOrder));
+    int ok = ts_compare_many(query, table, orders);
+    for (int r = 0; ok && r < table->rows; r++) {
+        ok = orders[r] == ts_compare(query, &rows[r]);
+    }
+    free(orders);
+    return ok;
+}
+
+/* ---------- Batch Comparison Tests ---------- */
+
+static int test_compare_many_matches_compare() {
+    // Starting from 4 rows the table grows nine times; the checked row counts fall on
+    // both sides of the 1024-row tile
+    enum { N = 12, ROWS = 1500 };
+    const int checkpoints[] = {0, 1, 3, 4, 5, 1023, 1024, 1025, ROWS};
+    Timestamp *rows = malloc(ROWS * sizeof(Timestamp));
+
+    for (int type = 0; type < CLOCK_TYPE_COUNT; type++) {
+        if (!clock_table_supports((ClockType)type)) continue;
+        make_history((ClockType)type, N, rows, ROWS, 11 + type);
+
+        ClockTable table;
+        clock_table_init(&table, N, (ClockType)type, 4);
+        int added = 0;
+        for (int c = 0; c < (int)(sizeof(checkpoints) / sizeof(checkpoints[0])); c++) {
+            for (; added < checkpoints[c]; added++) {
+                TEST_ASSERT_EQ(added, clock_table_add(&table, &rows[added]), "Rows should be stored in order");
+            }
+            TEST_ASSERT_EQ(checkpoints[c], table.rows, "Table should hold every added row");
+
+            // Queries from the history (equal to some row, ordered or concurrent with the rest)
+            for (int q = 0; q < ROWS; q += 97) {
+                TEST_ASSERT(matches_compare(&rows[q], &table, rows), clock_type_names[type]);
+            }
+        }
+
+        clock_table_destroy(&table);
+        for (int r = 0; r < ROWS; r++) ts_destroy(&rows[r]);
+    }
+    free(rows);
+    return 1;
+}
+
+static int test_add_all_matches_add() {
+    enum { N = 8, ROWS = 300 };
+    Timestamp rows[ROWS];
+    make_history(CLOCK_SPARSE, N, rows, ROWS, 3);
+
+    ClockTable one, all;
+    clock_table_init(&one, N, CLOCK_SPARSE, 0);
+    clock_table_init(&all, N, CLOCK_SPARSE, 0);
+    for (int r = 0; r < ROWS; r++) clock_table_add(&one, &rows[r]);
+    clock_table_add_all(&all, rows, ROWS);
+
+    TEST_ASSERT_EQ(one.rows, all.rows, "Both tables should hold every row");
+    for (int k = 0; k < N; k++) {
+        TEST_ASSERT(memcmp(one.cols + (size_t)k * one.capacity, all.cols + (size_t)k * all.capacity,
+                           ROWS * sizeof(int)) == 0, "Columns should match");
+    }
+
+    clock_table_destroy(&one);
+    clock_table_destroy(&all);
+    for (int r = 0; r < ROWS; r++) ts_destroy(&rows[r]);
+    return 1;
+}
+
+/* ---------- Refusal Tests ---------- */
+
+static int test_unsupported_types() {
+    // Equal folded vectors from different pids compare CONCURRENT; a row keeps no pid
+    TEST_ASSERT(!clock_table_supports(CLOCK_PLAUSIBLE), "Plausible clocks need the pid");
+    Timestamp a = ts_create(4, 0, CLOCK_PLAUSIBLE);
+    Timestamp b = ts_create(4, 1, CLOCK_PLAUSIBLE);
+    int va[4], vb[4];
+    ts_to_vector(&a, va);
+    ts_to_vector(&b, vb);
+    TEST_ASSERT(memcmp(va, vb, sizeof(va)) == 0, "Fresh plausible clocks expand alike");
+    TEST_ASSERT_EQ(TS_CONCURRENT, ts_compare(&a, &b), "... yet compare concurrent");
+    ts_destroy(&a);
+    ts_destroy(&b);
+
+    TEST_ASSERT(!clock_table_supports(CLOCK_ITC), "ITC has no vector");
+    TEST_ASSERT(!clock_table_supports(CLOCK_HLC), "HLC has no vector");
+    TEST_ASSERT(!clock_table_supports(CLOCK_BLOOM), "Bloom has no vector");
+    TEST_ASSERT(!clock_table_supports(CLOCK_LAMPORT), "Lamport has no vector");
+    return 1;
+}
+
+static int test_wide_standard_refused() {
+    // [2^31, 0] and [2^32, 0] would both clamp to INT_MAX and read as EQUAL
+    uint64_t low[2] = {(uint64_t)1 << 31, 0};
+    uint64_t high[2] = {(uint64_t)1 << 32, 0};
+    Timestamp a = ts_create(2, 1, CLOCK_STANDARD);
+    Timestamp b = ts_create(2, 1, CLOCK_STANDARD);
+    Timestamp small = ts_create(2, 1, CLOCK_STANDARD);
+    ts_merge(&a, low, sizeof(low));
+    ts_merge(&b, high, sizeof(high));
+    ts_increment(&small);
+    TEST_ASSERT_EQ(TS_BEFORE, ts_compare(&a, &b), "64-bit counters should order");
+
+    ClockTable table;
+    clock_table_init(&table, 2, CLOCK_STANDARD, 0);
+    TEST_ASSERT_EQ(-1, clock_table_add(&table, &a), "Counter past INT_MAX should be refused");
+    TEST_ASSERT_EQ(0, table.rows, "Nothing should be stored");
+    TEST_ASSERT_EQ(0, clock_table_add(&table, &small), "Small clocks still fit");
+
+    TSOrder order = TS_EQUAL;
+    TEST_ASSERT(!ts_compare_many(&b, &table, &order), "Wide query should be refused");
+    TEST_ASSERT_EQ(TS_EQUAL, order, "Refused query should leave the output alone");
+    TEST_ASSERT(ts_compare_many(&small, &table, &order), "Narrow query should run");
+    TEST_ASSERT_EQ(TS_EQUAL, order, "Row should equal itself");
+
+    clock_table_destroy(&table);
+    ts_destroy(&a);
+    ts_destroy(&b);
+    ts_destroy(&small);
+    return 1;
+}
+
+/* ---------- Test Runner ---------- */
+
+static void print_test_summary() {
+    printf("\n=== Test Summary ===\n");
+    printf("Tests run: %d\n", g_stats.tests_run);
+    printf("Tests passed: %d\n", g_stats.tests_passed);
+    printf("Tests failed: %d\n", g_stats.tests_failed);
+    printf("Success rate: %.1f%%\n",
+           g_stats.tests_run > 0 ? (100.0 * g_stats.tests_passed / g_stats.tests_run) : 0.0);
+}
+
+int main() {
+    printf("=== Clock Table Test Suite ===\n\n");
+
+    // Batch Comparison Tests
+    printf("--- Batch Comparison Tests ---\n");
+    RUN_TEST(test_compare_many_matches_compare);
+    RUN_TEST(test_add_all_matches_add);
+
+    // Refusal Tests
+    printf("\n--- Refusal Tests ---\n");
+    RUN_TEST(test_unsupported_types);
+    RUN_TEST(test_wide_standard_refused);
+
+    print_test_summary();
+
+    return g_stats.tests_failed > 0 ? 1 : 0;
+}
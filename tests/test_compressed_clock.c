@@ -53,14 +53,15 @@ static int test_compressed_create() {
     
     CompressedClockData *data = (CompressedClockData*)ts.data;
     TEST_ASSERT(data->vt != NULL, "Vector clock should not be NULL");
-    TEST_ASSERT(data->tau != NULL, "Tau matrix should not be NULL");
     TEST_ASSERT(data->n == 3, "Internal n should be 3");
+    TEST_ASSERT_EQ(0, data->rows_used, "No tau rows should exist before any send");
     
     // Check initial values
     for (int i = 0; i < 3; i++) {
         TEST_ASSERT_EQ(0, data->vt[i], "Vector should be initialized to zeros");
+        TEST_ASSERT_EQ(COMPRESSED_ROW_NONE, data->row_of[i], "No destination should be tracked");
         for (int j = 0; j < 3; j++) {
-            TEST_ASSERT_EQ(0, data->tau[i][j], "Tau matrix should be initialized to zeros");
+            TEST_ASSERT_EQ(0, compressed_tau_row(&ts, i)[j], "New tau rows should be zeros");
         }
     }
     
@@ -75,7 +76,7 @@ static int test_compressed_destroy() {
     // Verify data exists before destruction
     TEST_ASSERT(data != NULL, "Data should exist before destruction");
     TEST_ASSERT(data->vt != NULL, "Vector should exist before destruction");
-    TEST_ASSERT(data->tau != NULL, "Tau matrix should exist before destruction");
+    TEST_ASSERT(data->row_of != NULL, "Row index should exist before destruction");
     
     compressed_destroy(&ts);
     
@@ -93,8 +94,8 @@ static int test_compressed_clone() {
     compressed_increment(&original);
     
     CompressedClockData *orig_data = (CompressedClockData*)original.data;
-    orig_data->tau[0][1] = 5;  // Simulate having sent to process 0
-    orig_data->tau[2][1] = 3;  // Simulate having sent to process 2
+    compressed_tau_row(&original, 0)[1] = 5;  // Simulate having sent to process 0
+    compressed_tau_row(&original, 2)[1] = 3;  // Simulate having sent to process 2
     
     Timestamp clone = compressed_clone(&original);
     
@@ -106,13 +107,16 @@ static int test_compressed_clone() {
     CompressedClockData *clone_data = (CompressedClockData*)clone.data;
     TEST_ASSERT(clone_data->vt != orig_data->vt, "Clone vector should be different pointer");
     TEST_ASSERT(clone_data->tau != orig_data->tau, "Clone tau should be different pointer");
+    TEST_ASSERT_EQ(orig_data->rows_used, clone_data->rows_used, "Clone should track the same destinations");
     
     // Check values are copied correctly
     for (int i = 0; i < 3; i++) {
         TEST_ASSERT_EQ(orig_data->vt[i], clone_data->vt[i], "Vector values should match");
-        for (int j = 0; j < 3; j++) {
-            TEST_ASSERT_EQ(orig_data->tau[i][j], clone_data->tau[i][j], "Tau values should match");
-        }
+        TEST_ASSERT_EQ(orig_data->row_of[i], clone_data->row_of[i], "Row index should match");
+    }
+    for (int j = 0; j < 3; j++) {
+        TEST_ASSERT_EQ(compressed_tau_row(&original, 0)[j], compressed_tau_row(&clone, 0)[j], "Tau values should match");
+        TEST_ASSERT_EQ(compressed_tau_row(&original, 2)[j], compressed_tau_row(&clone, 2)[j], "Tau values should match");
     }
     
     compressed_destroy(&original);
@@ -182,59 +186,78 @@ static int test_compressed_serialize_for_dest_basic() {
     data->vt[3] = 0;
     
     // Simulate last sent to process 3: tau[3] = [5, 7, 1, 0] (same as current)
-    memcpy(data->tau[3], data->vt, 4 * sizeof(int));
+    memcpy(compressed_tau_row(&ts, 3), data->vt, 4 * sizeof(int));
+    
+    // The simulation ticks before sending, so vt[2] becomes 2
+    compressed_increment(&ts);
     
     int buffer[10];
     size_t size = compressed_serialize_for_dest(&ts, 3, buffer, sizeof(buffer));
     
-    // After increment, vt[2] becomes 2, so only index 2 should be sent
+    // Only index 2 changed, so a single pair is the smallest encoding
     TEST_ASSERT_EQ(3 * sizeof(int), size, "Should send 3 ints: count + 1 pair");
-    TEST_ASSERT_EQ(1, buffer[0], "Should send 1 changed entry");
+    TEST_ASSERT_EQ(1, buffer[0], "Should send 1 changed entry (pairs tag is 0)");
     TEST_ASSERT_EQ(2, buffer[1], "Changed index should be 2");
     TEST_ASSERT_EQ(2, buffer[2], "New value should be 2");
     
     // Verify tau was updated
-    TEST_ASSERT_EQ(2, data->tau[3][2], "tau[3][2] should be updated to 2");
+    TEST_ASSERT_EQ(2, compressed_tau_row(&ts, 3)[2], "tau[3][2] should be updated to 2");
     
     compressed_destroy(&ts);
     return 1;
 }
 
 static int test_compressed_serialize_for_dest_multiple_changes() {
-    Timestamp ts = compressed_create(4, 2, CLOCK_COMPRESSED);
+    Timestamp ts = compressed_create(8, 2, CLOCK_COMPRESSED);
     CompressedClockData *data = (CompressedClockData*)ts.data;
     
-    // Current state: vt = [5, 8, 1, 0]
+    // Current state: vt = [5, 8, 1, 0, ...]
     data->vt[0] = 5;
     data->vt[1] = 8;
     data->vt[2] = 1;
-    data->vt[3] = 0;
     
-    // Last sent to process 3: tau[3] = [5, 7, 1, 0] (different at index 1)
-    data->tau[3][0] = 5;
-    data->tau[3][1] = 7;  // Different!
-    data->tau[3][2] = 1;
-    data->tau[3][3] = 0;
+    // Last sent to process 3: tau[3] = [5, 7, 1, 0, ...] (different at index 1)
+    int *tau = compressed_tau_row(&ts, 3);
+    tau[0] = 5;
+    tau[1] = 7;  // Different!
+    tau[2] = 1;
     
-    int buffer[10];
+    compressed_increment(&ts);
+    
+    int buffer[16];
     size_t size = compressed_serialize_for_dest(&ts, 3, buffer, sizeof(buffer));
     
-    // Should send: index 1 (7->8) and index 2 (1->2 after increment)
-    TEST_ASSERT_EQ(5 * sizeof(int), size, "Should send 5 ints: count + 2 pairs");
-    TEST_ASSERT_EQ(2, buffer[0], "Should send 2 changed entries");
+    // Indices 1 and 2 changed: one bitmap word + 2 values beats 2 pairs or 1 run
+    TEST_ASSERT_EQ(4 * sizeof(int), size, "Should send header + bitmap + 2 values");
+    TEST_ASSERT_EQ(COMPRESSED_ENC_BITMAP, (unsigned)buffer[0] >> COMPRESSED_TAG_SHIFT, "Should use the bitmap encoding");
+    TEST_ASSERT_EQ(2, buffer[0] & COMPRESSED_COUNT_MASK, "Should send 2 changed entries");
+    TEST_ASSERT_EQ(0x6, buffer[1], "Bitmap should mark indices 1 and 2");
+    TEST_ASSERT_EQ(8, buffer[2], "First value should be vt[1]");
+    TEST_ASSERT_EQ(2, buffer[3], "Second value should be vt[2]");
     
-    // Check the pairs (order might vary, so check both possibilities)
-    int found_idx1 = 0, found_idx2 = 0;
-    for (int i = 0; i < 2; i++) {
-        int idx = buffer[1 + i * 2];
-        int val = buffer[1 + i * 2 + 1];
-        
-        if (idx == 1 && val == 8) found_idx1 = 1;
-        if (idx == 2 && val == 2) found_idx2 = 1;
+    compressed_destroy(&ts);
+    return 1;
+}
+
+static int test_compressed_serialize_for_dest_runs() {
+    Timestamp ts = compressed_create(100, 0, CLOCK_COMPRESSED);
+    CompressedClockData *data = (CompressedClockData*)ts.data;
+    
+    // A burst of updates from processes 10..19
+    for (int k = 10; k < 20; k++) {
+        data->vt[k] = k;
     }
     
-    TEST_ASSERT(found_idx1, "Should find (1, 8) pair");
-    TEST_ASSERT(found_idx2, "Should find (2, 2) pair");
+    int buffer[100];
+    size_t size = compressed_serialize_for_dest(&ts, 1, buffer, sizeof(buffer));
+    
+    // One run: header + (start, length) + 10 values
+    TEST_ASSERT_EQ(13 * sizeof(int), size, "Should send a single run");
+    TEST_ASSERT_EQ(COMPRESSED_ENC_RUNS, (unsigned)buffer[0] >> COMPRESSED_TAG_SHIFT, "Should use the runs encoding");
+    TEST_ASSERT_EQ(1, buffer[0] & COMPRESSED_COUNT_MASK, "Should send 1 run");
+    TEST_ASSERT_EQ(10, buffer[1], "Run should start at index 10");
+    TEST_ASSERT_EQ(10, buffer[2], "Run should cover 10 indices");
+    TEST_ASSERT_EQ(19, buffer[12], "Last value should be vt[19]");
     
     compressed_destroy(&ts);
     return 1;
@@ -254,14 +277,174 @@ static int test_compressed_serialize_for_dest_first_send() {
     int buffer[10];
     size_t size = compressed_serialize_for_dest(&ts, 0, buffer, sizeof(buffer));
     
-    // All non-zero entries should be sent (plus own entry after increment)
-    TEST_ASSERT_EQ(7 * sizeof(int), size, "Should send 7 ints: count + 3 pairs");
-    TEST_ASSERT_EQ(3, buffer[0], "Should send 3 entries");
+    // Every entry changed, so no delta is shorter than the full vector
+    TEST_ASSERT_EQ(3 * sizeof(int), size, "Should fall back to the full vector");
+    TEST_ASSERT_EQ(2, buffer[0], "Full vector should start with vt[0]");
+    TEST_ASSERT_EQ(1, compressed_tau_row(&ts, 0)[2], "tau[0] should be updated");
+    
+    compressed_destroy(&ts);
+    return 1;
+}
+
+static int test_compressed_encodings_roundtrip() {
+    // Scattered, clustered and single-entry updates exercise each encoding
+    int patterns[3][6] = {
+        {3, 40, 77, 91, 120, 150},
+        {60, 61, 62, 63, 64, 65},
+        {7, -1, -1, -1, -1, -1}
+    };
+    
+    for (int p = 0; p < 3; p++) {
+        Timestamp sender = compressed_create(160, 0, CLOCK_COMPRESSED);
+        Timestamp receiver = compressed_create(160, 1, CLOCK_COMPRESSED);
+        CompressedClockData *s_data = (CompressedClockData*)sender.data;
+        CompressedClockData *r_data = (CompressedClockData*)receiver.data;
+        
+        for (int i = 0; i < 6; i++) {
+            if (patterns[p][i] >= 0) s_data->vt[patterns[p][i]] = 100 + i;
+        }
+        
+        int buffer[160];
+        size_t size = compressed_serialize_for_dest(&sender, 1, buffer, sizeof(buffer));
+        TEST_ASSERT(size < 160 * sizeof(int), "Should send a delta, not the full vector");
+        
+        int pids[160], values[160];
+        int count = compressed_decode_entries(160, buffer, size, pids, values);
+        TEST_ASSERT_EQ(p == 2 ? 1 : 6, count, "Decoder should recover every changed entry");
+        
+        compressed_deserialize(&receiver, buffer, size);
+        TEST_ASSERT_EQ(TS_EQUAL, compressed_compare(&sender, &receiver), "Receiver should match sender");
+        TEST_ASSERT_EQ(0, r_data->vt[1], "Deserialize should not tick");
+        
+        compressed_destroy(&sender);
+        compressed_destroy(&receiver);
+    }
+    return 1;
+}
+
+static int test_compressed_malformed_delta_ignored() {
+    Timestamp ts = compressed_create(8, 0, CLOCK_COMPRESSED);
+    CompressedClockData *data = (CompressedClockData*)ts.data;
+    
+    // Bitmap claims 3 entries but only 2 values follow
+    int truncated[] = {(COMPRESSED_ENC_BITMAP << COMPRESSED_TAG_SHIFT) | 3, 0x7, 9, 9};
+    compressed_deserialize(&ts, truncated, sizeof(truncated));
+    
+    // Run extends past n
+    int overrun[] = {(COMPRESSED_ENC_RUNS << COMPRESSED_TAG_SHIFT) | 1, 7, 2, 9, 9};
+    compressed_deserialize(&ts, overrun, sizeof(overrun));
+    
+    for (int k = 0; k < 8; k++) {
+        TEST_ASSERT_EQ(0, data->vt[k], "Malformed messages should be ignored");
+    }
+    
+    compressed_destroy(&ts);
+    return 1;
+}
+
+/* ---------- Destination Tracking Tests ---------- */
+
+static int test_compressed_lazy_tau_rows() {
+    Timestamp ts = compressed_create(64, 0, CLOCK_COMPRESSED);
+    CompressedClockData *data = (CompressedClockData*)ts.data;
+    int buffer[64];
+    
+    compressed_increment(&ts);
+    compressed_serialize_for_dest(&ts, 5, buffer, sizeof(buffer));
+    compressed_increment(&ts);
+    compressed_serialize_for_dest(&ts, 9, buffer, sizeof(buffer));
+    
+    TEST_ASSERT_EQ(2, data->rows_used, "Only destinations sent to should get rows");
+    TEST_ASSERT(data->row_of[5] >= 0 && data->row_of[9] >= 0, "Both destinations should be tracked");
+    TEST_ASSERT_EQ(COMPRESSED_ROW_NONE, data->row_of[6], "Other destinations should stay untracked");
+    TEST_ASSERT(compressed_tau_bytes(&ts) < 64 * 64 * sizeof(int) / 8, "Tau state should be far below n^2");
+    
+    // Size queries must not claim rows
+    TEST_ASSERT(compressed_serialize_for_dest(&ts, 7, NULL, 0) > 0, "Size query should answer");
+    TEST_ASSERT_EQ(COMPRESSED_ROW_NONE, data->row_of[7], "Size query should not track the destination");
     
     compressed_destroy(&ts);
     return 1;
 }
 
+static int test_compressed_lru_eviction() {
+    compressed_set_max_destinations(2);
+    Timestamp ts = compressed_create(40, 0, CLOCK_COMPRESSED);
+    compressed_set_max_destinations(0);
+    CompressedClockData *data = (CompressedClockData*)ts.data;
+    int buffer[40];
+    
+    compressed_increment(&ts);
+    compressed_serialize_for_dest(&ts, 1, buffer, sizeof(buffer));
+    compressed_serialize_for_dest(&ts, 2, buffer, sizeof(buffer));
+    compressed_serialize_for_dest(&ts, 1, buffer, sizeof(buffer));  // 2 is now least recent
+    compressed_serialize_for_dest(&ts, 3, buffer, sizeof(buffer));
+    
+    TEST_ASSERT_EQ(2, data->rows_used, "Rows should be capped at K");
+    TEST_ASSERT_EQ(COMPRESSED_ROW_EVICTED, data->row_of[2], "Least recently used destination should be evicted");
+    TEST_ASSERT(data->row_of[1] >= 0 && data->row_of[3] >= 0, "Recent destinations should keep their rows");
+    TEST_ASSERT_EQ(1, compressed_evictions(&ts), "Eviction should be counted");
+    
+    // A single change would be a 3-int delta, but 2's last state is unknown
+    compressed_increment(&ts);
+    size_t size = compressed_serialize_for_dest(&ts, 2, buffer, sizeof(buffer));
+    TEST_ASSERT_EQ(40 * sizeof(int), size, "Evicted destination should get the full vector");
+    TEST_ASSERT(data->row_of[2] >= 0, "Full send should rebuild the row");
+    
+    compressed_increment(&ts);
+    size = compressed_serialize_for_dest(&ts, 2, buffer, sizeof(buffer));
+    TEST_ASSERT_EQ(3 * sizeof(int), size, "Rebuilt row should allow deltas again");
+    
+    compressed_destroy(&ts);
+    return 1;
+}
+
+static int test_compressed_dirty_bits_match_scan() {
+    // Random traffic among 70 processes (two dirty words each) with a small destination
+    // cap; every delta must carry exactly the entries where vt differs from what that
+    // sender last sent to that receiver
+    enum { N = 70 };
+    static int last_sent[N][N][N];
+    Timestamp procs[N];
+    unsigned int seed = 11;
+    memset(last_sent, 0, sizeof(last_sent));
+    compressed_set_max_destinations(6);
+    for (int i = 0; i < N; i++) {
+        procs[i] = compressed_create(N, i, CLOCK_COMPRESSED);
+    }
+    compressed_set_max_destinations(0);
+    
+    for (int op = 0; op < 3000; op++) {
+        int p = rand_r(&seed) % N;
+        int q = rand_r(&seed) % 8;  // mostly the same few receivers, so rows are reused
+        compressed_increment(&procs[p]);
+        if (p == q) continue;
+        
+        const int *vt = ((CompressedClockData*)procs[p].data)->vt;
+        int buffer[N + 4], pids[N], values[N];
+        size_t size = compressed_serialize_for_dest(&procs[p], q, buffer, sizeof(buffer));
+        if (size != N * sizeof(int)) {
+            int count = compressed_decode_entries(N, buffer, size, pids, values);
+            int expected = 0;
+            for (int k = 0; k < N; k++) {
+                expected += vt[k] != last_sent[p][q][k];
+            }
+            TEST_ASSERT_EQ(expected, count, "Delta should carry every changed entry");
+            for (int i = 0; i < count; i++) {
+                TEST_ASSERT(vt[pids[i]] != last_sent[p][q][pids[i]], "Delta should only carry changed entries");
+                TEST_ASSERT_EQ(vt[pids[i]], values[i], "Delta should carry current values");
+            }
+        }
+        memcpy(last_sent[p][q], vt, sizeof(last_sent[p][q]));
+        compressed_merge(&procs[q], buffer, size);
+    }
+    
+    for (int i = 0; i < N; i++) {
+        compressed_destroy(&procs[i]);
+    }
+    return 1;
+}
+
 /* ---------- Merge Tests ---------- */
 
 static int test_compressed_merge_full_vector() {
@@ -352,24 +535,21 @@ static int test_compressed_algorithm_end_to_end() {
     Timestamp sender = compressed_create(4, 2, CLOCK_COMPRESSED);
     CompressedClockData *sender_data = (CompressedClockData*)sender.data;
     
-    // Set up the example: current vt = [5,8,1,0], last sent to P3 was [5,7,1,0]
+    // Set up the example: current vt = [5,8,1,0], last sent to P3 was [5,8,1,0]
     sender_data->vt[0] = 5;
     sender_data->vt[1] = 8;
     sender_data->vt[2] = 1;
     sender_data->vt[3] = 0;
+    memcpy(compressed_tau_row(&sender, 3), sender_data->vt, 4 * sizeof(int));
     
-    sender_data->tau[3][0] = 5;
-    sender_data->tau[3][1] = 7;  // Different!
-    sender_data->tau[3][2] = 1;
-    sender_data->tau[3][3] = 0;
-    
-    // Serialize for destination 3
+    // Send event: tick, then serialize for destination 3
+    compressed_increment(&sender);
     int buffer[10];
     size_t msg_size = compressed_serialize_for_dest(&sender, 3, buffer, sizeof(buffer));
     
-    // Should send only index 1 (7->8) and index 2 (1->2 after increment)
-    TEST_ASSERT_EQ(5 * sizeof(int), msg_size, "Should send compressed format");
-    TEST_ASSERT_EQ(2, buffer[0], "Should send 2 changed entries");
+    // Should send only index 2 (1->2 after increment)
+    TEST_ASSERT_EQ(3 * sizeof(int), msg_size, "Should send compressed format");
+    TEST_ASSERT_EQ(1, buffer[0], "Should send 1 changed entry");
     
     // Create receiver and simulate receive
     Timestamp receiver = compressed_create(4, 3, CLOCK_COMPRESSED);
@@ -379,9 +559,106 @@ static int test_compressed_algorithm_end_to_end() {
     
     // Receiver should have: incremented own clock, then merged
     TEST_ASSERT_EQ(1, recv_data->vt[3], "Receiver should increment own clock");
-    TEST_ASSERT_EQ(8, recv_data->vt[1], "Receiver should have sender's vt[1]");
+    TEST_ASSERT_EQ(0, recv_data->vt[1], "Receiver should not see unchanged entries");
     TEST_ASSERT_EQ(2, recv_data->vt[2], "Receiver should have sender's vt[2]");
     
+    // A second send with nothing new falls back to the full vector
+    msg_size = compressed_serialize_for_dest(&sender, 3, buffer, sizeof(buffer));
+    TEST_ASSERT_EQ(4 * sizeof(int), msg_size, "Unchanged clock should send the full vector");
+    compressed_merge(&receiver, buffer, msg_size);
+    TEST_ASSERT_EQ(8, recv_data->vt[1], "Full vector should carry every entry");
+    
+    compressed_destroy(&sender);
+    compressed_destroy(&receiver);
+    return 1;
+}
+
+/* ---------- Value-Delta Tests ---------- */
+
+static int test_compressed_value_delta_roundtrip() {
+    compressed_set_value_deltas(1);
+    Timestamp sender = compressed_create(100, 0, CLOCK_COMPRESSED);
+    Timestamp receiver = compressed_create(100, 1, CLOCK_COMPRESSED);
+    compressed_set_value_deltas(0);
+    int buffer[100], bump[100];
+    unsigned int seed = 7;
+    
+    for (int round = 0; round < 50; round++) {
+        // Raise a few scattered entries by 1-3, as incoming messages would
+        memset(bump, 0, sizeof(bump));
+        compressed_to_vector(&sender, bump);
+        for (int i = 0; i < 4; i++) {
+            bump[rand_r(&seed) % 100] += 1 + rand_r(&seed) % 3;
+        }
+        compressed_deserialize(&sender, bump, sizeof(bump));
+        compressed_increment(&sender);
+        
+        size_t size = compressed_serialize_for_dest(&sender, 1, buffer, sizeof(buffer));
+        TEST_ASSERT(compressed_is_value_delta(buffer, size), "Every send should be a value-delta frame");
+        if (round > 0) {
+            TEST_ASSERT(size <= sizeof(int) + 2 + 5 * 2, "Small deltas should take about a byte each");
+        }
+        compressed_deserialize(&receiver, buffer, size);
+        TEST_ASSERT_EQ(TS_EQUAL, compressed_compare(&sender, &receiver), "Receiver should rebuild the sender's vector");
+    }
+    
+    compressed_destroy(&sender);
+    compressed_destroy(&receiver);
+    return 1;
+}
+
+static int test_compressed_value_delta_out_of_sequence_ignored() {
+    compressed_set_value_deltas(1);
+    Timestamp sender = compressed_create(16, 0, CLOCK_COMPRESSED);
+    Timestamp receiver = compressed_create(16, 1, CLOCK_COMPRESSED);
+    compressed_set_value_deltas(0);
+    CompressedClockData *r_data = (CompressedClockData*)receiver.data;
+    int first[16], second[16];
+    
+    compressed_increment(&sender);
+    size_t first_size = compressed_serialize_for_dest(&sender, 1, first, sizeof(first));
+    compressed_increment(&sender);
+    size_t second_size = compressed_serialize_for_dest(&sender, 1, second, sizeof(second));
+    
+    // The second frame is relative to the first: alone it cannot be rebuilt
+    compressed_deserialize(&receiver, second, second_size);
+    TEST_ASSERT_EQ(0, r_data->vt[0], "Out-of-sequence frame should be ignored");
+    
+    compressed_deserialize(&receiver, first, first_size);
+    compressed_deserialize(&receiver, second, second_size);
+    TEST_ASSERT_EQ(2, r_data->vt[0], "Frames in order should rebuild the counter");
+    
+    compressed_destroy(&sender);
+    compressed_destroy(&receiver);
+    return 1;
+}
+
+static int test_compressed_value_delta_after_eviction() {
+    compressed_set_max_destinations(1);
+    compressed_set_value_deltas(1);
+    Timestamp sender = compressed_create(8, 0, CLOCK_COMPRESSED);
+    Timestamp receiver = compressed_create(8, 1, CLOCK_COMPRESSED);
+    compressed_set_value_deltas(0);
+    compressed_set_max_destinations(0);
+    int buffer[8];
+    
+    for (int i = 0; i < 5; i++) compressed_increment(&sender);
+    size_t size = compressed_serialize_for_dest(&sender, 1, buffer, sizeof(buffer));
+    compressed_deserialize(&receiver, buffer, size);
+    
+    // Sending to 2 evicts 1, so 1's next frame restarts the channel against zeros
+    compressed_serialize_for_dest(&sender, 2, buffer, sizeof(buffer));
+    compressed_increment(&sender);
+    size = compressed_serialize_for_dest(&sender, 1, buffer, sizeof(buffer));
+    TEST_ASSERT(compressed_is_value_delta(buffer, size), "Evicted destination should still get a frame");
+    compressed_deserialize(&receiver, buffer, size);
+    TEST_ASSERT_EQ(TS_EQUAL, compressed_compare(&sender, &receiver), "Restarted channel should rebuild exactly");
+    
+    compressed_increment(&sender);
+    size = compressed_serialize_for_dest(&sender, 1, buffer, sizeof(buffer));
+    compressed_deserialize(&receiver, buffer, size);
+    TEST_ASSERT_EQ(TS_EQUAL, compressed_compare(&sender, &receiver), "Channel should continue after the restart");
+    
     compressed_destroy(&sender);
     compressed_destroy(&receiver);
     return 1;
@@ -416,7 +693,22 @@ int main() {
     printf("\n--- Compression Algorithm Tests ---\n");
     RUN_TEST(test_compressed_serialize_for_dest_basic);
     RUN_TEST(test_compressed_serialize_for_dest_multiple_changes);
+    RUN_TEST(test_compressed_serialize_for_dest_runs);
     RUN_TEST(test_compressed_serialize_for_dest_first_send);
+    RUN_TEST(test_compressed_encodings_roundtrip);
+    RUN_TEST(test_compressed_malformed_delta_ignored);
+    
+    // Destination Tracking Tests
+    printf("\n--- Value-Delta Tests ---\n");
+    RUN_TEST(test_compressed_value_delta_roundtrip);
+    RUN_TEST(test_compressed_value_delta_out_of_sequence_ignored);
+    RUN_TEST(test_compressed_value_delta_after_eviction);
+    
+    // Destination Tracking Tests
+    printf("\n--- Destination Tracking Tests ---\n");
+    RUN_TEST(test_compressed_lazy_tau_rows);
+    RUN_TEST(test_compressed_lru_eviction);
+    RUN_TEST(test_compressed_dirty_bits_match_scan);
     
     // Merge Tests
     printf("\n--- Merge Tests ---\n");
@@ -0,0 +1,500 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "counter_store.h"
+#include "clock_arena.h"
+#include "timestamp.h"
+#include "standard_clock.h"
+
+/* ---------- Test Framework ---------- */
+
+typedef struct {
+    int tests_run;
+    int tests_passed;
+    int tests_failed;
+    char current_test[256];
+} TestStats;
+
+static TestStats g_stats = {0};
+
+#define TEST_ASSERT(condition, message) do { \
+    if (!(condition)) { \
+        printf("FAIL: %s - %s\n", g_stats.current_test, message); \
+        g_stats.tests_failed++; \
+        return 0; \
+    } \
+} while(0)
+
+#define TEST_ASSERT_EQ(expected, actual, message) do { \
+    if ((expected) != (actual)) { \
+        printf("FAIL: %s - %s (expected: %d, actual: %d)\n", \
+               g_stats.current_test, message, (int)(expected), (int)(actual)); \
+        g_stats.tests_failed++; \
+        return 0; \
+    } \
+} while(0)
+
+#define RUN_TEST(test_func) do { \
+    snprintf(g_stats.current_test, sizeof(g_stats.current_test), #test_func); \
+    g_stats.tests_run++; \
+    if (test_func()) { \
+        printf("PASS: %s\n", #test_func); \
+        g_stats.tests_passed++; \
+    } \
+} while(0)
+
+/* ---------- Helpers ---------- */
+
+static const int widths[] = {1, 2, 4, 8};
+
+// Fills an n-entry vector of the given width with a pattern that fits it
+static void fill(void *cells, int width, int n, int seed) {
+    for (int i = 0; i < n; i++) {
+        counter_set(cells, width, i, (uint64_t)((i * 7 + seed) % 100));
+    }
+}
+
+// Digest of n counters from scratch
+static ClockDigest digest_of(const void *cells, int width, int n) {
+    ClockDigest d;
+    clock_digest_reset(&d);
+    for (int i = 0; i < n; i++) {
+        uint64_t v = counter_get(cells, width, i);
+        if (v) clock_digest_raise(&d, i, 0, v);
+    }
+    return d;
+}
+
+static int same_digest(ClockDigest a, ClockDigest b) {
+    return a.sum == b.sum && a.max == b.max && a.hash == b.hash;
+}
+
+static int width_of(const Timestamp *ts) {
+    return ((const StandardClockData*)ts->data)->width;
+}
+
+/* ---------- Kernel Tests ---------- */
+
+static int test_width_for() {
+    TEST_ASSERT_EQ(1, counter_width_for(0), "0 fits a byte");
+    TEST_ASSERT_EQ(1, counter_width_for(UINT8_MAX), "255 fits a byte");
+    TEST_ASSERT_EQ(2, counter_width_for(UINT8_MAX + 1), "256 needs 16 bits");
+    TEST_ASSERT_EQ(4, counter_width_for(UINT16_MAX + 1), "65536 needs 32 bits");
+    TEST_ASSERT_EQ(4, counter_width_for(INT32_MAX), "INT32_MAX fits 32 bits");
+    TEST_ASSERT_EQ(8, counter_width_for((uint64_t)INT32_MAX + 1), "32-bit cells stay valid ints");
+    TEST_ASSERT_EQ(8, counter_width_for((uint64_t)UINT32_MAX + 1), "2^32 needs 64 bits");
+    return 1;
+}
+
+static int test_copy_between_widths() {
+    uint64_t src[70], wide[70], back[70];
+    for (int s = 0; s < 4; s++) {
+        for (int d = 0; d < 4; d++) {
+            fill(src, widths[s], 70, s);
+            counter_copy(wide, widths[d], src, widths[s], 70);
+            counter_copy(back, widths[s], wide, widths[d], 70);
+            for (int i = 0; i < 70; i++) {
+                TEST_ASSERT(counter_get(back, widths[s], i) == counter_get(src, widths[s], i),
+                            "Copy should preserve values across widths");
+            }
+        }
+    }
+    return 1;
+}
+
+static int test_compare_all_width_pairs() {
+    // 130 entries crosses the 64-entry early-exit blocks
+    uint64_t a[130], b[130];
+    for (int x = 0; x < 4; x++) {
+        for (int y = 0; y < 4; y++) {
+            fill(a, widths[x], 130, 3);
+            fill(b, widths[y], 130, 3);
+            TEST_ASSERT_EQ(TS_EQUAL, counter_compare(a, widths[x], b, widths[y], 130), "Same values are equal");
+            
+            counter_set(b, widths[y], 129, counter_get(b, widths[y], 129) + 1);
+            TEST_ASSERT_EQ(TS_BEFORE, counter_compare(a, widths[x], b, widths[y], 130), "Last entry decides");
+            TEST_ASSERT_EQ(TS_AFTER, counter_compare(b, widths[y], a, widths[x], 130), "Reverse should be after");
+            
+            counter_set(a, widths[x], 0, counter_get(a, widths[x], 0) + 1);
+            TEST_ASSERT_EQ(TS_CONCURRENT, counter_compare(a, widths[x], b, widths[y], 130), "Should be concurrent");
+        }
+    }
+    return 1;
+}
+
+static int test_merge_kernels() {
+    for (int w = 0; w < 4; w++) {
+        uint64_t dst[20];
+        int32_t src32[20];
+        uint64_t src64[20];
+        fill(dst, widths[w], 20, 0);
+        for (int i = 0; i < 20; i++) {
+            src32[i] = i % 2 ? 99 : -5;
+            src64[i] = i % 3 ? 0 : 100;
+        }
+        
+        ClockDigest digest = digest_of(dst, widths[w], 20);
+        counter_merge_i32(dst, widths[w], src32, 20, &digest);
+        counter_merge_u64(dst, widths[w], src64, 20, &digest);
+        for (int i = 0; i < 20; i++) {
+            uint64_t expected = (uint64_t)((i * 7) % 100);
+            if (i % 2 && expected < 99) expected = 99;
+            if (i % 3 == 0 && expected < 100) expected = 100;
+            TEST_ASSERT(counter_get(dst, widths[w], i) == expected, "Merge should take the entrywise max");
+        }
+        TEST_ASSERT(same_digest(digest_of(dst, widths[w], 20), digest), "Merge should raise the digest");
+    }
+    return 1;
+}
+
+static int test_merge_32bit_blocks() {
+    // 32-bit cells go through vk_merge_max in 1024-entry blocks: growth in the first and
+    // last blocks only, values up to INT32_MAX, negative entries ignored
+    enum { N = 2600 };
+    uint32_t cells[N];
+    uint64_t wide[N];
+    int32_t src[N];
+    fill(cells, 4, N, 1);
+    fill(wide, 8, N, 1);
+    for (int i = 0; i < N; i++) {
+        src[i] = i % 5 == 0 ? -1 : 0;
+        if (i < 1024 && i % 3 == 0) src[i] = 1000 + i;
+        if (i >= 2048 && i % 7 == 0) src[i] = INT32_MAX - i;
+    }
+    
+    ClockDigest digest = digest_of(cells, 4, N);
+    ClockDigest wide_digest = digest_of(wide, 8, N);
+    counter_merge_i32(cells, 4, src, N, &digest);
+    counter_merge_i32(wide, 8, src, N, &wide_digest);
+    for (int i = 0; i < N; i++) {
+        TEST_ASSERT(counter_get(cells, 4, i) == wide[i], "32-bit merge should match the 64-bit one");
+    }
+    TEST_ASSERT(same_digest(digest_of(cells, 4, N), digest), "Merge should raise the digest");
+    TEST_ASSERT(same_digest(wide_digest, digest), "Both widths should raise alike");
+    TEST_ASSERT_EQ(TS_EQUAL, counter_compare(cells, 4, wide, 8, N), "Mixed widths should compare equal");
+    return 1;
+}
+
+typedef struct {
+    int n;
+    uint64_t (*max)(const void *cells, int width);
+    void (*copy)(void *dst, int dst_width, const void *src, int src_width);
+    void (*merge_i32)(void *dst, int dst_width, const int32_t *src, ClockDigest *digest);
+    TSOrder (*compare)(const void *a, int a_width, const void *b, int b_width);
+} FixedKernels;
+
+#define FIXED_KERNELS_ENTRY(N) \
+    {N, counter_max_##N, counter_copy_##N, counter_merge_i32_##N, counter_compare_##N},
+static const FixedKernels fixed_kernels[] = { FOR_EACH_FIXED_N(FIXED_KERNELS_ENTRY) };
+#define FIXED_KERNEL_SETS ((int)(sizeof(fixed_kernels) / sizeof(fixed_kernels[0])))
+
+static int test_fixed_n_kernels_match() {
+    uint64_t a[64], b[64], fixed[64], generic[64];
+    int32_t src[64];
+    for (int f = 0; f < FIXED_KERNEL_SETS; f++) {
+        const FixedKernels *k = &fixed_kernels[f];
+        int n = k->n;
+        for (int x = 0; x < 4; x++) {
+            fill(a, widths[x], n, x);
+            TEST_ASSERT(k->max(a, widths[x]) == counter_max(a, widths[x], n), "Max should match");
+            for (int y = 0; y < 4; y++) {
+                fill(b, widths[y], n, x);
+                TEST_ASSERT_EQ(counter_compare(a, widths[x], b, widths[y], n),
+                               k->compare(a, widths[x], b, widths[y]), "Equal compare should match");
+                counter_set(b, widths[y], n - 1, counter_get(b, widths[y], n - 1) + 1);
+                TEST_ASSERT_EQ(TS_BEFORE, k->compare(a, widths[x], b, widths[y]), "Last entry decides");
+                counter_set(a, widths[x], 0, counter_get(a, widths[x], 0) + 1);
+                TEST_ASSERT_EQ(TS_CONCURRENT, k->compare(a, widths[x], b, widths[y]), "Should be concurrent");
+                counter_set(a, widths[x], 0, counter_get(a, widths[x], 0) - 1);
+                
+                k->copy(fixed, widths[y], a, widths[x]);
+                counter_copy(generic, widths[y], a, widths[x], n);
+                TEST_ASSERT(memcmp(fixed, generic, (size_t)n * widths[y]) == 0, "Copy should match");
+            }
+            
+            for (int i = 0; i < n; i++) src[i] = i % 3 ? (i * 13) % 90 : -1;
+            memcpy(fixed, a, (size_t)n * widths[x]);
+            memcpy(generic, a, (size_t)n * widths[x]);
+            ClockDigest fixed_digest = digest_of(a, widths[x], n);
+            ClockDigest generic_digest = fixed_digest;
+            k->merge_i32(fixed, widths[x], src, &fixed_digest);
+            counter_merge_i32(generic, widths[x], src, n, &generic_digest);
+            TEST_ASSERT(memcmp(fixed, generic, (size_t)n * widths[x]) == 0, "Merge should match");
+            TEST_ASSERT(same_digest(digest_of(fixed, widths[x], n), fixed_digest), "Digests should match");
+            TEST_ASSERT(same_digest(generic_digest, fixed_digest), "Digests should match");
+        }
+    }
+    return 1;
+}
+
+/* ---------- Standard Clock Tests ---------- */
+
+static int test_promotes_in_arena() {
+    ClockArena arena;
+    clock_arena_init(&arena, 0);
+    Timestamp ts = ts_create_in(&arena, 4, 1, CLOCK_STANDARD);
+    
+    for (int i = 0; i < 255; i++) ts_increment(&ts);
+    TEST_ASSERT_EQ(1, width_of(&ts), "255 events should still fit a byte");
+    
+    ts_increment(&ts);
+    TEST_ASSERT_EQ(2, width_of(&ts), "The 256th event should promote to 16 bits");
+    TEST_ASSERT(standard_get(&ts, 1) == 256, "Counter should survive promotion");
+    TEST_ASSERT(clock_block_arena(ts.data) == &arena, "Promoted block should stay in the arena");
+    TEST_ASSERT_EQ(1, (int)arena.live_blocks, "The narrow block should be returned");
+    
+    ts_destroy(&ts);
+    clock_arena_release(&arena);
+    return 1;
+}
+
+static int test_merge_promotes() {
+    Timestamp a = ts_create(4, 0, CLOCK_STANDARD);
+    Timestamp b = ts_create(4, 1, CLOCK_STANDARD);
+    int v[4] = {0, 70000, 3, 0};
+    
+    ts_merge(&a, v, sizeof(v));
+    TEST_ASSERT_EQ(4, width_of(&a), "Merging 70000 should promote to 32 bits");
+    
+    uint8_t buffer[64];
+    size_t size = ts_serialize(&a, buffer, sizeof(buffer));
+    TEST_ASSERT_EQ(4 * (int)sizeof(int), (int)size, "Counters below INT32_MAX serialize as ints");
+    ts_merge(&b, buffer, size);
+    TEST_ASSERT_EQ(TS_EQUAL, ts_compare(&a, &b), "Merged copy should equal the source");
+    
+    ts_destroy(&a);
+    ts_destroy(&b);
+    return 1;
+}
+
+static int test_64bit_raw_round_trip() {
+    const uint64_t big = (uint64_t)1 << 40;
+    uint64_t v[4] = {5, big, 0, big + 1};
+    Timestamp a = ts_create(4, 0, CLOCK_STANDARD);
+    ts_deserialize(&a, v, sizeof(v));
+    TEST_ASSERT_EQ(8, width_of(&a), "2^40 should need 64 bits");
+    TEST_ASSERT(standard_get(&a, 3) == big + 1, "Deserialize should keep the full value");
+    
+    uint8_t buffer[64];
+    size_t size = ts_serialize(&a, buffer, sizeof(buffer));
+    TEST_ASSERT_EQ(4 * (int)sizeof(uint64_t), (int)size, "Counters past INT32_MAX serialize as uint64_t");
+    
+    Timestamp b = ts_create(4, 2, CLOCK_STANDARD);
+    ts_increment(&b);
+    ts_merge(&b, buffer, size);
+    TEST_ASSERT(standard_get(&b, 1) == big, "Merge should carry 64-bit counters");
+    TEST_ASSERT_EQ(TS_BEFORE, ts_compare(&a, &b), "Receiver should follow the sender");
+    
+    ts_increment(&a);
+    TEST_ASSERT(standard_get(&a, 0) == 6, "Increment should work at 64 bits");
+    
+    char text[128];
+    ts_to_string(&a, text, sizeof(text));
+    TEST_ASSERT(strcmp(text, "[6,1099511627776,0,1099511627777]") == 0, "to_string should print 64-bit values");
+    
+    ts_destroy(&a);
+    ts_destroy(&b);
+    return 1;
+}
+
+static int test_64bit_compact_round_trip() {
+    const uint64_t big = (uint64_t)3 << 33;
+    uint64_t v[6] = {0, 0, big, 0, 0, 9};
+    Timestamp a = ts_create(6, 0, CLOCK_STANDARD);
+    ts_deserialize(&a, v, sizeof(v));
+    ts_set_wire_format(&a, WIRE_COMPACT);
+    
+    uint8_t buffer[128];
+    size_t size = ts_serialize(&a, buffer, sizeof(buffer));
+    TEST_ASSERT(size < sizeof(v), "Compact frame should be smaller than the raw vector");
+    
+    Timestamp b = ts_create(6, 1, CLOCK_STANDARD);
+    ts_set_wire_format(&b, WIRE_COMPACT);
+    ts_deserialize(&b, buffer, size);
+    TEST_ASSERT_EQ(TS_EQUAL, ts_compare(&a, &b), "Compact round trip should keep 64-bit counters");
+    TEST_ASSERT(standard_get(&b, 2) == big, "Decoded counter should be exact");
+    
+    ts_destroy(&a);
+    ts_destroy(&b);
+    return 1;
+}
+
+static int test_64bit_to_vector() {
+    const uint64_t big = (uint64_t)1 << 35;
+    uint64_t v[3] = {1, big, 2};
+    Timestamp a = ts_create(3, 0, CLOCK_STANDARD);
+    ts_deserialize(&a, v, sizeof(v));
+    
+    uint64_t out[3];
+    standard_to_vector64(&a, out);
+    TEST_ASSERT(memcmp(v, out, sizeof(v)) == 0, "to_vector64 should return the full counters");
+    TEST_ASSERT(!standard_fits_int32(&a), "2^35 should not fit an int");
+    
+    ts_destroy(&a);
+    return 1;
+}
+
+// Receives of uint64_t vectors, deferred and eager, should end at the same clock
+static int deferred_wide_matches_eager(uint64_t own) {
+    const uint64_t big = (uint64_t)5 << 32;
+    uint64_t m1[4] = {0, big, 7, own};
+    uint64_t m2[4] = {3, 1, big + 9, 0};
+    int32_t narrow[4] = {4, 2, 1, 0};
+    
+    Timestamp eager = ts_create(4, 0, CLOCK_STANDARD);
+    Timestamp lazy = ts_create(4, 0, CLOCK_STANDARD);
+    ts_set_deferred(&lazy, 1);
+    for (int round = 0; round < 2; round++) {
+        Timestamp *ts = round ? &lazy : &eager;
+        ts_increment(ts);
+        ts_merge_and_tick(ts, m1, sizeof(m1));
+        ts_merge_and_tick(ts, narrow, sizeof(narrow));
+        ts_increment(ts);
+        ts_merge_and_tick(ts, m2, sizeof(m2));
+    }
+    
+    int same = ts_compare(&eager, &lazy) == TS_EQUAL;
+    ts_destroy(&eager);
+    ts_destroy(&lazy);
+    return same;
+}
+
+static int test_64bit_deferred_receive() {
+    TEST_ASSERT(deferred_wide_matches_eager(0), "Wide vectors should be gathered");
+    // Entry 3 past INT_MAX too; the own entry (pid 0) stays small
+    TEST_ASSERT(deferred_wide_matches_eager((uint64_t)1 << 33), "Wide non-own entries should be gathered");
+    
+    // An own entry past INT_MAX is merged in order
+    uint64_t m[2] = {(uint64_t)1 << 32, 1};
+    Timestamp eager = ts_create(2, 0, CLOCK_STANDARD);
+    Timestamp lazy = ts_create(2, 0, CLOCK_STANDARD);
+    ts_set_deferred(&lazy, 1);
+    ts_increment(&eager);
+    ts_increment(&lazy);
+    ts_merge_and_tick(&eager, m, sizeof(m));
+    ts_merge_and_tick(&lazy, m, sizeof(m));
+    TEST_ASSERT_EQ(TS_EQUAL, ts_compare(&eager, &lazy), "Wide own entry should be merged in order");
+    TEST_ASSERT(standard_get(&lazy, 0) == ((uint64_t)1 << 32) + 1, "Own entry should take the receive tick");
+    
+    ts_destroy(&eager);
+    ts_destroy(&lazy);
+    return 1;
+}
+
+static int test_fixed_n_binding() {
+    Timestamp fixed = ts_create(8, 0, CLOCK_STANDARD);
+    Timestamp other = ts_create(5, 0, CLOCK_STANDARD);
+    TEST_ASSERT(fixed.ops == standard_specialize(8), "n = 8 should bind the fixed-n table");
+    TEST_ASSERT(other.ops == &STANDARD_OPS, "n = 5 should keep the generic table");
+    TEST_ASSERT(standard_specialize(5) == NULL, "There is no table for n = 5");
+    
+    Timestamp copy = ts_clone(&fixed);
+    TEST_ASSERT(copy.ops == fixed.ops, "Clones should keep the bound table");
+    
+    ts_set_fixed_kernels(0);
+    Timestamp generic = ts_create(8, 0, CLOCK_STANDARD);
+    ts_set_fixed_kernels(1);
+    TEST_ASSERT(generic.ops == &STANDARD_OPS, "Disabled fixed kernels should bind the generic table");
+    
+    ts_destroy(&fixed);
+    ts_destroy(&other);
+    ts_destroy(&copy);
+    ts_destroy(&generic);
+    return 1;
+}
+
+static int test_fixed_n_matches_generic() {
+    // The same traffic on fixed-n and generic clocks, through every width
+    enum { N = 16 };
+    Timestamp fixed[N], generic[N];
+    unsigned int seed = 11;
+    ts_set_fixed_kernels(0);
+    for (int i = 0; i < N; i++) generic[i] = ts_create(N, i, CLOCK_STANDARD);
+    ts_set_fixed_kernels(1);
+    for (int i = 0; i < N; i++) fixed[i] = ts_create(N, i, CLOCK_STANDARD);
+    
+    uint64_t wide[N] = {0};
+    wide[3] = (uint64_t)1 << 33;
+    int32_t jump[N] = {0};
+    jump[5] = 70000;
+    
+    for (int op = 0; op < 3000; op++) {
+        int p = rand_r(&seed) % N;
+        int q = rand_r(&seed) % N;
+        ts_increment(&fixed[p]);
+        ts_increment(&generic[p]);
+        if (op == 1000) {
+            ts_merge(&fixed[p], jump, sizeof(jump));
+            ts_merge(&generic[p], jump, sizeof(jump));
+        }
+        if (op == 2000) {
+            ts_merge(&fixed[p], wide, sizeof(wide));
+            ts_merge(&generic[p], wide, sizeof(wide));
+        }
+        
+        uint64_t a[N], b[N];
+        size_t a_size = ts_serialize(&fixed[p], a, sizeof(a));
+        size_t b_size = ts_serialize(&generic[p], b, sizeof(b));
+        TEST_ASSERT(a_size == b_size && memcmp(a, b, a_size) == 0, "Serializations should match");
+        ts_merge_and_tick(&fixed[q], a, a_size);
+        ts_merge_and_tick(&generic[q], b, b_size);
+        TEST_ASSERT_EQ(ts_compare(&generic[p], &generic[q]), ts_compare(&fixed[p], &fixed[q]),
+                       "Orders should match");
+    }
+    int widest = 0;
+    for (int i = 0; i < N; i++) {
+        if (width_of(&fixed[i]) > widest) widest = width_of(&fixed[i]);
+    }
+    TEST_ASSERT_EQ(8, widest, "Traffic should have reached 64-bit counters");
+    
+    for (int i = 0; i < N; i++) {
+        const StandardClockData *data = (const StandardClockData*)fixed[i].data;
+        TEST_ASSERT(standard_get(&fixed[i], i) == standard_get(&generic[i], i), "Counters should match");
+        TEST_ASSERT(same_digest(digest_of(data->cells, data->width, N), fixed[i].digest),
+                    "64-bit counters should keep the digest exact");
+        TEST_ASSERT(ts_hash(&fixed[i]) == ts_hash(&generic[i]), "Equal clocks should hash equally");
+        ts_destroy(&fixed[i]);
+        ts_destroy(&generic[i]);
+    }
+    return 1;
+}
+
+/* ---------- Test Runner ---------- */
+
+static void print_test_summary() {
+    printf("\n=== Test Summary ===\n");
+    printf("Tests run: %d\n", g_stats.tests_run);
+    printf("Tests passed: %d\n", g_stats.tests_passed);
+    printf("Tests failed: %d\n", g_stats.tests_failed);
+    printf("Success rate: %.1f%%\n", 
+           g_stats.tests_run > 0 ? (100.0 * g_stats.tests_passed / g_stats.tests_run) : 0.0);
+}
+
+int main() {
+    printf("=== Counter Store Test Suite ===\n\n");
+    
+    // Kernel Tests
+    printf("--- Kernel Tests ---\n");
+    RUN_TEST(test_width_for);
+    RUN_TEST(test_copy_between_widths);
+    RUN_TEST(test_compare_all_width_pairs);
+    RUN_TEST(test_merge_kernels);
+    RUN_TEST(test_merge_32bit_blocks);
+    RUN_TEST(test_fixed_n_kernels_match);
+    
+    // Standard Clock Tests
+    printf("\n--- Standard Clock Tests ---\n");
+    RUN_TEST(test_promotes_in_arena);
+    RUN_TEST(test_merge_promotes);
+    RUN_TEST(test_64bit_raw_round_trip);
+    RUN_TEST(test_64bit_compact_round_trip);
+    RUN_TEST(test_64bit_to_vector);
+    RUN_TEST(test_64bit_deferred_receive);
+    RUN_TEST(test_fixed_n_binding);
+    RUN_TEST(test_fixed_n_matches_generic);
+    
+    print_test_summary();
+    
+    return g_stats.tests_failed > 0 ? 1 : 0;
+}
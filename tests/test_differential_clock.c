@@ -57,7 +57,6 @@ static int test_differential_create() {
     TEST_ASSERT(data->v != NULL, "Vector array should not be NULL");
     TEST_ASSERT(data->LS != NULL, "LS array should not be NULL");
     TEST_ASSERT(data->LU != NULL, "LU array should not be NULL");
-    TEST_ASSERT(data->local_clock == 0, "Local clock should be initialized to 0");
     
     // Check initial values
     for (int i = 0; i < 3; i++) {
@@ -115,7 +114,7 @@ static int test_differential_clone() {
         TEST_ASSERT_EQ(orig_data->LS[i], clone_data->LS[i], "LS values should match");
         TEST_ASSERT_EQ(orig_data->LU[i], clone_data->LU[i], "LU values should match");
     }
-    TEST_ASSERT_EQ(orig_data->local_clock, clone_data->local_clock, "Local clock should match");
+    TEST_ASSERT_EQ(orig_data->newest, clone_data->newest, "Update order should match");
     
     differential_destroy(&original);
     differential_destroy(&clone);
@@ -130,19 +129,16 @@ static int test_differential_increment() {
     
     // Initial state
     TEST_ASSERT_EQ(0, data->v[1], "Initial v[1] should be 0");
-    TEST_ASSERT_EQ(0, data->local_clock, "Initial local_clock should be 0");
     TEST_ASSERT_EQ(0, data->LU[1], "Initial LU[1] should be 0");
     
     // First increment
     differential_increment(&ts);
     TEST_ASSERT_EQ(1, data->v[1], "After increment, v[1] should be 1");
-    TEST_ASSERT_EQ(1, data->local_clock, "After increment, local_clock should be 1");
     TEST_ASSERT_EQ(1, data->LU[1], "After increment, LU[1] should be 1");
     
     // Second increment
     differential_increment(&ts);
     TEST_ASSERT_EQ(2, data->v[1], "After second increment, v[1] should be 2");
-    TEST_ASSERT_EQ(2, data->local_clock, "After second increment, local_clock should be 2");
     TEST_ASSERT_EQ(2, data->LU[1], "After second increment, LU[1] should be 2");
     
     // Other processes should remain unchanged
@@ -185,7 +181,6 @@ static int test_differential_merge_full_vector() {
     
     // Set up initial state
     data->v[1] = 2;
-    data->local_clock = 2;
     data->LU[1] = 2;
     
     // Create other vector to merge
@@ -194,15 +189,14 @@ static int test_differential_merge_full_vector() {
     differential_merge(&ts, other_vector, 3 * sizeof(int));
     
     // After merge: local clock should increment, then merge
-    TEST_ASSERT_EQ(3, data->local_clock, "Local clock should increment to 3");
     TEST_ASSERT_EQ(3, data->v[1], "v[1] should increment to 3");
     TEST_ASSERT_EQ(5, data->v[0], "v[0] should be updated to 5");
     TEST_ASSERT_EQ(3, data->v[2], "v[2] should be updated to 3");
     
     // LU should be updated for changed components
-    TEST_ASSERT_EQ(3, data->LU[0], "LU[0] should be updated to local_clock");
-    TEST_ASSERT_EQ(3, data->LU[1], "LU[1] should be updated to local_clock");
-    TEST_ASSERT_EQ(3, data->LU[2], "LU[2] should be updated to local_clock");
+    TEST_ASSERT_EQ(3, data->LU[0], "LU[0] should be updated to v[pid]");
+    TEST_ASSERT_EQ(3, data->LU[1], "LU[1] should be updated to v[pid]");
+    TEST_ASSERT_EQ(3, data->LU[2], "LU[2] should be updated to v[pid]");
     
     differential_destroy(&ts);
     return 1;
@@ -214,7 +208,6 @@ static int test_differential_merge_differential_format() {
     
     // Set up initial state
     data->v[1] = 2;
-    data->local_clock = 2;
     data->LU[1] = 2;
     
     // Create differential format: [(process_id, value), ...]
@@ -223,7 +216,6 @@ static int test_differential_merge_differential_format() {
     differential_merge(&ts, differential_data, 4 * sizeof(int));
     
     // Check results
-    TEST_ASSERT_EQ(3, data->local_clock, "Local clock should increment to 3");
     TEST_ASSERT_EQ(3, data->v[1], "v[1] should increment to 3");
     TEST_ASSERT_EQ(5, data->v[0], "v[0] should be updated to 5");
     TEST_ASSERT_EQ(3, data->v[2], "v[2] should be updated to 3");
@@ -264,7 +256,6 @@ static int test_differential_serialize_for_dest() {
     data->v[0] = 5;
     data->v[1] = 2;
     data->v[2] = 3;
-    data->local_clock = 2;
     data->LU[0] = 1;
     data->LU[1] = 2;
     data->LU[2] = 1;
@@ -274,16 +265,113 @@ static int test_differential_serialize_for_dest() {
     int buffer[6]; // Enough for 3 pairs
     size_t required = differential_serialize_for_dest(&ts, 0, buffer, sizeof(buffer));
     
-    // Should send: (0,5), (1,2), (2,3) because LS[0]=0 < LU[all] and process 1 is always included
-    TEST_ASSERT_EQ(6 * sizeof(int), required, "Should send 3 pairs (6 ints)");
+    // (0,5), (1,2), (2,3) are due because LS[0]=0 < LU[all]; three pairs are no shorter
+    // than the vector, so the full vector goes instead
+    TEST_ASSERT_EQ(3 * sizeof(int), required, "Should send the full vector (3 ints)");
+    TEST_ASSERT(memcmp(buffer, data->v, 3 * sizeof(int)) == 0, "Should carry the vector");
     
     // Check LS update
-    TEST_ASSERT_EQ(2, data->LS[0], "LS[0] should be updated to local_clock");
+    TEST_ASSERT_EQ(2, data->LS[0], "LS[0] should be updated to v[pid]");
     
     differential_destroy(&ts);
     return 1;
 }
 
+static int test_differential_update_order_matches_scan() {
+    // Random traffic among 24 processes; every send must carry exactly the entries a full
+    // scan for LS[dest] < LU[k] (plus the sender's own entry) would pick, in pid order
+    enum { N = 24 };
+    Timestamp procs[N];
+    unsigned int seed = 7;
+    for (int i = 0; i < N; i++) {
+        procs[i] = differential_create(N, i, CLOCK_DIFFERENTIAL);
+    }
+    
+    for (int op = 0; op < 2000; op++) {
+        int p = rand_r(&seed) % N;
+        int q = rand_r(&seed) % N;
+        differential_increment(&procs[p]);
+        if (p == q) continue;
+        
+        DifferentialClockData *data = (DifferentialClockData*)procs[p].data;
+        int expected[2 * N], count = 0;
+        for (int k = 0; k < N; k++) {
+            if (data->LS[q] < data->LU[k] || k == p) {
+                expected[count++] = k;
+                expected[count++] = data->v[k];
+            }
+        }
+        
+        if (count >= N) {
+            // As many pairs as the vector has entries: the vector is sent instead
+            memcpy(expected, data->v, N * sizeof(int));
+            count = N;
+        }
+        
+        int buffer[2 * N];
+        size_t size = differential_serialize_for_dest(&procs[p], q, buffer, sizeof(buffer));
+        TEST_ASSERT_EQ(count * sizeof(int), size, "Send should carry the scanned entry count");
+        TEST_ASSERT(memcmp(expected, buffer, size) == 0, "Send should carry the scanned entries in pid order");
+        differential_merge(&procs[q], buffer, size);
+    }
+    
+    for (int i = 0; i < N; i++) {
+        differential_destroy(&procs[i]);
+    }
+    return 1;
+}
+
+static int test_differential_half_vector_send() {
+    // n/2 due entries would make a pair list exactly n ints long, the size of the full
+    // vector; every receiver must still see the sender's counters, not pids as values
+    const int sizes[] = {4, 8, 64};
+    for (int s = 0; s < (int)(sizeof(sizes) / sizeof(sizes[0])); s++) {
+        int n = sizes[s];
+        Timestamp sender = differential_create(n, 0, CLOCK_DIFFERENTIAL);
+        Timestamp receiver = differential_create(n, n - 1, CLOCK_DIFFERENTIAL);
+        Timestamp settled = differential_create(n, n - 1, CLOCK_DIFFERENTIAL);
+        DifferentialClockData *data = (DifferentialClockData*)sender.data;
+        
+        // The sender learns entries 1 .. n/2 - 1 at values above any pid; with its own
+        // entry that makes n/2 entries due to n - 1
+        int incoming[128], m = 0;
+        for (int k = 1; k < n / 2; k++) {
+            incoming[m++] = k;
+            incoming[m++] = 1000 + k;
+        }
+        differential_merge(&sender, incoming, m * sizeof(int));
+        
+        int buffer[128];
+        size_t size = differential_serialize_for_dest(&sender, n - 1, buffer, sizeof(buffer));
+        TEST_ASSERT_EQ(n * sizeof(int), size, "n/2 entries should go as the full vector");
+        TEST_ASSERT(memcmp(buffer, data->v, size) == 0, "Message should be the vector itself");
+        
+        differential_merge(&receiver, buffer, size);
+        differential_deserialize(&settled, buffer, size);
+        const DifferentialClockData *r = (const DifferentialClockData*)receiver.data;
+        const DifferentialClockData *d = (const DifferentialClockData*)settled.data;
+        for (int k = 0; k < n - 1; k++) {
+            TEST_ASSERT_EQ(data->v[k], r->v[k], "Merge should take the sender's counters");
+            TEST_ASSERT_EQ(data->v[k], d->v[k], "Deserialize should take the sender's counters");
+        }
+        
+        // One entry fewer goes as pairs again
+        m = 0;
+        for (int k = 1; k < n / 2 - 1; k++) {
+            incoming[m++] = k;
+            incoming[m++] = 2000 + k;
+        }
+        differential_merge(&sender, incoming, m * sizeof(int));
+        size = differential_serialize_for_dest(&sender, n - 1, buffer, sizeof(buffer));
+        TEST_ASSERT_EQ((n / 2 - 1) * 2 * sizeof(int), size, "n/2 - 1 entries should go as pairs");
+        
+        differential_destroy(&sender);
+        differential_destroy(&receiver);
+        differential_destroy(&settled);
+    }
+    return 1;
+}
+
 /* ---------- Comparison Tests ---------- */
 
 static int test_differential_compare() {
@@ -373,6 +461,88 @@ static int test_differential_edge_cases() {
     return 1;
 }
 
+/* ---------- Fixed-n Tests ---------- */
+
+static int test_differential_fixed_n_matches_generic() {
+    // Mixed full-vector and per-destination sends on fixed-n and generic clocks
+    enum { N = 32 };
+    Timestamp fixed[N], generic[N];
+    unsigned int seed = 5;
+    ts_set_fixed_kernels(0);
+    for (int i = 0; i < N; i++) generic[i] = ts_create(N, i, CLOCK_DIFFERENTIAL);
+    ts_set_fixed_kernels(1);
+    for (int i = 0; i < N; i++) fixed[i] = ts_create(N, i, CLOCK_DIFFERENTIAL);
+    TEST_ASSERT(fixed[0].ops == differential_specialize(N), "n = 32 should bind the fixed-n table");
+    TEST_ASSERT(generic[0].ops == &DIFFERENTIAL_OPS, "Generic clocks should keep the generic table");
+    
+    for (int op = 0; op < 3000; op++) {
+        int p = rand_r(&seed) % N;
+        int q = rand_r(&seed) % N;
+        ts_increment(&fixed[p]);
+        ts_increment(&generic[p]);
+        if (p == q) continue;
+        
+        int a[2 * N], b[2 * N];
+        size_t a_size, b_size;
+        if (op % 3) {
+            a_size = ts_serialize_for_dest(&fixed[p], q, a, sizeof(a));
+            b_size = ts_serialize_for_dest(&generic[p], q, b, sizeof(b));
+        } else {
+            a_size = ts_serialize(&fixed[p], a, sizeof(a));
+            b_size = ts_serialize(&generic[p], b, sizeof(b));
+        }
+        TEST_ASSERT(a_size == b_size && memcmp(a, b, a_size) == 0, "Sends should match");
+        ts_merge_and_tick(&fixed[q], a, a_size);
+        ts_merge_and_tick(&generic[q], b, b_size);
+        TEST_ASSERT_EQ(ts_compare(&generic[p], &generic[q]), ts_compare(&fixed[p], &fixed[q]),
+                       "Orders should match");
+    }
+    
+    for (int i = 0; i < N; i++) {
+        const DifferentialClockData *x = (const DifferentialClockData*)fixed[i].data;
+        const DifferentialClockData *y = (const DifferentialClockData*)generic[i].data;
+        TEST_ASSERT(memcmp(x->v, y->v, 3 * N * sizeof(int)) == 0, "v, LS and LU should match");
+        ts_destroy(&fixed[i]);
+        ts_destroy(&generic[i]);
+    }
+    return 1;
+}
+
+/* ---------- Deferred Receive Tests ---------- */
+
+static int test_deferred_half_vector_send() {
+    // A send of n/2 due entries is the full vector; queued receives must settle to the
+    // sender's counters just as an eager merge does
+    enum { N = 8 };
+    Timestamp sender = ts_create(N, 0, CLOCK_DIFFERENTIAL);
+    Timestamp eager = ts_create(N, N - 1, CLOCK_DIFFERENTIAL);
+    Timestamp deferred = ts_create(N, N - 1, CLOCK_DIFFERENTIAL);
+    ts_set_deferred(&deferred, 1);
+    
+    int incoming[2 * N], m = 0;
+    for (int k = 1; k < N / 2; k++) {
+        incoming[m++] = k;
+        incoming[m++] = 1000 + k;
+    }
+    ts_merge_and_tick(&sender, incoming, m * sizeof(int));
+    
+    int buffer[2 * N];
+    size_t size = ts_serialize_for_dest(&sender, N - 1, buffer, sizeof(buffer));
+    TEST_ASSERT_EQ(N * sizeof(int), size, "n/2 entries should go as the full vector");
+    ts_merge_and_tick(&eager, buffer, size);
+    ts_merge_and_tick(&deferred, buffer, size);
+    
+    int a[N], b[N];
+    ts_to_vector(&eager, a);
+    ts_to_vector(&deferred, b);
+    TEST_ASSERT(memcmp(a, b, sizeof(a)) == 0, "Settled vector should match the eager one");
+    TEST_ASSERT_EQ(1000 + N / 2 - 1, b[N / 2 - 1], "Settled clock should hold the sender's counter");
+    ts_destroy(&sender);
+    ts_destroy(&eager);
+    ts_destroy(&deferred);
+    return 1;
+}
+
 /* ---------- Test Runner ---------- */
 
 static void print_test_summary() {
@@ -407,6 +577,8 @@ int main() {
     printf("\n--- Serialization Tests ---\n");
     RUN_TEST(test_differential_serialize_basic);
     RUN_TEST(test_differential_serialize_for_dest);
+    RUN_TEST(test_differential_update_order_matches_scan);
+    RUN_TEST(test_differential_half_vector_send);
     
     // Comparison Tests
     printf("\n--- Comparison Tests ---\n");
@@ -420,6 +592,14 @@ int main() {
     printf("\n--- Edge Case Tests ---\n");
     RUN_TEST(test_differential_edge_cases);
     
+    // Fixed-n Tests
+    printf("\n--- Fixed-n Tests ---\n");
+    RUN_TEST(test_differential_fixed_n_matches_generic);
+    
+    // Deferred Receive Tests
+    printf("\n--- Deferred Receive Tests ---\n");
+    RUN_TEST(test_deferred_half_vector_send);
+    
     print_test_summary();
     
     return g_stats.tests_failed > 0 ? 1 : 0;
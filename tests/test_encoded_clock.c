@@ -0,0 +1,461 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "encoded_clock.h"
+
+/* ---------- Test Framework ---------- */
+
+typedef struct {
+    int tests_run;
+    int tests_passed;
+    int tests_failed;
+    char current_test[256];
+} TestStats;
+
+static TestStats g_stats = {0};
+
+#define TEST_ASSERT(condition, message) do { \
+    if (!(condition)) { \
+        printf("FAIL: %s - %s\n", g_stats.current_test, message); \
+        g_stats.tests_failed++; \
+        return 0; \
+    } \
+} while(0)
+
+#define TEST_ASSERT_EQ(expected, actual, message) do { \
+    if ((expected) != (actual)) { \
+        printf("FAIL: %s - %s (expected: %d, actual: %d)\n", \
+               g_stats.current_test, message, (int)(expected), (int)(actual)); \
+        g_stats.tests_failed++; \
+        return 0; \
+    } \
+} while(0)
+
+#define RUN_TEST(test_func) do { \
+    snprintf(g_stats.current_test, sizeof(g_stats.current_test), #test_func); \
+    g_stats.tests_run++; \
+    if (test_func()) { \
+        printf("PASS: %s\n", #test_func); \
+        g_stats.tests_passed++; \
+    } \
+} while(0)
+
+/* ---------- Helper Functions ---------- */
+
+// Restores the default threshold so tests do not leak configuration
+static void reset_threshold(void) {
+    encoded_set_vector_threshold(0);
+}
+
+/* ---------- Prime Table Tests ---------- */
+
+static int test_prime_table() {
+    const uint32_t *primes = encoded_primes(1000);
+    
+    TEST_ASSERT_EQ(2, primes[0], "First prime should be 2");
+    TEST_ASSERT_EQ(97, primes[24], "25th prime should be 97");
+    TEST_ASSERT_EQ(7919, primes[999], "1000th prime should be 7919");
+    return 1;
+}
+
+/* ---------- Bignum Encoding Tests ---------- */
+
+static int test_encoded_large_n() {
+    encoded_set_vector_threshold(1 << 20);
+    Timestamp ts = encoded_create(200, 150, CLOCK_ENCODED);
+    
+    for (int i = 0; i < 50; i++) {
+        encoded_increment(&ts);
+    }
+    
+    int v[200];
+    encoded_to_vector(&ts, v);
+    TEST_ASSERT_EQ(50, v[150], "Own entry should count every increment");
+    TEST_ASSERT_EQ(0, v[0], "Other entries should stay zero");
+    
+    EncodedClockData *data = (EncodedClockData*)ts.data;
+    TEST_ASSERT(!data->overflow, "Large threshold should keep the prime encoding");
+    TEST_ASSERT(data->value.len > 2, "Product should need more than 64 bits");
+    
+    encoded_destroy(&ts);
+    reset_threshold();
+    return 1;
+}
+
+static int test_encoded_big_roundtrip() {
+    encoded_set_vector_threshold(1 << 20);
+    Timestamp a = encoded_create(40, 3, CLOCK_ENCODED);
+    Timestamp b = encoded_create(40, 37, CLOCK_ENCODED);
+    
+    for (int i = 0; i < 30; i++) encoded_increment(&a);
+    for (int i = 0; i < 20; i++) encoded_increment(&b);
+    
+    unsigned char buffer[1024];
+    size_t size = encoded_serialize(&a, buffer, sizeof(buffer));
+    uint32_t header;
+    memcpy(&header, buffer, sizeof(header));
+    TEST_ASSERT(size > sizeof(unsigned long long), "Wide product should use the tagged form");
+    TEST_ASSERT_EQ(ENCODED_BIG_TAG, header & ~ENCODED_LIMB_MASK, "Header should carry the bignum tag");
+    
+    encoded_merge(&b, buffer, size);
+    
+    int v[40];
+    encoded_to_vector(&b, v);
+    TEST_ASSERT_EQ(30, v[3], "Merge should take the sender's entry");
+    TEST_ASSERT_EQ(20, v[37], "Merge should keep the receiver's entry");
+    TEST_ASSERT_EQ(TS_BEFORE, encoded_compare(&a, &b), "Sender should be before the merged receiver");
+    
+    Timestamp copy = encoded_create(40, 0, CLOCK_ENCODED);
+    encoded_deserialize(&copy, buffer, size);
+    TEST_ASSERT_EQ(TS_EQUAL, encoded_compare(&a, &copy), "Deserialized clock should equal the sender");
+    
+    encoded_destroy(&a);
+    encoded_destroy(&b);
+    encoded_destroy(&copy);
+    reset_threshold();
+    return 1;
+}
+
+static int test_encoded_small_value_compat() {
+    Timestamp ts = encoded_create(4, 1, CLOCK_ENCODED);
+    encoded_increment(&ts);
+    encoded_increment(&ts);
+    
+    unsigned long long value;
+    size_t size = encoded_serialize(&ts, &value, sizeof(value));
+    TEST_ASSERT_EQ(sizeof(unsigned long long), size, "Small products should stay 8 bytes");
+    TEST_ASSERT(value == 9, "Two ticks at process 1 should encode 3^2");
+    
+    encoded_destroy(&ts);
+    return 1;
+}
+
+/* ---------- Encoded-Domain Tests ---------- */
+
+static int test_encoded_divisibility_compare() {
+    Timestamp a = encoded_create(6, 0, CLOCK_ENCODED);
+    Timestamp b = encoded_create(6, 1, CLOCK_ENCODED);
+    
+    TEST_ASSERT_EQ(TS_EQUAL, encoded_compare(&a, &b), "Fresh clocks should be equal");
+    
+    encoded_increment(&a);  // a = 2
+    TEST_ASSERT_EQ(TS_AFTER, encoded_compare(&a, &b), "2 should be after 1");
+    
+    encoded_increment(&b);  // b = 3
+    TEST_ASSERT_EQ(TS_CONCURRENT, encoded_compare(&a, &b), "2 and 3 should be concurrent");
+    
+    unsigned long long value;
+    encoded_serialize(&a, &value, sizeof(value));
+    encoded_merge(&b, &value, sizeof(value));  // b = lcm(3, 2) = 6
+    TEST_ASSERT_EQ(TS_BEFORE, encoded_compare(&a, &b), "2 should be before 6");
+    
+    encoded_serialize(&b, &value, sizeof(value));
+    TEST_ASSERT(value == 6, "Merge should be the LCM of the products");
+    
+    encoded_destroy(&a);
+    encoded_destroy(&b);
+    return 1;
+}
+
+static int test_encoded_matches_decode_path() {
+    const int n = 12;
+    encoded_set_vector_threshold(1 << 20);
+    srand(7);
+    
+    for (int round = 0; round < 200; round++) {
+        Timestamp clocks[2][2];
+        for (int path = 0; path < 2; path++) {
+            clocks[path][0] = encoded_create(n, rand() % n, CLOCK_ENCODED);
+            clocks[path][1] = encoded_create(n, rand() % n, CLOCK_ENCODED);
+        }
+        
+        // Same random history on both paths
+        int ops = rand() % 120;
+        unsigned seed = rand();
+        for (int path = 0; path < 2; path++) {
+            encoded_force_decode(path);
+            srand(seed);
+            for (int op = 0; op < ops; op++) {
+                Timestamp *x = &clocks[path][rand() % 2];
+                if (rand() % 3) {
+                    x->pid = rand() % n;
+                    encoded_increment(x);
+                } else {
+                    Timestamp *y = &clocks[path][rand() % 2];
+                    unsigned char buffer[1024];
+                    size_t size = encoded_serialize(y, buffer, sizeof(buffer));
+                    encoded_merge(x, buffer, size);
+                }
+            }
+        }
+        
+        encoded_force_decode(1);
+        TSOrder expected = encoded_compare(&clocks[1][0], &clocks[1][1]);
+        encoded_force_decode(0);
+        TSOrder actual = encoded_compare(&clocks[0][0], &clocks[0][1]);
+        TEST_ASSERT_EQ(expected, actual, "Divisibility compare should match the decode path");
+        
+        int v0[12], v1[12];
+        for (int i = 0; i < 2; i++) {
+            encoded_to_vector(&clocks[0][i], v0);
+            encoded_to_vector(&clocks[1][i], v1);
+            TEST_ASSERT(memcmp(v0, v1, sizeof(v0)) == 0, "LCM merge should match the decode path");
+        }
+        
+        for (int path = 0; path < 2; path++) {
+            encoded_destroy(&clocks[path][0]);
+            encoded_destroy(&clocks[path][1]);
+        }
+    }
+    
+    reset_threshold();
+    return 1;
+}
+
+/* ---------- Threshold Tests ---------- */
+
+static int test_encoded_vector_switch() {
+    encoded_set_vector_threshold(16);
+    Timestamp ts = encoded_create(30, 29, CLOCK_ENCODED);
+    EncodedClockData *data = (EncodedClockData*)ts.data;
+    
+    // 113^10 needs a third limb, which serializes to 16 bytes
+    int ticks = 0;
+    while (!data->overflow && ticks < 100) {
+        encoded_increment(&ts);
+        ticks++;
+    }
+    TEST_ASSERT(data->overflow, "Clock should switch once the encoding exceeds 16 bytes");
+    TEST_ASSERT_EQ(ticks, data->fallback_v[29], "Vector form should keep every tick");
+    
+    unsigned char buffer[256];
+    TEST_ASSERT_EQ(30 * sizeof(int), encoded_serialize(&ts, buffer, sizeof(buffer)),
+                   "Switched clock should serialize as a vector");
+    
+    encoded_destroy(&ts);
+    reset_threshold();
+    return 1;
+}
+
+static int test_encoded_two_process_vector_form() {
+    // At n = 2 the vector form would be 8 bytes, the size of a one-word product
+    Timestamp a = encoded_create(2, 0, CLOCK_ENCODED);
+    Timestamp b = encoded_create(2, 1, CLOCK_ENCODED);
+    EncodedClockData *data = (EncodedClockData*)a.data;
+    int ticks = 0;
+    while (!data->overflow && ticks < 100) {
+        encoded_increment(&a);
+        ticks++;
+    }
+    TEST_ASSERT(data->overflow, "2^64 should not fit the 8-byte threshold");
+    
+    unsigned char buffer[64];
+    size_t size = encoded_serialize(&a, buffer, sizeof(buffer));
+    TEST_ASSERT_EQ(encoded_vector_size(2), size, "Vector form should be padded at n = 2");
+    TEST_ASSERT(size != sizeof(unsigned long long), "Vector form should not read as a product");
+    
+    encoded_merge(&b, buffer, size);
+    TEST_ASSERT_EQ(TS_EQUAL, encoded_compare(&a, &b), "Merge should take the vector as sent");
+    
+    Timestamp c = encoded_create(2, 1, CLOCK_ENCODED);
+    encoded_deserialize(&c, buffer, size);
+    TEST_ASSERT_EQ(TS_EQUAL, encoded_compare(&a, &c), "Deserialize should take the vector as sent");
+    
+    encoded_destroy(&a);
+    encoded_destroy(&b);
+    encoded_destroy(&c);
+    return 1;
+}
+
+static int test_encoded_malformed_ignored() {
+    Timestamp ts = encoded_create(4, 0, CLOCK_ENCODED);
+    encoded_increment(&ts);
+    
+    // Zero products and unrecognized sizes carry no clock
+    unsigned long long zero = 0;
+    encoded_merge(&ts, &zero, sizeof(zero));
+    int odd_size[3] = {1, 2, 3};
+    encoded_merge(&ts, odd_size, sizeof(odd_size));
+    
+    int v[4];
+    encoded_to_vector(&ts, v);
+    TEST_ASSERT_EQ(1, v[0], "Malformed values should be ignored");
+    TEST_ASSERT_EQ(0, v[1] + v[2] + v[3], "Malformed values should not add entries");
+    
+    // Deserialize leaves the clock as it was
+    encoded_deserialize(&ts, &zero, sizeof(zero));
+    encoded_deserialize(&ts, odd_size, sizeof(odd_size));
+    encoded_deserialize(&ts, NULL, 0);
+    encoded_to_vector(&ts, v);
+    TEST_ASSERT_EQ(1, v[0], "Malformed input should not reset the clock");
+    TEST_ASSERT_EQ(0, v[1] + v[2] + v[3], "Malformed input should not add entries");
+    
+    encoded_destroy(&ts);
+    return 1;
+}
+
+/* ---------- Log-Domain Tests ---------- */
+
+static int test_encoded_log_exact_powers() {
+    Timestamp ts = encoded_create(4, 0, CLOCK_ENCODED);
+    EncodedClockData *data = (EncodedClockData*)ts.data;
+    TEST_ASSERT(data->prime_logs[0] == (uint64_t)1 << ENCODED_LOG_FRAC_BITS, "log2(2) should be exact");
+    
+    for (int i = 0; i < 10; i++) encoded_increment(&ts);
+    TEST_ASSERT(encoded_log2(&ts, NULL) == (uint64_t)10 << ENCODED_LOG_FRAC_BITS,
+                "Ten ticks of process 0 should log to exactly 10");
+    
+    // A merge recomputes the log from the product itself
+    unsigned char buffer[64];
+    size_t size = encoded_serialize(&ts, buffer, sizeof(buffer));
+    encoded_merge(&ts, buffer, size);
+    uint64_t err;
+    TEST_ASSERT(encoded_log2(&ts, &err) == (uint64_t)10 << ENCODED_LOG_FRAC_BITS,
+                "Log of 1024 should be exact after a merge");
+    TEST_ASSERT(err > 0 && err < 8, "A recomputed log should carry a small bound");
+    
+    encoded_destroy(&ts);
+    return 1;
+}
+
+static int test_encoded_log_within_bound() {
+    const int n = 12;
+    srand(11);
+    
+    // Both forms: products only, and a switch to vectors part way through
+    for (size_t threshold = 16; threshold <= 1024; threshold *= 64) {
+        encoded_set_vector_threshold(threshold);
+        Timestamp a = encoded_create(n, 0, CLOCK_ENCODED);
+        Timestamp b = encoded_create(n, 1, CLOCK_ENCODED);
+        for (int step = 0; step < 80; step++) {
+            Timestamp *x = rand() % 2 ? &a : &b;
+            if (rand() % 3) {
+                x->pid = rand() % n;
+                encoded_increment(x);
+            } else {
+                Timestamp *y = x == &a ? &b : &a;
+                unsigned char buffer[1024];
+                size_t size = encoded_serialize(y, buffer, sizeof(buffer));
+                encoded_merge(x, buffer, size);
+            }
+            
+            // Reference: exponent sum over the same table, with its own bound
+            const EncodedClockData *data = (const EncodedClockData*)x->data;
+            int v[12];
+            encoded_to_vector(x, v);
+            uint64_t ref = 0, ref_err = 0, err;
+            for (int i = 0; i < n; i++) {
+                ref += (uint64_t)v[i] * data->prime_logs[i];
+                ref_err += (uint64_t)v[i] * 2;
+            }
+            uint64_t log = encoded_log2(x, &err);
+            uint64_t gap = log > ref ? log - ref : ref - log;
+            TEST_ASSERT(gap <= err + ref_err, "Log should stay within its error bound");
+        }
+        encoded_destroy(&a);
+        encoded_destroy(&b);
+    }
+    
+    reset_threshold();
+    return 1;
+}
+
+static int test_encoded_log_close_magnitudes() {
+    // 8 = 2^3 and 9 = 3^2 are a fraction of a bit apart but concurrent; 8 -> 16
+    Timestamp a = encoded_create(2, 0, CLOCK_ENCODED);
+    Timestamp b = encoded_create(2, 1, CLOCK_ENCODED);
+    for (int i = 0; i < 3; i++) encoded_increment(&a);
+    for (int i = 0; i < 2; i++) encoded_increment(&b);
+    TEST_ASSERT_EQ(TS_CONCURRENT, encoded_compare(&a, &b), "8 and 9 should be concurrent");
+    
+    Timestamp c = encoded_clone(&a);
+    TEST_ASSERT_EQ(TS_EQUAL, encoded_compare(&a, &c), "Clone should compare equal");
+    encoded_increment(&c);
+    TEST_ASSERT_EQ(TS_BEFORE, encoded_compare(&a, &c), "8 should precede 16");
+    TEST_ASSERT_EQ(TS_AFTER, encoded_compare(&c, &a), "16 should follow 8");
+    
+    // Equal products reached by different routes
+    unsigned char buffer[64];
+    size_t size = encoded_serialize(&a, buffer, sizeof(buffer));
+    Timestamp d = encoded_create(2, 0, CLOCK_ENCODED);
+    encoded_merge(&d, buffer, size);
+    TEST_ASSERT_EQ(TS_EQUAL, encoded_compare(&a, &d), "Merged copy should compare equal");
+    
+    encoded_destroy(&a);
+    encoded_destroy(&b);
+    encoded_destroy(&c);
+    encoded_destroy(&d);
+    return 1;
+}
+
+static int test_encoded_events_left_lower_bound() {
+    const int sizes[] = {1, 4, 30, 200};
+    encoded_set_vector_threshold(1024);  // keep the product form for small n
+    for (int k = 0; k < 4; k++) {
+        int n = sizes[k];
+        for (size_t bytes = 8; bytes <= 16; bytes += 8) {
+            // Ticks on the largest prime are the worst case the prediction assumes
+            Timestamp ts = encoded_create(n, n - 1, CLOCK_ENCODED);
+            long long predicted = encoded_events_left(&ts, bytes);
+            long long fits = 0;
+            for (;;) {
+                encoded_increment(&ts);
+                if (encoded_serialize(&ts, NULL, 0) > bytes) break;
+                fits++;
+            }
+            TEST_ASSERT(predicted <= fits, "Prediction should never overshoot");
+            TEST_ASSERT(predicted >= fits - 1, "Prediction should be tight on the largest prime");
+            encoded_destroy(&ts);
+        }
+    }
+    reset_threshold();
+    return 1;
+}
+
+/* ---------- Test Runner ---------- */
+
+static void print_test_summary() {
+    printf("\n=== Test Summary ===\n");
+    printf("Tests run: %d\n", g_stats.tests_run);
+    printf("Tests passed: %d\n", g_stats.tests_passed);
+    printf("Tests failed: %d\n", g_stats.tests_failed);
+    printf("Success rate: %.1f%%\n", 
+           g_stats.tests_run > 0 ? (100.0 * g_stats.tests_passed / g_stats.tests_run) : 0.0);
+}
+
+int main() {
+    printf("=== Encoded Clock Test Suite ===\n\n");
+    
+    // Prime Table Tests
+    printf("--- Prime Table Tests ---\n");
+    RUN_TEST(test_prime_table);
+    
+    // Bignum Encoding Tests
+    printf("\n--- Bignum Encoding Tests ---\n");
+    RUN_TEST(test_encoded_large_n);
+    RUN_TEST(test_encoded_big_roundtrip);
+    RUN_TEST(test_encoded_small_value_compat);
+    
+    // Encoded-Domain Tests
+    printf("\n--- Encoded-Domain Tests ---\n");
+    RUN_TEST(test_encoded_divisibility_compare);
+    RUN_TEST(test_encoded_matches_decode_path);
+    
+    // Threshold Tests
+    printf("\n--- Threshold Tests ---\n");
+    RUN_TEST(test_encoded_vector_switch);
+    RUN_TEST(test_encoded_two_process_vector_form);
+    RUN_TEST(test_encoded_malformed_ignored);
+    
+    // Log-Domain Tests
+    printf("\n--- Log-Domain Tests ---\n");
+    RUN_TEST(test_encoded_log_exact_powers);
+    RUN_TEST(test_encoded_log_within_bound);
+    RUN_TEST(test_encoded_log_close_magnitudes);
+    RUN_TEST(test_encoded_events_left_lower_bound);
+    
+    print_test_summary();
+    
+    return g_stats.tests_failed > 0 ? 1 : 0;
+}
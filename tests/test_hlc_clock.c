@@ -0,0 +1,229 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "hlc_clock.h"
+
+/* ---------- Test Framework ---------- */
+
+typedef struct {
+    int tests_run;
+    int tests_passed;
+    int tests_failed;
+    char current_test[256];
+} TestStats;
+
+static TestStats g_stats = {0};
+
+#define TEST_ASSERT(condition, message) do { \
+    if (!(condition)) { \
+        printf("FAIL: %s - %s\n", g_stats.current_test, message); \
+        g_stats.tests_failed++; \
+        return 0; \
+    } \
+} while(0)
+
+#define TEST_ASSERT_EQ(expected, actual, message) do { \
+    if ((expected) != (actual)) { \
+        printf("FAIL: %s - %s (expected: %d, actual: %d)\n", \
+               g_stats.current_test, message, (int)(expected), (int)(actual)); \
+        g_stats.tests_failed++; \
+        return 0; \
+    } \
+} while(0)
+
+#define RUN_TEST(test_func) do { \
+    snprintf(g_stats.current_test, sizeof(g_stats.current_test), #test_func); \
+    g_stats.tests_run++; \
+    if (test_func()) { \
+        printf("PASS: %s\n", #test_func); \
+        g_stats.tests_passed++; \
+    } \
+} while(0)
+
+/* ---------- Helper Functions ---------- */
+
+// Manually driven physical clock
+static uint64_t fake_now = 0;
+
+static uint64_t fake_clock(void) {
+    return fake_now;
+}
+
+static uint64_t value_of(const Timestamp *ts) {
+    return ((const HlcClockData*)ts->data)->hlc;
+}
+
+static void set_value(Timestamp *ts, uint64_t pt, uint64_t l) {
+    uint64_t packed = HLC_PACK(pt, l);
+    hlc_deserialize(ts, &packed, sizeof(packed));
+}
+
+/* ---------- Update Rule Tests ---------- */
+
+static int test_hlc_send_rule() {
+    hlc_set_physical_clock(fake_clock);
+    fake_now = 1000;
+    Timestamp ts = hlc_create(2, 0, CLOCK_HLC);
+    
+    hlc_send(&ts);
+    TEST_ASSERT(value_of(&ts) == HLC_PACK(1000, 0), "First event should take physical time");
+    hlc_send(&ts);
+    TEST_ASSERT(value_of(&ts) == HLC_PACK(1000, 1), "Same millisecond should bump the counter");
+    
+    fake_now = 1005;
+    hlc_send(&ts);
+    TEST_ASSERT(value_of(&ts) == HLC_PACK(1005, 0), "Advancing physical time should reset the counter");
+    
+    // A clock that went backwards must not move the HLC backwards
+    fake_now = 900;
+    hlc_send(&ts);
+    TEST_ASSERT(value_of(&ts) == HLC_PACK(1005, 1), "HLC should never go backwards");
+    
+    hlc_destroy(&ts);
+    hlc_set_physical_clock(NULL);
+    return 1;
+}
+
+static int test_hlc_recv_rule() {
+    hlc_set_physical_clock(fake_clock);
+    Timestamp ts = hlc_create(2, 0, CLOCK_HLC);
+    
+    fake_now = 999;
+    set_value(&ts, 1000, 3);
+    TEST_ASSERT_EQ(1, hlc_recv(&ts, HLC_PACK(1000, 7)), "Message should be accepted");
+    TEST_ASSERT(value_of(&ts) == HLC_PACK(1000, 8), "Equal physical parts take the max counter + 1");
+    
+    TEST_ASSERT_EQ(1, hlc_recv(&ts, HLC_PACK(1002, 4)), "Message should be accepted");
+    TEST_ASSERT(value_of(&ts) == HLC_PACK(1002, 5), "A sender ahead sets the physical part");
+    
+    TEST_ASSERT_EQ(1, hlc_recv(&ts, HLC_PACK(990, 40)), "Message should be accepted");
+    TEST_ASSERT(value_of(&ts) == HLC_PACK(1002, 6), "A sender behind only bumps the counter");
+    
+    fake_now = 2000;
+    TEST_ASSERT_EQ(1, hlc_recv(&ts, HLC_PACK(1500, 2)), "Message should be accepted");
+    TEST_ASSERT(value_of(&ts) == HLC_PACK(2000, 0), "Local physical time ahead of both resets the counter");
+    
+    hlc_destroy(&ts);
+    hlc_set_physical_clock(NULL);
+    return 1;
+}
+
+static int test_hlc_drift_rejected() {
+    hlc_set_physical_clock(fake_clock);
+    hlc_set_max_drift(50);
+    fake_now = 1000;
+    Timestamp ts = hlc_create(2, 0, CLOCK_HLC);
+    hlc_send(&ts);
+    
+    TEST_ASSERT_EQ(1, hlc_recv(&ts, HLC_PACK(1050, 0)), "Drift at the bound should be accepted");
+    uint64_t before = value_of(&ts);
+    TEST_ASSERT_EQ(0, hlc_recv(&ts, HLC_PACK(1051, 0)), "Drift past the bound should be rejected");
+    TEST_ASSERT(value_of(&ts) == before, "Rejected message should not change the clock");
+    TEST_ASSERT_EQ(1, hlc_drift_rejections(&ts), "Rejection should be counted");
+    
+    hlc_destroy(&ts);
+    hlc_set_max_drift(HLC_DEFAULT_MAX_DRIFT_MS);
+    hlc_set_physical_clock(NULL);
+    return 1;
+}
+
+static int test_hlc_logical_overflow() {
+    hlc_set_physical_clock(fake_clock);
+    fake_now = 1000;
+    Timestamp ts = hlc_create(2, 0, CLOCK_HLC);
+    set_value(&ts, 1000, HLC_LOGICAL_MASK);
+    
+    uint64_t before = value_of(&ts);
+    hlc_send(&ts);
+    TEST_ASSERT(value_of(&ts) > before, "Counter overflow should still advance the clock");
+    TEST_ASSERT(value_of(&ts) == HLC_PACK(1001, 0), "Counter overflow should spill into physical time");
+    
+    hlc_destroy(&ts);
+    hlc_set_physical_clock(NULL);
+    return 1;
+}
+
+/* ---------- Ordering Tests ---------- */
+
+static int test_hlc_compare() {
+    hlc_set_physical_clock(fake_clock);
+    fake_now = 1000;
+    Timestamp a = hlc_create(2, 0, CLOCK_HLC);
+    Timestamp b = hlc_create(2, 1, CLOCK_HLC);
+    
+    TEST_ASSERT_EQ(TS_CONCURRENT, hlc_compare(&a, &b), "Equal values from different processes are undecided");
+    Timestamp a2 = hlc_clone(&a);
+    TEST_ASSERT_EQ(TS_EQUAL, hlc_compare(&a, &a2), "Same process and value should be equal");
+    
+    // Happened-before is always reflected
+    hlc_send(&a);
+    uint64_t msg = value_of(&a);
+    hlc_recv(&b, msg);
+    TEST_ASSERT_EQ(TS_BEFORE, hlc_compare(&a, &b), "Send should order before receive");
+    
+    // Concurrent events get ordered anyway: the false orderings the simulation measures
+    hlc_send(&a);
+    hlc_send(&a);
+    TEST_ASSERT_EQ(TS_AFTER, hlc_compare(&a, &b), "Concurrent events are ordered by value");
+    
+    hlc_destroy(&a);
+    hlc_destroy(&a2);
+    hlc_destroy(&b);
+    hlc_set_physical_clock(NULL);
+    return 1;
+}
+
+static int test_hlc_serialize() {
+    Timestamp ts = hlc_create(4, 1, CLOCK_HLC);
+    hlc_send(&ts);
+    
+    uint64_t buffer[2];
+    TEST_ASSERT_EQ(8, hlc_serialize(&ts, NULL, 0), "Timestamps should be 8 bytes regardless of n");
+    size_t size = hlc_serialize(&ts, buffer, sizeof(buffer));
+    
+    Timestamp copy = hlc_create(4, 1, CLOCK_HLC);
+    hlc_deserialize(&copy, buffer, size);
+    TEST_ASSERT_EQ(TS_EQUAL, hlc_compare(&ts, &copy), "Round trip should preserve the value");
+    
+    // Wrong sizes are ignored
+    uint64_t before = value_of(&copy);
+    hlc_merge(&copy, buffer, 4);
+    hlc_deserialize(&copy, buffer, 16);
+    TEST_ASSERT(value_of(&copy) == before, "Malformed sizes should be ignored");
+    
+    hlc_destroy(&ts);
+    hlc_destroy(&copy);
+    return 1;
+}
+
+/* ---------- Test Runner ---------- */
+
+static void print_test_summary() {
+    printf("\n=== Test Summary ===\n");
+    printf("Tests run: %d\n", g_stats.tests_run);
+    printf("Tests passed: %d\n", g_stats.tests_passed);
+    printf("Tests failed: %d\n", g_stats.tests_failed);
+    printf("Success rate: %.1f%%\n", 
+           g_stats.tests_run > 0 ? (100.0 * g_stats.tests_passed / g_stats.tests_run) : 0.0);
+}
+
+int main() {
+    printf("=== Hybrid Logical Clock Test Suite ===\n\n");
+    
+    // Update Rule Tests
+    printf("--- Update Rule Tests ---\n");
+    RUN_TEST(test_hlc_send_rule);
+    RUN_TEST(test_hlc_recv_rule);
+    RUN_TEST(test_hlc_drift_rejected);
+    RUN_TEST(test_hlc_logical_overflow);
+    
+    // Ordering Tests
+    printf("\n--- Ordering Tests ---\n");
+    RUN_TEST(test_hlc_compare);
+    RUN_TEST(test_hlc_serialize);
+    
+    print_test_summary();
+    
+    return g_stats.tests_failed > 0 ? 1 : 0;
+}
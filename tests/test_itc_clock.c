@@ -0,0 +1,300 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "itc_clock.h"
+#include "standard_clock.h"
+
+/* ---------- Test Framework ---------- */
+
+typedef struct {
+    int tests_run;
+    int tests_passed;
+    int tests_failed;
+    char current_test[256];
+} TestStats;
+
+static TestStats g_stats = {0};
+
+#define TEST_ASSERT(condition, message) do { \
+    if (!(condition)) { \
+        printf("FAIL: %s - %s\n", g_stats.current_test, message); \
+        g_stats.tests_failed++; \
+        return 0; \
+    } \
+} while(0)
+
+#define TEST_ASSERT_EQ(expected, actual, message) do { \
+    if ((expected) != (actual)) { \
+        printf("FAIL: %s - %s (expected: %d, actual: %d)\n", \
+               g_stats.current_test, message, (int)(expected), (int)(actual)); \
+        g_stats.tests_failed++; \
+        return 0; \
+    } \
+} while(0)
+
+#define RUN_TEST(test_func) do { \
+    snprintf(g_stats.current_test, sizeof(g_stats.current_test), #test_func); \
+    g_stats.tests_run++; \
+    if (test_func()) { \
+        printf("PASS: %s\n", #test_func); \
+        g_stats.tests_passed++; \
+    } \
+} while(0)
+
+/* ---------- Helper Functions ---------- */
+
+// Delivers a message from src to dst: dst joins the given form of src's stamp
+static void deliver(const Timestamp *src, Timestamp *dst, int full_stamp) {
+    unsigned char buffer[1024];
+    size_t size = full_stamp ? itc_serialize(src, buffer, sizeof(buffer))
+                             : itc_serialize_for_dest(src, dst->pid, buffer, sizeof(buffer));
+    assert(size <= sizeof(buffer));
+    itc_merge(dst, buffer, size);
+}
+
+/* ---------- Basic Operation Tests ---------- */
+
+static int test_itc_create_and_event() {
+    Timestamp a = itc_create(4, 2, CLOCK_ITC);
+    Timestamp b = itc_create(4, 2, CLOCK_ITC);
+    char buf[256];
+    
+    itc_to_string(&a, buf, sizeof(buf));
+    TEST_ASSERT(strcmp(buf, "I:(0,(1,0)) E:0") == 0, "Slot 2 of 4 should own the third quarter");
+    TEST_ASSERT_EQ(TS_EQUAL, itc_compare(&a, &b), "Fresh stamps should be equal");
+    
+    itc_increment(&a);
+    TEST_ASSERT_EQ(TS_AFTER, itc_compare(&a, &b), "Event should advance the stamp");
+    TEST_ASSERT_EQ(TS_BEFORE, itc_compare(&b, &a), "Order should be antisymmetric");
+    
+    itc_destroy(&a);
+    itc_destroy(&b);
+    return 1;
+}
+
+static int test_itc_fork_join() {
+    Timestamp a = itc_create(1, 0, CLOCK_ITC);
+    Timestamp b = itc_fork(&a);
+    char buf[256];
+    
+    itc_to_string(&a, buf, sizeof(buf));
+    TEST_ASSERT(strcmp(buf, "I:(1,0) E:0") == 0, "Fork should keep the left half");
+    itc_to_string(&b, buf, sizeof(buf));
+    TEST_ASSERT(strcmp(buf, "I:(0,1) E:0") == 0, "Fork should hand out the right half");
+    
+    itc_increment(&a);
+    itc_increment(&b);
+    TEST_ASSERT_EQ(TS_CONCURRENT, itc_compare(&a, &b), "Independent events should be concurrent");
+    
+    // Retiring b hands its id back; the join normalizes to a single seed again
+    deliver(&b, &a, 1);
+    itc_retire(&b);
+    TEST_ASSERT(!itc_has_id(&b), "Retired stamp should own nothing");
+    TEST_ASSERT_EQ(TS_AFTER, itc_compare(&a, &b), "Join should cover both histories");
+    
+    itc_increment(&a);
+    itc_to_string(&a, buf, sizeof(buf));
+    TEST_ASSERT(strcmp(buf, "I:1 E:2") == 0, "Joined stamp should normalize to one counter");
+    
+    itc_destroy(&a);
+    itc_destroy(&b);
+    return 1;
+}
+
+static int test_itc_peek_is_anonymous() {
+    Timestamp a = itc_create(2, 0, CLOCK_ITC);
+    Timestamp b = itc_create(2, 1, CLOCK_ITC);
+    
+    itc_increment(&a);
+    deliver(&a, &b, 0);
+    itc_increment(&b);
+    TEST_ASSERT_EQ(TS_BEFORE, itc_compare(&a, &b), "Receive should order after the send");
+    
+    Timestamp peek = itc_peek(&b);
+    TEST_ASSERT(!itc_has_id(&peek), "Peek should carry no id");
+    TEST_ASSERT_EQ(TS_EQUAL, itc_compare(&peek, &b), "Peek should carry the full history");
+    itc_increment(&peek);
+    TEST_ASSERT_EQ(TS_EQUAL, itc_compare(&peek, &b), "Anonymous stamps cannot record events");
+    
+    // Joining a peek must not change ownership
+    char before[256], after[256];
+    itc_to_string(&a, before, sizeof(before));
+    deliver(&peek, &a, 1);
+    itc_to_string(&a, after, sizeof(after));
+    TEST_ASSERT(strncmp(before, after, strchr(before, ' ') - before) == 0, "Peek join should keep the id");
+    
+    itc_destroy(&a);
+    itc_destroy(&b);
+    itc_destroy(&peek);
+    return 1;
+}
+
+/* ---------- Ground Truth Tests ---------- */
+
+// Random events and messages over both clock types must produce the same partial order
+static int test_itc_matches_vector_order() {
+    enum { N = 5, ROUNDS = 50, OPS = 60 };
+    unsigned int seed = 42;
+    
+    for (int round = 0; round < ROUNDS; round++) {
+        Timestamp itc[N], vec[N];
+        for (int i = 0; i < N; i++) {
+            itc[i] = itc_create(N, i, CLOCK_ITC);
+            vec[i] = standard_create(N, i, CLOCK_STANDARD);
+        }
+        
+        for (int op = 0; op < OPS; op++) {
+            int p = rand_r(&seed) % N;
+            int q = rand_r(&seed) % N;
+            if (p == q || rand_r(&seed) % 3 == 0) {
+                itc_increment(&itc[p]);
+                standard_increment(&vec[p]);
+            } else {
+                int v[N];
+                itc_increment(&itc[p]);
+                standard_increment(&vec[p]);
+                deliver(&itc[p], &itc[q], 0);
+                standard_serialize(&vec[p], v, sizeof(v));
+                standard_merge(&vec[q], v, sizeof(v));
+                itc_increment(&itc[q]);
+                standard_increment(&vec[q]);
+            }
+        }
+        
+        for (int i = 0; i < N; i++) {
+            for (int j = 0; j < N; j++) {
+                TEST_ASSERT_EQ(standard_compare(&vec[i], &vec[j]), itc_compare(&itc[i], &itc[j]),
+                               "ITC order should match the vector clock order");
+            }
+        }
+        for (int i = 0; i < N; i++) {
+            itc_destroy(&itc[i]);
+            standard_destroy(&vec[i]);
+        }
+    }
+    return 1;
+}
+
+/* ---------- Encoding Tests ---------- */
+
+static int test_itc_serialize_roundtrip() {
+    Timestamp a = itc_create(1, 0, CLOCK_ITC);
+    Timestamp b = itc_fork(&a);
+    Timestamp c = itc_fork(&b);
+    for (int i = 0; i < 7; i++) itc_increment(&a);
+    for (int i = 0; i < 300; i++) itc_increment(&c);
+    deliver(&c, &a, 0);
+    
+    unsigned char buffer[256];
+    size_t size = itc_serialize(&a, buffer, sizeof(buffer));
+    TEST_ASSERT(size <= 8, "Small trees should encode in a few bytes");
+    
+    Timestamp copy = itc_create(1, 0, CLOCK_ITC);
+    itc_deserialize(&copy, buffer, size);
+    
+    char expected[256], actual[256];
+    itc_to_string(&a, expected, sizeof(expected));
+    itc_to_string(&copy, actual, sizeof(actual));
+    TEST_ASSERT(strcmp(expected, actual) == 0, "Deserialized stamp should match the original");
+    TEST_ASSERT_EQ(TS_EQUAL, itc_compare(&a, &copy), "Deserialized stamp should compare equal");
+    
+    itc_destroy(&a);
+    itc_destroy(&b);
+    itc_destroy(&c);
+    itc_destroy(&copy);
+    return 1;
+}
+
+static int test_itc_churn_stays_small() {
+    enum { PROCS = 64 };
+    Timestamp procs[PROCS];
+    procs[0] = itc_create(1, 0, CLOCK_ITC);
+    
+    // Grow by forking, with events everywhere, then retire all but one
+    for (int i = 1; i < PROCS; i++) {
+        procs[i] = itc_fork(&procs[i / 2]);
+        itc_increment(&procs[i]);
+        itc_increment(&procs[i / 2]);
+    }
+    unsigned char buffer[4096];
+    size_t peak = itc_serialize(&procs[0], buffer, sizeof(buffer));
+    
+    for (int i = PROCS - 1; i > 0; i--) {
+        deliver(&procs[i], &procs[0], 1);
+        itc_retire(&procs[i]);
+    }
+    itc_increment(&procs[0]);
+    
+    char buf[256];
+    itc_to_string(&procs[0], buf, sizeof(buf));
+    TEST_ASSERT(strncmp(buf, "I:1 E:", 6) == 0, "Rejoined ids should collapse to the seed");
+    TEST_ASSERT(strchr(buf, '(') == NULL, "Event tree should flatten once one process owns all");
+    size_t final = itc_serialize(&procs[0], buffer, sizeof(buffer));
+    TEST_ASSERT(final <= peak, "Stamp should shrink after retirements");
+    TEST_ASSERT(final <= 4, "Single owner stamp should be a few bytes");
+    
+    for (int i = 0; i < PROCS; i++) {
+        itc_destroy(&procs[i]);
+    }
+    return 1;
+}
+
+static int test_itc_malformed_ignored() {
+    Timestamp ts = itc_create(2, 0, CLOCK_ITC);
+    itc_increment(&ts);
+    char before[256], after[256];
+    itc_to_string(&ts, before, sizeof(before));
+    
+    // Truncated: node markers with no children
+    unsigned char truncated[] = {0xFF};
+    itc_merge(&ts, truncated, sizeof(truncated));
+    itc_deserialize(&ts, truncated, sizeof(truncated));
+    
+    // Nesting far past the depth limit
+    unsigned char deep[64];
+    memset(deep, 0xFF, sizeof(deep));
+    itc_merge(&ts, deep, sizeof(deep));
+    itc_merge(&ts, NULL, 0);
+    
+    itc_to_string(&ts, after, sizeof(after));
+    TEST_ASSERT(strcmp(before, after) == 0, "Malformed stamps should be ignored");
+    
+    itc_destroy(&ts);
+    return 1;
+}
+
+/* ---------- Test Runner ---------- */
+
+static void print_test_summary() {
+    printf("\n=== Test Summary ===\n");
+    printf("Tests run: %d\n", g_stats.tests_run);
+    printf("Tests passed: %d\n", g_stats.tests_passed);
+    printf("Tests failed: %d\n", g_stats.tests_failed);
+    printf("Success rate: %.1f%%\n", 
+           g_stats.tests_run > 0 ? (100.0 * g_stats.tests_passed / g_stats.tests_run) : 0.0);
+}
+
+int main() {
+    printf("=== Interval Tree Clock Test Suite ===\n\n");
+    
+    // Basic Operation Tests
+    printf("--- Basic Operation Tests ---\n");
+    RUN_TEST(test_itc_create_and_event);
+    RUN_TEST(test_itc_fork_join);
+    RUN_TEST(test_itc_peek_is_anonymous);
+    
+    // Ground Truth Tests
+    printf("\n--- Ground Truth Tests ---\n");
+    RUN_TEST(test_itc_matches_vector_order);
+    
+    // Encoding Tests
+    printf("\n--- Encoding Tests ---\n");
+    RUN_TEST(test_itc_serialize_roundtrip);
+    RUN_TEST(test_itc_churn_stays_small);
+    RUN_TEST(test_itc_malformed_ignored);
+    
+    print_test_summary();
+    
+    return g_stats.tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,216 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "lamport_clock.h"
+#include "simulation.h"
+
+/* ---------- Test Framework ---------- */
+
+typedef struct {
+    int tests_run;
+    int tests_passed;
+    int tests_failed;
+    char current_test[256];
+} TestStats;
+
+static TestStats g_stats = {0};
+
+#define TEST_ASSERT(condition, message) do { \
+    if (!(condition)) { \
+        printf("FAIL: %s - %s\n", g_stats.current_test, message); \
+        g_stats.tests_failed++; \
+        return 0; \
+    } \
+} while(0)
+
+#define TEST_ASSERT_EQ(expected, actual, message) do { \
+    if ((expected) != (actual)) { \
+        printf("FAIL: %s - %s (expected: %d, actual: %d)\n", \
+               g_stats.current_test, message, (int)(expected), (int)(actual)); \
+        g_stats.tests_failed++; \
+        return 0; \
+    } \
+} while(0)
+
+#define RUN_TEST(test_func) do { \
+    snprintf(g_stats.current_test, sizeof(g_stats.current_test), #test_func); \
+    g_stats.tests_run++; \
+    if (test_func()) { \
+        printf("PASS: %s\n", #test_func); \
+        g_stats.tests_passed++; \
+    } \
+} while(0)
+
+/* ---------- Helper Functions ---------- */
+
+static uint64_t value_of(const Timestamp *ts) {
+    return ((const LamportClockData*)ts->data)->counter;
+}
+
+// Send from one clock to another: tick, serialize, receive
+static void send(Timestamp *from, Timestamp *to) {
+    uint64_t buffer;
+    lamport_increment(from);
+    size_t size = lamport_serialize(from, &buffer, sizeof(buffer));
+    lamport_merge_and_tick(to, &buffer, size);
+}
+
+/* ---------- Update Rule Tests ---------- */
+
+static int test_lamport_update_rules() {
+    Timestamp a = ts_create(3, 0, CLOCK_LAMPORT);
+    Timestamp b = ts_create(3, 1, CLOCK_LAMPORT);
+    
+    ts_increment(&a);
+    ts_increment(&a);
+    TEST_ASSERT(value_of(&a) == 2, "Local events should count up");
+    
+    send(&a, &b);
+    TEST_ASSERT(value_of(&b) == 4, "Receive should take the max and tick");
+    
+    // A smaller remote counter does not pull the clock back
+    uint64_t old = 1;
+    lamport_merge(&b, &old, sizeof(old));
+    TEST_ASSERT(value_of(&b) == 4, "Merge should keep the larger counter");
+    
+    ts_destroy(&a);
+    ts_destroy(&b);
+    return 1;
+}
+
+static int test_lamport_counter_is_64_bit() {
+    Timestamp ts = ts_create(2, 0, CLOCK_LAMPORT);
+    uint64_t big = 0xFFFFFFFFull;
+    lamport_deserialize(&ts, &big, sizeof(big));
+    ts_increment(&ts);
+    TEST_ASSERT(value_of(&ts) == 0x100000000ull, "Counter should not wrap at 32 bits");
+    
+    ts_destroy(&ts);
+    return 1;
+}
+
+/* ---------- Ordering Tests ---------- */
+
+static int test_lamport_compare() {
+    Timestamp a = ts_create(3, 0, CLOCK_LAMPORT);
+    Timestamp b = ts_create(3, 1, CLOCK_LAMPORT);
+    
+    TEST_ASSERT_EQ(TS_CONCURRENT, ts_compare(&a, &b), "Equal counters from different processes are undecided");
+    Timestamp a2 = ts_clone(&a);
+    TEST_ASSERT_EQ(TS_EQUAL, ts_compare(&a, &a2), "Same process and counter should be equal");
+    
+    // Happened-before is always reflected
+    send(&a, &b);
+    TEST_ASSERT_EQ(TS_BEFORE, ts_compare(&a, &b), "Send should order before receive");
+    TEST_ASSERT_EQ(TS_AFTER, ts_compare(&b, &a), "Receive should order after send");
+    
+    // Concurrent events get ordered by counter
+    for (int i = 0; i < 3; i++) ts_increment(&a);
+    TEST_ASSERT_EQ(TS_AFTER, ts_compare(&a, &b), "Concurrent events are ordered by counter");
+    
+    ts_destroy(&a);
+    ts_destroy(&a2);
+    ts_destroy(&b);
+    return 1;
+}
+
+static int test_lamport_total_order() {
+    Timestamp a = ts_create(3, 0, CLOCK_LAMPORT);
+    Timestamp b = ts_create(3, 2, CLOCK_LAMPORT);
+    ts_increment(&a);
+    ts_increment(&b);
+    
+    TEST_ASSERT_EQ(TS_BEFORE, lamport_total_order(&a, &b), "Ties should be broken by the lower pid");
+    TEST_ASSERT_EQ(TS_AFTER, lamport_total_order(&b, &a), "Tie-break should be antisymmetric");
+    ts_increment(&a);
+    TEST_ASSERT_EQ(TS_AFTER, lamport_total_order(&a, &b), "Counters should decide before pids");
+    
+    ts_destroy(&a);
+    ts_destroy(&b);
+    return 1;
+}
+
+/* ---------- Serialization Tests ---------- */
+
+static int test_lamport_serialize() {
+    Timestamp ts = ts_create(64, 1, CLOCK_LAMPORT);
+    ts_increment(&ts);
+    
+    uint64_t buffer[2];
+    TEST_ASSERT_EQ(8, ts_serialize(&ts, NULL, 0), "Timestamps should be 8 bytes regardless of n");
+    size_t size = ts_serialize(&ts, buffer, sizeof(buffer));
+    
+    Timestamp copy = ts_create(64, 1, CLOCK_LAMPORT);
+    ts_deserialize(&copy, buffer, size);
+    TEST_ASSERT_EQ(TS_EQUAL, ts_compare(&ts, &copy), "Round trip should preserve the counter");
+    
+    // Wrong sizes are ignored
+    lamport_merge(&copy, buffer, 4);
+    lamport_deserialize(&copy, buffer, 16);
+    TEST_ASSERT(value_of(&copy) == 1, "Malformed sizes should be ignored");
+    
+    // Compact frames carry the counter as one varint
+    ts_set_wire_format(&ts, WIRE_COMPACT);
+    ts_set_wire_format(&copy, WIRE_COMPACT);
+    uint8_t frame[32];
+    size = ts_serialize(&ts, frame, sizeof(frame));
+    TEST_ASSERT(size < 8, "Compact frame should be smaller than the raw counter");
+    ts_merge_and_tick(&copy, frame, size);
+    TEST_ASSERT(value_of(&copy) == 2, "Compact frame should decode");
+    
+    ts_destroy(&ts);
+    ts_destroy(&copy);
+    return 1;
+}
+
+/* ---------- Report Tests ---------- */
+
+static int test_lamport_is_the_floor() {
+    TypeCost lamport = measure_type_cost(CLOCK_LAMPORT, 8, 2000, WIRE_RAW, 0);
+    TypeCost standard = measure_type_cost(CLOCK_STANDARD, 8, 2000, WIRE_RAW, 0);
+    
+    TEST_ASSERT(lamport.messages > 0, "Workload should send messages");
+    TEST_ASSERT_EQ(lamport.messages, standard.messages, "Every type should replay the same workload");
+    TEST_ASSERT(lamport.bytes_per_message == 8.0, "Lamport messages should carry 8 bytes");
+    TEST_ASSERT(standard.bytes_per_message > lamport.bytes_per_message,
+                "Standard clocks should cost more bytes than the floor");
+    return 1;
+}
+
+/* ---------- Test Runner ---------- */
+
+static void print_test_summary() {
+    printf("\n=== Test Summary ===\n");
+    printf("Tests run: %d\n", g_stats.tests_run);
+    printf("Tests passed: %d\n", g_stats.tests_passed);
+    printf("Tests failed: %d\n", g_stats.tests_failed);
+    printf("Success rate: %.1f%%\n", 
+           g_stats.tests_run > 0 ? (100.0 * g_stats.tests_passed / g_stats.tests_run) : 0.0);
+}
+
+int main() {
+    printf("=== Lamport Clock Test Suite ===\n\n");
+    
+    // Update Rule Tests
+    printf("--- Update Rule Tests ---\n");
+    RUN_TEST(test_lamport_update_rules);
+    RUN_TEST(test_lamport_counter_is_64_bit);
+    
+    // Ordering Tests
+    printf("\n--- Ordering Tests ---\n");
+    RUN_TEST(test_lamport_compare);
+    RUN_TEST(test_lamport_total_order);
+    
+    // Serialization Tests
+    printf("\n--- Serialization Tests ---\n");
+    RUN_TEST(test_lamport_serialize);
+    
+    // Report Tests
+    printf("\n--- Report Tests ---\n");
+    RUN_TEST(test_lamport_is_the_floor);
+    
+    print_test_summary();
+    
+    return g_stats.tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,324 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "logictime.hpp"
+
+extern "C" {
+#include "timestamp.h"
+#include "encoded_clock.h"
+}
+
+/* ---------- Test Framework ---------- */
+
+typedef struct {
+    int tests_run;
+    int tests_passed;
+    int tests_failed;
+    char current_test[256];
+} TestStats;
+
+static TestStats g_stats = {0, 0, 0, {0}};
+
+#define TEST_ASSERT(condition, message) do { \
+    if (!(condition)) { \
+        printf("FAIL: %s - %s\n", g_stats.current_test, message); \
+        g_stats.tests_failed++; \
+        return 0; \
+    } \
+} while(0)
+
+#define TEST_ASSERT_EQ(expected, actual, message) do { \
+    if ((expected) != (actual)) { \
+        printf("FAIL: %s - %s (expected: %d, actual: %d)\n", \
+               g_stats.current_test, message, (int)(expected), (int)(actual)); \
+        g_stats.tests_failed++; \
+        return 0; \
+    } \
+} while(0)
+
+#define RUN_TEST(test_func) do { \
+    snprintf(g_stats.current_test, sizeof(g_stats.current_test), #test_func); \
+    g_stats.tests_run++; \
+    if (test_func()) { \
+        printf("PASS: %s\n", #test_func); \
+        g_stats.tests_passed++; \
+    } \
+} while(0)
+
+using namespace logictime;
+
+/* ---------- Helper Functions ---------- */
+
+// Deterministic mixed workload on n C++ clocks of one representation, with the sends
+// of every fifth event delivered through serialize_for
+template <class C>
+static std::vector<C> run_workload(int n, int events, unsigned seed) {
+    std::vector<C> clocks;
+    for (int p = 0; p < n; p++) clocks.push_back(C(n, p));
+    for (int e = 0; e < events; e++) {
+        seed = seed * 1103515245u + 12345u;
+        int from = (int)(seed >> 16) % n, to = (int)(seed >> 8) % n;
+        clocks[from].tick();
+        if (from == to) continue;
+        std::vector<unsigned char> msg = e % 5 ? clocks[from].bytes() : clocks[from].bytes_for(to);
+        clocks[to].receive(msg.data(), msg.size());
+    }
+    return clocks;
+}
+
+// C++ clock (pid 0) and C clock (pid 1) take turns sending; after each receive the
+// receiver knows every entry but its own exactly as the sender has it
+template <class Rep>
+static bool exchange_with_c(int n, int rounds, bool use_dest) {
+    Clock<Rep> cpp(n, 0);
+    Timestamp c = ts_create(n, 1, (ClockType)Rep::clock_type);
+    std::vector<unsigned char> buffer(16 * n + 64);
+    std::vector<int> v(n);
+    bool ok = true;
+    
+    for (int r = 0; r < rounds && ok; r++) {
+        for (int i = 0; i <= r % 3; i++) cpp.tick();
+        std::vector<unsigned char> msg = use_dest ? cpp.bytes_for(1) : cpp.bytes();
+        ts_merge_and_tick(&c, msg.data(), msg.size());
+        ts_to_vector(&c, v.data());
+        for (int k = 0; k < n; k++) ok = ok && (k == 1 || v[k] == cpp[k]);
+    
+        ts_increment(&c);
+        size_t size = use_dest ? ts_serialize_for_dest(&c, 0, buffer.data(), buffer.size())
+                               : ts_serialize(&c, buffer.data(), buffer.size());
+        ok = ok && cpp.receive(buffer.data(), size);
+        ts_to_vector(&c, v.data());
+        for (int k = 1; k < n; k++) ok = ok && cpp[k] == v[k];
+    }
+    ts_destroy(&c);
+    return ok;
+}
+
+/* ---------- Kernel Tests ---------- */
+
+static int test_fixed_matches_dynamic() {
+    // The unrolled (N = 8) and looped (dynamic) kernels see the same events
+    std::vector<Clock<Dense>> dyn = run_workload<Clock<Dense>>(8, 500, 7u);
+    std::vector<Clock<Dense, 8>> fixed = run_workload<Clock<Dense, 8>>(8, 500, 7u);
+    for (int p = 0; p < 8; p++) {
+        for (int k = 0; k < 8; k++) {
+            TEST_ASSERT_EQ(dyn[p][k], fixed[p][k], "Fixed and dynamic N should agree");
+        }
+        for (int q = 0; q < 8; q++) {
+            TEST_ASSERT(dyn[p].compare(dyn[q]) == fixed[p].compare(fixed[q]), "Orders should agree");
+        }
+    }
+    
+    // Every representation tracks the same causality on the same workload
+    std::vector<Clock<Sparse, 8>> sparse = run_workload<Clock<Sparse, 8>>(8, 500, 7u);
+    std::vector<Clock<Differential, 8>> diff = run_workload<Clock<Differential, 8>>(8, 500, 7u);
+    std::vector<Clock<Compressed, 8>> comp = run_workload<Clock<Compressed, 8>>(8, 500, 7u);
+    std::vector<Clock<Encoded, 8>> enc = run_workload<Clock<Encoded, 8>>(8, 500, 7u);
+    for (int p = 0; p < 8; p++) {
+        for (int k = 0; k < 8; k++) {
+            TEST_ASSERT_EQ(fixed[p][k], sparse[p][k], "Sparse should match dense");
+            TEST_ASSERT_EQ(fixed[p][k], diff[p][k], "Differential should match dense");
+            TEST_ASSERT_EQ(fixed[p][k], comp[p][k], "Compressed should match dense");
+            TEST_ASSERT_EQ(fixed[p][k], enc[p][k], "Encoded should match dense");
+        }
+        TEST_ASSERT(sparse[p].compare(sparse[0]) == fixed[p].compare(fixed[0]), "Sparse order");
+    }
+    return 1;
+}
+
+static int test_compare_orders() {
+    Clock<Dense, 3> a(0), b(1);
+    TEST_ASSERT(a.compare(b) == Order::equal, "Fresh clocks should be equal");
+    a.tick();
+    TEST_ASSERT(a.compare(b) == Order::after, "a should be after b");
+    TEST_ASSERT(b.compare(a) == Order::before, "b should be before a");
+    b.tick();
+    TEST_ASSERT(a.compare(b) == Order::concurrent, "Independent ticks are concurrent");
+    TEST_ASSERT_EQ(TS_CONCURRENT, (int)a.compare(b), "Order values should match TSOrder");
+    
+    Clock<Dense> x(3, 0), y(4, 0);
+    bool thrown = false;
+    try {
+        x.compare(y);
+    } catch (const std::invalid_argument &) {
+        thrown = true;
+    }
+    TEST_ASSERT(thrown, "Comparing clocks of different n should throw");
+    return 1;
+}
+
+static int test_prime_table() {
+    static_assert(detail::fixed_primes<8>[7] == 19, "primes are computed at compile time");
+    const uint32_t *c_primes = encoded_primes(100);
+    const uint32_t *cpp_primes = detail::runtime_primes(100);
+    for (int i = 0; i < 100; i++) {
+        TEST_ASSERT_EQ(c_primes[i], cpp_primes[i], "Prime tables should match encoded_primes");
+    }
+    return 1;
+}
+
+/* ---------- Value Semantics Tests ---------- */
+
+static int test_move_and_copy() {
+    static_assert(std::is_nothrow_move_constructible<Clock<Compressed>>::value, "moves do not throw");
+    static_assert(std::is_nothrow_move_assignable<Clock<Sparse, 4>>::value, "moves do not throw");
+    
+    Clock<Compressed> a(64, 3);
+    a.tick();
+    Clock<Compressed> copy = a;
+    copy.tick();
+    TEST_ASSERT_EQ(1, a[3], "Copies should not share counters");
+    TEST_ASSERT_EQ(2, copy[3], "Copy should keep its own tick");
+    
+    Clock<Compressed> moved = std::move(copy);
+    TEST_ASSERT_EQ(2, moved[3], "Move should carry the counters");
+    TEST_ASSERT_EQ(64, moved.n(), "Move should carry n");
+    TEST_ASSERT_EQ(3, moved.pid(), "Move should carry pid");
+    return 1;
+}
+
+/* ---------- Interop Tests ---------- */
+
+static int test_dense_interop() {
+    TEST_ASSERT(exchange_with_c<Dense>(5, 20, false), "Dense and standard clocks should interoperate");
+    
+    // The C clock's 64-bit layout is read while the counters still fit an int
+    Clock<Dense> clock(2, 0);
+    uint64_t wide[2] = {7, 9};
+    TEST_ASSERT(clock.merge(wide, sizeof(wide)), "64-bit counters in range should merge");
+    TEST_ASSERT_EQ(9, clock[1], "64-bit counter should be read");
+    wide[1] = (uint64_t)INT32_MAX + 1;
+    TEST_ASSERT(!clock.merge(wide, sizeof(wide)), "Counters past an int should be refused");
+    TEST_ASSERT_EQ(7, clock[0], "Refused message should change nothing");
+    return 1;
+}
+
+static int test_sparse_interop() {
+    TEST_ASSERT(exchange_with_c<Sparse>(100, 20, false), "Sparse clocks should interoperate");
+    return 1;
+}
+
+static int test_differential_interop() {
+    TEST_ASSERT(exchange_with_c<Differential>(6, 20, false), "Full vectors should interoperate");
+    TEST_ASSERT(exchange_with_c<Differential>(64, 20, true), "Pair deltas should interoperate");
+    
+    // Only entries updated since the last send to dest go out
+    Clock<Differential> clock(64, 0);
+    clock.tick();
+    std::vector<unsigned char> first = clock.bytes_for(1);
+    TEST_ASSERT_EQ(2 * sizeof(int32_t), first.size(), "First send should carry one pair");
+    std::vector<unsigned char> again = clock.bytes_for(1);
+    TEST_ASSERT_EQ(2 * sizeof(int32_t), again.size(), "The sender's own entry always goes");
+    
+    // A size query must not advance the per-destination state
+    clock.tick();
+    int32_t pair[2];
+    TEST_ASSERT_EQ(sizeof(pair), clock.serialize_for(2, pair, 1), "Size query returns the size");
+    TEST_ASSERT_EQ(sizeof(pair), clock.serialize_for(2, pair, sizeof(pair)), "Write after query");
+    return 1;
+}
+
+static int test_compressed_interop() {
+    TEST_ASSERT(exchange_with_c<Compressed>(6, 20, false), "Full vectors should interoperate");
+    TEST_ASSERT(exchange_with_c<Compressed>(64, 30, true), "Tagged deltas should interoperate");
+    
+    // Bitmap frame, as a C sender picks for dense deltas
+    Clock<Compressed> clock(40, 0);
+    int32_t frame[1 + 2 + 3];
+    frame[0] = (int32_t)((detail::compressed_enc_bitmap << detail::compressed_tag_shift) | 3u);
+    frame[1] = (int32_t)((1u << 2) | (1u << 5));
+    frame[2] = (int32_t)(1u << 1);  // pid 33
+    frame[3] = 4;
+    frame[4] = 6;
+    frame[5] = 8;
+    TEST_ASSERT(clock.merge(frame, sizeof(frame)), "Bitmap frame should merge");
+    TEST_ASSERT(clock[2] == 4 && clock[5] == 6 && clock[33] == 8, "Bitmap values land by pid");
+    return 1;
+}
+
+static int test_encoded_interop() {
+    TEST_ASSERT(exchange_with_c<Encoded>(4, 6, false), "64-bit products should interoperate");
+    TEST_ASSERT(exchange_with_c<Encoded>(12, 30, false), "Limb products should interoperate");
+    TEST_ASSERT(exchange_with_c<Encoded>(3, 40, false), "Vector form should interoperate");
+    
+    // Byte-identical to the C encoding for the same counters
+    Clock<Encoded> cpp(10, 0);
+    Timestamp c = ts_create(10, 0, CLOCK_ENCODED);
+    for (int i = 0; i < 9; i++) {
+        cpp.tick();
+        ts_increment(&c);
+    }
+    std::vector<unsigned char> mine = cpp.bytes();
+    std::vector<unsigned char> theirs(ts_serialize(&c, NULL, 0));
+    ts_serialize(&c, theirs.data(), theirs.size());
+    TEST_ASSERT(mine == theirs, "Products should serialize identically");
+    ts_destroy(&c);
+    return 1;
+}
+
+static int test_malformed_ignored() {
+    unsigned char junk[13] = {0};
+    Clock<Dense> dense(4, 0);
+    Clock<Sparse> sparse(4, 0);
+    Clock<Differential> diff(6, 0);
+    Clock<Compressed> comp(8, 0);
+    Clock<Encoded> enc(4, 0);
+    TEST_ASSERT(!dense.merge(junk, sizeof(junk)), "Dense should refuse odd sizes");
+    TEST_ASSERT(!sparse.merge(junk, sizeof(junk)), "Sparse should refuse odd sizes");
+    TEST_ASSERT(!diff.merge(junk, sizeof(junk)), "Differential should refuse odd sizes");
+    TEST_ASSERT(!comp.merge(junk, sizeof(junk)), "Compressed should refuse odd sizes");
+    TEST_ASSERT(!enc.merge(junk, sizeof(junk)), "Encoded should refuse odd sizes");
+    
+    int32_t pairs[4] = {1, 5, 9, 5};  // pid 9 out of range
+    TEST_ASSERT(!sparse.merge(pairs, sizeof(pairs)), "Sparse should refuse bad pids");
+    TEST_ASSERT(!diff.merge(pairs, sizeof(pairs)), "Differential should refuse bad pids");
+    TEST_ASSERT_EQ(0, diff[1], "Refused message should change nothing");
+    
+    uint64_t zero = 0, foreign = 2ull * 3 * 11;  // 11 is not one of four processes' primes
+    TEST_ASSERT(!enc.merge(&zero, sizeof(zero)), "Encoded should refuse a zero product");
+    TEST_ASSERT(!enc.merge(&foreign, sizeof(foreign)), "Encoded should refuse foreign factors");
+    TEST_ASSERT_EQ(0, enc[0], "Refused product should change nothing");
+    
+    int32_t frame[3] = {(int32_t)((detail::compressed_enc_pairs << detail::compressed_tag_shift) | 1u), 8, 1};
+    TEST_ASSERT(!comp.merge(frame, sizeof(frame)), "Compressed should refuse bad pids");
+    return 1;
+}
+
+/* ---------- Test Runner ---------- */
+
+static void print_test_summary() {
+    printf("\n=== Test Summary ===\n");
+    printf("Tests run: %d\n", g_stats.tests_run);
+    printf("Tests passed: %d\n", g_stats.tests_passed);
+    printf("Tests failed: %d\n", g_stats.tests_failed);
+    printf("Success rate: %.1f%%\n", 
+           g_stats.tests_run > 0 ? (100.0 * g_stats.tests_passed / g_stats.tests_run) : 0.0);
+}
+
+int main() {
+    printf("=== C++ Clock API Test Suite ===\n\n");
+    
+    // Kernel Tests
+    printf("--- Kernel Tests ---\n");
+    RUN_TEST(test_fixed_matches_dynamic);
+    RUN_TEST(test_compare_orders);
+    RUN_TEST(test_prime_table);
+    
+    // Value Semantics Tests
+    printf("\n--- Value Semantics Tests ---\n");
+    RUN_TEST(test_move_and_copy);
+    
+    // Interop Tests
+    printf("\n--- Interop Tests ---\n");
+    RUN_TEST(test_dense_interop);
+    RUN_TEST(test_sparse_interop);
+    RUN_TEST(test_differential_interop);
+    RUN_TEST(test_compressed_interop);
+    RUN_TEST(test_encoded_interop);
+    RUN_TEST(test_malformed_ignored);
+    
+    print_test_summary();
+    
+    return g_stats.tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,316 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "timestamp.h"
+#include "matrix_clock.h"
+
+/* ---------- Test Framework ---------- */
+
+typedef struct {
+    int tests_run;
+    int tests_passed;
+    int tests_failed;
+    char current_test[256];
+} TestStats;
+
+static TestStats g_stats = {0};
+
+#define TEST_ASSERT(condition, message) do { \
+    if (!(condition)) { \
+        printf("FAIL: %s - %s\n", g_stats.current_test, message); \
+        g_stats.tests_failed++; \
+        return 0; \
+    } \
+} while(0)
+
+#define TEST_ASSERT_EQ(expected, actual, message) do { \
+    if ((expected) != (actual)) { \
+        printf("FAIL: %s - %s (expected: %d, actual: %d)\n", \
+               g_stats.current_test, message, (int)(expected), (int)(actual)); \
+        g_stats.tests_failed++; \
+        return 0; \
+    } \
+} while(0)
+
+#define RUN_TEST(test_func) do { \
+    snprintf(g_stats.current_test, sizeof(g_stats.current_test), #test_func); \
+    g_stats.tests_run++; \
+    if (test_func()) { \
+        printf("PASS: %s\n", #test_func); \
+        g_stats.tests_passed++; \
+    } \
+} while(0)
+
+/* ---------- Helpers ---------- */
+
+static int cell(const Timestamp *ts, int i, int k) {
+    const MatrixClockData *data = (const MatrixClockData*)ts->data;
+    return data->m[i * ts->n + k];
+}
+
+// Sends from one clock to another through the destination-aware path, as the simulator does
+static size_t send_delta(Timestamp *from, Timestamp *to) {
+    uint8_t buffer[1 << 16];
+    size_t size = ts_serialize_for_dest(from, to->pid, buffer, sizeof(buffer));
+    ts_merge_and_tick(to, buffer, size);
+    return size;
+}
+
+static size_t send_full(Timestamp *from, Timestamp *to) {
+    uint8_t buffer[1 << 16];
+    size_t size = ts_serialize(from, buffer, sizeof(buffer));
+    ts_merge_and_tick(to, buffer, size);
+    return size;
+}
+
+/* ---------- Basic Tests ---------- */
+
+static int test_matrix_increment_and_compare() {
+    Timestamp a = ts_create(3, 0, CLOCK_MATRIX);
+    Timestamp b = ts_create(3, 1, CLOCK_MATRIX);
+    ts_increment(&a);
+    ts_increment(&a);
+    
+    int v[3];
+    ts_to_vector(&a, v);
+    TEST_ASSERT_EQ(2, v[0], "Own row should count local events");
+    TEST_ASSERT_EQ(0, v[1] + v[2], "Other entries should stay zero");
+    TEST_ASSERT_EQ(TS_AFTER, ts_compare(&a, &b), "Busy clock should follow an idle one");
+    
+    send_full(&a, &b);
+    TEST_ASSERT_EQ(TS_BEFORE, ts_compare(&a, &b), "Receive should follow the send");
+    TEST_ASSERT_EQ(2, cell(&b, 0, 0), "Receiver should learn the sender's row");
+    TEST_ASSERT_EQ(2, cell(&b, 1, 0), "Receiver's own row should include the sender's events");
+    TEST_ASSERT_EQ(1, cell(&b, 1, 1), "Receive should count as an event");
+    
+    ts_destroy(&a);
+    ts_destroy(&b);
+    return 1;
+}
+
+static int test_matrix_min_known() {
+    const int n = 3;
+    Timestamp p[3];
+    for (int i = 0; i < n; i++) p[i] = ts_create(n, i, CLOCK_MATRIX);
+    
+    ts_increment(&p[0]);
+    TEST_ASSERT_EQ(0, ts_min_known(&p[0], 0), "Nobody else has seen P0's event yet");
+    
+    // P0 -> P1 -> P2 -> P0: P0 then knows that everyone has seen its first event
+    send_delta(&p[0], &p[1]);
+    TEST_ASSERT_EQ(0, ts_min_known(&p[1], 0), "P1 does not know whether P2 has seen it");
+    send_delta(&p[1], &p[2]);
+    TEST_ASSERT_EQ(1, matrix_min_known(&p[2], 0), "P2 should know that P0, P1 and itself have");
+    TEST_ASSERT_EQ(0, ts_min_known(&p[0], 0), "P0 has heard nothing back yet");
+    send_delta(&p[2], &p[0]);
+    TEST_ASSERT_EQ(1, ts_min_known(&p[0], 0), "P0 should know all processes saw its first event");
+    TEST_ASSERT_EQ(0, ts_min_known(&p[0], 2), "P1 had not seen P2's send when it last told anyone");
+    
+    for (int i = 0; i < n; i++) ts_destroy(&p[i]);
+    return 1;
+}
+
+/* ---------- Delta Tests ---------- */
+
+static int test_matrix_delta_carries_changes_only() {
+    const int n = 256;
+    Timestamp a = ts_create(n, 0, CLOCK_MATRIX);
+    Timestamp b = ts_create(n, 1, CLOCK_MATRIX);
+    
+    ts_increment(&a);
+    size_t first = send_delta(&a, &b);
+    TEST_ASSERT(first < 64, "First send should carry the one changed cell");
+    
+    ts_increment(&a);
+    ts_increment(&a);
+    uint8_t buffer[64];
+    size_t query = ts_serialize_for_dest(&a, 1, NULL, 0);
+    TEST_ASSERT_EQ(query, ts_serialize_for_dest(&a, 1, NULL, 0), "Size queries should not consume state");
+    size_t second = ts_serialize_for_dest(&a, 1, buffer, sizeof(buffer));
+    TEST_ASSERT_EQ(query, second, "Written size should match the query");
+    TEST_ASSERT_EQ(6 * sizeof(uint32_t), second, "One changed cell: header, row and pair");
+    ts_merge_and_tick(&b, buffer, second);
+    TEST_ASSERT_EQ(3, cell(&b, 0, 0), "Delta should carry the new value");
+    
+    // Nothing changed since: an empty delta
+    TEST_ASSERT_EQ(2 * sizeof(uint32_t), ts_serialize_for_dest(&a, 1, buffer, sizeof(buffer)),
+                   "Unchanged clock should send an empty delta");
+    
+    ts_destroy(&a);
+    ts_destroy(&b);
+    return 1;
+}
+
+static int test_matrix_delta_matches_full() {
+    // The same random run twice: once with destination-aware deltas, once with full
+    // matrices. FIFO delivery is immediate here, so both must end in the same state.
+    const int n = 6;
+    Timestamp delta[6], full[6];
+    for (int i = 0; i < n; i++) {
+        delta[i] = ts_create(n, i, CLOCK_MATRIX);
+        full[i] = ts_create(n, i, CLOCK_MATRIX);
+    }
+    
+    srand(7);
+    size_t delta_bytes = 0, full_bytes = 0;
+    for (int step = 0; step < 400; step++) {
+        int from = rand() % n, to = rand() % n;
+        if (rand() % 3 == 0 || from == to) {
+            ts_increment(&delta[from]);
+            ts_increment(&full[from]);
+            continue;
+        }
+        delta_bytes += send_delta(&delta[from], &delta[to]);
+        full_bytes += send_full(&full[from], &full[to]);
+    }
+    
+    for (int i = 0; i < n; i++) {
+        const MatrixClockData *d = (const MatrixClockData*)delta[i].data;
+        const MatrixClockData *f = (const MatrixClockData*)full[i].data;
+        TEST_ASSERT(memcmp(d->m, f->m, n * n * sizeof(int)) == 0, "Deltas should rebuild the full matrix");
+    }
+    TEST_ASSERT(delta_bytes < full_bytes, "Deltas should be smaller than full matrices");
+    
+    for (int i = 0; i < n; i++) {
+        ts_destroy(&delta[i]);
+        ts_destroy(&full[i]);
+    }
+    return 1;
+}
+
+static int test_matrix_row_merge_stamps_grown_cells() {
+    // 100 cells: one full 64-cell block and a 36-cell tail
+    enum { N = 100 };
+    Timestamp ts = ts_create(N, 0, CLOCK_MATRIX);
+    int base[N], incoming[N];
+    for (int k = 0; k < N; k++) base[k] = k % 7;
+    ts_merge(&ts, base, sizeof(base));
+    
+    MatrixClockData *data = (MatrixClockData*)ts.data;
+    memset(data->stamp, 0, N * sizeof(unsigned));
+    data->epoch = 5;
+    
+    // Lower, equal and larger cells in both blocks; the first block also ends concurrent
+    memcpy(incoming, base, sizeof(incoming));
+    const int grown[] = {3, 63, 64, 99};
+    for (int g = 0; g < 4; g++) incoming[grown[g]] += 10;
+    incoming[1] = 0;
+    incoming[70] = 0;
+    ts_merge(&ts, incoming, sizeof(incoming));
+    
+    for (int k = 0, g = 0; k < N; k++) {
+        int is_grown = g < 4 && grown[g] == k;
+        TEST_ASSERT_EQ(is_grown ? base[k] + 10 : base[k], cell(&ts, 0, k), "Row should be the cell-wise max");
+        TEST_ASSERT_EQ(is_grown ? 5 : 0, data->stamp[k], "Only grown cells should be restamped");
+        g += is_grown;
+    }
+    TEST_ASSERT_EQ(5, data->row_stamp[0], "Row stamp should follow its cells");
+    
+    int sum = 0;
+    for (int k = 0; k < N; k++) sum += cell(&ts, 0, k);
+    TEST_ASSERT(ts.digest.sum == (uint64_t)sum, "Digest should follow the own row");
+    
+    ts_destroy(&ts);
+    return 1;
+}
+
+static int test_matrix_compact_round_trip() {
+    Timestamp a = ts_create(4, 0, CLOCK_MATRIX);
+    Timestamp b = ts_create(4, 1, CLOCK_MATRIX);
+    ts_set_wire_format(&a, WIRE_COMPACT);
+    ts_set_wire_format(&b, WIRE_COMPACT);
+    for (int i = 0; i < 3; i++) ts_increment(&a);
+    
+    send_delta(&a, &b);
+    TEST_ASSERT_EQ(3, cell(&b, 0, 0), "Compact delta should decode");
+    TEST_ASSERT_EQ(TS_BEFORE, ts_compare(&a, &b), "Receive should follow the send");
+    
+    ts_destroy(&a);
+    ts_destroy(&b);
+    return 1;
+}
+
+static int test_matrix_malformed_ignored() {
+    Timestamp ts = ts_create(4, 0, CLOCK_MATRIX);
+    ts_increment(&ts);
+    
+    // Sender out of range, truncated delta, column out of range
+    uint32_t bad_sender[3] = {MATRIX_TAG_DELTA | 9, 0, 0};
+    uint32_t truncated[5] = {MATRIX_TAG_DELTA | 1, 2, 1, 1, 3};
+    uint32_t bad_column[6] = {MATRIX_TAG_DELTA | 1, 1, 1, 1, 4, 7};
+    ts_merge(&ts, bad_sender, sizeof(bad_sender));
+    ts_merge(&ts, truncated, sizeof(truncated));
+    ts_merge(&ts, bad_column, sizeof(bad_column));
+    
+    const MatrixClockData *data = (const MatrixClockData*)ts.data;
+    int total = 0;
+    for (int c = 0; c < 16; c++) total += data->m[c];
+    TEST_ASSERT_EQ(1, total, "Malformed frames should change nothing");
+    
+    ts_destroy(&ts);
+    return 1;
+}
+
+/* ---------- Copy Tests ---------- */
+
+static int test_matrix_clone_is_independent() {
+    ClockArena arena;
+    clock_arena_init(&arena, 0);
+    Timestamp a = ts_create_in(&arena, 5, 2, CLOCK_MATRIX);
+    Timestamp b = ts_create(5, 3, CLOCK_MATRIX);
+    ts_increment(&a);
+    send_delta(&a, &b);
+    
+    Timestamp c = ts_clone_in(&arena, &a);
+    TEST_ASSERT_EQ(TS_EQUAL, ts_compare(&a, &c), "Clone should equal its source");
+    
+    // The clone keeps the send state: nothing new for P3
+    uint8_t buffer[256];
+    TEST_ASSERT_EQ(2 * sizeof(uint32_t), ts_serialize_for_dest(&c, 3, buffer, sizeof(buffer)),
+                   "Clone should remember what was sent");
+    ts_increment(&c);
+    TEST_ASSERT_EQ(TS_BEFORE, ts_compare(&a, &c), "Clone should not share state with its source");
+    
+    ts_destroy(&a);
+    ts_destroy(&b);
+    ts_destroy(&c);
+    clock_arena_release(&arena);
+    return 1;
+}
+
+/* ---------- Test Runner ---------- */
+
+static void print_test_summary() {
+    printf("\n=== Test Summary ===\n");
+    printf("Tests run: %d\n", g_stats.tests_run);
+    printf("Tests passed: %d\n", g_stats.tests_passed);
+    printf("Tests failed: %d\n", g_stats.tests_failed);
+    printf("Success rate: %.1f%%\n", 
+           g_stats.tests_run > 0 ? (100.0 * g_stats.tests_passed / g_stats.tests_run) : 0.0);
+}
+
+int main() {
+    printf("=== Matrix Clock Test Suite ===\n\n");
+    
+    // Basic Tests
+    printf("--- Basic Tests ---\n");
+    RUN_TEST(test_matrix_increment_and_compare);
+    RUN_TEST(test_matrix_min_known);
+    
+    // Delta Tests
+    printf("\n--- Delta Tests ---\n");
+    RUN_TEST(test_matrix_delta_carries_changes_only);
+    RUN_TEST(test_matrix_delta_matches_full);
+    RUN_TEST(test_matrix_row_merge_stamps_grown_cells);
+    RUN_TEST(test_matrix_compact_round_trip);
+    RUN_TEST(test_matrix_malformed_ignored);
+    
+    // Copy Tests
+    printf("\n--- Copy Tests ---\n");
+    RUN_TEST(test_matrix_clone_is_independent);
+    
+    print_test_summary();
+    
+    return g_stats.tests_failed > 0 ? 1 : 0;
+}
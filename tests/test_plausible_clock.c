@@ -0,0 +1,213 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "plausible_clock.h"
+#include "standard_clock.h"
+
+/* ---------- Test Framework ---------- */
+
+typedef struct {
+    int tests_run;
+    int tests_passed;
+    int tests_failed;
+    char current_test[256];
+} TestStats;
+
+static TestStats g_stats = {0};
+
+#define TEST_ASSERT(condition, message) do { \
+    if (!(condition)) { \
+        printf("FAIL: %s - %s\n", g_stats.current_test, message); \
+        g_stats.tests_failed++; \
+        return 0; \
+    } \
+} while(0)
+
+#define TEST_ASSERT_EQ(expected, actual, message) do { \
+    if ((expected) != (actual)) { \
+        printf("FAIL: %s - %s (expected: %d, actual: %d)\n", \
+               g_stats.current_test, message, (int)(expected), (int)(actual)); \
+        g_stats.tests_failed++; \
+        return 0; \
+    } \
+} while(0)
+
+#define RUN_TEST(test_func) do { \
+    snprintf(g_stats.current_test, sizeof(g_stats.current_test), #test_func); \
+    g_stats.tests_run++; \
+    if (test_func()) { \
+        printf("PASS: %s\n", #test_func); \
+        g_stats.tests_passed++; \
+    } \
+} while(0)
+
+/* ---------- Helper Functions ---------- */
+
+// Random events and messages driven identically over plausible and standard clocks.
+// Returns the number of concurrent pairs ordered by the plausible clocks, or -1 if a
+// causally related pair was reported wrongly.
+static int run_against_standard(int n, int entries, unsigned int seed) {
+    Timestamp pc[32], vec[32];
+    int false_orderings = 0;
+    assert(n <= 32);
+    
+    plausible_set_entries(entries);
+    for (int i = 0; i < n; i++) {
+        pc[i] = plausible_create(n, i, CLOCK_PLAUSIBLE);
+        vec[i] = standard_create(n, i, CLOCK_STANDARD);
+    }
+    
+    for (int op = 0; op < 8 * n; op++) {
+        int p = rand_r(&seed) % n;
+        int q = rand_r(&seed) % n;
+        plausible_increment(&pc[p]);
+        standard_increment(&vec[p]);
+        if (p != q && rand_r(&seed) % 2) {
+            int buf[32];
+            plausible_serialize(&pc[p], buf, sizeof(buf));
+            plausible_merge(&pc[q], buf, plausible_serialize(&pc[p], NULL, 0));
+            standard_serialize(&vec[p], buf, sizeof(buf));
+            standard_merge(&vec[q], buf, n * sizeof(int));
+            plausible_increment(&pc[q]);
+            standard_increment(&vec[q]);
+        }
+    }
+    
+    for (int i = 0; i < n && false_orderings >= 0; i++) {
+        for (int j = 0; j < n; j++) {
+            TSOrder truth = standard_compare(&vec[i], &vec[j]);
+            TSOrder plausible = plausible_compare(&pc[i], &pc[j]);
+            if (truth == TS_CONCURRENT) {
+                if (plausible != TS_CONCURRENT) false_orderings++;
+            } else if (plausible != truth) {
+                false_orderings = -1;
+                break;
+            }
+        }
+    }
+    
+    for (int i = 0; i < n; i++) {
+        plausible_destroy(&pc[i]);
+        standard_destroy(&vec[i]);
+    }
+    plausible_set_entries(0);
+    return false_orderings;
+}
+
+/* ---------- Folding Tests ---------- */
+
+static int test_plausible_folding() {
+    plausible_set_entries(4);
+    Timestamp a = plausible_create(10, 5, CLOCK_PLAUSIBLE);
+    Timestamp b = plausible_create(10, 1, CLOCK_PLAUSIBLE);
+    plausible_set_entries(0);
+    
+    TEST_ASSERT_EQ(4 * sizeof(int), plausible_serialize(&a, NULL, 0), "Timestamps should hold R entries");
+    
+    plausible_increment(&a);
+    plausible_increment(&b);
+    int v[10];
+    plausible_to_vector(&a, v);
+    TEST_ASSERT_EQ(1, v[1], "P5 should tick entry 5 % 4");
+    TEST_ASSERT_EQ(1, v[5], "Expansion should repeat folded entries");
+    TEST_ASSERT_EQ(0, v[0] + v[2] + v[3], "Other entries should be untouched");
+    
+    // Both processes reached the same folded state independently
+    TEST_ASSERT_EQ(TS_CONCURRENT, plausible_compare(&a, &b), "Equal folds from different processes are concurrent");
+    
+    plausible_destroy(&a);
+    plausible_destroy(&b);
+    return 1;
+}
+
+static int test_plausible_entries_capped_by_n() {
+    plausible_set_entries(64);
+    TEST_ASSERT_EQ(5, plausible_entries(5), "R should never exceed n");
+    TEST_ASSERT_EQ(64, plausible_entries(1000), "Configured R should apply to large n");
+    plausible_set_entries(0);
+    TEST_ASSERT_EQ(PLAUSIBLE_DEFAULT_ENTRIES, plausible_entries(1000), "0 should restore the default");
+    return 1;
+}
+
+/* ---------- Accuracy Tests ---------- */
+
+static int test_plausible_exact_when_r_covers_n() {
+    for (unsigned int seed = 1; seed <= 20; seed++) {
+        TEST_ASSERT_EQ(0, run_against_standard(12, 12, seed), "R >= n should be exact");
+    }
+    return 1;
+}
+
+static int test_plausible_never_misorders_causality() {
+    int total = 0;
+    for (unsigned int seed = 1; seed <= 50; seed++) {
+        int false_orderings = run_against_standard(24, 3, seed);
+        TEST_ASSERT(false_orderings >= 0, "Causally related pairs must keep their order");
+        total += false_orderings;
+    }
+    TEST_ASSERT(total > 0, "Folding 24 processes into 3 entries should order some concurrent pairs");
+    return 1;
+}
+
+/* ---------- Serialization Tests ---------- */
+
+static int test_plausible_serialize() {
+    plausible_set_entries(3);
+    Timestamp ts = plausible_create(9, 4, CLOCK_PLAUSIBLE);
+    Timestamp copy = plausible_create(9, 4, CLOCK_PLAUSIBLE);
+    plausible_set_entries(0);
+    plausible_increment(&ts);
+    plausible_increment(&ts);
+    
+    int buf[8];
+    size_t size = plausible_serialize(&ts, buf, sizeof(buf));
+    plausible_deserialize(&copy, buf, size);
+    TEST_ASSERT_EQ(TS_EQUAL, plausible_compare(&ts, &copy), "Round trip should preserve the entries");
+    
+    // Timestamps of another R are ignored
+    int other[4] = {9, 9, 9, 9};
+    plausible_merge(&copy, other, sizeof(other));
+    TEST_ASSERT_EQ(TS_EQUAL, plausible_compare(&ts, &copy), "Mismatched sizes should be ignored");
+    
+    Timestamp clone = plausible_clone(&ts);
+    TEST_ASSERT_EQ(TS_EQUAL, plausible_compare(&ts, &clone), "Clone should keep R after the default changed");
+    
+    plausible_destroy(&ts);
+    plausible_destroy(&copy);
+    plausible_destroy(&clone);
+    return 1;
+}
+
+/* ---------- Test Runner ---------- */
+
+static void print_test_summary() {
+    printf("\n=== Test Summary ===\n");
+    printf("Tests run: %d\n", g_stats.tests_run);
+    printf("Tests passed: %d\n", g_stats.tests_passed);
+    printf("Tests failed: %d\n", g_stats.tests_failed);
+    printf("Success rate: %.1f%%\n", 
+           g_stats.tests_run > 0 ? (100.0 * g_stats.tests_passed / g_stats.tests_run) : 0.0);
+}
+
+int main() {
+    printf("=== Plausible Clock Test Suite ===\n\n");
+    
+    // Folding Tests
+    printf("--- Folding Tests ---\n");
+    RUN_TEST(test_plausible_folding);
+    RUN_TEST(test_plausible_entries_capped_by_n);
+    
+    // Accuracy Tests
+    printf("\n--- Accuracy Tests ---\n");
+    RUN_TEST(test_plausible_exact_when_r_covers_n);
+    RUN_TEST(test_plausible_never_misorders_causality);
+    
+    // Serialization Tests
+    printf("\n--- Serialization Tests ---\n");
+    RUN_TEST(test_plausible_serialize);
+    
+    print_test_summary();
+    
+    return g_stats.tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,259 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "sparse_clock.h"
+
+/* ---------- Test Framework ---------- */
+
+typedef struct {
+    int tests_run;
+    int tests_passed;
+    int tests_failed;
+    char current_test[256];
+} TestStats;
+
+static TestStats g_stats = {0};
+
+#define TEST_ASSERT(condition, message) do { \
+    if (!(condition)) { \
+        printf("FAIL: %s - %s\n", g_stats.current_test, message); \
+        g_stats.tests_failed++; \
+        return 0; \
+    } \
+} while(0)
+
+#define TEST_ASSERT_EQ(expected, actual, message) do { \
+    if ((expected) != (actual)) { \
+        printf("FAIL: %s - %s (expected: %d, actual: %d)\n", \
+               g_stats.current_test, message, (int)(expected), (int)(actual)); \
+        g_stats.tests_failed++; \
+        return 0; \
+    } \
+} while(0)
+
+#define RUN_TEST(test_func) do { \
+    snprintf(g_stats.current_test, sizeof(g_stats.current_test), #test_func); \
+    g_stats.tests_run++; \
+    if (test_func()) { \
+        printf("PASS: %s\n", #test_func); \
+        g_stats.tests_passed++; \
+    } \
+} while(0)
+
+/* ---------- Helper Functions ---------- */
+
+static void merge_from(Timestamp *dst, const Timestamp *src) {
+    SparseEntry buffer[64];
+    size_t size = sparse_serialize(src, buffer, sizeof(buffer));
+    sparse_merge(dst, buffer, size);
+}
+
+static int entries_sorted(const SparseClockData *data) {
+    for (int i = 1; i < data->count; i++) {
+        if (data->entries[i - 1].pid >= data->entries[i].pid) return 0;
+    }
+    return 1;
+}
+
+/* ---------- Data Structure Tests ---------- */
+
+static int test_sparse_create_inline() {
+    Timestamp ts = sparse_create(100000, 7, CLOCK_SPARSE);
+    SparseClockData *data = (SparseClockData*)ts.data;
+    
+    TEST_ASSERT(ts.n == 100000, "Process count should be 100000");
+    TEST_ASSERT_EQ(0, data->count, "New clock should have no entries");
+    TEST_ASSERT_EQ(SPARSE_INLINE_CAPACITY, data->capacity, "Capacity should start at the inline size");
+    TEST_ASSERT(data->entries == data->inline_entries, "Entries should use the inline buffer");
+    
+    sparse_destroy(&ts);
+    TEST_ASSERT(ts.data == NULL, "Data should be NULL after destruction");
+    return 1;
+}
+
+static int test_sparse_clone_outgrown() {
+    Timestamp a = sparse_create(64, 0, CLOCK_SPARSE);
+    for (int pid = 0; pid < 10; pid++) {
+        Timestamp other = sparse_create(64, pid * 3, CLOCK_SPARSE);
+        sparse_increment(&other);
+        merge_from(&a, &other);
+        sparse_destroy(&other);
+    }
+    
+    Timestamp clone = sparse_clone(&a);
+    SparseClockData *src = (SparseClockData*)a.data;
+    SparseClockData *dst = (SparseClockData*)clone.data;
+    
+    TEST_ASSERT(src->entries != src->inline_entries, "Ten entries should outgrow the inline buffer");
+    TEST_ASSERT(dst->entries != src->entries, "Clone should own its entries");
+    TEST_ASSERT_EQ(src->count, dst->count, "Clone should have the same entry count");
+    TEST_ASSERT_EQ(TS_EQUAL, sparse_compare(&a, &clone), "Clone should compare EQUAL");
+    
+    sparse_destroy(&a);
+    sparse_destroy(&clone);
+    return 1;
+}
+
+/* ---------- Ordering Tests ---------- */
+
+static int test_sparse_increment_keeps_order() {
+    int pids[] = {9, 2, 5, 0, 7, 3};
+    Timestamp acc = sparse_create(10, 1, CLOCK_SPARSE);
+    
+    for (int i = 0; i < 6; i++) {
+        Timestamp ts = sparse_create(10, pids[i], CLOCK_SPARSE);
+        sparse_increment(&ts);
+        merge_from(&acc, &ts);
+        sparse_destroy(&ts);
+    }
+    sparse_increment(&acc);  // inserts pid 1 between 0 and 2
+    
+    SparseClockData *data = (SparseClockData*)acc.data;
+    TEST_ASSERT_EQ(7, data->count, "Should have 7 entries");
+    TEST_ASSERT(entries_sorted(data), "Entries should be sorted by pid");
+    TEST_ASSERT_EQ(1, data->entries[1].pid, "pid 1 should be at index 1");
+    
+    sparse_increment(&acc);
+    TEST_ASSERT_EQ(2, data->entries[1].counter, "Existing entry should be found by binary search");
+    
+    sparse_destroy(&acc);
+    return 1;
+}
+
+static int test_sparse_serialize_sorted() {
+    Timestamp ts = sparse_create(10, 4, CLOCK_SPARSE);
+    SparseEntry incoming[] = {{8, 1}, {2, 3}, {6, 2}};  // unsorted input is accepted
+    sparse_merge(&ts, incoming, sizeof(incoming));
+    sparse_increment(&ts);
+    
+    SparseEntry buffer[8];
+    size_t size = sparse_serialize(&ts, buffer, sizeof(buffer));
+    
+    TEST_ASSERT_EQ(4 * sizeof(SparseEntry), size, "Should serialize 4 entries");
+    TEST_ASSERT_EQ(2, buffer[0].pid, "First pid should be 2");
+    TEST_ASSERT_EQ(4, buffer[1].pid, "Second pid should be 4");
+    TEST_ASSERT_EQ(6, buffer[2].pid, "Third pid should be 6");
+    TEST_ASSERT_EQ(8, buffer[3].pid, "Fourth pid should be 8");
+    
+    sparse_destroy(&ts);
+    return 1;
+}
+
+/* ---------- Merge Tests ---------- */
+
+static int test_sparse_merge_join() {
+    Timestamp a = sparse_create(10, 0, CLOCK_SPARSE);
+    SparseEntry a_entries[] = {{1, 4}, {3, 1}, {5, 2}};
+    SparseEntry b_entries[] = {{0, 1}, {3, 6}, {5, 1}, {9, 2}};
+    sparse_deserialize(&a, a_entries, sizeof(a_entries));
+    sparse_merge(&a, b_entries, sizeof(b_entries));
+    
+    SparseClockData *data = (SparseClockData*)a.data;
+    int expected_pid[] = {0, 1, 3, 5, 9};
+    int expected_counter[] = {1, 4, 6, 2, 2};
+    
+    TEST_ASSERT_EQ(5, data->count, "Union should have 5 entries");
+    for (int i = 0; i < 5; i++) {
+        TEST_ASSERT_EQ(expected_pid[i], data->entries[i].pid, "Merged pid mismatch");
+        TEST_ASSERT_EQ(expected_counter[i], data->entries[i].counter, "Merged counter should be the max");
+    }
+    
+    sparse_destroy(&a);
+    return 1;
+}
+
+static int test_sparse_merge_unsorted_input() {
+    // Repeated pids collapse to their largest counter; pids outside [0, n) are dropped
+    Timestamp a = sparse_create(8, 0, CLOCK_SPARSE);
+    SparseEntry a_entries[] = {{2, 5}, {6, 1}};
+    SparseEntry messy[] = {{6, 3}, {2, 1}, {6, 9}, {8, 7}, {-1, 4}, {2, 7}, {4, 2}, {4, 1}};
+    sparse_deserialize(&a, a_entries, sizeof(a_entries));
+    sparse_merge(&a, messy, sizeof(messy));
+    
+    SparseClockData *data = (SparseClockData*)a.data;
+    int expected_pid[] = {2, 4, 6};
+    int expected_counter[] = {7, 2, 9};
+    TEST_ASSERT_EQ(3, data->count, "Each pid should appear once");
+    TEST_ASSERT(entries_sorted(data), "Entries should stay strictly sorted");
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_EQ(expected_pid[i], data->entries[i].pid, "Merged pid mismatch");
+        TEST_ASSERT_EQ(expected_counter[i], data->entries[i].counter, "Merged counter should be the max");
+    }
+    
+    // The clock keeps working on the sorted entries
+    Timestamp b = sparse_create(8, 4, CLOCK_SPARSE);
+    sparse_deserialize(&b, messy, sizeof(messy));
+    TEST_ASSERT_EQ(TS_EQUAL, sparse_compare(&a, &b), "Deserialize should canonicalize alike");
+    sparse_increment(&b);
+    TEST_ASSERT_EQ(3, ((SparseClockData*)b.data)->count, "Increment should find the existing entry");
+    TEST_ASSERT_EQ(TS_BEFORE, sparse_compare(&a, &b), "Tick should order after");
+    int v[8];
+    sparse_to_vector(&b, v);
+    TEST_ASSERT_EQ(3, v[4], "Own entry should count the tick");
+    
+    sparse_destroy(&a);
+    sparse_destroy(&b);
+    return 1;
+}
+
+/* ---------- Comparison Tests ---------- */
+
+static int test_sparse_compare() {
+    Timestamp a = sparse_create(100000, 0, CLOCK_SPARSE);
+    Timestamp b = sparse_create(100000, 1, CLOCK_SPARSE);
+    
+    TEST_ASSERT_EQ(TS_EQUAL, sparse_compare(&a, &b), "Empty clocks should be equal");
+    
+    SparseEntry a_entries[] = {{10, 1}, {99999, 2}};
+    SparseEntry b_entries[] = {{10, 1}, {500, 1}, {99999, 2}};
+    sparse_deserialize(&a, a_entries, sizeof(a_entries));
+    sparse_deserialize(&b, b_entries, sizeof(b_entries));
+    TEST_ASSERT_EQ(TS_BEFORE, sparse_compare(&a, &b), "Missing pid counts as zero: a before b");
+    TEST_ASSERT_EQ(TS_AFTER, sparse_compare(&b, &a), "b should be after a");
+    
+    sparse_increment(&a);  // a gains pid 0, which b lacks
+    TEST_ASSERT_EQ(TS_CONCURRENT, sparse_compare(&a, &b), "Clocks should be concurrent");
+    
+    sparse_destroy(&a);
+    sparse_destroy(&b);
+    return 1;
+}
+
+/* ---------- Test Runner ---------- */
+
+static void print_test_summary() {
+    printf("\n=== Test Summary ===\n");
+    printf("Tests run: %d\n", g_stats.tests_run);
+    printf("Tests passed: %d\n", g_stats.tests_passed);
+    printf("Tests failed: %d\n", g_stats.tests_failed);
+    printf("Success rate: %.1f%%\n", 
+           g_stats.tests_run > 0 ? (100.0 * g_stats.tests_passed / g_stats.tests_run) : 0.0);
+}
+
+int main() {
+    printf("=== Sparse Clock Test Suite ===\n\n");
+    
+    // Data Structure Tests
+    printf("--- Data Structure Tests ---\n");
+    RUN_TEST(test_sparse_create_inline);
+    RUN_TEST(test_sparse_clone_outgrown);
+    
+    // Ordering Tests
+    printf("\n--- Ordering Tests ---\n");
+    RUN_TEST(test_sparse_increment_keeps_order);
+    RUN_TEST(test_sparse_serialize_sorted);
+    
+    // Merge Tests
+    printf("\n--- Merge Tests ---\n");
+    RUN_TEST(test_sparse_merge_join);
+    RUN_TEST(test_sparse_merge_unsorted_input);
+    
+    // Comparison Tests
+    printf("\n--- Comparison Tests ---\n");
+    RUN_TEST(test_sparse_compare);
+    
+    print_test_summary();
+    
+    return g_stats.tests_failed > 0 ? 1 : 0;
+}
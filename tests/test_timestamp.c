@@ -0,0 +1,308 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "timestamp.h"
+#include "compressed_clock.h"
+
+/* ---------- Test Framework ---------- */
+
+typedef struct {
+    int tests_run;
+    int tests_passed;
+    int tests_failed;
+    char current_test[256];
+} TestStats;
+
+static TestStats g_stats = {0};
+
+#define TEST_ASSERT(condition, message) do { \
+    if (!(condition)) { \
+        printf("FAIL: %s - %s\n", g_stats.current_test, message); \
+        g_stats.tests_failed++; \
+        return 0; \
+    } \
+} while(0)
+
+#define TEST_ASSERT_EQ(expected, actual, message) do { \
+    if ((expected) != (actual)) { \
+        printf("FAIL: %s - %s (expected: %d, actual: %d)\n", \
+               g_stats.current_test, message, (int)(expected), (int)(actual)); \
+        g_stats.tests_failed++; \
+        return 0; \
+    } \
+} while(0)
+
+#define RUN_TEST(test_func) do { \
+    snprintf(g_stats.current_test, sizeof(g_stats.current_test), #test_func); \
+    g_stats.tests_run++; \
+    if (test_func()) { \
+        printf("PASS: %s\n", #test_func); \
+        g_stats.tests_passed++; \
+    } \
+} while(0)
+
+/* ---------- Digest Tests ---------- */
+
+// Digest of a clock's dense vector, from scratch
+static int digest_matches_vector(const Timestamp *ts) {
+    int v[64];
+    ClockDigest d;
+    ts_to_vector(ts, v);
+    clock_digest_of_vector(&d, v, ts->n);
+    return d.sum == ts->digest.sum && d.max == ts->digest.max && d.hash == ts->digest.hash;
+}
+
+static int test_digest_tracks_every_type() {
+    // Per-destination and full sends between the types that keep a digest
+    enum { N = 12 };
+    const ClockType types[] = {CLOCK_STANDARD, CLOCK_SPARSE, CLOCK_DIFFERENTIAL, CLOCK_COMPRESSED,
+                               CLOCK_MATRIX};
+    
+    for (int t = 0; t < (int)(sizeof(types) / sizeof(types[0])); t++) {
+        Timestamp clocks[N];
+        unsigned int seed = 17;
+        for (int i = 0; i < N; i++) clocks[i] = ts_create(N, i, types[t]);
+        TEST_ASSERT(clocks[0].digest.valid, "Dense-vector types should keep a digest");
+        
+        for (int op = 0; op < 2000; op++) {
+            int p = rand_r(&seed) % N;
+            int q = rand_r(&seed) % N;
+            ts_increment(&clocks[p]);
+            if (p == q) continue;
+            
+            int buf[1 + N * N];
+            size_t size = op % 4 ? ts_serialize_for_dest(&clocks[p], q, buf, sizeof(buf))
+                                 : ts_serialize(&clocks[p], buf, sizeof(buf));
+            ts_merge_and_tick(&clocks[q], buf, size);
+            TEST_ASSERT(digest_matches_vector(&clocks[q]), "Merge should keep the digest exact");
+            
+            int r = rand_r(&seed) % N;
+            ts_set_digest_compare(0);
+            TSOrder scanned = ts_compare(&clocks[p], &clocks[r]);
+            ts_set_digest_compare(1);
+            TEST_ASSERT_EQ(scanned, ts_compare(&clocks[p], &clocks[r]), "Digest compare should agree");
+        }
+        
+        // Copies hash like their source whichever way they were made
+        Timestamp copy = ts_clone(&clocks[3]);
+        Timestamp loaded = ts_create(N, 3, types[t]);
+        int buf[1 + N * N];
+        ts_deserialize(&loaded, buf, ts_serialize(&clocks[3], buf, sizeof(buf)));
+        TEST_ASSERT(digest_matches_vector(&loaded), "Deserialize should rebuild the digest");
+        TEST_ASSERT_EQ(TS_EQUAL, ts_compare(&copy, &clocks[3]), "Clone should compare equal");
+        TEST_ASSERT(ts_hash(&copy) == ts_hash(&clocks[3]), "Clone should hash equally");
+        TEST_ASSERT(ts_hash(&loaded) == ts_hash(&clocks[3]), "Deserialized copy should hash equally");
+        ts_increment(&copy);
+        TEST_ASSERT(ts_hash(&copy) != ts_hash(&clocks[3]), "A tick should change the hash");
+        
+        ts_destroy(&copy);
+        ts_destroy(&loaded);
+        for (int i = 0; i < N; i++) ts_destroy(&clocks[i]);
+    }
+    return 1;
+}
+
+static int test_digest_compare_short_circuits() {
+    Timestamp a = ts_create(4, 0, CLOCK_DIFFERENTIAL);
+    Timestamp b = ts_create(4, 1, CLOCK_DIFFERENTIAL);
+    
+    // Equal sums: equal or concurrent, from the digests alone
+    ts_increment(&a);
+    ts_increment(&b);
+    TEST_ASSERT_EQ(TS_CONCURRENT, ts_compare(&a, &b), "Equal sums, different hashes");
+    int v[4] = {1, 1, 0, 0};
+    ts_deserialize(&a, v, sizeof(v));
+    ts_deserialize(&b, v, sizeof(v));
+    TEST_ASSERT_EQ(TS_EQUAL, ts_compare(&a, &b), "Equal sums and hashes");
+    TEST_ASSERT(ts_hash(&a) == ts_hash(&b), "Equal clocks should hash equally");
+    
+    // The smaller sum with the larger maximum: concurrent without a scan
+    int high[4] = {4, 0, 0, 0};
+    int wide[4] = {0, 2, 2, 1};
+    ts_deserialize(&a, high, sizeof(high));
+    ts_deserialize(&b, wide, sizeof(wide));
+    TEST_ASSERT(a.digest.sum < b.digest.sum && a.digest.max > b.digest.max, "[4,1,0,0] vs [1,2,2,1]");
+    TEST_ASSERT_EQ(TS_CONCURRENT, ts_compare(&a, &b), "Should be concurrent");
+    ts_set_digest_compare(0);
+    TSOrder scanned = ts_compare(&a, &b);
+    ts_set_digest_compare(1);
+    TEST_ASSERT_EQ(scanned, ts_compare(&a, &b), "Should match the scan");
+    
+    // Types without a digest hash their vector or serialization
+    Timestamp x = ts_create(4, 0, CLOCK_LAMPORT);
+    Timestamp y = ts_create(4, 0, CLOCK_LAMPORT);
+    TEST_ASSERT(!x.digest.valid, "Lamport clocks keep no digest");
+    ts_increment(&x);
+    ts_increment(&y);
+    TEST_ASSERT(ts_hash(&x) == ts_hash(&y), "Equal Lamport clocks should hash equally");
+    ts_increment(&y);
+    TEST_ASSERT(ts_hash(&x) != ts_hash(&y), "Different Lamport clocks should hash differently");
+    
+    ts_destroy(&a);
+    ts_destroy(&b);
+    ts_destroy(&x);
+    ts_destroy(&y);
+    return 1;
+}
+
+/* ---------- Deferred Receive Tests ---------- */
+
+#define INBOX_SLOTS 32
+#define MESSAGE_BYTES 512
+
+// Replays one seeded, receive-heavy event mix on eager and deferred copies of the same
+// processes: every message the deferred copies send has to match the eager one byte for
+// byte, and so do the clocks whenever they are compared
+static int deferred_matches_eager(ClockType type, int fixed) {
+    enum { N = 16 };
+    Timestamp eager[N], deferred[N];
+    ts_set_fixed_kernels(fixed);
+    for (int i = 0; i < N; i++) {
+        eager[i] = ts_create(N, i, type);
+        deferred[i] = ts_create(N, i, type);
+        ts_set_deferred(&deferred[i], 1);
+    }
+    ts_set_fixed_kernels(1);
+    TEST_ASSERT(ts_deferred(&deferred[0]), "Type should support deferred receives");
+    
+    // Per-process FIFO inboxes
+    unsigned char *inbox = malloc((size_t)N * INBOX_SLOTS * MESSAGE_BYTES);
+    size_t sizes[N][INBOX_SLOTS];
+    int head[N] = {0}, count[N] = {0};
+    unsigned int seed = 29;
+    
+    for (int op = 0; op < 4000; op++) {
+        int p = rand_r(&seed) % N;
+        int roll = rand_r(&seed) % 100;
+        
+        if (roll >= 40 && count[p] > 0) {
+            const unsigned char *m = inbox + ((size_t)p * INBOX_SLOTS + head[p]) * MESSAGE_BYTES;
+            ts_merge_and_tick(&eager[p], m, sizes[p][head[p]]);
+            ts_merge_and_tick(&deferred[p], m, sizes[p][head[p]]);
+            head[p] = (head[p] + 1) % INBOX_SLOTS;
+            count[p]--;
+            continue;
+        }
+        
+        int q = (p + 1 + rand_r(&seed) % (N - 1)) % N;
+        if (roll < 30 || count[q] == INBOX_SLOTS) {
+            ts_increment(&eager[p]);
+            ts_increment(&deferred[p]);
+        } else {
+            ts_increment(&eager[p]);
+            ts_increment(&deferred[p]);
+            int slot = (head[q] + count[q]) % INBOX_SLOTS;
+            unsigned char *m = inbox + ((size_t)q * INBOX_SLOTS + slot) * MESSAGE_BYTES;
+            unsigned char copy[MESSAGE_BYTES];
+            size_t size = op % 8 ? ts_serialize_for_dest(&eager[p], q, m, MESSAGE_BYTES)
+                                 : ts_serialize(&eager[p], m, MESSAGE_BYTES);
+            size_t copy_size = op % 8 ? ts_serialize_for_dest(&deferred[p], q, copy, sizeof(copy))
+                                      : ts_serialize(&deferred[p], copy, sizeof(copy));
+            TEST_ASSERT(size <= MESSAGE_BYTES && size == copy_size, "Messages should have the same size");
+            TEST_ASSERT(memcmp(m, copy, size) == 0, "Messages should be identical");
+            sizes[q][slot] = size;
+            count[q]++;
+        }
+        
+        if (op % 64 == 0) {
+            int r = rand_r(&seed) % N;
+            TEST_ASSERT_EQ(ts_compare(&eager[p], &eager[r]), ts_compare(&deferred[p], &deferred[r]),
+                           "Compare should see the queued events");
+        }
+    }
+    
+    for (int i = 0; i < N; i++) {
+        int a[N], b[N];
+        ts_to_vector(&eager[i], a);
+        ts_to_vector(&deferred[i], b);
+        TEST_ASSERT(memcmp(a, b, sizeof(a)) == 0, "Settled vectors should match");
+        TEST_ASSERT(ts_hash(&eager[i]) == ts_hash(&deferred[i]), "Settled digests should match");
+        ts_destroy(&eager[i]);
+        ts_destroy(&deferred[i]);
+    }
+    free(inbox);
+    return 1;
+}
+
+static int test_deferred_matches_eager() {
+    TEST_ASSERT(deferred_matches_eager(CLOCK_STANDARD, 0), "Standard, generic kernels");
+    TEST_ASSERT(deferred_matches_eager(CLOCK_STANDARD, 1), "Standard, fixed-n kernels");
+    TEST_ASSERT(deferred_matches_eager(CLOCK_DIFFERENTIAL, 0), "Differential, generic kernels");
+    TEST_ASSERT(deferred_matches_eager(CLOCK_DIFFERENTIAL, 1), "Differential, fixed-n kernels");
+    TEST_ASSERT(deferred_matches_eager(CLOCK_COMPRESSED, 1), "Compressed");
+    
+    // Value-delta frames cannot be gathered: they are merged in order
+    compressed_set_value_deltas(1);
+    int ok = deferred_matches_eager(CLOCK_COMPRESSED, 1);
+    compressed_set_value_deltas(0);
+    TEST_ASSERT(ok, "Compressed, value deltas");
+    return 1;
+}
+
+static int test_deferred_own_entry() {
+    // A message may claim more of the receiver's own events than it has had
+    const ClockType types[] = {CLOCK_STANDARD, CLOCK_DIFFERENTIAL, CLOCK_COMPRESSED};
+    int first[4] = {5, 1, 0, 0};
+    int second[4] = {2, 0, 3, 0};
+    int expected[4] = {8, 1, 3, 0};  // max(1, 5) + 1, + 1, max(7, 2) + 1
+    
+    for (int t = 0; t < 3; t++) {
+        Timestamp ts = ts_create(4, 0, types[t]);
+        ts_set_deferred(&ts, 1);
+        ts_increment(&ts);
+        ts_merge_and_tick(&ts, first, sizeof(first));
+        ts_increment(&ts);
+        ts_merge_and_tick(&ts, second, sizeof(second));
+        
+        int v[4];
+        ts_to_vector(&ts, v);
+        TEST_ASSERT(memcmp(v, expected, sizeof(v)) == 0, "Own entry should be replayed in order");
+        
+        // Settled clocks take further events as before; turning deferral off settles too
+        ts_increment(&ts);
+        ts_set_deferred(&ts, 0);
+        TEST_ASSERT(!ts_deferred(&ts), "Deferral should be off");
+        ts_to_vector(&ts, v);
+        TEST_ASSERT_EQ(9, v[0], "Tick before turning deferral off");
+        ts_destroy(&ts);
+    }
+    
+    // Types without gather stay eager
+    Timestamp sparse = ts_create(4, 0, CLOCK_SPARSE);
+    Timestamp hlc = ts_create(4, 0, CLOCK_HLC);
+    ts_set_deferred(&sparse, 1);
+    ts_set_deferred(&hlc, 1);
+    TEST_ASSERT(!ts_deferred(&sparse) && !ts_deferred(&hlc), "Sparse and HLC clocks stay eager");
+    ts_destroy(&sparse);
+    ts_destroy(&hlc);
+    return 1;
+}
+
+/* ---------- Test Runner ---------- */
+
+static void print_test_summary() {
+    printf("\n=== Test Summary ===\n");
+    printf("Tests run: %d\n", g_stats.tests_run);
+    printf("Tests passed: %d\n", g_stats.tests_passed);
+    printf("Tests failed: %d\n", g_stats.tests_failed);
+    printf("Success rate: %.1f%%\n", 
+           g_stats.tests_run > 0 ? (100.0 * g_stats.tests_passed / g_stats.tests_run) : 0.0);
+}
+
+int main() {
+    printf("=== Timestamp Test Suite ===\n\n");
+    
+    // Digest Tests
+    printf("--- Digest Tests ---\n");
+    RUN_TEST(test_digest_tracks_every_type);
+    RUN_TEST(test_digest_compare_short_circuits);
+    
+    // Deferred Receive Tests
+    printf("\n--- Deferred Receive Tests ---\n");
+    RUN_TEST(test_deferred_matches_eager);
+    RUN_TEST(test_deferred_own_entry);
+    
+    print_test_summary();
+    
+    return g_stats.tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,216 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "vector_kernels.h"
+
+/* ---------- Test Framework ---------- */
+
+typedef struct {
+    int tests_run;
+    int tests_passed;
+    int tests_failed;
+    char current_test[256];
+} TestStats;
+
+static TestStats g_stats = {0};
+
+#define TEST_ASSERT(condition, message) do { \
+    if (!(condition)) { \
+        printf("FAIL: %s - %s\n", g_stats.current_test, message); \
+        g_stats.tests_failed++; \
+        return 0; \
+    } \
+} while(0)
+
+#define TEST_ASSERT_EQ(expected, actual, message) do { \
+    if ((expected) != (actual)) { \
+        printf("FAIL: %s - %s (expected: %d, actual: %d)\n", \
+               g_stats.current_test, message, (int)(expected), (int)(actual)); \
+        g_stats.tests_failed++; \
+        return 0; \
+    } \
+} while(0)
+
+#define RUN_TEST(test_func) do { \
+    snprintf(g_stats.current_test, sizeof(g_stats.current_test), #test_func); \
+    g_stats.tests_run++; \
+    if (test_func()) { \
+        printf("PASS: %s\n", #test_func); \
+        g_stats.tests_passed++; \
+    } \
+} while(0)
+
+/* ---------- Helpers ---------- */
+
+// Odd lengths, lengths below one AVX2/AVX-512 step, and lengths one past a step
+static const int SIZES[] = {0, 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 33, 63, 64, 65, 131};
+#define SIZE_COUNT ((int)(sizeof(SIZES) / sizeof(SIZES[0])))
+#define MAX_N 131
+
+static void fill(int *v, int n, unsigned int *seed) {
+    for (int i = 0; i < n; i++) v[i] = rand_r(seed) % 50;
+}
+
+// The ISAs other than scalar this CPU can run
+static int other_isas(VkIsa *out) {
+    int count = 0;
+    for (int isa = VK_ISA_SCALAR + 1; isa < VK_ISA_COUNT; isa++) {
+        if (vk_isa_supported((VkIsa)isa)) out[count++] = (VkIsa)isa;
+    }
+    return count;
+}
+
+// b from a with the given relation: up raises entry i of b, down lowers entry j
+static void make_pair(int *a, int *b, int n, int up, int down, unsigned int *seed) {
+    fill(a, n, seed);
+    memcpy(b, a, n * sizeof(int));
+    if (up >= 0) b[up] += 1 + rand_r(seed) % 5;
+    if (down >= 0) b[down] -= 1 + rand_r(seed) % 5;
+}
+
+/* ---------- ISA Agreement Tests ---------- */
+
+static int test_merge_max_matches_scalar() {
+    VkIsa isas[VK_ISA_COUNT];
+    int count = other_isas(isas);
+    VkIsa initial = vk_active_isa();
+    unsigned int seed = 1;
+
+    for (int s = 0; s < SIZE_COUNT; s++) {
+        int n = SIZES[s];
+        int dst[MAX_N], src[MAX_N], expected[MAX_N], got[MAX_N];
+        fill(dst, n, &seed);
+        fill(src, n, &seed);
+
+        vk_force_isa(VK_ISA_SCALAR);
+        memcpy(expected, dst, n * sizeof(int));
+        vk_merge_max(expected, src, n);
+
+        for (int i = 0; i < count; i++) {
+            TEST_ASSERT(vk_force_isa(isas[i]), "Supported ISA should be selectable");
+            memcpy(got, dst, n * sizeof(int));
+            vk_merge_max(got, src, n);
+            TEST_ASSERT(memcmp(expected, got, n * sizeof(int)) == 0, vk_isa_name(isas[i]));
+        }
+    }
+
+    vk_force_isa(initial);
+    return 1;
+}
+
+static int test_compare_matches_scalar() {
+    VkIsa isas[VK_ISA_COUNT];
+    int count = other_isas(isas);
+    VkIsa initial = vk_active_isa();
+    unsigned int seed = 2;
+
+    for (int s = 0; s < SIZE_COUNT; s++) {
+        int n = SIZES[s];
+        if (n == 0) continue;
+        // EQUAL, BEFORE, AFTER, then CONCURRENT with both directions in the first lanes
+        // (the early exit), at the two ends, and at the tail past the last full step
+        const int cases[][2] = {
+            {-1, -1}, {n - 1, -1}, {-1, 0}, {0, n > 1 ? 1 : -1},
+            {n - 1, 0}, {n > 1 ? n - 2 : -1, n - 1}
+        };
+        for (int c = 0; c < (int)(sizeof(cases) / sizeof(cases[0])); c++) {
+            int a[MAX_N], b[MAX_N];
+            make_pair(a, b, n, cases[c][0], cases[c][1], &seed);
+
+            vk_force_isa(VK_ISA_SCALAR);
+            TSOrder expected = vk_compare(a, b, n);
+            for (int i = 0; i < count; i++) {
+                TEST_ASSERT(vk_force_isa(isas[i]), "Supported ISA should be selectable");
+                TEST_ASSERT_EQ(expected, vk_compare(a, b, n), vk_isa_name(isas[i]));
+            }
+        }
+    }
+
+    vk_force_isa(initial);
+    return 1;
+}
+
+static int test_accumulate_column_matches_scalar() {
+    VkIsa isas[VK_ISA_COUNT];
+    int count = other_isas(isas);
+    VkIsa initial = vk_active_isa();
+    unsigned int seed = 3;
+
+    for (int s = 0; s < SIZE_COUNT; s++) {
+        int rows = SIZES[s];
+        int col[MAX_N], q_gt0[MAX_N], col_gt0[MAX_N];
+        fill(col, rows, &seed);
+        // Flags are OR-accumulated, so start from a mix of set and clear ones
+        for (int r = 0; r < rows; r++) {
+            q_gt0[r] = rand_r(&seed) % 4 ? 0 : -1;
+            col_gt0[r] = rand_r(&seed) % 4 ? 0 : -1;
+        }
+        int q = col[rows / 2];
+
+        int q_exp[MAX_N], col_exp[MAX_N];
+        memcpy(q_exp, q_gt0, rows * sizeof(int));
+        memcpy(col_exp, col_gt0, rows * sizeof(int));
+        vk_force_isa(VK_ISA_SCALAR);
+        vk_accumulate_column(col, q, rows, q_exp, col_exp);
+
+        for (int i = 0; i < count; i++) {
+            int q_got[MAX_N], col_got[MAX_N];
+            memcpy(q_got, q_gt0, rows * sizeof(int));
+            memcpy(col_got, col_gt0, rows * sizeof(int));
+            TEST_ASSERT(vk_force_isa(isas[i]), "Supported ISA should be selectable");
+            vk_accumulate_column(col, q, rows, q_got, col_got);
+            TEST_ASSERT(memcmp(q_exp, q_got, rows * sizeof(int)) == 0, vk_isa_name(isas[i]));
+            TEST_ASSERT(memcmp(col_exp, col_got, rows * sizeof(int)) == 0, vk_isa_name(isas[i]));
+        }
+    }
+
+    vk_force_isa(initial);
+    return 1;
+}
+
+/* ---------- Dispatch Tests ---------- */
+
+static int test_force_isa() {
+    VkIsa initial = vk_active_isa();
+    TEST_ASSERT(vk_isa_supported(initial), "Dispatched ISA should be supported");
+    TEST_ASSERT(vk_force_isa(VK_ISA_SCALAR), "Scalar should always be available");
+    TEST_ASSERT_EQ(VK_ISA_SCALAR, vk_active_isa(), "Forced ISA should be active");
+    TEST_ASSERT(!vk_force_isa((VkIsa)VK_ISA_COUNT), "Unknown ISA should be refused");
+    TEST_ASSERT_EQ(VK_ISA_SCALAR, vk_active_isa(), "Refused ISA should leave dispatch alone");
+    vk_force_isa(initial);
+    return 1;
+}
+
+/* ---------- Test Runner ---------- */
+
+static void print_test_summary() {
+    printf("\n=== Test Summary ===\n");
+    printf("Tests run: %d\n", g_stats.tests_run);
+    printf("Tests passed: %d\n", g_stats.tests_passed);
+    printf("Tests failed: %d\n", g_stats.tests_failed);
+    printf("Success rate: %.1f%%\n",
+           g_stats.tests_run > 0 ? (100.0 * g_stats.tests_passed / g_stats.tests_run) : 0.0);
+}
+
+int main() {
+    printf("=== Vector Kernel Test Suite ===\n");
+    printf("Supported ISAs:");
+    for (int isa = 0; isa < VK_ISA_COUNT; isa++) {
+        if (vk_isa_supported((VkIsa)isa)) printf(" %s", vk_isa_name((VkIsa)isa));
+    }
+    printf("\n\n");
+
+    // ISA Agreement Tests
+    printf("--- ISA Agreement Tests ---\n");
+    RUN_TEST(test_merge_max_matches_scalar);
+    RUN_TEST(test_compare_matches_scalar);
+    RUN_TEST(test_accumulate_column_matches_scalar);
+
+    // Dispatch Tests
+    printf("\n--- Dispatch Tests ---\n");
+    RUN_TEST(test_force_isa);
+
+    print_test_summary();
+
+    return g_stats.tests_failed > 0 ? 1 : 0;
+}
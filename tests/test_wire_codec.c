@@ -0,0 +1,352 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "wire_codec.h"
+#include "timestamp.h"
+#include "compressed_clock.h"
+
+/* ---------- Test Framework ---------- */
+
+typedef struct {
+    int tests_run;
+    int tests_passed;
+    int tests_failed;
+    char current_test[256];
+} TestStats;
+
+static TestStats g_stats = {0};
+
+#define TEST_ASSERT(condition, message) do { \
+    if (!(condition)) { \
+        printf("FAIL: %s - %s\n", g_stats.current_test, message); \
+        g_stats.tests_failed++; \
+        return 0; \
+    } \
+} while(0)
+
+#define TEST_ASSERT_EQ(expected, actual, message) do { \
+    if ((expected) != (actual)) { \
+        printf("FAIL: %s - %s (expected: %d, actual: %d)\n", \
+               g_stats.current_test, message, (int)(expected), (int)(actual)); \
+        g_stats.tests_failed++; \
+        return 0; \
+    } \
+} while(0)
+
+#define RUN_TEST(test_func) do { \
+    snprintf(g_stats.current_test, sizeof(g_stats.current_test), #test_func); \
+    g_stats.tests_run++; \
+    if (test_func()) { \
+        printf("PASS: %s\n", #test_func); \
+        g_stats.tests_passed++; \
+    } \
+} while(0)
+
+/* ---------- Helper Functions ---------- */
+
+// Builds a clock that has seen a few events from several processes
+static Timestamp make_busy_clock(int n, int pid, ClockType type) {
+    Timestamp ts = ts_create(n, pid, type);
+    for (int src = 0; src < n; src += 2) {
+        Timestamp other = ts_create(n, src, type);
+        for (int i = 0; i <= src % 3; i++) ts_increment(&other);
+        
+        unsigned char buffer[1024];
+        size_t size = ts_serialize(&other, buffer, sizeof(buffer));
+        ts_merge(&ts, buffer, size);
+        ts_destroy(&other);
+    }
+    ts_increment(&ts);
+    return ts;
+}
+
+// Sends `sender` to a fresh receiver in the given format and returns the receiver
+static Timestamp deliver(const Timestamp *sender, int dest, WireFormat format, size_t *wire_size) {
+    Timestamp copy = ts_clone(sender);
+    ts_set_wire_format(&copy, format);
+    
+    size_t bound = ts_serialize_for_dest(&copy, dest, NULL, 0);
+    unsigned char *buffer = malloc(bound);
+    *wire_size = ts_serialize_for_dest(&copy, dest, buffer, bound);
+    
+    Timestamp receiver = ts_create(sender->n, dest, sender->type);
+    ts_set_wire_format(&receiver, format);
+    ts_merge(&receiver, buffer, *wire_size);
+    
+    free(buffer);
+    ts_destroy(&copy);
+    return receiver;
+}
+
+/* ---------- Varint Tests ---------- */
+
+static int test_uvarint_roundtrip() {
+    uint64_t values[] = {0, 1, 127, 128, 300, 16383, 16384, 0xFFFFFFFFull, 0xFFFFFFFFFFFFFFFFull};
+    for (int i = 0; i < 9; i++) {
+        uint8_t buffer[WIRE_MAX_VARINT];
+        size_t used = wire_put_uvarint(buffer, values[i]);
+        uint64_t decoded = 0;
+        
+        TEST_ASSERT_EQ(wire_uvarint_size(values[i]), used, "Size helper should match bytes written");
+        TEST_ASSERT_EQ(used, wire_get_uvarint(buffer, used, &decoded), "Decoder should consume every byte");
+        TEST_ASSERT(decoded == values[i], "Decoded value should match");
+    }
+    
+    uint8_t truncated[] = {0x80, 0x80};
+    uint64_t ignored;
+    TEST_ASSERT_EQ(0, wire_get_uvarint(truncated, sizeof(truncated), &ignored), "Truncated varint should fail");
+    return 1;
+}
+
+static int test_zigzag() {
+    TEST_ASSERT_EQ(0, wire_zigzag_encode(0), "0 -> 0");
+    TEST_ASSERT_EQ(1, wire_zigzag_encode(-1), "-1 -> 1");
+    TEST_ASSERT_EQ(2, wire_zigzag_encode(1), "1 -> 2");
+    TEST_ASSERT_EQ(3, wire_zigzag_encode(-2), "-2 -> 3");
+    TEST_ASSERT_EQ(-123456, wire_zigzag_decode(wire_zigzag_encode(-123456)), "Zigzag should round-trip");
+    return 1;
+}
+
+/* ---------- Frame Tests ---------- */
+
+static int test_compact_header() {
+    Timestamp ts = make_busy_clock(8, 3, CLOCK_STANDARD);
+    ts_set_wire_format(&ts, WIRE_COMPACT);
+    
+    uint8_t buffer[256];
+    size_t size = ts_serialize(&ts, buffer, sizeof(buffer));
+    
+    TEST_ASSERT(size < 8 * sizeof(int), "Compact frame should be smaller than the raw vector");
+    TEST_ASSERT_EQ(WIRE_COMPACT_VERSION, buffer[0] >> 6, "Header should carry the format version");
+    TEST_ASSERT_EQ(CLOCK_STANDARD, buffer[0] & 0x0F, "Header should carry the clock type");
+    
+    ts_destroy(&ts);
+    return 1;
+}
+
+static int test_compact_matches_raw_all_types() {
+    ClockType types[] = {CLOCK_STANDARD, CLOCK_SPARSE, CLOCK_DIFFERENTIAL, CLOCK_ENCODED, CLOCK_COMPRESSED};
+    
+    for (int t = 0; t < 5; t++) {
+        Timestamp sender = make_busy_clock(6, 1, types[t]);
+        size_t raw_size, compact_size;
+        Timestamp raw_rx = deliver(&sender, 4, WIRE_RAW, &raw_size);
+        Timestamp compact_rx = deliver(&sender, 4, WIRE_COMPACT, &compact_size);
+        
+        TEST_ASSERT_EQ(TS_EQUAL, ts_compare(&raw_rx, &compact_rx), "Compact delivery should match raw delivery");
+        TEST_ASSERT(compact_size < raw_size, "Compact frame should be smaller than raw");
+        
+        ts_destroy(&sender);
+        ts_destroy(&raw_rx);
+        ts_destroy(&compact_rx);
+    }
+    return 1;
+}
+
+static int test_compact_deserialize() {
+    Timestamp sender = make_busy_clock(10, 2, CLOCK_SPARSE);
+    ts_set_wire_format(&sender, WIRE_COMPACT);
+    
+    uint8_t buffer[256];
+    size_t size = ts_serialize(&sender, buffer, sizeof(buffer));
+    
+    Timestamp copy = ts_create(10, 2, CLOCK_SPARSE);
+    ts_set_wire_format(&copy, WIRE_COMPACT);
+    ts_deserialize(&copy, buffer, size);
+    
+    TEST_ASSERT_EQ(TS_EQUAL, ts_compare(&sender, &copy), "Deserialized clock should equal the sender");
+    
+    ts_destroy(&sender);
+    ts_destroy(&copy);
+    return 1;
+}
+
+static int test_malformed_frame_ignored() {
+    Timestamp ts = ts_create(4, 0, CLOCK_STANDARD);
+    ts_set_wire_format(&ts, WIRE_COMPACT);
+    
+    uint8_t wrong_type[] = {(WIRE_COMPACT_VERSION << 6) | CLOCK_SPARSE, 0};
+    ts_merge(&ts, wrong_type, sizeof(wrong_type));
+    
+    int v[4];
+    ts_to_vector(&ts, v);
+    TEST_ASSERT_EQ(0, v[0] + v[1] + v[2] + v[3], "Frame for another clock type should be ignored");
+    
+    ts_destroy(&ts);
+    return 1;
+}
+
+// Encodes raw bytes as a compact frame and decodes them again; 1 if the bytes come back
+static int roundtrips(ClockType type, int n, const int *raw, size_t raw_size) {
+    uint8_t frame[256];
+    size_t frame_size = wire_encode_compact(type, n, raw, raw_size, frame, sizeof(frame));
+    void *back;
+    size_t back_size;
+    if (frame_size > sizeof(frame) || !wire_decode_compact(type, n, frame, frame_size, &back, &back_size)) {
+        return 0;
+    }
+    int same = back_size == raw_size && memcmp(back, raw, raw_size) == 0;
+    free(back);
+    return same;
+}
+
+static int test_pairs_frame_keeps_layout() {
+    // Mostly-zero vectors go out as pairs frames; pair messages with as many entries must
+    // still come back as pair messages and vectors as vectors
+    int pairs[] = {1, 70, 5, 90, 6, 100};     // differential: 3 pairs at n = 8
+    int vector[8] = {0, 70, 0, 0, 0, 90, 0, 0};
+    TEST_ASSERT(roundtrips(CLOCK_DIFFERENTIAL, 8, pairs, sizeof(pairs)), "Differential pairs should round-trip");
+    TEST_ASSERT(roundtrips(CLOCK_DIFFERENTIAL, 8, vector, sizeof(vector)), "Differential vector should round-trip");
+    TEST_ASSERT(roundtrips(CLOCK_STANDARD, 8, vector, sizeof(vector)), "Standard vector should round-trip");
+    
+    int delta[] = {3, 1, 70, 5, 90, 6, 100};  // compressed tag-0 delta at n = 8
+    TEST_ASSERT(roundtrips(CLOCK_COMPRESSED, 8, delta, sizeof(delta)), "Compressed delta should round-trip");
+    TEST_ASSERT(roundtrips(CLOCK_COMPRESSED, 8, vector, sizeof(vector)), "Compressed vector should round-trip");
+    
+    // A pair message of n/2 pairs (pids 1, 5, 6, 7) would read as the vector once rebuilt;
+    // no differential sender makes one, so the frame is refused
+    uint8_t half[] = {(WIRE_COMPACT_VERSION << 6) | (WIRE_KIND_PAIRS << 4) | CLOCK_DIFFERENTIAL,
+                      (4 << 1) | WIRE_PAIRS_OF_MESSAGE, 1, 14, 3, 18, 0, 20, 0, 6};
+    void *back;
+    size_t back_size;
+    TEST_ASSERT(!wire_decode_compact(CLOCK_DIFFERENTIAL, 8, half, sizeof(half), &back, &back_size),
+                "Differential pair frame of n/2 entries should be refused");
+    half[1] = (4 << 1) | WIRE_PAIRS_OF_VECTOR;
+    TEST_ASSERT(wire_decode_compact(CLOCK_DIFFERENTIAL, 8, half, sizeof(half), &back, &back_size),
+                "The same entries as a vector should decode");
+    TEST_ASSERT_EQ(8 * sizeof(int), back_size, "Vector frame should rebuild n ints");
+    TEST_ASSERT_EQ(10, ((int*)back)[6], "Entries should land at their pids");
+    free(back);
+    return 1;
+}
+
+static int test_half_vector_send_compact() {
+    // A differential send with n/2 due entries, end to end in the compact format
+    enum { N = 8 };
+    Timestamp sender = ts_create(N, 0, CLOCK_DIFFERENTIAL);
+    int incoming[] = {1, 1001, 2, 1002, 3, 1003};
+    ts_merge(&sender, incoming, sizeof(incoming));
+    
+    size_t raw_size, compact_size;
+    Timestamp raw_rx = deliver(&sender, N - 1, WIRE_RAW, &raw_size);
+    Timestamp compact_rx = deliver(&sender, N - 1, WIRE_COMPACT, &compact_size);
+    int expected[N], a[N], b[N];
+    ts_to_vector(&sender, expected);
+    ts_to_vector(&raw_rx, a);
+    ts_to_vector(&compact_rx, b);
+    for (int k = 0; k < N - 1; k++) {
+        TEST_ASSERT_EQ(expected[k], a[k], "Raw receiver should take the sender's counters");
+        TEST_ASSERT_EQ(expected[k], b[k], "Compact receiver should take the sender's counters");
+    }
+    
+    ts_destroy(&sender);
+    ts_destroy(&raw_rx);
+    ts_destroy(&compact_rx);
+    return 1;
+}
+
+static int test_delta_frames_within_bound() {
+    // 40 of 64 entries near 2^29: five-byte zigzag varints, so the flattened pairs outgrow
+    // the bitmap and runs layouts
+    enum { N = 64, COUNT = 40 };
+    int bitmap[1 + 2 + COUNT] = {(COMPRESSED_ENC_BITMAP << COMPRESSED_TAG_SHIFT) | COUNT};
+    int runs[1 + 2 + COUNT] = {(COMPRESSED_ENC_RUNS << COMPRESSED_TAG_SHIFT) | 1, 10, COUNT};
+    for (int i = 0, pid = 0; i < COUNT; pid++) {
+        if (pid % 8 >= 5) continue;
+        bitmap[1 + pid / 32] |= 1u << (pid % 32);
+        bitmap[3 + i] = (1 << 29) + pid;
+        runs[3 + i] = (1 << 29) + 10 + i;
+        i++;
+    }
+    
+    const int *frames[] = {bitmap, runs};
+    for (int f = 0; f < 2; f++) {
+        uint8_t out[512];
+        size_t raw_size = sizeof(bitmap);
+        size_t size = wire_encode_compact(CLOCK_COMPRESSED, N, frames[f], raw_size, out, sizeof(out));
+        TEST_ASSERT(size <= wire_compact_bound(raw_size), "Frame should fit the bound");
+        TEST_ASSERT(roundtrips(CLOCK_COMPRESSED, N, frames[f], raw_size), "Delta should round-trip");
+    }
+    
+    // End to end: the size query is all a sender allocates
+    Timestamp sender = ts_create(N, 0, CLOCK_COMPRESSED);
+    int v[N] = {0};
+    for (int pid = 1; pid <= COUNT; pid++) v[pid] = (1 << 29) + pid;
+    ts_merge(&sender, v, sizeof(v));
+    size_t wire_size;
+    Timestamp receiver = deliver(&sender, N - 1, WIRE_COMPACT, &wire_size);
+    int got[N];
+    ts_to_vector(&receiver, got);
+    for (int pid = 1; pid <= COUNT; pid++) {
+        TEST_ASSERT_EQ(v[pid], got[pid], "Receiver should take every counter");
+    }
+    
+    ts_destroy(&sender);
+    ts_destroy(&receiver);
+    return 1;
+}
+
+static int test_merge_and_tick_orders_after_both() {
+    // The receive event must follow both the message and the receiver's previous state,
+    // whether or not the type's merge ticks by itself
+    for (int type = 0; type < CLOCK_TYPE_COUNT; type++) {
+        for (int format = WIRE_RAW; format <= WIRE_COMPACT; format++) {
+            Timestamp sender = make_busy_clock(6, 1, type);
+            Timestamp receiver = make_busy_clock(6, 4, type);
+            Timestamp before = ts_clone(&receiver);
+            ts_set_wire_format(&sender, format);
+            ts_set_wire_format(&receiver, format);
+            
+            uint8_t buffer[1024];
+            size_t size = ts_serialize(&sender, buffer, sizeof(buffer));
+            ts_merge_and_tick(&receiver, buffer, size);
+            
+            TEST_ASSERT_EQ(TS_BEFORE, ts_compare(&sender, &receiver), "Message should precede the receive event");
+            TEST_ASSERT_EQ(TS_BEFORE, ts_compare(&before, &receiver), "Previous state should precede the receive event");
+            
+            ts_destroy(&sender);
+            ts_destroy(&receiver);
+            ts_destroy(&before);
+        }
+    }
+    return 1;
+}
+
+/* ---------- Test Runner ---------- */
+
+static void print_test_summary() {
+    printf("\n=== Test Summary ===\n");
+    printf("Tests run: %d\n", g_stats.tests_run);
+    printf("Tests passed: %d\n", g_stats.tests_passed);
+    printf("Tests failed: %d\n", g_stats.tests_failed);
+    printf("Success rate: %.1f%%\n", 
+           g_stats.tests_run > 0 ? (100.0 * g_stats.tests_passed / g_stats.tests_run) : 0.0);
+}
+
+int main() {
+    printf("=== Wire Codec Test Suite ===\n\n");
+    
+    // Varint Tests
+    printf("--- Varint Tests ---\n");
+    RUN_TEST(test_uvarint_roundtrip);
+    RUN_TEST(test_zigzag);
+    
+    // Frame Tests
+    printf("\n--- Frame Tests ---\n");
+    RUN_TEST(test_compact_header);
+    RUN_TEST(test_compact_matches_raw_all_types);
+    RUN_TEST(test_compact_deserialize);
+    RUN_TEST(test_malformed_frame_ignored);
+    RUN_TEST(test_pairs_frame_keeps_layout);
+    RUN_TEST(test_half_vector_send_compact);
+    RUN_TEST(test_delta_frames_within_bound);
+    
+    // Dispatch Tests
+    printf("\n--- Dispatch Tests ---\n");
+    RUN_TEST(test_merge_and_tick_orders_after_both);
+    
+    print_test_summary();
+    
+    return g_stats.tests_failed > 0 ? 1 : 0;
+}